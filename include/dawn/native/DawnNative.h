@@ -181,6 +181,12 @@ namespace dawn::native {
     // Backdoor to get the number of lazy clears for testing
     DAWN_NATIVE_EXPORT size_t GetLazyClearCountForTesting(WGPUDevice device);
 
+    // Backdoor to get the number of redundant state-setting commands removed for testing
+    DAWN_NATIVE_EXPORT size_t GetRedundantStateCommandCountForTesting(WGPUDevice device);
+
+    // Backdoor to get the number of pipelines compiled by the backend for testing
+    DAWN_NATIVE_EXPORT size_t GetPipelineCompilationCountForTesting(WGPUDevice device);
+
     // Backdoor to get the number of deprecation warnings for testing
     DAWN_NATIVE_EXPORT size_t GetDeprecationWarningCountForTesting(WGPUDevice device);
 
@@ -33,6 +33,20 @@ namespace dawn::native::vulkan {
     DAWN_NATIVE_EXPORT WGPUTextureFormat
     GetNativeSwapChainPreferredFormat(const DawnSwapChainImplementation* swapChain);
 
+    // The memory used in a Vulkan memory heap of the device.
+    struct DAWN_NATIVE_EXPORT MemoryHeapInfo {
+        uint64_t size = 0;
+        bool isDeviceLocal = false;
+        // How much memory the process can allocate in the heap and how much it uses. They come
+        // from VK_EXT_memory_budget when it is supported. Otherwise the budget is the size of the
+        // heap and the usage is the memory allocated by Dawn.
+        uint64_t budget = 0;
+        uint64_t usage = 0;
+    };
+
+    // Returns the current usage of each memory heap of the device.
+    DAWN_NATIVE_EXPORT std::vector<MemoryHeapInfo> GetMemoryHeapInfos(WGPUDevice device);
+
     struct DAWN_NATIVE_EXPORT AdapterDiscoveryOptions : public AdapterDiscoveryOptionsBase {
         AdapterDiscoveryOptions();
 
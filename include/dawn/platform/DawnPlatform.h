@@ -61,6 +61,17 @@ namespace dawn::platform {
         CachingInterface& operator=(const CachingInterface&) = delete;
     };
 
+    // Creates a CachingInterface that persists the cached values in |directory|, which is created
+    // if needed. Values stored with a different |fingerprint| are kept in a separate subdirectory
+    // and the least recently used values are evicted to keep their total size under
+    // |maxSizeInBytes|. Embedders can return it from Platform::GetCachingInterface. Returns nullptr
+    // if the directory can't be created.
+    DAWN_PLATFORM_EXPORT std::unique_ptr<CachingInterface> CreateFileCachingInterface(
+        const char* directory,
+        uint64_t maxSizeInBytes,
+        const void* fingerprint,
+        size_t fingerprintSize);
+
     class DAWN_PLATFORM_EXPORT WaitableEvent {
       public:
         WaitableEvent() = default;
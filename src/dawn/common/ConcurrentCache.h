@@ -17,38 +17,60 @@
 
 #include "dawn/common/NonCopyable.h"
 
+#include <array>
 #include <mutex>
+#include <shared_mutex>
 #include <unordered_set>
 #include <utility>
 
+// A set of objects compared by content that can be used from several threads at once. The
+// objects are spread over shards that each have their own reader-writer lock, so that Find only
+// takes a shared lock and contends with writers of the same shard only, and operations on
+// objects of different shards don't contend at all.
 template <typename T>
 class ConcurrentCache : public NonMovable {
   public:
     ConcurrentCache() = default;
 
     T* Find(T* object) {
-        std::lock_guard<std::mutex> lock(mMutex);
-        auto iter = mCache.find(object);
-        if (iter == mCache.end()) {
+        Shard& shard = GetShard(object);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto iter = shard.objects.find(object);
+        if (iter == shard.objects.end()) {
             return nullptr;
         }
         return *iter;
     }
 
     std::pair<T*, bool> Insert(T* object) {
-        std::lock_guard<std::mutex> lock(mMutex);
-        auto [value, inserted] = mCache.insert(object);
+        Shard& shard = GetShard(object);
+        std::lock_guard<std::shared_mutex> lock(shard.mutex);
+        auto [value, inserted] = shard.objects.insert(object);
         return {*value, inserted};
     }
 
     size_t Erase(T* object) {
-        std::lock_guard<std::mutex> lock(mMutex);
-        return mCache.erase(object);
+        Shard& shard = GetShard(object);
+        std::lock_guard<std::shared_mutex> lock(shard.mutex);
+        return shard.objects.erase(object);
     }
 
   private:
-    std::mutex mMutex;
-    std::unordered_set<T*, typename T::HashFunc, typename T::EqualityFunc> mCache;
+    static constexpr size_t kShardCount = 16;
+
+    // Each shard is on its own cache line so that locking one doesn't slow down the others.
+    struct alignas(64) Shard {
+        std::shared_mutex mutex;
+        std::unordered_set<T*, typename T::HashFunc, typename T::EqualityFunc> objects;
+    };
+
+    Shard& GetShard(const T* object) {
+        size_t hash = typename T::HashFunc()(object);
+        // Fold the high bits in so that hashes that only differ there don't share a shard.
+        return mShards[(hash ^ (hash >> 16)) % kShardCount];
+    }
+
+    std::array<Shard, kShardCount> mShards;
 };
 
 #endif
@@ -1,18 +1,50 @@
 #include "dawn/native/AsyncTask.h"
 
+#include "dawn/common/Assert.h"
 #include "dawn/platform/DawnPlatform.h"
 
 namespace dawn::native {
 
+    void AsyncTaskManager::WaitableTask::Wait() {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mCondition.wait(lock, [this] { return mIsFinished; });
+    }
+
+    bool AsyncTaskManager::WaitableTask::TryLeavePendingState(State newState) {
+        ASSERT(newState != State::Pending);
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mState != State::Pending) {
+            return false;
+        }
+        mState = newState;
+        return true;
+    }
+
+    void AsyncTaskManager::WaitableTask::MarkAsFinished() {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            ASSERT(mState != State::Pending);
+            mIsFinished = true;
+        }
+        mCondition.notify_all();
+    }
+
+    bool AsyncTaskManager::WaitableTask::IsCancelled() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mState == State::Cancelled;
+    }
+
     AsyncTaskManager::AsyncTaskManager(dawn::platform::WorkerTaskPool* workerTaskPool)
         : mWorkerTaskPool(workerTaskPool) {
     }
 
-    void AsyncTaskManager::PostTask(AsyncTask asyncTask) {
+    Ref<AsyncTaskManager::WaitableTask> AsyncTaskManager::PostTask(AsyncTask asyncTask,
+                                                                   AsyncTask cancelCallback) {
         // If these allocations becomes expensive, we can slab-allocate tasks.
         Ref<WaitableTask> waitableTask = AcquireRef(new WaitableTask());
-        waitableTask->taskManager = this;
-        waitableTask->asyncTask = std::move(asyncTask);
+        waitableTask->mTaskManager = this;
+        waitableTask->mAsyncTask = std::move(asyncTask);
+        waitableTask->mCancelCallback = std::move(cancelCallback);
 
         {
             // We insert new waitableTask objects into mPendingTasks in main thread (PostTask()),
@@ -26,8 +58,50 @@ namespace dawn::native {
         // Ref the task since it is accessed inside the worker function.
         // The worker function will acquire and release the task upon completion.
         waitableTask->Reference();
-        waitableTask->waitableEvent =
-            mWorkerTaskPool->PostWorkerTask(DoWaitableTask, waitableTask.Get());
+        // Completion is tracked by the WaitableTask itself since the task may be cancelled or run
+        // on another thread before the worker gets to it.
+        mWorkerTaskPool->PostWorkerTask(DoWaitableTask, waitableTask.Get());
+
+        return waitableTask;
+    }
+
+    bool AsyncTaskManager::Cancel(WaitableTask* task) {
+        if (!task->TryLeavePendingState(WaitableTask::State::Cancelled)) {
+            return false;
+        }
+        HandleTaskCompletion(task);
+
+        // Release what the task captured right away instead of when the worker gets to the task.
+        AsyncTask cancelCallback = std::move(task->mCancelCallback);
+        task->mAsyncTask = nullptr;
+        task->mCancelCallback = nullptr;
+        if (cancelCallback) {
+            cancelCallback();
+        }
+
+        task->MarkAsFinished();
+        return true;
+    }
+
+    bool AsyncTaskManager::RunNow(WaitableTask* task) {
+        if (task->TryLeavePendingState(WaitableTask::State::Running)) {
+            RunTask(task);
+            return true;
+        }
+
+        task->Wait();
+        return !task->IsCancelled();
+    }
+
+    void AsyncTaskManager::RunTask(WaitableTask* task) {
+        task->mAsyncTask();
+        task->mAsyncTask = nullptr;
+        task->mCancelCallback = nullptr;
+
+        // Remove the task from mPendingTasks before marking it as finished, as a waiter could
+        // destroy the AsyncTaskManager as soon as it is.
+        HandleTaskCompletion(task);
+        task->MarkAsFinished();
     }
 
     void AsyncTaskManager::HandleTaskCompletion(WaitableTask* task) {
@@ -38,6 +112,21 @@ namespace dawn::native {
         }
     }
 
+    void AsyncTaskManager::CancelAllPendingTasks() {
+        std::unordered_map<WaitableTask*, Ref<WaitableTask>> allPendingTasks;
+
+        {
+            std::lock_guard<std::mutex> lock(mPendingTasksMutex);
+            allPendingTasks.swap(mPendingTasks);
+        }
+
+        for (auto& [_, task] : allPendingTasks) {
+            if (!Cancel(task.Get())) {
+                task->Wait();
+            }
+        }
+    }
+
     void AsyncTaskManager::WaitAllPendingTasks() {
         std::unordered_map<WaitableTask*, Ref<WaitableTask>> allPendingTasks;
 
@@ -47,7 +136,7 @@ namespace dawn::native {
         }
 
         for (auto& [_, task] : allPendingTasks) {
-            task->waitableEvent->Wait();
+            task->Wait();
         }
     }
 
@@ -58,8 +147,13 @@ namespace dawn::native {
 
     void AsyncTaskManager::DoWaitableTask(void* task) {
         Ref<WaitableTask> waitableTask = AcquireRef(static_cast<WaitableTask*>(task));
-        waitableTask->asyncTask();
-        waitableTask->taskManager->HandleTaskCompletion(waitableTask.Get());
+
+        // The task was cancelled or stolen by RunNow() while it was queued. The AsyncTaskManager
+        // may already be destroyed in that case so it must not be used.
+        if (!waitableTask->TryLeavePendingState(WaitableTask::State::Running)) {
+            return;
+        }
+        waitableTask->mTaskManager->RunTask(waitableTask.Get());
     }
 
 }  // namespace dawn::native
@@ -15,6 +15,7 @@
 #ifndef DAWNNATIVE_ASYC_TASK_H_
 #define DAWNNATIVE_ASYC_TASK_H_
 
+#include <condition_variable>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -29,30 +30,62 @@ namespace dawn::platform {
 
 namespace dawn::native {
 
-    // TODO(crbug.com/dawn/826): we'll add additional things to AsyncTask in the future, like
-    // Cancel() and RunNow(). Cancelling helps avoid running the task's body when we are just
-    // shutting down the device. RunNow() could be used for more advanced scenarios, for example
-    // always doing ShaderModule initial compilation asynchronously, but being able to steal the
-    // task if we need it for synchronous pipeline compilation.
     using AsyncTask = std::function<void()>;
 
     class AsyncTaskManager {
       public:
         explicit AsyncTaskManager(dawn::platform::WorkerTaskPool* workerTaskPool);
 
-        void PostTask(AsyncTask asyncTask);
-        void WaitAllPendingTasks();
-        bool HasPendingTasks();
-
-      private:
+        // A task posted to the AsyncTaskManager. It can be cancelled as long as it hasn't started
+        // running, and it can be stolen by another thread that needs its result right away.
         class WaitableTask : public RefCounted {
           public:
-            AsyncTask asyncTask;
-            AsyncTaskManager* taskManager;
-            std::unique_ptr<dawn::platform::WaitableEvent> waitableEvent;
+            // Blocks until the task either completed or got cancelled.
+            void Wait();
+
+          private:
+            friend class AsyncTaskManager;
+
+            enum class State {
+                Pending,
+                Running,
+                Cancelled,
+            };
+
+            // Moves the task from Pending to |newState|. Returns false if it was already running or
+            // cancelled.
+            bool TryLeavePendingState(State newState);
+            void MarkAsFinished();
+            bool IsCancelled();
+
+            AsyncTask mAsyncTask;
+            AsyncTask mCancelCallback;
+            AsyncTaskManager* mTaskManager = nullptr;
+
+            std::mutex mMutex;
+            std::condition_variable mCondition;
+            State mState = State::Pending;
+            bool mIsFinished = false;
         };
 
+        // |cancelCallback|, if any, is called on the cancelling thread instead of |asyncTask| if
+        // the task gets cancelled.
+        Ref<WaitableTask> PostTask(AsyncTask asyncTask, AsyncTask cancelCallback = nullptr);
+
+        // Cancels |task| if it hasn't started running yet. Returns true if it was cancelled.
+        bool Cancel(WaitableTask* task);
+        // Runs |task| on the calling thread if it hasn't started running yet, otherwise waits for
+        // it to complete. Returns false if the task was cancelled instead.
+        bool RunNow(WaitableTask* task);
+
+        // Cancels all the tasks that haven't started yet and waits for the others to complete.
+        void CancelAllPendingTasks();
+        void WaitAllPendingTasks();
+        bool HasPendingTasks();
+
+      private:
         static void DoWaitableTask(void* task);
+        void RunTask(WaitableTask* task);
         void HandleTaskCompletion(WaitableTask* task);
 
         std::mutex mPendingTasksMutex;
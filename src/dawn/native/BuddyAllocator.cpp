@@ -56,8 +56,11 @@ namespace dawn::native {
         return Log2(mMaxBlockSize) - Log2(blockSize);
     }
 
-    uint64_t BuddyAllocator::GetNextFreeAlignedBlock(size_t allocationBlockLevel,
-                                                     uint64_t alignment) const {
+    BuddyAllocator::BuddyBlock* BuddyAllocator::GetNextFreeAlignedBlock(
+        size_t allocationBlockLevel,
+        uint64_t alignment,
+        const BlockFilter& isBlockUsable,
+        size_t* blockLevel) const {
         ASSERT(IsPowerOfTwo(alignment));
         // The current level is the level that corresponds to the allocation size. The free list may
         // not contain a block at that level until a larger one gets allocated (and splits).
@@ -81,14 +84,23 @@ namespace dawn::native {
         //  Allocate(size=8, alignment=4) will be satified by using F1.
         //  Allocate(size=8, alignment=16) will be satisified by using F2.
         //
+        // With a filter, the whole free list of each level is searched for a block that it
+        // accepts instead of only looking at the first one.
         for (size_t ii = 0; ii <= allocationBlockLevel; ++ii) {
             size_t currLevel = allocationBlockLevel - ii;
-            BuddyBlock* freeBlock = mFreeLists[currLevel].head;
-            if (freeBlock && (freeBlock->mOffset % alignment == 0)) {
-                return currLevel;
+            for (BuddyBlock* freeBlock = mFreeLists[currLevel].head; freeBlock != nullptr;
+                 freeBlock = freeBlock->free.pNext) {
+                if (freeBlock->mOffset % alignment == 0 &&
+                    (!isBlockUsable || isBlockUsable(freeBlock->mOffset, freeBlock->mSize))) {
+                    *blockLevel = currLevel;
+                    return freeBlock;
+                }
+                if (!isBlockUsable) {
+                    break;
+                }
             }
         }
-        return kInvalidOffset;  // No free block exists at any level.
+        return nullptr;  // No free block exists at any level.
     }
 
     // Inserts existing free block into the free-list.
@@ -137,6 +149,12 @@ namespace dawn::native {
     }
 
     uint64_t BuddyAllocator::Allocate(uint64_t allocationSize, uint64_t alignment) {
+        return Allocate(allocationSize, alignment, {});
+    }
+
+    uint64_t BuddyAllocator::Allocate(uint64_t allocationSize,
+                                      uint64_t alignment,
+                                      const BlockFilter& isBlockUsable) {
         if (allocationSize == 0 || allocationSize > mMaxBlockSize) {
             return kInvalidOffset;
         }
@@ -146,17 +164,18 @@ namespace dawn::native {
 
         ASSERT(allocationSizeToLevel < mFreeLists.size());
 
-        uint64_t currBlockLevel = GetNextFreeAlignedBlock(allocationSizeToLevel, alignment);
+        size_t currBlockLevel = 0;
+        BuddyBlock* currBlock = GetNextFreeAlignedBlock(allocationSizeToLevel, alignment,
+                                                        isBlockUsable, &currBlockLevel);
 
         // Error when no free blocks exist (allocator is full)
-        if (currBlockLevel == kInvalidOffset) {
+        if (currBlock == nullptr) {
             return kInvalidOffset;
         }
 
         // Split free blocks level-by-level.
         // Terminate when the current block level is equal to the computed level of the requested
         // allocation.
-        BuddyBlock* currBlock = mFreeLists[currBlockLevel].head;
 
         for (; currBlockLevel < allocationSizeToLevel; currBlockLevel++) {
             ASSERT(currBlock->mState == BlockState::Free);
@@ -17,6 +17,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <limits>
 #include <vector>
 
@@ -42,6 +43,13 @@ namespace dawn::native {
         uint64_t Allocate(uint64_t allocationSize, uint64_t alignment = 1);
         void Deallocate(uint64_t offset);
 
+        // Like Allocate, but only uses the free blocks that |isBlockUsable| accepts, given their
+        // offset and size. The allocation is in the block that was accepted.
+        using BlockFilter = std::function<bool(uint64_t offset, uint64_t size)>;
+        uint64_t Allocate(uint64_t allocationSize,
+                          uint64_t alignment,
+                          const BlockFilter& isBlockUsable);
+
         // For testing purposes only.
         uint64_t ComputeTotalNumOfFreeBlocksForTesting() const;
 
@@ -49,7 +57,6 @@ namespace dawn::native {
 
       private:
         uint32_t ComputeLevelFromBlockSize(uint64_t blockSize) const;
-        uint64_t GetNextFreeAlignedBlock(size_t allocationBlockLevel, uint64_t alignment) const;
 
         enum class BlockState { Free, Split, Allocated };
 
@@ -91,6 +98,13 @@ namespace dawn::native {
             };
         };
 
+        // Returns the free block to allocate from and sets |blockLevel| to its level, or returns
+        // nullptr if there is none.
+        BuddyBlock* GetNextFreeAlignedBlock(size_t allocationBlockLevel,
+                                            uint64_t alignment,
+                                            const BlockFilter& isBlockUsable,
+                                            size_t* blockLevel) const;
+
         void InsertFreeBlock(BuddyBlock* block, size_t level);
         void RemoveFreeBlock(BuddyBlock* block, size_t level);
         void DeleteBlock(BuddyBlock* block);
@@ -69,13 +69,54 @@ namespace dawn::native {
             // Transfer ownership to this allocator
             std::unique_ptr<ResourceHeapBase> memory;
             DAWN_TRY_ASSIGN(memory, mHeapAllocator->AllocateResourceHeap(mMemoryBlockSize));
-            mTrackedSubAllocations[memoryIndex] = {/*refcount*/ 0, std::move(memory)};
+            mTrackedSubAllocations[memoryIndex] = {/*refcount*/ 0, /*usedSize*/ 0,
+                                                   std::move(memory)};
         }
 
+        return TrackSubAllocation(blockOffset, allocationSize);
+    }
+
+    ResourceMemoryAllocation BuddyMemoryAllocator::AllocateInExistingHeaps(
+        uint64_t allocationSize,
+        uint64_t alignment,
+        const std::function<bool(const ResourceHeapBase*)>& isHeapUsable) {
+        if (allocationSize == 0 || allocationSize > mMemoryBlockSize) {
+            return ResourceMemoryAllocation{};
+        }
+        allocationSize = NextPowerOfTwo(allocationSize);
+        if (allocationSize > mMemoryBlockSize) {
+            return ResourceMemoryAllocation{};
+        }
+
+        const uint64_t blockOffset = mBuddyBlockAllocator.Allocate(
+            allocationSize, alignment, [&](uint64_t offset, uint64_t size) {
+                // Free blocks larger than a memory block only contain memory blocks that aren't
+                // allocated.
+                if (size > mMemoryBlockSize) {
+                    return false;
+                }
+                const TrackedSubAllocations& tracked =
+                    mTrackedSubAllocations[GetMemoryIndex(offset)];
+                return tracked.refcount > 0 && isHeapUsable(tracked.mMemoryAllocation.get());
+            });
+        if (blockOffset == BuddyAllocator::kInvalidOffset) {
+            return ResourceMemoryAllocation{};
+        }
+
+        return TrackSubAllocation(blockOffset, allocationSize);
+    }
+
+    ResourceMemoryAllocation BuddyMemoryAllocator::TrackSubAllocation(uint64_t blockOffset,
+                                                                      uint64_t blockSize) {
+        const uint64_t memoryIndex = GetMemoryIndex(blockOffset);
+        ASSERT(mTrackedSubAllocations[memoryIndex].mMemoryAllocation != nullptr);
+
         mTrackedSubAllocations[memoryIndex].refcount++;
+        mTrackedSubAllocations[memoryIndex].usedSize += blockSize;
 
         AllocationInfo info;
         info.mBlockOffset = blockOffset;
+        info.mBlockSize = blockSize;
         info.mMethod = AllocationMethod::kSubAllocated;
 
         // Allocation offset is always local to the memory.
@@ -94,6 +135,8 @@ namespace dawn::native {
 
         ASSERT(mTrackedSubAllocations[memoryIndex].refcount > 0);
         mTrackedSubAllocations[memoryIndex].refcount--;
+        ASSERT(mTrackedSubAllocations[memoryIndex].usedSize >= info.mBlockSize);
+        mTrackedSubAllocations[memoryIndex].usedSize -= info.mBlockSize;
 
         if (mTrackedSubAllocations[memoryIndex].refcount == 0) {
             mHeapAllocator->DeallocateResourceHeap(
@@ -103,6 +146,17 @@ namespace dawn::native {
         mBuddyBlockAllocator.Deallocate(info.mBlockOffset);
     }
 
+    std::vector<BuddyMemoryAllocator::HeapUsage> BuddyMemoryAllocator::GetHeapUsages() const {
+        std::vector<HeapUsage> usages;
+        for (const TrackedSubAllocations& allocation : mTrackedSubAllocations) {
+            if (allocation.refcount > 0) {
+                usages.push_back({allocation.mMemoryAllocation.get(), allocation.refcount,
+                                  allocation.usedSize});
+            }
+        }
+        return usages;
+    }
+
     uint64_t BuddyMemoryAllocator::GetMemoryBlockSize() const {
         return mMemoryBlockSize;
     }
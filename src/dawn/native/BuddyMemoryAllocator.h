@@ -19,6 +19,7 @@
 #include "dawn/native/Error.h"
 #include "dawn/native/ResourceMemoryAllocation.h"
 
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -48,6 +49,23 @@ namespace dawn::native {
                                                          uint64_t alignment);
         void Deallocate(const ResourceMemoryAllocation& allocation);
 
+        // Like Allocate, but only sub-allocates in the memory blocks that are already allocated
+        // and that |isHeapUsable| accepts. Since no memory block is allocated it can't fail with
+        // an error, and it returns an invalid allocation when there isn't enough space in them.
+        ResourceMemoryAllocation AllocateInExistingHeaps(
+            uint64_t allocationSize,
+            uint64_t alignment,
+            const std::function<bool(const ResourceHeapBase*)>& isHeapUsable);
+
+        struct HeapUsage {
+            ResourceHeapBase* heap;
+            uint64_t subAllocationCount;
+            // The sum of the sizes of the blocks sub-allocated in the heap.
+            uint64_t usedSize;
+        };
+        // Returns the usage of each of the memory blocks that are allocated.
+        std::vector<HeapUsage> GetHeapUsages() const;
+
         uint64_t GetMemoryBlockSize() const;
 
         // For testing purposes.
@@ -55,6 +73,8 @@ namespace dawn::native {
 
       private:
         uint64_t GetMemoryIndex(uint64_t offset) const;
+        // Tracks the sub-allocation of the block in the memory that was already allocated for it.
+        ResourceMemoryAllocation TrackSubAllocation(uint64_t blockOffset, uint64_t blockSize);
 
         uint64_t mMemoryBlockSize = 0;
 
@@ -63,6 +83,7 @@ namespace dawn::native {
 
         struct TrackedSubAllocations {
             size_t refcount = 0;
+            uint64_t usedSize = 0;
             std::unique_ptr<ResourceHeapBase> mMemoryAllocation;
         };
 
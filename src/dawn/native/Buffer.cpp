@@ -16,6 +16,7 @@
 
 #include "dawn/common/Alloc.h"
 #include "dawn/common/Assert.h"
+#include "dawn/common/Math.h"
 #include "dawn/native/Commands.h"
 #include "dawn/native/Device.h"
 #include "dawn/native/DynamicUploader.h"
@@ -24,6 +25,7 @@
 #include "dawn/native/Queue.h"
 #include "dawn/native/ValidationUtils_autogen.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 #include <utility>
@@ -553,6 +555,38 @@ namespace dawn::native {
 
     void BufferBase::SetIsDataInitialized() {
         mIsDataInitialized = true;
+        mInitializedRanges.Clear();
+    }
+
+    bool BufferBase::NeedsInitialization(uint64_t offset, uint64_t size) const {
+        return NeedsInitialization() && !mInitializedRanges.Contains(offset, size);
+    }
+
+    bool BufferBase::IsDataUninitialized(uint64_t offset, uint64_t size) const {
+        return NeedsInitialization() && !mInitializedRanges.Intersects(offset, size);
+    }
+
+    void BufferBase::SetIsDataInitialized(uint64_t offset, uint64_t size) {
+        if (mIsDataInitialized) {
+            return;
+        }
+
+        mInitializedRanges.Add(offset, size);
+        if (mInitializedRanges.Contains(0, GetAllocatedSize())) {
+            SetIsDataInitialized();
+        }
+    }
+
+    std::vector<IntervalSet::Interval> BufferBase::GetUninitializedRanges(uint64_t offset,
+                                                                          uint64_t size) const {
+        ASSERT(NeedsInitialization());
+        ASSERT(offset + size <= GetAllocatedSize());
+
+        // Fills of buffers must be 4-byte aligned on some backends. The written ranges are 4-byte
+        // aligned too, so the extended range doesn't add initialized bytes to the gaps.
+        uint64_t start = offset & ~uint64_t(3);
+        uint64_t end = std::min(Align(offset + size, 4), GetAllocatedSize());
+        return mInitializedRanges.GetGaps(start, end - start);
     }
 
     bool BufferBase::IsFullBufferRange(uint64_t offset, uint64_t size) const {
@@ -18,11 +18,13 @@
 #include "dawn/native/Error.h"
 #include "dawn/native/Forward.h"
 #include "dawn/native/IntegerTypes.h"
+#include "dawn/native/IntervalSet.h"
 #include "dawn/native/ObjectBase.h"
 
 #include "dawn/native/dawn_platform.h"
 
 #include <memory>
+#include <vector>
 
 namespace dawn::native {
 
@@ -68,6 +70,21 @@ namespace dawn::native {
         bool IsDataInitialized() const;
         void SetIsDataInitialized();
 
+        // The initialization of the data is also tracked per range of bytes of the allocation so
+        // that writes to part of the buffer don't need to clear the rest of it. Only the ranges
+        // that were never written are lazily cleared, when they are read.
+        // Whether some of [offset, offset + size) wasn't written yet.
+        bool NeedsInitialization(uint64_t offset, uint64_t size) const;
+        // Whether none of [offset, offset + size) was written yet. Clearing such a range to zero
+        // can be skipped since it would be lazily cleared if it were read.
+        bool IsDataUninitialized(uint64_t offset, uint64_t size) const;
+        // Marks [offset, offset + size) as written. The rest of the buffer stays uninitialized.
+        void SetIsDataInitialized(uint64_t offset, uint64_t size);
+        // Returns the ranges of [offset, offset + size) that weren't written yet, extended to
+        // 4-byte alignment for the clears.
+        std::vector<IntervalSet::Interval> GetUninitializedRanges(uint64_t offset,
+                                                                  uint64_t size) const;
+
         void* GetMappedRange(size_t offset, size_t size, bool writable = true);
         void Unmap();
 
@@ -119,6 +136,8 @@ namespace dawn::native {
         wgpu::BufferUsage mUsage = wgpu::BufferUsage::None;
         BufferState mState;
         bool mIsDataInitialized = false;
+        // The ranges written while the buffer isn't entirely initialized.
+        IntervalSet mInitializedRanges;
 
         std::unique_ptr<StagingBufferBase> mStagingBuffer;
 
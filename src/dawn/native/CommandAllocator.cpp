@@ -24,6 +24,121 @@
 
 namespace dawn::native {
 
+    namespace {
+
+        BlockDef AllocateBlock(CommandBlockPool* pool, size_t size) {
+            if (pool != nullptr) {
+                return pool->Allocate(size);
+            }
+            return {size, static_cast<uint8_t*>(malloc(size))};
+        }
+
+        void FreeBlock(CommandBlockPool* pool, const BlockDef& block) {
+            if (pool != nullptr) {
+                pool->Deallocate(block);
+            } else {
+                free(block.block);
+            }
+        }
+
+        size_t GetSizeClass(size_t size) {
+            ASSERT(size >= CommandBlockPool::kMinBlockSize);
+            ASSERT(size <= CommandBlockPool::kMaxBlockSize);
+            return Log2Ceil(static_cast<uint64_t>(size)) -
+                   ConstexprLog2(CommandBlockPool::kMinBlockSize);
+        }
+
+    }  // anonymous namespace
+
+    // CommandBlockPool
+
+    CommandBlockPool::CommandBlockPool() = default;
+
+    CommandBlockPool::~CommandBlockPool() {
+        ASSERT(mSizeInUse == 0);
+        for (std::vector<uint8_t*>& blocks : mFreeBlocks) {
+            for (uint8_t* block : blocks) {
+                free(block);
+            }
+        }
+    }
+
+    BlockDef CommandBlockPool::Allocate(size_t minimumSize) {
+        if (minimumSize > kMaxBlockSize) {
+            return {minimumSize, static_cast<uint8_t*>(malloc(minimumSize))};
+        }
+
+        size_t sizeClass = GetSizeClass(std::max(minimumSize, kMinBlockSize));
+        size_t size = kMinBlockSize << sizeClass;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mSizeInUse += size;
+            mHighWaterMark = std::max(mHighWaterMark, mSizeInUse);
+
+            std::vector<uint8_t*>& freeBlocks = mFreeBlocks[sizeClass];
+            if (!freeBlocks.empty()) {
+                uint8_t* block = freeBlocks.back();
+                freeBlocks.pop_back();
+                mCachedSize -= size;
+                return {size, block};
+            }
+        }
+
+        uint8_t* block = static_cast<uint8_t*>(malloc(size));
+        if (DAWN_UNLIKELY(block == nullptr)) {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mSizeInUse -= size;
+        }
+        return {size, block};
+    }
+
+    void CommandBlockPool::Deallocate(const BlockDef& block) {
+        if (block.size > kMaxBlockSize) {
+            free(block.block);
+            return;
+        }
+
+        ASSERT(IsPowerOfTwo(block.size));
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            ASSERT(mSizeInUse >= block.size);
+            mSizeInUse -= block.size;
+
+            if (mCachedSize + block.size <= kMaxCachedSize) {
+                mFreeBlocks[GetSizeClass(block.size)].push_back(block.block);
+                mCachedSize += block.size;
+                return;
+            }
+        }
+        free(block.block);
+    }
+
+    void CommandBlockPool::Trim() {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        // Keep enough blocks to go back to the high-water mark without allocating, starting the
+        // eviction with the largest blocks since they are the rarest.
+        size_t sizeToKeep = mHighWaterMark - mSizeInUse;
+        for (size_t sizeClass = kSizeClassCount; sizeClass-- > 0;) {
+            std::vector<uint8_t*>& freeBlocks = mFreeBlocks[sizeClass];
+            size_t size = kMinBlockSize << sizeClass;
+            while (mCachedSize > sizeToKeep && !freeBlocks.empty()) {
+                free(freeBlocks.back());
+                freeBlocks.pop_back();
+                mCachedSize -= size;
+            }
+        }
+
+        mHighWaterMark = mSizeInUse;
+    }
+
+    size_t CommandBlockPool::GetCachedSizeForTesting() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mCachedSize;
+    }
+
+    // CommandIterator
+
     // TODO(cwallez@chromium.org): figure out a way to have more type safety for the iterator
 
     CommandIterator::CommandIterator() {
@@ -37,6 +152,7 @@ namespace dawn::native {
     CommandIterator::CommandIterator(CommandIterator&& other) {
         if (!other.IsEmpty()) {
             mBlocks = std::move(other.mBlocks);
+            mPool = std::move(other.mPool);
             other.Reset();
         }
         Reset();
@@ -46,6 +162,7 @@ namespace dawn::native {
         ASSERT(IsEmpty());
         if (!other.IsEmpty()) {
             mBlocks = std::move(other.mBlocks);
+            mPool = std::move(other.mPool);
             other.Reset();
         }
         Reset();
@@ -53,7 +170,7 @@ namespace dawn::native {
     }
 
     CommandIterator::CommandIterator(CommandAllocator allocator)
-        : mBlocks(allocator.AcquireBlocks()) {
+        : mBlocks(allocator.AcquireBlocks()), mPool(allocator.mPool) {
         Reset();
     }
 
@@ -63,6 +180,9 @@ namespace dawn::native {
         for (CommandAllocator& allocator : allocators) {
             CommandBlocks blocks = allocator.AcquireBlocks();
             if (!blocks.empty()) {
+                // All the blocks must go back to the same pool.
+                ASSERT(mBlocks.empty() || mPool.Get() == allocator.mPool.Get());
+                mPool = allocator.mPool;
                 mBlocks.reserve(mBlocks.size() + blocks.size());
                 for (BlockDef& block : blocks) {
                     mBlocks.push_back(std::move(block));
@@ -104,9 +224,10 @@ namespace dawn::native {
         }
 
         for (BlockDef& block : mBlocks) {
-            free(block.block);
+            FreeBlock(mPool.Get(), block);
         }
         mBlocks.clear();
+        mPool = nullptr;
         Reset();
         ASSERT(IsEmpty());
     }
@@ -129,12 +250,18 @@ namespace dawn::native {
         ResetPointers();
     }
 
+    CommandAllocator::CommandAllocator(CommandBlockPool* pool) : mPool(pool) {
+        ResetPointers();
+    }
+
     CommandAllocator::~CommandAllocator() {
         Reset();
     }
 
     CommandAllocator::CommandAllocator(CommandAllocator&& other)
-        : mBlocks(std::move(other.mBlocks)), mLastAllocationSize(other.mLastAllocationSize) {
+        : mBlocks(std::move(other.mBlocks)),
+          mLastAllocationSize(other.mLastAllocationSize),
+          mPool(other.mPool) {
         other.mBlocks.clear();
         if (!other.IsEmpty()) {
             mCurrentPtr = other.mCurrentPtr;
@@ -147,6 +274,7 @@ namespace dawn::native {
 
     CommandAllocator& CommandAllocator::operator=(CommandAllocator&& other) {
         Reset();
+        mPool = other.mPool;
         if (!other.IsEmpty()) {
             std::swap(mBlocks, other.mBlocks);
             mLastAllocationSize = other.mLastAllocationSize;
@@ -159,7 +287,7 @@ namespace dawn::native {
 
     void CommandAllocator::Reset() {
         for (BlockDef& block : mBlocks) {
-            free(block.block);
+            FreeBlock(mPool.Get(), block);
         }
         mBlocks.clear();
         mLastAllocationSize = kDefaultBaseAllocationSize;
@@ -209,14 +337,15 @@ namespace dawn::native {
         mLastAllocationSize =
             std::max(minimumSize, std::min(mLastAllocationSize * 2, size_t(16384)));
 
-        uint8_t* block = static_cast<uint8_t*>(malloc(mLastAllocationSize));
-        if (DAWN_UNLIKELY(block == nullptr)) {
+        // The pool may return a bigger block than requested.
+        BlockDef block = AllocateBlock(mPool.Get(), mLastAllocationSize);
+        if (DAWN_UNLIKELY(block.block == nullptr)) {
             return false;
         }
 
-        mBlocks.push_back({mLastAllocationSize, block});
-        mCurrentPtr = AlignPtr(block, alignof(uint32_t));
-        mEndPtr = block + mLastAllocationSize;
+        mBlocks.push_back(block);
+        mCurrentPtr = AlignPtr(block.block, alignof(uint32_t));
+        mEndPtr = block.block + block.size;
         return true;
     }
 
@@ -18,9 +18,12 @@
 #include "dawn/common/Assert.h"
 #include "dawn/common/Math.h"
 #include "dawn/common/NonCopyable.h"
+#include "dawn/common/RefCounted.h"
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
+#include <mutex>
 #include <vector>
 
 namespace dawn::native {
@@ -65,6 +68,44 @@ namespace dawn::native {
         constexpr uint32_t kAdditionalData = std::numeric_limits<uint32_t>::max() - 1;
     }  // namespace detail
 
+    // A cache of command blocks shared by the CommandAllocators of a device so that encoding many
+    // command buffers doesn't keep going back to malloc. Blocks are kept in power-of-two size
+    // classes that match the sizes the CommandAllocator grows through, and larger blocks are not
+    // cached. The blocks freed since the previous call to Trim() are kept only up to what was
+    // needed to reach the high-water mark of the blocks in use during that period.
+    // This class is thread-safe so that command buffers can be encoded and freed on any thread.
+    class CommandBlockPool : public RefCounted {
+      public:
+        CommandBlockPool();
+
+        // Returns a block of at least |minimumSize| bytes, or a block with a nullptr pointer if
+        // the allocation failed.
+        BlockDef Allocate(size_t minimumSize);
+        void Deallocate(const BlockDef& block);
+
+        // Frees the cached blocks that weren't needed since the previous call to Trim().
+        void Trim();
+
+        size_t GetCachedSizeForTesting();
+
+        static constexpr size_t kMinBlockSize = 4096;
+        static constexpr size_t kMaxBlockSize = 16384;
+        // Limit on the total size of the cached blocks, whatever the high-water mark.
+        static constexpr size_t kMaxCachedSize = 4 * 1024 * 1024;
+
+      private:
+        ~CommandBlockPool() override;
+
+        static constexpr size_t kSizeClassCount =
+            ConstexprLog2(kMaxBlockSize) - ConstexprLog2(kMinBlockSize) + 1;
+
+        std::mutex mMutex;
+        std::array<std::vector<uint8_t*>, kSizeClassCount> mFreeBlocks;
+        size_t mCachedSize = 0;
+        size_t mSizeInUse = 0;
+        size_t mHighWaterMark = 0;
+    };
+
     class CommandAllocator;
 
     class CommandIterator : public NonCopyable {
@@ -140,6 +181,8 @@ namespace dawn::native {
         }
 
         CommandBlocks mBlocks;
+        // The pool the blocks are returned to, if any.
+        Ref<CommandBlockPool> mPool;
         uint8_t* mCurrentPtr = nullptr;
         size_t mCurrentBlock = 0;
         // Used to avoid a special case for empty iterators.
@@ -149,9 +192,12 @@ namespace dawn::native {
     class CommandAllocator : public NonCopyable {
       public:
         CommandAllocator();
+        // Blocks are taken from and returned to |pool| when it isn't nullptr.
+        explicit CommandAllocator(CommandBlockPool* pool);
         ~CommandAllocator();
 
-        // NOTE: A moved-from CommandAllocator is reset to its initial empty state.
+        // NOTE: A moved-from CommandAllocator is reset to its initial empty state, and keeps using
+        // the same CommandBlockPool.
         CommandAllocator(CommandAllocator&&);
         CommandAllocator& operator=(CommandAllocator&&);
 
@@ -255,6 +301,7 @@ namespace dawn::native {
 
         CommandBlocks mBlocks;
         size_t mLastAllocationSize = kDefaultBaseAllocationSize;
+        Ref<CommandBlockPool> mPool;
 
         // Data used for the block range at initialization so that the first call to Allocate sees
         // there is not enough space and calls GetNewBlock. This avoids having to special case the
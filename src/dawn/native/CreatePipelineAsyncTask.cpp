@@ -122,17 +122,42 @@ namespace dawn::native {
         TRACE_EVENT1(device->GetPlatform(), General, "CreateComputePipelineAsyncTask::Run", "label",
                      eventLabel);
 
-        MaybeError maybeError = mComputePipeline->Initialize();
+        PipelineCompilationTracker<ComputePipelineBase>* tracker =
+            device->GetComputePipelineCompilationTracker();
+        ComputePipelineBase* pipeline = mComputePipeline.Get();
+
+        // Reuse the compilation of the same pipeline by another task if there was one when this
+        // task was posted. Otherwise (or if that compilation failed) compile this pipeline.
+        Ref<PipelineCompilation<ComputePipelineBase>> compilation = std::move(mExistingCompilation);
         std::string errorMessage;
-        if (maybeError.IsError()) {
-            mComputePipeline = nullptr;
-            errorMessage = maybeError.AcquireError()->GetMessage();
+        if (compilation != nullptr &&
+            device->GetAsyncTaskManager()->RunNow(compilation->task.Get()) &&
+            compilation->succeeded) {
+            mComputePipeline = compilation->pipeline;
+        } else {
+            device->IncrementPipelineCompilationCountForTesting();
+            MaybeError maybeError = pipeline->Initialize();
+            tracker->Complete(pipeline, !maybeError.IsError());
+            if (maybeError.IsError()) {
+                mComputePipeline = nullptr;
+                errorMessage = maybeError.AcquireError()->GetMessage();
+            }
         }
 
         device->AddComputePipelineAsyncCallbackTask(mComputePipeline, errorMessage, mCallback,
                                                     mUserdata);
     }
 
+    void CreateComputePipelineAsyncTask::Cancel() {
+        DeviceBase* device = mComputePipeline->GetDevice();
+        device->GetComputePipelineCompilationTracker()->Complete(mComputePipeline.Get(), false);
+
+        // The callback is called with the status of the device shutdown or loss that caused the
+        // cancellation.
+        device->AddComputePipelineAsyncCallbackTask(nullptr, "Pipeline creation was cancelled",
+                                                    mCallback, mUserdata);
+    }
+
     void CreateComputePipelineAsyncTask::RunAsync(
         std::unique_ptr<CreateComputePipelineAsyncTask> task) {
         DeviceBase* device = task->mComputePipeline->GetDevice();
@@ -140,18 +165,18 @@ namespace dawn::native {
         const char* eventLabel =
             utils::GetLabelForTrace(task->mComputePipeline->GetLabel().c_str());
 
-        // Using "taskPtr = std::move(task)" causes compilation error while it should be supported
-        // since C++14:
-        // https://docs.microsoft.com/en-us/cpp/cpp/lambda-expressions-in-cpp?view=msvc-160
-        auto asyncTask = [taskPtr = task.release()] {
-            std::unique_ptr<CreateComputePipelineAsyncTask> innnerTaskPtr(taskPtr);
-            innnerTaskPtr->Run();
-        };
-
         TRACE_EVENT_FLOW_BEGIN1(device->GetPlatform(), General,
                                 "CreateComputePipelineAsyncTask::RunAsync", task.get(), "label",
                                 eventLabel);
-        device->GetAsyncTaskManager()->PostTask(std::move(asyncTask));
+
+        // The task is shared with the cancel callback, and std::function requires copyable
+        // captures.
+        std::shared_ptr<CreateComputePipelineAsyncTask> sharedTask = std::move(task);
+        ComputePipelineBase* pipeline = sharedTask->mComputePipeline.Get();
+        device->GetComputePipelineCompilationTracker()->PostTask(
+            device->GetAsyncTaskManager(), pipeline, &sharedTask->mExistingCompilation,
+            [sharedTask] { sharedTask->Run(); },
+            [sharedTask] { sharedTask->Cancel(); });
     }
 
     CreateRenderPipelineAsyncTask::CreateRenderPipelineAsyncTask(
@@ -173,34 +198,59 @@ namespace dawn::native {
         TRACE_EVENT1(device->GetPlatform(), General, "CreateRenderPipelineAsyncTask::Run", "label",
                      eventLabel);
 
-        MaybeError maybeError = mRenderPipeline->Initialize();
+        PipelineCompilationTracker<RenderPipelineBase>* tracker =
+            device->GetRenderPipelineCompilationTracker();
+        RenderPipelineBase* pipeline = mRenderPipeline.Get();
+
+        // Reuse the compilation of the same pipeline by another task if there was one when this
+        // task was posted. Otherwise (or if that compilation failed) compile this pipeline.
+        Ref<PipelineCompilation<RenderPipelineBase>> compilation = std::move(mExistingCompilation);
         std::string errorMessage;
-        if (maybeError.IsError()) {
-            mRenderPipeline = nullptr;
-            errorMessage = maybeError.AcquireError()->GetMessage();
+        if (compilation != nullptr &&
+            device->GetAsyncTaskManager()->RunNow(compilation->task.Get()) &&
+            compilation->succeeded) {
+            mRenderPipeline = compilation->pipeline;
+        } else {
+            device->IncrementPipelineCompilationCountForTesting();
+            MaybeError maybeError = pipeline->Initialize();
+            tracker->Complete(pipeline, !maybeError.IsError());
+            if (maybeError.IsError()) {
+                mRenderPipeline = nullptr;
+                errorMessage = maybeError.AcquireError()->GetMessage();
+            }
         }
 
         device->AddRenderPipelineAsyncCallbackTask(mRenderPipeline, errorMessage, mCallback,
                                                    mUserdata);
     }
 
+    void CreateRenderPipelineAsyncTask::Cancel() {
+        DeviceBase* device = mRenderPipeline->GetDevice();
+        device->GetRenderPipelineCompilationTracker()->Complete(mRenderPipeline.Get(), false);
+
+        // The callback is called with the status of the device shutdown or loss that caused the
+        // cancellation.
+        device->AddRenderPipelineAsyncCallbackTask(nullptr, "Pipeline creation was cancelled",
+                                                   mCallback, mUserdata);
+    }
+
     void CreateRenderPipelineAsyncTask::RunAsync(
         std::unique_ptr<CreateRenderPipelineAsyncTask> task) {
         DeviceBase* device = task->mRenderPipeline->GetDevice();
 
         const char* eventLabel = utils::GetLabelForTrace(task->mRenderPipeline->GetLabel().c_str());
 
-        // Using "taskPtr = std::move(task)" causes compilation error while it should be supported
-        // since C++14:
-        // https://docs.microsoft.com/en-us/cpp/cpp/lambda-expressions-in-cpp?view=msvc-160
-        auto asyncTask = [taskPtr = task.release()] {
-            std::unique_ptr<CreateRenderPipelineAsyncTask> innerTaskPtr(taskPtr);
-            innerTaskPtr->Run();
-        };
-
         TRACE_EVENT_FLOW_BEGIN1(device->GetPlatform(), General,
                                 "CreateRenderPipelineAsyncTask::RunAsync", task.get(), "label",
                                 eventLabel);
-        device->GetAsyncTaskManager()->PostTask(std::move(asyncTask));
+
+        // The task is shared with the cancel callback, and std::function requires copyable
+        // captures.
+        std::shared_ptr<CreateRenderPipelineAsyncTask> sharedTask = std::move(task);
+        RenderPipelineBase* pipeline = sharedTask->mRenderPipeline.Get();
+        device->GetRenderPipelineCompilationTracker()->PostTask(
+            device->GetAsyncTaskManager(), pipeline, &sharedTask->mExistingCompilation,
+            [sharedTask] { sharedTask->Run(); },
+            [sharedTask] { sharedTask->Cancel(); });
     }
 }  // namespace dawn::native
@@ -15,11 +15,16 @@
 #ifndef DAWNNATIVE_CREATEPIPELINEASYNCTASK_H_
 #define DAWNNATIVE_CREATEPIPELINEASYNCTASK_H_
 
+#include "dawn/common/Assert.h"
 #include "dawn/common/RefCounted.h"
+#include "dawn/native/AsyncTask.h"
 #include "dawn/native/CallbackTaskManager.h"
 #include "dawn/native/Error.h"
 #include "dawn/webgpu.h"
 
+#include <mutex>
+#include <unordered_map>
+
 namespace dawn::native {
 
     class ComputePipelineBase;
@@ -67,6 +72,102 @@ namespace dawn::native {
         WGPUCreateRenderPipelineAsyncCallback mCreateRenderPipelineAsyncCallback;
     };
 
+    // The compilation of a pipeline by a Create*PipelineAsync task that isn't in the device's
+    // pipeline cache yet. Other creations of the same pipeline reuse it instead of compiling the
+    // pipeline a second time.
+    template <typename Pipeline>
+    struct PipelineCompilation : RefCounted {
+        Ref<Pipeline> pipeline;
+        Ref<AsyncTaskManager::WaitableTask> task;
+        // Set by the task before it completes, only valid once it did.
+        bool succeeded = false;
+    };
+
+    // Tracks the pipeline compilations of a device by pipeline content, from the time their task
+    // is posted until their pipeline is added to the device's pipeline cache, which only happens
+    // on the next Tick. Thread-safe as the tasks look up and complete their compilations on the
+    // worker threads.
+    template <typename Pipeline>
+    class PipelineCompilationTracker {
+      public:
+        ~PipelineCompilationTracker() {
+            ASSERT(mCompilations.empty());
+        }
+
+        // Posts |asyncTask| and, unless the same pipeline is already tracked, tracks it as the
+        // compilation of |pipeline|. Otherwise |existingCompilation| is set to the compilation of
+        // the same pipeline, before the task is posted, for the task to reuse it.
+        void PostTask(AsyncTaskManager* taskManager,
+                      Pipeline* pipeline,
+                      Ref<PipelineCompilation<Pipeline>>* existingCompilation,
+                      AsyncTask asyncTask,
+                      AsyncTask cancelCallback) {
+            // Track the compilation before posting the task so that it can't complete before it
+            // is tracked, but don't hold the lock while posting as the task may run inline.
+            Ref<PipelineCompilation<Pipeline>> compilation;
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                auto iter = mCompilations.find(pipeline);
+                if (iter != mCompilations.end()) {
+                    *existingCompilation = iter->second;
+                } else {
+                    compilation = AcquireRef(new PipelineCompilation<Pipeline>());
+                    compilation->pipeline = pipeline;
+                    mCompilations.emplace(pipeline, compilation);
+                }
+            }
+
+            Ref<AsyncTaskManager::WaitableTask> task =
+                taskManager->PostTask(std::move(asyncTask), std::move(cancelCallback));
+
+            if (compilation != nullptr) {
+                std::lock_guard<std::mutex> lock(mMutex);
+                compilation->task = std::move(task);
+            }
+        }
+
+        // Returns the tracked compilation of a pipeline equal to |blueprint|, if any.
+        Ref<PipelineCompilation<Pipeline>> Find(Pipeline* blueprint) {
+            std::lock_guard<std::mutex> lock(mMutex);
+            auto iter = mCompilations.find(blueprint);
+            if (iter == mCompilations.end() || iter->second->task == nullptr) {
+                return nullptr;
+            }
+            return iter->second;
+        }
+
+        // Called by the task for |pipeline| once it is done compiling it or got cancelled. Failed
+        // compilations stop being tracked, successful ones stay tracked until Remove() is called.
+        void Complete(Pipeline* pipeline, bool succeeded) {
+            std::lock_guard<std::mutex> lock(mMutex);
+            auto iter = mCompilations.find(pipeline);
+            if (iter != mCompilations.end() && iter->second->pipeline.Get() == pipeline) {
+                iter->second->succeeded = succeeded;
+                if (!succeeded) {
+                    mCompilations.erase(iter);
+                }
+            }
+        }
+
+        // Stops tracking the compilation of |pipeline| once it is in the device's pipeline cache,
+        // or once its result is dropped.
+        void Remove(Pipeline* pipeline) {
+            std::lock_guard<std::mutex> lock(mMutex);
+            auto iter = mCompilations.find(pipeline);
+            if (iter != mCompilations.end() && iter->second->pipeline.Get() == pipeline) {
+                mCompilations.erase(iter);
+            }
+        }
+
+      private:
+        std::mutex mMutex;
+        std::unordered_map<Pipeline*,
+                           Ref<PipelineCompilation<Pipeline>>,
+                           typename Pipeline::HashFunc,
+                           typename Pipeline::EqualityFunc>
+            mCompilations;
+    };
+
     // CreateComputePipelineAsyncTask defines all the inputs and outputs of
     // CreateComputePipelineAsync() tasks, which are the same among all the backends.
     class CreateComputePipelineAsyncTask {
@@ -76,11 +177,15 @@ namespace dawn::native {
                                        void* userdata);
 
         void Run();
+        void Cancel();
 
         static void RunAsync(std::unique_ptr<CreateComputePipelineAsyncTask> task);
 
       private:
         Ref<ComputePipelineBase> mComputePipeline;
+        // The compilation of the same pipeline by another task, if there was one when this task
+        // was posted.
+        Ref<PipelineCompilation<ComputePipelineBase>> mExistingCompilation;
         WGPUCreateComputePipelineAsyncCallback mCallback;
         void* mUserdata;
     };
@@ -94,11 +199,15 @@ namespace dawn::native {
                                       void* userdata);
 
         void Run();
+        void Cancel();
 
         static void RunAsync(std::unique_ptr<CreateRenderPipelineAsyncTask> task);
 
       private:
         Ref<RenderPipelineBase> mRenderPipeline;
+        // The compilation of the same pipeline by another task, if there was one when this task
+        // was posted.
+        Ref<PipelineCompilation<RenderPipelineBase>> mExistingCompilation;
         WGPUCreateRenderPipelineAsyncCallback mCallback;
         void* mUserdata;
     };
@@ -249,6 +249,14 @@ namespace dawn::native {
         return FromAPI(device)->GetLazyClearCountForTesting();
     }
 
+    size_t GetRedundantStateCommandCountForTesting(WGPUDevice device) {
+        return FromAPI(device)->GetRedundantStateCommandCountForTesting();
+    }
+
+    size_t GetPipelineCompilationCountForTesting(WGPUDevice device) {
+        return FromAPI(device)->GetPipelineCompilationCountForTesting();
+    }
+
     size_t GetDeprecationWarningCountForTesting(WGPUDevice device) {
         return FromAPI(device)->GetDeprecationWarningCountForTesting();
     }
@@ -22,6 +22,7 @@
 #include "dawn/native/BindGroupLayout.h"
 #include "dawn/native/Buffer.h"
 #include "dawn/native/ChainUtils_autogen.h"
+#include "dawn/native/CommandAllocator.h"
 #include "dawn/native/CommandBuffer.h"
 #include "dawn/native/CommandEncoder.h"
 #include "dawn/native/CompilationMessages.h"
@@ -80,6 +81,10 @@ namespace dawn::native {
         ContentLessObjectCache<RenderPipelineBase> renderPipelines;
         ContentLessObjectCache<SamplerBase> samplers;
         ContentLessObjectCache<ShaderModuleBase> shaderModules;
+
+        // Pipelines being compiled by Create*PipelineAsync tasks.
+        PipelineCompilationTracker<ComputePipelineBase> computePipelineCompilations;
+        PipelineCompilationTracker<RenderPipelineBase> renderPipelineCompilations;
     };
 
     struct DeviceBase::DeprecationWarnings {
@@ -238,6 +243,7 @@ namespace dawn::native {
         mCaches = std::make_unique<DeviceBase::Caches>();
         mErrorScopeStack = std::make_unique<ErrorScopeStack>();
         mDynamicUploader = std::make_unique<DynamicUploader>(this);
+        mCommandBlockPool = AcquireRef(new CommandBlockPool());
         mCallbackTaskManager = std::make_unique<CallbackTaskManager>();
         mDeprecationWarnings = std::make_unique<DeprecationWarnings>();
         mInternalPipelineStore = std::make_unique<InternalPipelineStore>(this);
@@ -336,9 +342,9 @@ namespace dawn::native {
                 mDeviceLostCallback = nullptr;
             }
 
-            // Call all the callbacks immediately as the device is about to shut down.
-            // TODO(crbug.com/dawn/826): Cancel the tasks that are in flight if possible.
-            mAsyncTaskManager->WaitAllPendingTasks();
+            // Call all the callbacks immediately as the device is about to shut down. The tasks
+            // that didn't start yet are cancelled and report the shutdown as well.
+            mAsyncTaskManager->CancelAllPendingTasks();
             auto callbackTasks = mCallbackTaskManager->AcquireCallbackTasks();
             for (std::unique_ptr<CallbackTask>& callbackTask : callbackTasks) {
                 callbackTask->HandleShutDown();
@@ -466,8 +472,7 @@ namespace dawn::native {
 
             mQueue->HandleDeviceLoss();
 
-            // TODO(crbug.com/dawn/826): Cancel the tasks that are in flight if possible.
-            mAsyncTaskManager->WaitAllPendingTasks();
+            mAsyncTaskManager->CancelAllPendingTasks();
             auto callbackTasks = mCallbackTaskManager->AcquireCallbackTasks();
             for (std::unique_ptr<CallbackTask>& callbackTask : callbackTasks) {
                 callbackTask->HandleDeviceLoss();
@@ -876,6 +881,7 @@ namespace dawn::native {
             result->SetIsCachedReference();
             result->SetContentHash(blueprintHash);
             mCaches->shaderModules.insert(result.Get());
+            result->StoreReflectionInCache();
         }
 
         return std::move(result);
@@ -1137,6 +1143,7 @@ namespace dawn::native {
             // reclaiming resources one tick earlier.
             mDynamicUploader->Deallocate(mCompletedSerial);
             mQueue->Tick(mCompletedSerial);
+            mCommandBlockPool->Trim();
         }
 
         // We have to check callback tasks in every Tick because it is not related to any global
@@ -1196,6 +1203,24 @@ namespace dawn::native {
         ++mLazyClearCountForTesting;
     }
 
+    size_t DeviceBase::GetPipelineCompilationCountForTesting() {
+        return mPipelineCompilationCountForTesting;
+    }
+
+    void DeviceBase::IncrementPipelineCompilationCountForTesting() {
+        ++mPipelineCompilationCountForTesting;
+    }
+
+    size_t DeviceBase::GetRedundantStateCommandCountForTesting() {
+        return mRedundantStateCommandCount;
+    }
+
+    void DeviceBase::AddRedundantStateCommandCount(size_t count) {
+        mRedundantStateCommandCount += count;
+        TRACE_COUNTER1(GetPlatform(), General, "RedundantStateCommandsRemoved",
+                       mRedundantStateCommandCount);
+    }
+
     size_t DeviceBase::GetDeprecationWarningCountForTesting() {
         return mDeprecationWarnings->count;
     }
@@ -1321,6 +1346,16 @@ namespace dawn::native {
             return cachedComputePipeline;
         }
 
+        // If a CreateComputePipelineAsync task is compiling the same pipeline, run it now or wait
+        // for it instead of compiling the pipeline a second time.
+        Ref<PipelineCompilation<ComputePipelineBase>> compilation =
+            mCaches->computePipelineCompilations.Find(uninitializedComputePipeline.Get());
+        if (compilation != nullptr && mAsyncTaskManager->RunNow(compilation->task.Get()) &&
+            compilation->succeeded) {
+            return AddOrGetCachedComputePipeline(compilation->pipeline);
+        }
+
+        IncrementPipelineCompilationCountForTesting();
         DAWN_TRY(uninitializedComputePipeline->Initialize());
         return AddOrGetCachedComputePipeline(std::move(uninitializedComputePipeline));
     }
@@ -1378,6 +1413,7 @@ namespace dawn::native {
         Ref<ComputePipelineBase> result;
         std::string errorMessage;
 
+        IncrementPipelineCompilationCountForTesting();
         MaybeError maybeError = computePipeline->Initialize();
         if (maybeError.IsError()) {
             std::unique_ptr<ErrorData> error = maybeError.AcquireError();
@@ -1401,6 +1437,7 @@ namespace dawn::native {
         Ref<RenderPipelineBase> result;
         std::string errorMessage;
 
+        IncrementPipelineCompilationCountForTesting();
         MaybeError maybeError = renderPipeline->Initialize();
         if (maybeError.IsError()) {
             std::unique_ptr<ErrorData> error = maybeError.AcquireError();
@@ -1476,6 +1513,16 @@ namespace dawn::native {
             return cachedRenderPipeline;
         }
 
+        // If a CreateRenderPipelineAsync task is compiling the same pipeline, run it now or wait
+        // for it instead of compiling the pipeline a second time.
+        Ref<PipelineCompilation<RenderPipelineBase>> compilation =
+            mCaches->renderPipelineCompilations.Find(uninitializedRenderPipeline.Get());
+        if (compilation != nullptr && mAsyncTaskManager->RunNow(compilation->task.Get()) &&
+            compilation->succeeded) {
+            return AddOrGetCachedRenderPipeline(compilation->pipeline);
+        }
+
+        IncrementPipelineCompilationCountForTesting();
         DAWN_TRY(uninitializedRenderPipeline->Initialize());
         return AddOrGetCachedRenderPipeline(std::move(uninitializedRenderPipeline));
     }
@@ -1536,6 +1583,7 @@ namespace dawn::native {
         // error directly in Dawn and no compilationMessages held in the shader module. It is ok as
         // long as dawn_native don't use the compilationMessages of these internal shader modules.
         ShaderModuleParseResult parseResult;
+        LoadShaderModuleReflectionFromCache(this, descriptor, &parseResult);
 
         if (IsValidationEnabled()) {
             DAWN_TRY_CONTEXT(
@@ -1606,6 +1654,10 @@ namespace dawn::native {
         return mDynamicUploader.get();
     }
 
+    CommandBlockPool* DeviceBase::GetCommandBlockPool() const {
+        return mCommandBlockPool.Get();
+    }
+
     // The Toggle device facility
 
     std::vector<const char*> DeviceBase::GetTogglesUsed() const {
@@ -1633,6 +1685,7 @@ namespace dawn::native {
     void DeviceBase::SetDefaultToggles() {
         SetToggle(Toggle::LazyClearResourceOnFirstUse, true);
         SetToggle(Toggle::DisallowUnsafeAPIs, true);
+        SetToggle(Toggle::SkipRedundantStateCommands, true);
     }
 
     void DeviceBase::ApplyToggleOverrides(const DawnTogglesDeviceDescriptor* togglesDescriptor) {
@@ -1694,7 +1747,27 @@ namespace dawn::native {
         // needs to call the private member function DeviceBase::AddOrGetCachedComputePipeline().
         struct CreateComputePipelineAsyncWaitableCallbackTask final
             : CreateComputePipelineAsyncCallbackTask {
-            using CreateComputePipelineAsyncCallbackTask::CreateComputePipelineAsyncCallbackTask;
+            CreateComputePipelineAsyncWaitableCallbackTask(
+                Ref<ComputePipelineBase> pipeline,
+                std::string errorMessage,
+                WGPUCreateComputePipelineAsyncCallback callback,
+                void* userdata)
+                : CreateComputePipelineAsyncCallbackTask(pipeline,
+                                                         std::move(errorMessage),
+                                                         callback,
+                                                         userdata),
+                  mCompiledPipeline(std::move(pipeline)) {
+            }
+
+            // The compilation stays tracked until the pipeline is in the cache, so that the
+            // creations of the same pipeline before that reuse it.
+            ~CreateComputePipelineAsyncWaitableCallbackTask() override {
+                if (mCompiledPipeline != nullptr) {
+                    mCompiledPipeline->GetDevice()->GetComputePipelineCompilationTracker()->Remove(
+                        mCompiledPipeline.Get());
+                }
+            }
+
             void Finish() final {
                 // TODO(dawn:529): call AddOrGetCachedComputePipeline() asynchronously in
                 // CreateComputePipelineAsyncTaskImpl::Run() when the front-end pipeline cache is
@@ -1705,6 +1778,8 @@ namespace dawn::native {
 
                 CreateComputePipelineAsyncCallbackTask::Finish();
             }
+
+            Ref<ComputePipelineBase> mCompiledPipeline;
         };
 
         mCallbackTaskManager->AddCallbackTask(
@@ -1721,7 +1796,26 @@ namespace dawn::native {
         // needs to call the private member function DeviceBase::AddOrGetCachedRenderPipeline().
         struct CreateRenderPipelineAsyncWaitableCallbackTask final
             : CreateRenderPipelineAsyncCallbackTask {
-            using CreateRenderPipelineAsyncCallbackTask::CreateRenderPipelineAsyncCallbackTask;
+            CreateRenderPipelineAsyncWaitableCallbackTask(
+                Ref<RenderPipelineBase> pipeline,
+                std::string errorMessage,
+                WGPUCreateRenderPipelineAsyncCallback callback,
+                void* userdata)
+                : CreateRenderPipelineAsyncCallbackTask(pipeline,
+                                                        std::move(errorMessage),
+                                                        callback,
+                                                        userdata),
+                  mCompiledPipeline(std::move(pipeline)) {
+            }
+
+            // The compilation stays tracked until the pipeline is in the cache, so that the
+            // creations of the same pipeline before that reuse it.
+            ~CreateRenderPipelineAsyncWaitableCallbackTask() override {
+                if (mCompiledPipeline != nullptr) {
+                    mCompiledPipeline->GetDevice()->GetRenderPipelineCompilationTracker()->Remove(
+                        mCompiledPipeline.Get());
+                }
+            }
 
             void Finish() final {
                 // TODO(dawn:529): call AddOrGetCachedRenderPipeline() asynchronously in
@@ -1733,6 +1827,8 @@ namespace dawn::native {
 
                 CreateRenderPipelineAsyncCallbackTask::Finish();
             }
+
+            Ref<RenderPipelineBase> mCompiledPipeline;
         };
 
         mCallbackTaskManager->AddCallbackTask(
@@ -1740,6 +1836,16 @@ namespace dawn::native {
                 std::move(pipeline), errorMessage, callback, userdata));
     }
 
+    PipelineCompilationTracker<ComputePipelineBase>*
+    DeviceBase::GetComputePipelineCompilationTracker() {
+        return &mCaches->computePipelineCompilations;
+    }
+
+    PipelineCompilationTracker<RenderPipelineBase>*
+    DeviceBase::GetRenderPipelineCompilationTracker() {
+        return &mCaches->renderPipelineCompilations;
+    }
+
     PipelineCompatibilityToken DeviceBase::GetNextPipelineCompatibilityToken() {
         return PipelineCompatibilityToken(mNextPipelineCompatibilityToken++);
     }
@@ -44,6 +44,7 @@ namespace dawn::native {
     class AttachmentStateBlueprint;
     class BindGroupLayoutBase;
     class CallbackTaskManager;
+    class CommandBlockPool;
     class DynamicUploader;
     class ErrorScopeStack;
     class ExternalTextureBase;
@@ -51,6 +52,8 @@ namespace dawn::native {
     class PersistentCache;
     class StagingBufferBase;
     struct CallbackTask;
+    template <typename Pipeline>
+    class PipelineCompilationTracker;
     struct InternalPipelineStore;
     struct ShaderModuleParseResult;
 
@@ -286,6 +289,7 @@ namespace dawn::native {
                                                     const Extent3D& copySizePixels) = 0;
 
         DynamicUploader* GetDynamicUploader() const;
+        CommandBlockPool* GetCommandBlockPool() const;
 
         // The device state which is a combination of creation state and loss state.
         //
@@ -319,7 +323,14 @@ namespace dawn::native {
         bool IsRobustnessEnabled() const;
         size_t GetLazyClearCountForTesting();
         void IncrementLazyClearCountForTesting();
+        // The number of state-setting commands removed by EliminateRedundantStateCommands.
+        size_t GetRedundantStateCommandCountForTesting();
+        void AddRedundantStateCommandCount(size_t count);
         size_t GetDeprecationWarningCountForTesting();
+        // The number of pipelines compiled by the backend, that weren't found in the cache or
+        // being compiled by another creation of the same pipeline.
+        size_t GetPipelineCompilationCountForTesting();
+        void IncrementPipelineCompilationCountForTesting();
         void EmitDeprecationWarning(const char* warning);
         void EmitLog(const char* message);
         void EmitLog(WGPULoggingType loggingType, const char* message);
@@ -364,6 +375,9 @@ namespace dawn::native {
                                                 WGPUCreateRenderPipelineAsyncCallback callback,
                                                 void* userdata);
 
+        PipelineCompilationTracker<ComputePipelineBase>* GetComputePipelineCompilationTracker();
+        PipelineCompilationTracker<RenderPipelineBase>* GetRenderPipelineCompilationTracker();
+
         PipelineCompatibilityToken GetNextPipelineCompatibilityToken();
 
         const std::string& GetCacheIsolationKey() const;
@@ -508,6 +522,8 @@ namespace dawn::native {
         Ref<BindGroupLayoutBase> mEmptyBindGroupLayout;
 
         std::unique_ptr<DynamicUploader> mDynamicUploader;
+        // Kept alive by the allocators and iterators that use it, so it can outlive the device.
+        Ref<CommandBlockPool> mCommandBlockPool;
         std::unique_ptr<AsyncTaskManager> mAsyncTaskManager;
         Ref<QueueBase> mQueue;
 
@@ -529,6 +545,9 @@ namespace dawn::native {
         TogglesSet mEnabledToggles;
         TogglesSet mOverridenToggles;
         size_t mLazyClearCountForTesting = 0;
+        size_t mRedundantStateCommandCount = 0;
+        // Incremented by the Create*PipelineAsync tasks on the worker threads.
+        std::atomic<size_t> mPipelineCompilationCountForTesting{0};
         std::atomic_uint64_t mNextPipelineCompatibilityToken;
 
         CombinedLimits mLimits;
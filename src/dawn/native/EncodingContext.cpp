@@ -20,12 +20,16 @@
 #include "dawn/native/Device.h"
 #include "dawn/native/ErrorData.h"
 #include "dawn/native/IndirectDrawValidationEncoder.h"
+#include "dawn/native/RedundantStateElimination.h"
 #include "dawn/native/RenderBundleEncoder.h"
 
 namespace dawn::native {
 
     EncodingContext::EncodingContext(DeviceBase* device, const ApiObjectBase* initialEncoder)
-        : mDevice(device), mTopLevelEncoder(initialEncoder), mCurrentEncoder(initialEncoder) {
+        : mDevice(device),
+          mTopLevelEncoder(initialEncoder),
+          mCurrentEncoder(initialEncoder),
+          mPendingCommands(device->GetCommandBlockPool()) {
     }
 
     EncodingContext::~EncodingContext() {
@@ -52,9 +56,24 @@ namespace dawn::native {
         MoveToIterator();
         ASSERT(!mWereCommandsAcquired);
         mWereCommandsAcquired = true;
+        // Eliminating the redundant commands moves the commands to new blocks. The indexed
+        // indirect draws of render passes are patched by ExitRenderPass, before the commands are
+        // acquired, so only render bundles need to opt out.
+        if (mCanEliminateRedundantState &&
+            mDevice->IsToggleEnabled(Toggle::SkipRedundantStateCommands)) {
+            size_t removedCount =
+                EliminateRedundantStateCommands(&mIterator, mDevice->GetCommandBlockPool());
+            if (removedCount > 0) {
+                mDevice->AddRedundantStateCommandCount(removedCount);
+            }
+        }
         return std::move(mIterator);
     }
 
+    void EncodingContext::DisableRedundantStateElimination() {
+        mCanEliminateRedundantState = false;
+    }
+
     CommandIterator* EncodingContext::GetIterator() {
         MoveToIterator();
         ASSERT(!mWereCommandsAcquired);
@@ -44,6 +44,10 @@ namespace dawn::native {
         CommandIterator AcquireCommands();
         CommandIterator* GetIterator();
 
+        // Keeps the commands in the blocks they were encoded in when they are acquired, for
+        // encoders that hold pointers to their commands past AcquireCommands().
+        void DisableRedundantStateElimination();
+
         // Functions to handle encoder errors
         void HandleError(std::unique_ptr<ErrorData> error);
 
@@ -171,6 +175,7 @@ namespace dawn::native {
         CommandIterator mIterator;
         bool mWasMovedToIterator = false;
         bool mWereCommandsAcquired = false;
+        bool mCanEliminateRedundantState = true;
         bool mDestroyed = false;
 
         std::unique_ptr<ErrorData> mError;
@@ -0,0 +1,113 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/native/IntervalSet.h"
+
+#include "dawn/common/Assert.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace dawn::native {
+
+    void IntervalSet::Add(uint64_t offset, uint64_t size) {
+        if (size == 0) {
+            return;
+        }
+
+        uint64_t start = offset;
+        uint64_t end = offset + size;
+        ASSERT(end > start);
+
+        // Extend the new interval with the interval starting before it if they touch.
+        auto it = mIntervals.upper_bound(start);
+        if (it != mIntervals.begin()) {
+            auto previous = std::prev(it);
+            if (previous->second >= start) {
+                start = previous->first;
+                it = previous;
+            }
+        }
+
+        // Merge all the intervals that overlap or touch [start, end) into it.
+        while (it != mIntervals.end() && it->first <= end) {
+            end = std::max(end, it->second);
+            it = mIntervals.erase(it);
+        }
+
+        mIntervals.emplace(start, end);
+    }
+
+    void IntervalSet::Clear() {
+        mIntervals.clear();
+    }
+
+    bool IntervalSet::IsEmpty() const {
+        return mIntervals.empty();
+    }
+
+    bool IntervalSet::Contains(uint64_t offset, uint64_t size) const {
+        if (size == 0) {
+            return true;
+        }
+
+        // Since the intervals are coalesced, the range must be in the last interval starting at or
+        // before its start.
+        auto it = mIntervals.upper_bound(offset);
+        if (it == mIntervals.begin()) {
+            return false;
+        }
+        return std::prev(it)->second >= offset + size;
+    }
+
+    bool IntervalSet::Intersects(uint64_t offset, uint64_t size) const {
+        if (size == 0) {
+            return false;
+        }
+
+        auto it = mIntervals.upper_bound(offset);
+        if (it != mIntervals.begin() && std::prev(it)->second > offset) {
+            return true;
+        }
+        return it != mIntervals.end() && it->first < offset + size;
+    }
+
+    std::vector<IntervalSet::Interval> IntervalSet::GetGaps(uint64_t offset, uint64_t size) const {
+        std::vector<Interval> gaps;
+
+        uint64_t current = offset;
+        const uint64_t end = offset + size;
+
+        auto it = mIntervals.upper_bound(offset);
+        if (it != mIntervals.begin()) {
+            current = std::max(current, std::prev(it)->second);
+        }
+
+        for (; current < end; ++it) {
+            if (it == mIntervals.end() || it->first >= end) {
+                gaps.push_back({current, end - current});
+                break;
+            }
+            gaps.push_back({current, it->first - current});
+            current = it->second;
+        }
+
+        return gaps;
+    }
+
+    size_t IntervalSet::GetIntervalCountForTesting() const {
+        return mIntervals.size();
+    }
+
+}  // namespace dawn::native
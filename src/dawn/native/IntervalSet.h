@@ -0,0 +1,58 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_INTERVALSET_H_
+#define DAWNNATIVE_INTERVALSET_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace dawn::native {
+
+    // A set of uint64_t values stored as disjoint intervals, for example the ranges of bytes of a
+    // buffer. Overlapping and adjacent intervals are coalesced when they are added, so a set
+    // filled by consecutive writes stays a single interval.
+    class IntervalSet {
+      public:
+        struct Interval {
+            uint64_t offset;
+            uint64_t size;
+        };
+
+        // Adds [offset, offset + size) to the set.
+        void Add(uint64_t offset, uint64_t size);
+        void Clear();
+
+        bool IsEmpty() const;
+        // Whether all of [offset, offset + size) is in the set.
+        bool Contains(uint64_t offset, uint64_t size) const;
+        // Whether any of [offset, offset + size) is in the set.
+        bool Intersects(uint64_t offset, uint64_t size) const;
+
+        // Returns the intervals of [offset, offset + size) that aren't in the set, in increasing
+        // order.
+        std::vector<Interval> GetGaps(uint64_t offset, uint64_t size) const;
+
+        size_t GetIntervalCountForTesting() const;
+
+      private:
+        // Maps the start of each interval to its end.
+        std::map<uint64_t, uint64_t> mIntervals;
+    };
+
+}  // namespace dawn::native
+
+#endif  // DAWNNATIVE_INTERVALSET_H_
@@ -14,6 +14,7 @@
 
 #include "dawn/native/PassResourceUsageTracker.h"
 
+#include "dawn/common/Math.h"
 #include "dawn/native/BindGroup.h"
 #include "dawn/native/Buffer.h"
 #include "dawn/native/EnumMaskIterator.h"
@@ -22,27 +23,109 @@
 #include "dawn/native/QuerySet.h"
 #include "dawn/native/Texture.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <utility>
 
 namespace dawn::native {
 
+    namespace detail {
+
+        namespace {
+
+            size_t HashPointer(const void* pointer) {
+                // The low bits are always zero because of the alignment of the objects.
+                uintptr_t value = reinterpret_cast<uintptr_t>(pointer) >> 4;
+                return static_cast<size_t>(value * 0x9E3779B97F4A7C15ull);
+            }
+
+        }  // anonymous namespace
+
+        template <typename T>
+        std::pair<size_t, bool> ResourceIndexMap<T>::FindOrAppend(std::vector<T*>* resources,
+                                                                  T* resource) {
+            if (mTable.empty()) {
+                auto it = std::find(resources->begin(), resources->end(), resource);
+                if (it != resources->end()) {
+                    return {it - resources->begin(), false};
+                }
+                resources->push_back(resource);
+                if (resources->size() > kMaxLinearSearchSize) {
+                    RebuildTable(*resources);
+                }
+                return {resources->size() - 1, true};
+            }
+
+            size_t mask = mTable.size() - 1;
+            for (size_t slot = HashPointer(resource) & mask;; slot = (slot + 1) & mask) {
+                uint32_t index = mTable[slot];
+                if (index == kEmptySlot) {
+                    break;
+                }
+                if ((*resources)[index] == resource) {
+                    return {index, false};
+                }
+            }
+
+            resources->push_back(resource);
+            if (resources->size() * 2 > mTable.size()) {
+                RebuildTable(*resources);
+            } else {
+                InsertInTable(*resources, static_cast<uint32_t>(resources->size() - 1));
+            }
+            return {resources->size() - 1, true};
+        }
+
+        template <typename T>
+        void ResourceIndexMap<T>::Clear() {
+            mTable.clear();
+        }
+
+        template <typename T>
+        void ResourceIndexMap<T>::InsertInTable(const std::vector<T*>& resources, uint32_t index) {
+            size_t mask = mTable.size() - 1;
+            size_t slot = HashPointer(resources[index]) & mask;
+            while (mTable[slot] != kEmptySlot) {
+                slot = (slot + 1) & mask;
+            }
+            mTable[slot] = index;
+        }
+
+        template <typename T>
+        void ResourceIndexMap<T>::RebuildTable(const std::vector<T*>& resources) {
+            mTable.assign(NextPowerOfTwo(resources.size() * 4), kEmptySlot);
+            for (uint32_t i = 0; i < resources.size(); ++i) {
+                InsertInTable(resources, i);
+            }
+        }
+
+    }  // namespace detail
+
     void SyncScopeUsageTracker::BufferUsedAs(BufferBase* buffer, wgpu::BufferUsage usage) {
-        // std::map's operator[] will create the key and return 0 if the key didn't exist
-        // before.
-        mBufferUsages[buffer] |= usage;
+        auto [index, appended] = mBufferIndices.FindOrAppend(&mUsage.buffers, buffer);
+        if (appended) {
+            mUsage.bufferUsages.push_back(usage);
+        } else {
+            mUsage.bufferUsages[index] |= usage;
+        }
+    }
+
+    TextureSubresourceUsage* SyncScopeUsageTracker::GetOrCreateTextureUsage(TextureBase* texture) {
+        auto [index, appended] = mTextureIndices.FindOrAppend(&mUsage.textures, texture);
+        if (appended) {
+            // The usage of all the subresources is initially wgpu::TextureUsage::None.
+            mUsage.textureUsages.emplace_back(texture->GetFormat().aspects,
+                                              texture->GetArrayLayers(),
+                                              texture->GetNumMipLevels(), wgpu::TextureUsage::None);
+        }
+        return &mUsage.textureUsages[index];
     }
 
     void SyncScopeUsageTracker::TextureViewUsedAs(TextureViewBase* view, wgpu::TextureUsage usage) {
         TextureBase* texture = view->GetTexture();
         const SubresourceRange& range = view->GetSubresourceRange();
 
-        // Get or create a new TextureSubresourceUsage for that texture (initially filled with
-        // wgpu::TextureUsage::None)
-        auto it = mTextureUsages.emplace(
-            std::piecewise_construct, std::forward_as_tuple(texture),
-            std::forward_as_tuple(texture->GetFormat().aspects, texture->GetArrayLayers(),
-                                  texture->GetNumMipLevels(), wgpu::TextureUsage::None));
-        TextureSubresourceUsage& textureUsage = it.first->second;
+        TextureSubresourceUsage& textureUsage = *GetOrCreateTextureUsage(texture);
 
         textureUsage.Update(range,
                             [usage](const SubresourceRange&, wgpu::TextureUsage* storedUsage) {
@@ -63,13 +146,7 @@ namespace dawn::native {
     void SyncScopeUsageTracker::AddRenderBundleTextureUsage(
         TextureBase* texture,
         const TextureSubresourceUsage& textureUsage) {
-        // Get or create a new TextureSubresourceUsage for that texture (initially filled with
-        // wgpu::TextureUsage::None)
-        auto it = mTextureUsages.emplace(
-            std::piecewise_construct, std::forward_as_tuple(texture),
-            std::forward_as_tuple(texture->GetFormat().aspects, texture->GetArrayLayers(),
-                                  texture->GetNumMipLevels(), wgpu::TextureUsage::None));
-        TextureSubresourceUsage* passTextureUsage = &it.first->second;
+        TextureSubresourceUsage* passTextureUsage = GetOrCreateTextureUsage(texture);
 
         passTextureUsage->Merge(
             textureUsage, [](const SubresourceRange&, wgpu::TextureUsage* storedUsage,
@@ -134,35 +211,16 @@ namespace dawn::native {
         }
 
         for (const Ref<ExternalTextureBase>& externalTexture : group->GetBoundExternalTextures()) {
-            mExternalTextureUsages.insert(externalTexture.Get());
+            mExternalTextureIndices.FindOrAppend(&mUsage.externalTextures, externalTexture.Get());
         }
     }
 
     SyncScopeResourceUsage SyncScopeUsageTracker::AcquireSyncScopeUsage() {
-        SyncScopeResourceUsage result;
-        result.buffers.reserve(mBufferUsages.size());
-        result.bufferUsages.reserve(mBufferUsages.size());
-        result.textures.reserve(mTextureUsages.size());
-        result.textureUsages.reserve(mTextureUsages.size());
-
-        for (auto& [buffer, usage] : mBufferUsages) {
-            result.buffers.push_back(buffer);
-            result.bufferUsages.push_back(usage);
-        }
-
-        for (auto& [texture, usage] : mTextureUsages) {
-            result.textures.push_back(texture);
-            result.textureUsages.push_back(std::move(usage));
-        }
-
-        for (auto& it : mExternalTextureUsages) {
-            result.externalTextures.push_back(it);
-        }
-
-        mBufferUsages.clear();
-        mTextureUsages.clear();
-        mExternalTextureUsages.clear();
-
+        mBufferIndices.Clear();
+        mTextureIndices.Clear();
+        mExternalTextureIndices.Clear();
+        SyncScopeResourceUsage result = std::move(mUsage);
+        mUsage = {};
         return result;
     }
 
@@ -20,6 +20,8 @@
 #include "dawn/native/dawn_platform.h"
 
 #include <map>
+#include <utility>
+#include <vector>
 
 namespace dawn::native {
 
@@ -31,7 +33,36 @@ namespace dawn::native {
 
     using QueryAvailabilityMap = std::map<QuerySetBase*, std::vector<bool>>;
 
-    // Helper class to build SyncScopeResourceUsages
+    namespace detail {
+
+        // Finds the index of resources in one of the vectors of a SyncScopeResourceUsage. Small
+        // vectors are searched linearly. Once they grow larger, an open-addressing hash table of
+        // their indices is built so that the lookups stay constant time.
+        template <typename T>
+        class ResourceIndexMap {
+          public:
+            // Returns the index of |resource| in |resources|, appending it first if needed, and
+            // whether it was appended.
+            std::pair<size_t, bool> FindOrAppend(std::vector<T*>* resources, T* resource);
+
+            void Clear();
+
+          private:
+            static constexpr size_t kMaxLinearSearchSize = 16;
+
+            void InsertInTable(const std::vector<T*>& resources, uint32_t index);
+            void RebuildTable(const std::vector<T*>& resources);
+
+            // Indices in the resources vector, or kEmptySlot. The size is a power of two and
+            // the table is at most half full.
+            static constexpr uint32_t kEmptySlot = ~uint32_t(0);
+            std::vector<uint32_t> mTable;
+        };
+
+    }  // namespace detail
+
+    // Helper class to build SyncScopeResourceUsages. The usages are directly accumulated in the
+    // vectors of the SyncScopeResourceUsage so that acquiring them doesn't copy anything.
     class SyncScopeUsageTracker {
       public:
         void BufferUsedAs(BufferBase* buffer, wgpu::BufferUsage usage);
@@ -46,9 +77,12 @@ namespace dawn::native {
         SyncScopeResourceUsage AcquireSyncScopeUsage();
 
       private:
-        std::map<BufferBase*, wgpu::BufferUsage> mBufferUsages;
-        std::map<TextureBase*, TextureSubresourceUsage> mTextureUsages;
-        std::set<ExternalTextureBase*> mExternalTextureUsages;
+        TextureSubresourceUsage* GetOrCreateTextureUsage(TextureBase* texture);
+
+        SyncScopeResourceUsage mUsage;
+        detail::ResourceIndexMap<BufferBase> mBufferIndices;
+        detail::ResourceIndexMap<TextureBase> mTextureIndices;
+        detail::ResourceIndexMap<ExternalTextureBase> mExternalTextureIndices;
     };
 
     // Helper class to build ComputePassResourceUsages
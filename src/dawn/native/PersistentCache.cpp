@@ -51,6 +51,10 @@ namespace dawn::native {
         mCache->StoreData(ToAPI(mDevice), key.data(), key.size(), value, size);
     }
 
+    bool PersistentCache::IsEnabled() const {
+        return mCache != nullptr;
+    }
+
     dawn::platform::CachingInterface* PersistentCache::GetPlatformCache() {
         // TODO(dawn:549): Create a fingerprint of concatenated version strings (ex. Tint commit
         // hash, Dawn commit hash). This will be used by the client so it may know when to discard
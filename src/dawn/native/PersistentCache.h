@@ -35,7 +35,7 @@ namespace dawn::native {
 
     class DeviceBase;
 
-    enum class PersistentKeyType { Shader };
+    enum class PersistentKeyType { Shader, PipelineCache, ShaderReflection, ProgramBinary };
 
     // This class should always be thread-safe as it is used in Create*PipelineAsync() where it is
     // called asynchronously.
@@ -75,11 +75,16 @@ namespace dawn::native {
             return std::move(blob);
         }
 
-      private:
-        // PersistentCache impl
+        // Direct access for blobs that are updated after they are created, like driver pipeline
+        // caches. LoadData returns an empty blob if there is no value for the key.
         ScopedCachedBlob LoadData(const PersistentCacheKey& key);
         void StoreData(const PersistentCacheKey& key, const void* value, size_t size);
 
+        // Whether the platform provides a cache. Otherwise loads always miss and stores are
+        // ignored, so there is no point in producing the data to store.
+        bool IsEnabled() const;
+
+      private:
         dawn::platform::CachingInterface* GetPlatformCache();
 
         DeviceBase* mDevice = nullptr;
@@ -71,6 +71,12 @@ namespace dawn::native {
         QueueBase(DeviceBase* device, ObjectBase::ErrorTag tag);
         void DestroyImpl() override;
 
+        // Uploads |data| through the DynamicUploader of the device.
+        virtual MaybeError WriteBufferImpl(BufferBase* buffer,
+                                           uint64_t bufferOffset,
+                                           const void* data,
+                                           size_t size);
+
       private:
         MaybeError WriteTextureInternal(const ImageCopyTexture* destination,
                                         const void* data,
@@ -84,10 +90,6 @@ namespace dawn::native {
 
         virtual MaybeError SubmitImpl(uint32_t commandCount,
                                       CommandBufferBase* const* commands) = 0;
-        virtual MaybeError WriteBufferImpl(BufferBase* buffer,
-                                           uint64_t bufferOffset,
-                                           const void* data,
-                                           size_t size);
         virtual MaybeError WriteTextureImpl(const ImageCopyTexture& destination,
                                             const void* data,
                                             const TextureDataLayout& dataLayout,
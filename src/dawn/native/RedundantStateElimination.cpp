@@ -0,0 +1,405 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/native/RedundantStateElimination.h"
+
+#include "dawn/common/ityp_array.h"
+#include "dawn/native/BindGroup.h"
+#include "dawn/native/Buffer.h"
+#include "dawn/native/CommandAllocator.h"
+#include "dawn/native/Commands.h"
+#include "dawn/native/ComputePipeline.h"
+#include "dawn/native/QuerySet.h"
+#include "dawn/native/RenderBundle.h"
+#include "dawn/native/RenderPipeline.h"
+#include "dawn/native/Texture.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace dawn::native {
+
+    namespace {
+
+        // The state that was last set by the commands of the current pass. Objects are only
+        // compared by pointer so raw pointers are enough: the commands keep them alive.
+        struct PassState {
+            struct BindGroupState {
+                const BindGroupBase* group = nullptr;
+                const uint32_t* dynamicOffsets = nullptr;
+                uint32_t dynamicOffsetCount = 0;
+            };
+            struct VertexBufferState {
+                const BufferBase* buffer = nullptr;
+                uint64_t offset = 0;
+                uint64_t size = 0;
+            };
+
+            const ComputePipelineBase* computePipeline = nullptr;
+            const RenderPipelineBase* renderPipeline = nullptr;
+            ityp::array<BindGroupIndex, BindGroupState, kMaxBindGroups> bindGroups = {};
+            ityp::array<VertexBufferSlot, VertexBufferState, kMaxVertexBuffers> vertexBuffers = {};
+
+            const BufferBase* indexBuffer = nullptr;
+            wgpu::IndexFormat indexFormat = wgpu::IndexFormat::Undefined;
+            uint64_t indexOffset = 0;
+            uint64_t indexSize = 0;
+
+            bool hasViewport = false;
+            SetViewportCmd viewport;
+            bool hasScissor = false;
+            SetScissorRectCmd scissor;
+            bool hasBlendConstant = false;
+            Color blendConstant;
+            bool hasStencilReference = false;
+            uint32_t stencilReference = 0;
+        };
+
+        // Walks the commands and either only counts the redundant ones, or also moves the other
+        // ones to |output|. The commands are left in a moved-from state in the latter case so they
+        // must still be freed.
+        class RedundantStateEliminator {
+          public:
+            explicit RedundantStateEliminator(CommandAllocator* output) : mOutput(output) {
+            }
+
+            size_t Run(CommandIterator* commands);
+
+          private:
+            template <typename T>
+            void Keep(Command type, T* cmd) {
+                if (mOutput != nullptr) {
+                    *mOutput->Allocate<T>(type) = std::move(*cmd);
+                }
+            }
+
+            template <typename T>
+            void KeepData(T* data, size_t count) {
+                if (mOutput != nullptr) {
+                    std::move(data, data + count, mOutput->AllocateData<T>(count));
+                }
+            }
+
+            bool IsRedundant(const SetBindGroupCmd* cmd, const uint32_t* dynamicOffsets);
+            bool IsRedundant(const SetVertexBufferCmd* cmd);
+            bool IsRedundant(const SetIndexBufferCmd* cmd);
+            bool IsRedundant(const SetViewportCmd* cmd);
+            bool IsRedundant(const SetScissorRectCmd* cmd);
+            bool IsRedundant(const SetBlendConstantCmd* cmd);
+            bool IsRedundant(const SetStencilReferenceCmd* cmd);
+
+            CommandAllocator* mOutput;
+            PassState mState;
+            size_t mRemovedCount = 0;
+        };
+
+        size_t RedundantStateEliminator::Run(CommandIterator* commands) {
+            Command type;
+            while (commands->NextCommandId(&type)) {
+                switch (type) {
+                    case Command::BeginComputePass:
+                        mState = {};
+                        Keep(type, commands->NextCommand<BeginComputePassCmd>());
+                        break;
+                    case Command::BeginOcclusionQuery:
+                        Keep(type, commands->NextCommand<BeginOcclusionQueryCmd>());
+                        break;
+                    case Command::BeginRenderPass:
+                        mState = {};
+                        Keep(type, commands->NextCommand<BeginRenderPassCmd>());
+                        break;
+                    case Command::ClearBuffer:
+                        Keep(type, commands->NextCommand<ClearBufferCmd>());
+                        break;
+                    case Command::CopyBufferToBuffer:
+                        Keep(type, commands->NextCommand<CopyBufferToBufferCmd>());
+                        break;
+                    case Command::CopyBufferToTexture:
+                        Keep(type, commands->NextCommand<CopyBufferToTextureCmd>());
+                        break;
+                    case Command::CopyTextureToBuffer:
+                        Keep(type, commands->NextCommand<CopyTextureToBufferCmd>());
+                        break;
+                    case Command::CopyTextureToTexture:
+                        Keep(type, commands->NextCommand<CopyTextureToTextureCmd>());
+                        break;
+                    case Command::Dispatch:
+                        Keep(type, commands->NextCommand<DispatchCmd>());
+                        break;
+                    case Command::DispatchIndirect:
+                        Keep(type, commands->NextCommand<DispatchIndirectCmd>());
+                        break;
+                    case Command::Draw:
+                        Keep(type, commands->NextCommand<DrawCmd>());
+                        break;
+                    case Command::DrawIndexed:
+                        Keep(type, commands->NextCommand<DrawIndexedCmd>());
+                        break;
+                    case Command::DrawIndirect:
+                        Keep(type, commands->NextCommand<DrawIndirectCmd>());
+                        break;
+                    case Command::DrawIndexedIndirect:
+                        Keep(type, commands->NextCommand<DrawIndexedIndirectCmd>());
+                        break;
+                    case Command::EndComputePass:
+                        mState = {};
+                        Keep(type, commands->NextCommand<EndComputePassCmd>());
+                        break;
+                    case Command::EndOcclusionQuery:
+                        Keep(type, commands->NextCommand<EndOcclusionQueryCmd>());
+                        break;
+                    case Command::EndRenderPass:
+                        mState = {};
+                        Keep(type, commands->NextCommand<EndRenderPassCmd>());
+                        break;
+                    case Command::ExecuteBundles: {
+                        // The bundles change the state in ways that aren't tracked here, and the
+                        // backends reset it after executing them.
+                        mState = {};
+                        ExecuteBundlesCmd* cmd = commands->NextCommand<ExecuteBundlesCmd>();
+                        Keep(type, cmd);
+                        KeepData(commands->NextData<Ref<RenderBundleBase>>(cmd->count), cmd->count);
+                        break;
+                    }
+                    case Command::InsertDebugMarker: {
+                        InsertDebugMarkerCmd* cmd = commands->NextCommand<InsertDebugMarkerCmd>();
+                        Keep(type, cmd);
+                        KeepData(commands->NextData<char>(cmd->length + 1), cmd->length + 1);
+                        break;
+                    }
+                    case Command::PopDebugGroup:
+                        Keep(type, commands->NextCommand<PopDebugGroupCmd>());
+                        break;
+                    case Command::PushDebugGroup: {
+                        PushDebugGroupCmd* cmd = commands->NextCommand<PushDebugGroupCmd>();
+                        Keep(type, cmd);
+                        KeepData(commands->NextData<char>(cmd->length + 1), cmd->length + 1);
+                        break;
+                    }
+                    case Command::ResolveQuerySet:
+                        Keep(type, commands->NextCommand<ResolveQuerySetCmd>());
+                        break;
+                    case Command::SetComputePipeline: {
+                        SetComputePipelineCmd* cmd = commands->NextCommand<SetComputePipelineCmd>();
+                        if (cmd->pipeline.Get() == mState.computePipeline) {
+                            mRemovedCount++;
+                            break;
+                        }
+                        mState.computePipeline = cmd->pipeline.Get();
+                        Keep(type, cmd);
+                        break;
+                    }
+                    case Command::SetRenderPipeline: {
+                        SetRenderPipelineCmd* cmd = commands->NextCommand<SetRenderPipelineCmd>();
+                        if (cmd->pipeline.Get() == mState.renderPipeline) {
+                            mRemovedCount++;
+                            break;
+                        }
+                        mState.renderPipeline = cmd->pipeline.Get();
+                        Keep(type, cmd);
+                        break;
+                    }
+                    case Command::SetStencilReference: {
+                        SetStencilReferenceCmd* cmd =
+                            commands->NextCommand<SetStencilReferenceCmd>();
+                        if (IsRedundant(cmd)) {
+                            mRemovedCount++;
+                            break;
+                        }
+                        Keep(type, cmd);
+                        break;
+                    }
+                    case Command::SetViewport: {
+                        SetViewportCmd* cmd = commands->NextCommand<SetViewportCmd>();
+                        if (IsRedundant(cmd)) {
+                            mRemovedCount++;
+                            break;
+                        }
+                        Keep(type, cmd);
+                        break;
+                    }
+                    case Command::SetScissorRect: {
+                        SetScissorRectCmd* cmd = commands->NextCommand<SetScissorRectCmd>();
+                        if (IsRedundant(cmd)) {
+                            mRemovedCount++;
+                            break;
+                        }
+                        Keep(type, cmd);
+                        break;
+                    }
+                    case Command::SetBlendConstant: {
+                        SetBlendConstantCmd* cmd = commands->NextCommand<SetBlendConstantCmd>();
+                        if (IsRedundant(cmd)) {
+                            mRemovedCount++;
+                            break;
+                        }
+                        Keep(type, cmd);
+                        break;
+                    }
+                    case Command::SetBindGroup: {
+                        SetBindGroupCmd* cmd = commands->NextCommand<SetBindGroupCmd>();
+                        uint32_t* dynamicOffsets = nullptr;
+                        if (cmd->dynamicOffsetCount > 0) {
+                            dynamicOffsets = commands->NextData<uint32_t>(cmd->dynamicOffsetCount);
+                        }
+                        if (IsRedundant(cmd, dynamicOffsets)) {
+                            mRemovedCount++;
+                            break;
+                        }
+                        Keep(type, cmd);
+                        if (dynamicOffsets != nullptr) {
+                            KeepData(dynamicOffsets, cmd->dynamicOffsetCount);
+                        }
+                        break;
+                    }
+                    case Command::SetIndexBuffer: {
+                        SetIndexBufferCmd* cmd = commands->NextCommand<SetIndexBufferCmd>();
+                        if (IsRedundant(cmd)) {
+                            mRemovedCount++;
+                            break;
+                        }
+                        Keep(type, cmd);
+                        break;
+                    }
+                    case Command::SetVertexBuffer: {
+                        SetVertexBufferCmd* cmd = commands->NextCommand<SetVertexBufferCmd>();
+                        if (IsRedundant(cmd)) {
+                            mRemovedCount++;
+                            break;
+                        }
+                        Keep(type, cmd);
+                        break;
+                    }
+                    case Command::WriteBuffer: {
+                        WriteBufferCmd* cmd = commands->NextCommand<WriteBufferCmd>();
+                        Keep(type, cmd);
+                        KeepData(commands->NextData<uint8_t>(cmd->size), cmd->size);
+                        break;
+                    }
+                    case Command::WriteTimestamp:
+                        Keep(type, commands->NextCommand<WriteTimestampCmd>());
+                        break;
+                }
+            }
+            return mRemovedCount;
+        }
+
+        // Each IsRedundant() records the new state when the command isn't redundant.
+
+        bool RedundantStateEliminator::IsRedundant(const SetBindGroupCmd* cmd,
+                                                   const uint32_t* dynamicOffsets) {
+            PassState::BindGroupState& state = mState.bindGroups[cmd->index];
+            if (state.group == cmd->group.Get() &&
+                state.dynamicOffsetCount == cmd->dynamicOffsetCount &&
+                std::equal(dynamicOffsets, dynamicOffsets + cmd->dynamicOffsetCount,
+                           state.dynamicOffsets)) {
+                return true;
+            }
+            // The offsets stay valid in the input commands until they are freed.
+            state.group = cmd->group.Get();
+            state.dynamicOffsets = dynamicOffsets;
+            state.dynamicOffsetCount = cmd->dynamicOffsetCount;
+            return false;
+        }
+
+        bool RedundantStateEliminator::IsRedundant(const SetVertexBufferCmd* cmd) {
+            PassState::VertexBufferState& state = mState.vertexBuffers[cmd->slot];
+            if (state.buffer == cmd->buffer.Get() && state.offset == cmd->offset &&
+                state.size == cmd->size) {
+                return true;
+            }
+            state.buffer = cmd->buffer.Get();
+            state.offset = cmd->offset;
+            state.size = cmd->size;
+            return false;
+        }
+
+        bool RedundantStateEliminator::IsRedundant(const SetIndexBufferCmd* cmd) {
+            if (mState.indexBuffer == cmd->buffer.Get() && mState.indexFormat == cmd->format &&
+                mState.indexOffset == cmd->offset && mState.indexSize == cmd->size) {
+                return true;
+            }
+            mState.indexBuffer = cmd->buffer.Get();
+            mState.indexFormat = cmd->format;
+            mState.indexOffset = cmd->offset;
+            mState.indexSize = cmd->size;
+            return false;
+        }
+
+        bool RedundantStateEliminator::IsRedundant(const SetViewportCmd* cmd) {
+            const SetViewportCmd& state = mState.viewport;
+            if (mState.hasViewport && state.x == cmd->x && state.y == cmd->y &&
+                state.width == cmd->width && state.height == cmd->height &&
+                state.minDepth == cmd->minDepth && state.maxDepth == cmd->maxDepth) {
+                return true;
+            }
+            mState.hasViewport = true;
+            mState.viewport = *cmd;
+            return false;
+        }
+
+        bool RedundantStateEliminator::IsRedundant(const SetScissorRectCmd* cmd) {
+            const SetScissorRectCmd& state = mState.scissor;
+            if (mState.hasScissor && state.x == cmd->x && state.y == cmd->y &&
+                state.width == cmd->width && state.height == cmd->height) {
+                return true;
+            }
+            mState.hasScissor = true;
+            mState.scissor = *cmd;
+            return false;
+        }
+
+        bool RedundantStateEliminator::IsRedundant(const SetBlendConstantCmd* cmd) {
+            const Color& state = mState.blendConstant;
+            if (mState.hasBlendConstant && state.r == cmd->color.r && state.g == cmd->color.g &&
+                state.b == cmd->color.b && state.a == cmd->color.a) {
+                return true;
+            }
+            mState.hasBlendConstant = true;
+            mState.blendConstant = cmd->color;
+            return false;
+        }
+
+        bool RedundantStateEliminator::IsRedundant(const SetStencilReferenceCmd* cmd) {
+            if (mState.hasStencilReference && mState.stencilReference == cmd->reference) {
+                return true;
+            }
+            mState.hasStencilReference = true;
+            mState.stencilReference = cmd->reference;
+            return false;
+        }
+
+    }  // anonymous namespace
+
+    size_t EliminateRedundantStateCommands(CommandIterator* commands, CommandBlockPool* pool) {
+        // Most command buffers have nothing to remove so only count the redundant commands first,
+        // which is much cheaper than moving all the commands to new blocks.
+        size_t removedCount = RedundantStateEliminator(nullptr).Run(commands);
+        commands->Reset();
+        if (removedCount == 0) {
+            return 0;
+        }
+
+        CommandAllocator output(pool);
+        RedundantStateEliminator eliminator(&output);
+        size_t rewriteRemovedCount = eliminator.Run(commands);
+        ASSERT(rewriteRemovedCount == removedCount);
+        DAWN_UNUSED(rewriteRemovedCount);
+
+        FreeCommands(commands);
+        *commands = CommandIterator(std::move(output));
+        return removedCount;
+    }
+
+}  // namespace dawn::native
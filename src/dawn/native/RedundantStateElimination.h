@@ -0,0 +1,37 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_REDUNDANTSTATEELIMINATION_H_
+#define DAWNNATIVE_REDUNDANTSTATEELIMINATION_H_
+
+#include <cstddef>
+
+namespace dawn::native {
+
+    class CommandBlockPool;
+    class CommandIterator;
+
+    // Removes the state-setting commands (pipelines, bind groups, vertex and index buffers,
+    // viewport, scissor, blend constant and stencil reference) that set the state to the value it
+    // already has, so that backends don't translate them into redundant API calls. The state is
+    // considered unknown at the start and end of each pass and after ExecuteBundles, like it is
+    // for the backends.
+    // The commands are only rewritten, into blocks allocated from |pool|, if something can be
+    // removed. Pointers to the commands are invalidated then, so this must not be used on commands
+    // that something else still points to. Returns the number of commands removed.
+    size_t EliminateRedundantStateCommands(CommandIterator* commands, CommandBlockPool* pool);
+
+}  // namespace dawn::native
+
+#endif  // DAWNNATIVE_REDUNDANTSTATEELIMINATION_H_
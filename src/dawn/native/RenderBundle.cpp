@@ -40,6 +40,8 @@ namespace dawn::native {
     }
 
     void RenderBundleBase::DestroyImpl() {
+        // The backend data may refer to the commands so it is deleted first.
+        mBackendData = nullptr;
         FreeCommands(&mCommands);
 
         // Remove reference to the attachment state so that we don't have lingering references to
@@ -88,4 +90,14 @@ namespace dawn::native {
         return mIndirectDrawMetadata;
     }
 
+    RenderBundleBackendData* RenderBundleBase::GetBackendData() const {
+        ASSERT(!IsError());
+        return mBackendData.get();
+    }
+
+    void RenderBundleBase::SetBackendData(std::unique_ptr<RenderBundleBackendData> backendData) {
+        ASSERT(!IsError());
+        mBackendData = std::move(backendData);
+    }
+
 }  // namespace dawn::native
@@ -27,12 +27,20 @@
 #include "dawn/native/dawn_platform.h"
 
 #include <bitset>
+#include <memory>
 
 namespace dawn::native {
 
     struct RenderBundleDescriptor;
     class RenderBundleEncoder;
 
+    // Data that a backend can attach to a RenderBundle, like command buffers prebuilt from the
+    // bundle's commands. It is deleted when the bundle is destroyed.
+    class RenderBundleBackendData {
+      public:
+        virtual ~RenderBundleBackendData() = default;
+    };
+
     class RenderBundleBase final : public ApiObjectBase {
       public:
         RenderBundleBase(RenderBundleEncoder* encoder,
@@ -55,6 +63,9 @@ namespace dawn::native {
         const RenderPassResourceUsage& GetResourceUsage() const;
         const IndirectDrawMetadata& GetIndirectDrawMetadata();
 
+        RenderBundleBackendData* GetBackendData() const;
+        void SetBackendData(std::unique_ptr<RenderBundleBackendData> backendData);
+
       private:
         RenderBundleBase(DeviceBase* device, ErrorTag errorTag);
 
@@ -66,6 +77,7 @@ namespace dawn::native {
         bool mDepthReadOnly;
         bool mStencilReadOnly;
         RenderPassResourceUsage mResourceUsage;
+        std::unique_ptr<RenderBundleBackendData> mBackendData;
     };
 
 }  // namespace dawn::native
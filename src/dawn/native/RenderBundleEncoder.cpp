@@ -157,6 +157,12 @@ namespace dawn::native {
             DAWN_TRY(ValidateFinish(usages));
         }
 
+        // The indirect draw metadata points to the DrawIndexedIndirectCmds of the bundle, which
+        // are patched each time the bundle is executed. They must stay where they were encoded.
+        if (!mIndirectDrawMetadata.GetIndexedIndirectBufferValidationInfo()->empty()) {
+            mBundleEncodingContext.DisableRedundantStateElimination();
+        }
+
         return new RenderBundleBase(this, descriptor, AcquireAttachmentState(), IsDepthReadOnly(),
                                     IsStencilReadOnly(), std::move(usages),
                                     std::move(mIndirectDrawMetadata));
@@ -46,6 +46,10 @@ namespace dawn::native {
         // allocation offset is always local to the memory.
         uint64_t mBlockOffset = 0;
 
+        // The size of the block used by the buddy sub-allocator, which is the allocation size
+        // rounded up to a power of two.
+        uint64_t mBlockSize = 0;
+
         AllocationMethod mMethod = AllocationMethod::kInvalid;
     };
 
@@ -18,19 +18,26 @@
 #include "dawn/common/BitSetIterator.h"
 #include "dawn/common/Constants.h"
 #include "dawn/common/HashUtils.h"
+#include "dawn/common/UnderlyingType.h"
 #include "dawn/native/BindGroupLayout.h"
 #include "dawn/native/ChainUtils_autogen.h"
 #include "dawn/native/CompilationMessages.h"
 #include "dawn/native/Device.h"
 #include "dawn/native/ObjectContentHasher.h"
+#include "dawn/native/PersistentCache.h"
 #include "dawn/native/Pipeline.h"
 #include "dawn/native/PipelineLayout.h"
 #include "dawn/native/RenderPipeline.h"
 #include "dawn/native/TintUtils.h"
+#include "dawn/platform/DawnPlatform.h"
+#include "dawn/platform/tracing/TraceEvent.h"
 
 #include <tint/tint.h>
 
+#include <cstring>
 #include <sstream>
+#include <string_view>
+#include <type_traits>
 
 namespace dawn::native {
 
@@ -958,7 +965,7 @@ namespace dawn::native {
         default;
 
     bool ShaderModuleParseResult::HasParsedShader() const {
-        return tintProgram != nullptr;
+        return tintProgram != nullptr || cachedEntryPoints != nullptr;
     }
 
     // TintSource is a PIMPL container for a tint::Source::File, which needs to be kept alive for as
@@ -972,6 +979,407 @@ namespace dawn::native {
         tint::Source::File file;
     };
 
+    namespace {
+
+        MaybeError ParseShaderModule(DeviceBase* device,
+                                     const ShaderModuleDescriptor* descriptor,
+                                     ShaderModuleParseResult* parseResult,
+                                     OwnedCompilationMessages* outMessages) {
+            ScopedTintICEHandler scopedICEHandler(device);
+
+            const ShaderModuleSPIRVDescriptor* spirvDesc = nullptr;
+            FindInChain(descriptor->nextInChain, &spirvDesc);
+            const ShaderModuleWGSLDescriptor* wgslDesc = nullptr;
+            FindInChain(descriptor->nextInChain, &wgslDesc);
+
+            // We have a temporary toggle to force the SPIRV ingestion to go through a WGSL
+            // intermediate step. It is done by switching the spirvDesc for a wgslDesc below.
+            ShaderModuleWGSLDescriptor newWgslDesc;
+            std::string newWgslCode;
+            if (spirvDesc && device->IsToggleEnabled(Toggle::ForceWGSLStep)) {
+                std::vector<uint32_t> spirv(spirvDesc->code,
+                                            spirvDesc->code + spirvDesc->codeSize);
+                tint::Program program;
+                DAWN_TRY_ASSIGN(program, ParseSPIRV(spirv, outMessages));
+
+                tint::writer::wgsl::Options options;
+                auto result = tint::writer::wgsl::Generate(&program, options);
+                DAWN_INVALID_IF(!result.success, "Tint WGSL failure: Generator: %s",
+                                result.error);
+
+                newWgslCode = std::move(result.wgsl);
+                newWgslDesc.source = newWgslCode.c_str();
+
+                spirvDesc = nullptr;
+                wgslDesc = &newWgslDesc;
+            }
+
+            if (spirvDesc) {
+                DAWN_INVALID_IF(device->IsToggleEnabled(Toggle::DisallowSpirv),
+                                "SPIR-V is disallowed.");
+
+                std::vector<uint32_t> spirv(spirvDesc->code,
+                                            spirvDesc->code + spirvDesc->codeSize);
+                tint::Program program;
+                DAWN_TRY_ASSIGN(program, ParseSPIRV(spirv, outMessages));
+                parseResult->tintProgram = std::make_unique<tint::Program>(std::move(program));
+            } else if (wgslDesc) {
+                auto tintSource = std::make_unique<TintSource>("", wgslDesc->source);
+
+                if (device->IsToggleEnabled(Toggle::DumpShaders)) {
+                    std::ostringstream dumpedMsg;
+                    dumpedMsg << "// Dumped WGSL:" << std::endl << wgslDesc->source;
+                    device->EmitLog(WGPULoggingType_Info, dumpedMsg.str().c_str());
+                }
+
+                tint::Program program;
+                DAWN_TRY_ASSIGN(program, ParseWGSL(&tintSource->file, outMessages));
+                parseResult->tintProgram = std::make_unique<tint::Program>(std::move(program));
+                parseResult->tintSource = std::move(tintSource);
+            }
+
+            return {};
+        }
+
+        void SerializeSpirvSource(std::ostream& output, const uint32_t* code, size_t codeSize) {
+            output << "spirv " << codeSize << "\n";
+            output.write(reinterpret_cast<const char*>(code), codeSize * sizeof(uint32_t));
+            output << "\n";
+        }
+
+        void SerializeWgslSource(std::ostream& output, std::string_view source) {
+            output << "wgsl " << source.length() << "\n";
+            output << source;
+            output << "\n";
+        }
+
+        // Completes the key of the cached reflection of a module with everything other than the
+        // source that the parsing and the reflection depend on. The key contains a version that
+        // must be bumped when the serialization below or the reflection itself changes, as well
+        // as the layout of the reflection structures so that builds where they differ don't
+        // share entries.
+        PersistentCacheKey MakeReflectionCacheKey(const DeviceBase* device,
+                                                  std::stringstream* stream) {
+            const CombinedLimits& limits = device->GetLimits();
+
+            *stream << "(ShaderReflectionRequest";
+            *stream << " version=2";
+            *stream << " layout=" << sizeof(EntryPointMetadata) << ","
+                    << sizeof(ShaderBindingInfo) << ","
+                    << sizeof(EntryPointMetadata::OverridableConstant) << ","
+                    << sizeof(EntryPointMetadata::InterStageVariableInfo) << ","
+                    << sizeof(EntryPointMetadata::FragmentOutputVariableInfo) << ","
+                    << kMaxBindGroups << "," << kMaxVertexAttributes << ","
+                    << kMaxColorAttachments << "," << kMaxInterStageShaderVariables;
+            *stream << " disallowSpirv=" << device->IsToggleEnabled(Toggle::DisallowSpirv);
+            *stream << " disallowUnsafeAPIs="
+                    << device->IsToggleEnabled(Toggle::DisallowUnsafeAPIs);
+            *stream << " maxComputeWorkgroupSize=" << limits.v1.maxComputeWorkgroupSizeX << ","
+                    << limits.v1.maxComputeWorkgroupSizeY << ","
+                    << limits.v1.maxComputeWorkgroupSizeZ;
+            *stream << " maxComputeInvocationsPerWorkgroup="
+                    << limits.v1.maxComputeInvocationsPerWorkgroup;
+            *stream << " maxComputeWorkgroupStorageSize="
+                    << limits.v1.maxComputeWorkgroupStorageSize;
+            *stream << ")";
+            *stream << "\n";
+
+            return PersistentCacheKey(std::istreambuf_iterator<char>{*stream},
+                                      std::istreambuf_iterator<char>{});
+        }
+
+        // The reflection is serialized field by field. Only integers, enums and typed integers
+        // are written, as their underlying integer, so the data doesn't depend on the padding of
+        // the structures. Sizes are written as uint64_t.
+        template <typename T>
+        void WriteReflection(std::vector<uint8_t>* output, T value) {
+            UnderlyingType<T> underlying = static_cast<UnderlyingType<T>>(value);
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&underlying);
+            output->insert(output->end(), bytes, bytes + sizeof(underlying));
+        }
+
+        void WriteReflection(std::vector<uint8_t>* output, const std::string& value) {
+            WriteReflection(output, uint64_t(value.size()));
+            output->insert(output->end(), value.begin(), value.end());
+        }
+
+        class ReflectionReader {
+          public:
+            ReflectionReader(const uint8_t* data, size_t size) : mData(data), mSize(size) {
+            }
+
+            template <typename T>
+            bool Read(T* value) {
+                UnderlyingType<T> underlying;
+                if (mSize - mOffset < sizeof(underlying)) {
+                    return false;
+                }
+                memcpy(&underlying, mData + mOffset, sizeof(underlying));
+                mOffset += sizeof(underlying);
+                *value = static_cast<T>(underlying);
+                return true;
+            }
+
+            bool Read(std::string* value) {
+                uint64_t length;
+                if (!Read(&length) || mSize - mOffset < length) {
+                    return false;
+                }
+                value->assign(reinterpret_cast<const char*>(mData + mOffset),
+                              static_cast<size_t>(length));
+                mOffset += static_cast<size_t>(length);
+                return true;
+            }
+
+            bool IsAtEnd() const {
+                return mOffset == mSize;
+            }
+
+          private:
+            const uint8_t* mData;
+            size_t mSize;
+            size_t mOffset = 0;
+        };
+
+        std::vector<uint8_t> SerializeReflection(const EntryPointMetadataTable& entryPoints) {
+            std::vector<uint8_t> output;
+            WriteReflection(&output, uint64_t(entryPoints.size()));
+            for (const auto& [name, metadata] : entryPoints) {
+                WriteReflection(&output, name);
+
+                for (BindGroupIndex group(0); group < kMaxBindGroupsTyped; ++group) {
+                    WriteReflection(&output, uint64_t(metadata->bindings[group].size()));
+                    for (const auto& [bindingNumber, info] : metadata->bindings[group]) {
+                        WriteReflection(&output, bindingNumber);
+                        WriteReflection(&output, info.bindingType);
+                        WriteReflection(&output, info.buffer.type);
+                        WriteReflection(&output, info.buffer.hasDynamicOffset);
+                        WriteReflection(&output, info.buffer.minBindingSize);
+                        WriteReflection(&output, info.sampler.isComparison);
+                        WriteReflection(&output, info.texture.compatibleSampleTypes);
+                        WriteReflection(&output, info.texture.viewDimension);
+                        WriteReflection(&output, info.texture.multisampled);
+                        WriteReflection(&output, info.storageTexture.access);
+                        WriteReflection(&output, info.storageTexture.format);
+                        WriteReflection(&output, info.storageTexture.viewDimension);
+                    }
+                }
+
+                WriteReflection(&output, uint64_t(metadata->samplerTexturePairs.size()));
+                for (const auto& pair : metadata->samplerTexturePairs) {
+                    WriteReflection(&output, pair.sampler.group);
+                    WriteReflection(&output, pair.sampler.binding);
+                    WriteReflection(&output, pair.texture.group);
+                    WriteReflection(&output, pair.texture.binding);
+                }
+
+                for (VertexAttributeLocation location(uint8_t(0));
+                     location < kMaxVertexAttributesTyped; ++location) {
+                    WriteReflection(&output, metadata->vertexInputBaseTypes[location]);
+                    WriteReflection(&output, bool(metadata->usedVertexInputs[location]));
+                }
+
+                for (ColorAttachmentIndex i(uint8_t(0)); i < kMaxColorAttachmentsTyped; ++i) {
+                    WriteReflection(&output, metadata->fragmentOutputVariables[i].baseType);
+                    WriteReflection(&output, metadata->fragmentOutputVariables[i].componentCount);
+                    WriteReflection(&output, bool(metadata->fragmentOutputsWritten[i]));
+                }
+
+                for (size_t i = 0; i < kMaxInterStageShaderVariables; ++i) {
+                    const auto& variable = metadata->interStageVariables[i];
+                    WriteReflection(&output, bool(metadata->usedInterStageVariables[i]));
+                    WriteReflection(&output, variable.baseType);
+                    WriteReflection(&output, variable.componentCount);
+                    WriteReflection(&output, variable.interpolationType);
+                    WriteReflection(&output, variable.interpolationSampling);
+                }
+
+                WriteReflection(&output, metadata->localWorkgroupSize.x);
+                WriteReflection(&output, metadata->localWorkgroupSize.y);
+                WriteReflection(&output, metadata->localWorkgroupSize.z);
+                WriteReflection(&output, metadata->stage);
+
+                // The sets of initialized and uninitialized constants are rebuilt from
+                // isInitialized when deserializing. The default value is written as the bits of
+                // its 32-bit member whatever its type.
+                WriteReflection(&output, uint64_t(metadata->overridableConstants.size()));
+                for (const auto& [identifier, constant] : metadata->overridableConstants) {
+                    WriteReflection(&output, identifier);
+                    WriteReflection(&output, constant.id);
+                    WriteReflection(&output, constant.type);
+                    WriteReflection(&output, constant.isInitialized);
+                    WriteReflection(&output, constant.defaultValue.u32);
+                }
+
+                WriteReflection(&output, metadata->usesNumWorkgroups);
+            }
+            return output;
+        }
+
+        bool DeserializeReflection(const uint8_t* data,
+                                   size_t size,
+                                   EntryPointMetadataTable* entryPoints) {
+            ReflectionReader reader(data, size);
+
+            uint64_t entryPointCount;
+            if (!reader.Read(&entryPointCount)) {
+                return false;
+            }
+            for (uint64_t i = 0; i < entryPointCount; ++i) {
+                std::string name;
+                auto metadata = std::make_unique<EntryPointMetadata>();
+                if (!reader.Read(&name)) {
+                    return false;
+                }
+
+                for (BindGroupIndex group(0); group < kMaxBindGroupsTyped; ++group) {
+                    uint64_t bindingCount;
+                    if (!reader.Read(&bindingCount)) {
+                        return false;
+                    }
+                    for (uint64_t j = 0; j < bindingCount; ++j) {
+                        BindingNumber bindingNumber;
+                        ShaderBindingInfo info = {};
+                        if (!reader.Read(&bindingNumber) || !reader.Read(&info.bindingType) ||
+                            !reader.Read(&info.buffer.type) ||
+                            !reader.Read(&info.buffer.hasDynamicOffset) ||
+                            !reader.Read(&info.buffer.minBindingSize) ||
+                            !reader.Read(&info.sampler.isComparison) ||
+                            !reader.Read(&info.texture.compatibleSampleTypes) ||
+                            !reader.Read(&info.texture.viewDimension) ||
+                            !reader.Read(&info.texture.multisampled) ||
+                            !reader.Read(&info.storageTexture.access) ||
+                            !reader.Read(&info.storageTexture.format) ||
+                            !reader.Read(&info.storageTexture.viewDimension)) {
+                            return false;
+                        }
+                        metadata->bindings[group].emplace(bindingNumber, info);
+                    }
+                }
+
+                uint64_t pairCount;
+                if (!reader.Read(&pairCount)) {
+                    return false;
+                }
+                for (uint64_t j = 0; j < pairCount; ++j) {
+                    EntryPointMetadata::SamplerTexturePair pair;
+                    if (!reader.Read(&pair.sampler.group) || !reader.Read(&pair.sampler.binding) ||
+                        !reader.Read(&pair.texture.group) || !reader.Read(&pair.texture.binding)) {
+                        return false;
+                    }
+                    metadata->samplerTexturePairs.push_back(pair);
+                }
+
+                for (VertexAttributeLocation location(uint8_t(0));
+                     location < kMaxVertexAttributesTyped; ++location) {
+                    bool used;
+                    if (!reader.Read(&metadata->vertexInputBaseTypes[location]) ||
+                        !reader.Read(&used)) {
+                        return false;
+                    }
+                    metadata->usedVertexInputs.set(location, used);
+                }
+
+                for (ColorAttachmentIndex i(uint8_t(0)); i < kMaxColorAttachmentsTyped; ++i) {
+                    auto& variable = metadata->fragmentOutputVariables[i];
+                    bool written;
+                    if (!reader.Read(&variable.baseType) ||
+                        !reader.Read(&variable.componentCount) || !reader.Read(&written)) {
+                        return false;
+                    }
+                    metadata->fragmentOutputsWritten.set(i, written);
+                }
+
+                for (size_t i = 0; i < kMaxInterStageShaderVariables; ++i) {
+                    auto& variable = metadata->interStageVariables[i];
+                    bool used;
+                    if (!reader.Read(&used) || !reader.Read(&variable.baseType) ||
+                        !reader.Read(&variable.componentCount) ||
+                        !reader.Read(&variable.interpolationType) ||
+                        !reader.Read(&variable.interpolationSampling)) {
+                        return false;
+                    }
+                    metadata->usedInterStageVariables.set(i, used);
+                }
+
+                if (!reader.Read(&metadata->localWorkgroupSize.x) ||
+                    !reader.Read(&metadata->localWorkgroupSize.y) ||
+                    !reader.Read(&metadata->localWorkgroupSize.z) ||
+                    !reader.Read(&metadata->stage)) {
+                    return false;
+                }
+
+                uint64_t constantCount;
+                if (!reader.Read(&constantCount)) {
+                    return false;
+                }
+                for (uint64_t j = 0; j < constantCount; ++j) {
+                    std::string identifier;
+                    EntryPointMetadata::OverridableConstant constant;
+                    if (!reader.Read(&identifier) || !reader.Read(&constant.id) ||
+                        !reader.Read(&constant.type) || !reader.Read(&constant.isInitialized) ||
+                        !reader.Read(&constant.defaultValue.u32)) {
+                        return false;
+                    }
+                    if (constant.isInitialized) {
+                        metadata->initializedOverridableConstants.insert(identifier);
+                    } else {
+                        metadata->uninitializedOverridableConstants.insert(identifier);
+                    }
+                    metadata->overridableConstants[std::move(identifier)] = constant;
+                }
+
+                if (!reader.Read(&metadata->usesNumWorkgroups)) {
+                    return false;
+                }
+
+                (*entryPoints)[std::move(name)] = std::move(metadata);
+            }
+            return reader.IsAtEnd();
+        }
+
+    }  // anonymous namespace
+
+    void LoadShaderModuleReflectionFromCache(DeviceBase* device,
+                                             const ShaderModuleDescriptor* descriptor,
+                                             ShaderModuleParseResult* parseResult) {
+        // The cached reflection doesn't contain the messages of the intermediate SPIR-V parsing.
+        if (!device->GetPersistentCache()->IsEnabled() ||
+            device->IsToggleEnabled(Toggle::ForceWGSLStep)) {
+            return;
+        }
+
+        // The descriptor isn't validated yet. Invalid chains are rejected by the validation that
+        // still happens on a hit.
+        const ShaderModuleSPIRVDescriptor* spirvDesc = nullptr;
+        FindInChain(descriptor->nextInChain, &spirvDesc);
+        const ShaderModuleWGSLDescriptor* wgslDesc = nullptr;
+        FindInChain(descriptor->nextInChain, &wgslDesc);
+
+        std::stringstream stream;
+        stream << static_cast<uint32_t>(PersistentKeyType::ShaderReflection);
+        stream << "\n";
+        if (spirvDesc != nullptr && wgslDesc == nullptr) {
+            SerializeSpirvSource(stream, spirvDesc->code, spirvDesc->codeSize);
+        } else if (wgslDesc != nullptr && spirvDesc == nullptr && wgslDesc->source != nullptr) {
+            SerializeWgslSource(stream, wgslDesc->source);
+        } else {
+            return;
+        }
+
+        ScopedCachedBlob blob =
+            device->GetPersistentCache()->LoadData(MakeReflectionCacheKey(device, &stream));
+        if (blob.bufferSize == 0) {
+            return;
+        }
+
+        // Data that can't be deserialized is treated as a miss.
+        auto entryPoints = std::make_unique<EntryPointMetadataTable>();
+        if (DeserializeReflection(blob.buffer.get(), blob.bufferSize, entryPoints.get())) {
+            parseResult->cachedEntryPoints = std::move(entryPoints);
+        }
+    }
+
     MaybeError ValidateShaderModuleDescriptor(DeviceBase* device,
                                               const ShaderModuleDescriptor* descriptor,
                                               ShaderModuleParseResult* parseResult,
@@ -986,57 +1394,14 @@ namespace dawn::native {
         DAWN_TRY(ValidateSingleSType(chainedDescriptor, wgpu::SType::ShaderModuleSPIRVDescriptor,
                                      wgpu::SType::ShaderModuleWGSLDescriptor));
 
-        ScopedTintICEHandler scopedICEHandler(device);
-
-        const ShaderModuleSPIRVDescriptor* spirvDesc = nullptr;
-        FindInChain(chainedDescriptor, &spirvDesc);
-        const ShaderModuleWGSLDescriptor* wgslDesc = nullptr;
-        FindInChain(chainedDescriptor, &wgslDesc);
-
-        // We have a temporary toggle to force the SPIRV ingestion to go through a WGSL
-        // intermediate step. It is done by switching the spirvDesc for a wgslDesc below.
-        ShaderModuleWGSLDescriptor newWgslDesc;
-        std::string newWgslCode;
-        if (spirvDesc && device->IsToggleEnabled(Toggle::ForceWGSLStep)) {
-            std::vector<uint32_t> spirv(spirvDesc->code, spirvDesc->code + spirvDesc->codeSize);
-            tint::Program program;
-            DAWN_TRY_ASSIGN(program, ParseSPIRV(spirv, outMessages));
-
-            tint::writer::wgsl::Options options;
-            auto result = tint::writer::wgsl::Generate(&program, options);
-            DAWN_INVALID_IF(!result.success, "Tint WGSL failure: Generator: %s", result.error);
-
-            newWgslCode = std::move(result.wgsl);
-            newWgslDesc.source = newWgslCode.c_str();
-
-            spirvDesc = nullptr;
-            wgslDesc = &newWgslDesc;
-        }
-
-        if (spirvDesc) {
-            DAWN_INVALID_IF(device->IsToggleEnabled(Toggle::DisallowSpirv),
-                            "SPIR-V is disallowed.");
-
-            std::vector<uint32_t> spirv(spirvDesc->code, spirvDesc->code + spirvDesc->codeSize);
-            tint::Program program;
-            DAWN_TRY_ASSIGN(program, ParseSPIRV(spirv, outMessages));
-            parseResult->tintProgram = std::make_unique<tint::Program>(std::move(program));
-        } else if (wgslDesc) {
-            auto tintSource = std::make_unique<TintSource>("", wgslDesc->source);
-
-            if (device->IsToggleEnabled(Toggle::DumpShaders)) {
-                std::ostringstream dumpedMsg;
-                dumpedMsg << "// Dumped WGSL:" << std::endl << wgslDesc->source;
-                device->EmitLog(WGPULoggingType_Info, dumpedMsg.str().c_str());
-            }
-
-            tint::Program program;
-            DAWN_TRY_ASSIGN(program, ParseWGSL(&tintSource->file, outMessages));
-            parseResult->tintProgram = std::make_unique<tint::Program>(std::move(program));
-            parseResult->tintSource = std::move(tintSource);
+        // The source of modules with cached reflection was successfully parsed and reflected by
+        // a previous device with the same toggles and limits, so parsing is deferred until a
+        // backend needs the tint::Program.
+        if (parseResult->cachedEntryPoints != nullptr) {
+            return {};
         }
 
-        return {};
+        return ParseShaderModule(device, descriptor, parseResult, outMessages);
     }
 
     RequiredBufferSizes ComputeRequiredBufferSizesForLayout(const EntryPointMetadata& entryPoint,
@@ -1238,11 +1603,68 @@ namespace dawn::native {
                a->mWgsl == b->mWgsl;
     }
 
-    const tint::Program* ShaderModuleBase::GetTintProgram() const {
-        ASSERT(mTintProgram);
+    ResultOrError<const tint::Program*> ShaderModuleBase::GetTintProgram() const {
+        std::lock_guard<std::mutex> lock(mTintProgramMutex);
+        if (mTintProgram == nullptr) {
+            TRACE_EVENT0(GetDevice()->GetPlatform(), General, "ShaderModuleBase::ParseLazily");
+
+            ShaderModuleSPIRVDescriptor spirvDesc;
+            ShaderModuleWGSLDescriptor wgslDesc;
+            ShaderModuleDescriptor descriptor;
+            switch (mType) {
+                case Type::Spirv:
+                    spirvDesc.codeSize = mOriginalSpirv.size();
+                    spirvDesc.code = mOriginalSpirv.data();
+                    descriptor.nextInChain = &spirvDesc;
+                    break;
+                case Type::Wgsl:
+                    wgslDesc.source = mWgsl.c_str();
+                    descriptor.nextInChain = &wgslDesc;
+                    break;
+                case Type::Undefined:
+                    UNREACHABLE();
+            }
+
+            ShaderModuleParseResult parseResult;
+            DAWN_TRY(ParseShaderModule(GetDevice(), &descriptor, &parseResult, nullptr));
+            mTintProgram = std::move(parseResult.tintProgram);
+            mTintSource = std::move(parseResult.tintSource);
+        }
         return mTintProgram.get();
     }
 
+    void ShaderModuleBase::SerializeSource(std::ostream& output) const {
+        switch (mType) {
+            case Type::Spirv:
+                SerializeSpirvSource(output, mOriginalSpirv.data(), mOriginalSpirv.size());
+                break;
+            case Type::Wgsl:
+                SerializeWgslSource(output, mWgsl);
+                break;
+            case Type::Undefined:
+                UNREACHABLE();
+        }
+    }
+
+    void ShaderModuleBase::StoreReflectionInCache() {
+        // Modules created from cached reflection don't have a program yet. Compilation messages
+        // aren't cached, so modules that have some are parsed again by the next devices instead.
+        if (!GetDevice()->GetPersistentCache()->IsEnabled() || mTintProgram == nullptr ||
+            mTintProgram->Diagnostics().count() != 0 ||
+            GetDevice()->IsToggleEnabled(Toggle::ForceWGSLStep)) {
+            return;
+        }
+
+        std::stringstream stream;
+        stream << static_cast<uint32_t>(PersistentKeyType::ShaderReflection);
+        stream << "\n";
+        SerializeSource(stream);
+
+        std::vector<uint8_t> reflection = SerializeReflection(mEntryPoints);
+        GetDevice()->GetPersistentCache()->StoreData(
+            MakeReflectionCacheKey(GetDevice(), &stream), reflection.data(), reflection.size());
+    }
+
     void ShaderModuleBase::APIGetCompilationInfo(wgpu::CompilationInfoCallback callback,
                                                  void* userdata) {
         if (callback == nullptr) {
@@ -1313,6 +1735,11 @@ namespace dawn::native {
     }
 
     MaybeError ShaderModuleBase::InitializeBase(ShaderModuleParseResult* parseResult) {
+        if (parseResult->cachedEntryPoints != nullptr) {
+            mEntryPoints = std::move(*parseResult->cachedEntryPoints);
+            return {};
+        }
+
         mTintProgram = std::move(parseResult->tintProgram);
         mTintSource = std::move(parseResult->tintSource);
 
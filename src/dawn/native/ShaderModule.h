@@ -30,7 +30,9 @@
 #include "dawn/native/dawn_platform.h"
 
 #include <bitset>
+#include <iosfwd>
 #include <map>
+#include <mutex>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -94,8 +96,18 @@ namespace dawn::native {
 
         std::unique_ptr<tint::Program> tintProgram;
         std::unique_ptr<TintSource> tintSource;
+
+        // The reflection of an identical module created previously, loaded from the
+        // PersistentCache. When set, there is no tintProgram and the module parses its source only
+        // once a backend needs it.
+        std::unique_ptr<EntryPointMetadataTable> cachedEntryPoints;
     };
 
+    // Looks up the reflection stored by a previous module with the same source in the device's
+    // PersistentCache and puts it in |parseResult| on a hit, so that validation can skip parsing.
+    void LoadShaderModuleReflectionFromCache(DeviceBase* device,
+                                             const ShaderModuleDescriptor* descriptor,
+                                             ShaderModuleParseResult* parseResult);
     MaybeError ValidateShaderModuleDescriptor(DeviceBase* device,
                                               const ShaderModuleDescriptor* descriptor,
                                               ShaderModuleParseResult* parseResult,
@@ -267,7 +279,17 @@ namespace dawn::native {
             bool operator()(const ShaderModuleBase* a, const ShaderModuleBase* b) const;
         };
 
-        const tint::Program* GetTintProgram() const;
+        // The program is parsed on the first call if the module was created from cached
+        // reflection. Can be called from the asynchronous pipeline creation tasks.
+        ResultOrError<const tint::Program*> GetTintProgram() const;
+
+        // Writes the source the module was created from. Used in the PersistentCache keys of the
+        // results derived from the module.
+        void SerializeSource(std::ostream& output) const;
+
+        // Stores the reflection in the PersistentCache so that modules with the same source
+        // created by later devices don't need to be parsed.
+        void StoreReflectionInCache();
 
         void APIGetCompilationInfo(wgpu::CompilationInfoCallback callback, void* userdata);
 
@@ -297,8 +319,11 @@ namespace dawn::native {
         std::string mWgsl;
 
         EntryPointMetadataTable mEntryPoints;
-        std::unique_ptr<tint::Program> mTintProgram;
-        std::unique_ptr<TintSource> mTintSource;  // Keep the tint::Source::File alive
+
+        // Lazily created by GetTintProgram() when the module comes from cached reflection.
+        mutable std::mutex mTintProgramMutex;
+        mutable std::unique_ptr<tint::Program> mTintProgram;
+        mutable std::unique_ptr<TintSource> mTintSource;  // Keep the tint::Source::File alive
 
         std::unique_ptr<OwnedCompilationMessages> mCompilationMessages;
     };
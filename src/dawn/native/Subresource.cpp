@@ -82,7 +82,9 @@ namespace dawn::native {
         // TODO(crbug.com/dawn/829): This should use popcount once Dawn has such a function.
         // Note that we can't do a switch because compilers complain that Depth | Stencil is not
         // a valid enum value.
-        if (aspects == Aspect::Color || aspects == Aspect::Depth ||
+        if (aspects == Aspect::None) {
+            return 0;
+        } else if (aspects == Aspect::Color || aspects == Aspect::Depth ||
             aspects == Aspect::CombinedDepthStencil) {
             return 1;
         } else if (aspects == (Aspect::Plane0 | Aspect::Plane1)) {
@@ -129,4 +131,10 @@ namespace dawn::native {
         return {aspects, {0, layerCount}, {0, levelCount}};
     }
 
+    bool SubresourceRange::operator==(const SubresourceRange& other) const {
+        return aspects == other.aspects && baseArrayLayer == other.baseArrayLayer &&
+               layerCount == other.layerCount && baseMipLevel == other.baseMipLevel &&
+               levelCount == other.levelCount;
+    }
+
 }  // namespace dawn::native
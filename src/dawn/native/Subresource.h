@@ -88,6 +88,8 @@ namespace dawn::native {
                                            uint32_t baseMipLevel);
 
         static SubresourceRange MakeFull(Aspect aspects, uint32_t layerCount, uint32_t levelCount);
+
+        bool operator==(const SubresourceRange& other) const;
     };
 
     // Helper function to use aspects as linear indices in arrays.
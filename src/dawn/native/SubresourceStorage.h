@@ -110,7 +110,8 @@ namespace dawn::native {
         static_assert(HasEqualityOperator<T>::value, "T requires bool operator == (T, T)");
 
         // Creates the storage with the given "dimensions" and all subresources starting with the
-        // initial value.
+        // initial value. A storage with Aspect::None has no subresources, like the one of error
+        // textures.
         SubresourceStorage(Aspect aspects,
                            uint32_t arrayLayerCount,
                            uint32_t mipLevelCount,
@@ -164,6 +165,17 @@ namespace dawn::native {
         template <typename U, typename F>
         void Merge(const SubresourceStorage<U>& other, F&& mergeFunc);
 
+        // Given a predicate that's a function or function-like object that can be called with an
+        // argument of type (const T& data) and returns bool, returns whether it returns true for
+        // the data of all the subresources in `range`. The predicate is called once per compressed
+        // aspect or layer, so checking a whole compressed texture is a single call. For example:
+        //
+        //   bool allInitialized = subresources.AllOf(range, [](bool initialized) {
+        //       return initialized;
+        //   });
+        template <typename F>
+        bool AllOf(const SubresourceRange& range, F&& predicate) const;
+
         // Other operations to consider:
         //
         //  - UpdateTo(Range, T) that updates the range to a constant value.
@@ -295,6 +307,41 @@ namespace dawn::native {
         }
     }
 
+    template <typename T>
+    template <typename F>
+    bool SubresourceStorage<T>::AllOf(const SubresourceRange& range, F&& predicate) const {
+        for (Aspect aspect : IterateEnumMask(range.aspects)) {
+            uint32_t aspectIndex = GetAspectIndex(aspect);
+
+            // The whole aspect has the same data, check it once.
+            if (mAspectCompressed[aspectIndex]) {
+                if (!predicate(DataInline(aspectIndex))) {
+                    return false;
+                }
+                continue;
+            }
+
+            uint32_t layerEnd = range.baseArrayLayer + range.layerCount;
+            for (uint32_t layer = range.baseArrayLayer; layer < layerEnd; layer++) {
+                // The whole layer has the same data, check it once.
+                if (LayerCompressed(aspectIndex, layer)) {
+                    if (!predicate(Data(aspectIndex, layer))) {
+                        return false;
+                    }
+                    continue;
+                }
+
+                uint32_t levelEnd = range.baseMipLevel + range.levelCount;
+                for (uint32_t level = range.baseMipLevel; level < levelEnd; level++) {
+                    if (!predicate(Data(aspectIndex, layer, level))) {
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
     template <typename T>
     template <typename U, typename F>
     void SubresourceStorage<T>::Merge(const SubresourceStorage<U>& other, F&& mergeFunc) {
@@ -466,11 +466,8 @@ namespace dawn::native {
           mSampleCount(descriptor->sampleCount),
           mUsage(descriptor->usage),
           mInternalUsage(mUsage),
-          mState(state) {
-        uint32_t subresourceCount =
-            mMipLevelCount * GetArrayLayers() * GetAspectCount(mFormat.aspects);
-        mIsSubresourceContentInitializedAtIndex = std::vector<bool>(subresourceCount, false);
-
+          mState(state),
+          mIsSubresourceContentInitialized(mFormat.aspects, GetArrayLayers(), mMipLevelCount) {
         const DawnTextureInternalUsageDescriptor* internalUsageDesc = nullptr;
         FindInChain(descriptor->nextInChain, &internalUsageDesc);
         if (internalUsageDesc != nullptr) {
@@ -482,12 +479,17 @@ namespace dawn::native {
     static Format kUnusedFormat;
 
     TextureBase::TextureBase(DeviceBase* device, TextureState state)
-        : ApiObjectBase(device, kLabelNotImplemented), mFormat(kUnusedFormat), mState(state) {
+        : ApiObjectBase(device, kLabelNotImplemented),
+          mFormat(kUnusedFormat),
+          mState(state),
+          mIsSubresourceContentInitialized(Aspect::None, 0, 0) {
         TrackInDevice();
     }
 
     TextureBase::TextureBase(DeviceBase* device, ObjectBase::ErrorTag tag)
-        : ApiObjectBase(device, tag), mFormat(kUnusedFormat) {
+        : ApiObjectBase(device, tag),
+          mFormat(kUnusedFormat),
+          mIsSubresourceContentInitialized(Aspect::None, 0, 0) {
     }
 
     void TextureBase::DestroyImpl() {
@@ -550,7 +552,7 @@ namespace dawn::native {
     }
     uint32_t TextureBase::GetSubresourceCount() const {
         ASSERT(!IsError());
-        return static_cast<uint32_t>(mIsSubresourceContentInitializedAtIndex.size());
+        return mMipLevelCount * GetArrayLayers() * GetAspectCount(mFormat.aspects);
     }
     wgpu::TextureUsage TextureBase::GetUsage() const {
         ASSERT(!IsError());
@@ -576,36 +578,15 @@ namespace dawn::native {
 
     bool TextureBase::IsSubresourceContentInitialized(const SubresourceRange& range) const {
         ASSERT(!IsError());
-        for (Aspect aspect : IterateEnumMask(range.aspects)) {
-            for (uint32_t arrayLayer = range.baseArrayLayer;
-                 arrayLayer < range.baseArrayLayer + range.layerCount; ++arrayLayer) {
-                for (uint32_t mipLevel = range.baseMipLevel;
-                     mipLevel < range.baseMipLevel + range.levelCount; ++mipLevel) {
-                    uint32_t subresourceIndex = GetSubresourceIndex(mipLevel, arrayLayer, aspect);
-                    ASSERT(subresourceIndex < mIsSubresourceContentInitializedAtIndex.size());
-                    if (!mIsSubresourceContentInitializedAtIndex[subresourceIndex]) {
-                        return false;
-                    }
-                }
-            }
-        }
-        return true;
+        return mIsSubresourceContentInitialized.AllOf(
+            range, [](bool isInitialized) { return isInitialized; });
     }
 
     void TextureBase::SetIsSubresourceContentInitialized(bool isInitialized,
                                                          const SubresourceRange& range) {
         ASSERT(!IsError());
-        for (Aspect aspect : IterateEnumMask(range.aspects)) {
-            for (uint32_t arrayLayer = range.baseArrayLayer;
-                 arrayLayer < range.baseArrayLayer + range.layerCount; ++arrayLayer) {
-                for (uint32_t mipLevel = range.baseMipLevel;
-                     mipLevel < range.baseMipLevel + range.levelCount; ++mipLevel) {
-                    uint32_t subresourceIndex = GetSubresourceIndex(mipLevel, arrayLayer, aspect);
-                    ASSERT(subresourceIndex < mIsSubresourceContentInitializedAtIndex.size());
-                    mIsSubresourceContentInitializedAtIndex[subresourceIndex] = isInitialized;
-                }
-            }
-        }
+        mIsSubresourceContentInitialized.Update(
+            range, [&](const SubresourceRange&, bool* data) { *data = isInitialized; });
     }
 
     MaybeError TextureBase::ValidateCanUseInSubmitNow() const {
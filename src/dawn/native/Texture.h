@@ -21,6 +21,7 @@
 #include "dawn/native/Forward.h"
 #include "dawn/native/ObjectBase.h"
 #include "dawn/native/Subresource.h"
+#include "dawn/native/SubresourceStorage.h"
 
 #include "dawn/native/dawn_platform.h"
 
@@ -113,8 +114,7 @@ namespace dawn::native {
         wgpu::TextureUsage mInternalUsage = wgpu::TextureUsage::None;
         TextureState mState;
 
-        // TODO(crbug.com/dawn/845): Use a more optimized data structure to save space
-        std::vector<bool> mIsSubresourceContentInitializedAtIndex;
+        SubresourceStorage<bool> mIsSubresourceContentInitialized;
     };
 
     class TextureViewBase : public ApiObjectBase {
@@ -241,6 +241,41 @@ namespace dawn::native {
              {"disable_timestamp_query_conversion",
               "Resolve timestamp queries into ticks instead of nanoseconds.",
               "https://crbug.com/dawn/1305"}},
+            {Toggle::SkipRedundantStateCommands,
+             {"skip_redundant_state_commands",
+              "Remove the state-setting commands that don't change the current state of the pass "
+              "when a command buffer or render bundle is finished, so that they aren't translated "
+              "into backend API calls. Enabled by default.",
+              "https://crbug.com/dawn"}},
+            {Toggle::VulkanUseDedicatedTransferQueue,
+             {"vulkan_use_dedicated_transfer_queue",
+              "Submit the uploads of Queue::WriteBuffer and Queue::WriteTexture to a queue of a "
+              "transfer-only queue family when the device has one, so that they can run while the "
+              "main queue renders. Requires VK_KHR_timeline_semaphore.",
+              "https://crbug.com/dawn"}},
+            {Toggle::VulkanDefragmentMemoryWhenIdle,
+             {"vulkan_defragment_memory_when_idle",
+              "When the GPU is idle, move the buffers sub-allocated in sparsely used memory blocks "
+              "to other memory blocks, and free the memory blocks that are no longer used.",
+              "https://crbug.com/dawn"}},
+            {Toggle::VulkanRecordCommandBuffersInParallel,
+             {"vulkan_record_command_buffers_in_parallel",
+              "Record the render passes of the command buffers of a submit in secondary command "
+              "buffers on worker threads, one command buffer per thread. The barriers are still "
+              "computed and recorded in submission order on the thread calling Queue::Submit.",
+              "https://crbug.com/dawn"}},
+            {Toggle::VulkanDisableTimelineSemaphore,
+             {"vulkan_disable_timeline_semaphore",
+              "Track the completed serials with one fence per submit even when timeline semaphores "
+              "are supported. Used to test the fence path on devices that have timeline "
+              "semaphores.",
+              "https://crbug.com/dawn"}},
+            {Toggle::DisablePersistentlyMappedUploads,
+             {"disable_persistently_mapped_uploads",
+              "Upload the data of Queue::WriteBuffer and of the buffers mapped for writing with "
+              "glBufferSubData and glMapBufferRange instead of copying it from persistently "
+              "mapped staging buffers. Enabled when glBufferStorage is unavailable.",
+              "https://crbug.com/dawn"}},
 
             // Dummy comment to separate the }} so it is clearer what to copy-paste to add a toggle.
         }};
@@ -63,6 +63,12 @@ namespace dawn::native {
         FxcOptimizations,
         RecordDetailedTimingInTraceEvents,
         DisableTimestampQueryConversion,
+        SkipRedundantStateCommands,
+        VulkanUseDedicatedTransferQueue,
+        VulkanDefragmentMemoryWhenIdle,
+        VulkanRecordCommandBuffersInParallel,
+        VulkanDisableTimelineSemaphore,
+        DisablePersistentlyMappedUploads,
 
         EnumCount,
         InvalidEnum = EnumCount,
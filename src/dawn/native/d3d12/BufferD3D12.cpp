@@ -356,7 +356,7 @@ namespace dawn::native::d3d12 {
     MaybeError Buffer::MapAsyncImpl(wgpu::MapMode mode, size_t offset, size_t size) {
         CommandRecordingContext* commandContext;
         DAWN_TRY_ASSIGN(commandContext, ToBackend(GetDevice())->GetPendingCommandContext());
-        DAWN_TRY(EnsureDataInitialized(commandContext));
+        DAWN_TRY(EnsureDataInitialized(commandContext, offset, size));
 
         return MapInternal(mode & wgpu::MapMode::Write, offset, size, "D3D12 map async");
     }
@@ -400,29 +400,32 @@ namespace dawn::native::d3d12 {
     }
 
     MaybeError Buffer::EnsureDataInitialized(CommandRecordingContext* commandContext) {
-        if (!NeedsInitialization()) {
+        return EnsureDataInitialized(commandContext, 0, GetAllocatedSize());
+    }
+
+    MaybeError Buffer::EnsureDataInitialized(CommandRecordingContext* commandContext,
+                                             uint64_t offset,
+                                             uint64_t size) {
+        if (!NeedsInitialization(offset, size)) {
             return {};
         }
 
-        DAWN_TRY(InitializeToZero(commandContext));
+        DAWN_TRY(InitializeToZero(commandContext, offset, size));
         return {};
     }
 
-    ResultOrError<bool> Buffer::EnsureDataInitializedAsDestination(
-        CommandRecordingContext* commandContext,
-        uint64_t offset,
-        uint64_t size) {
+    void Buffer::EnsureDataInitializedAsDestination(CommandRecordingContext* commandContext,
+                                                    uint64_t offset,
+                                                    uint64_t size) {
         if (!NeedsInitialization()) {
-            return {false};
+            return;
         }
 
         if (IsFullBufferRange(offset, size)) {
             SetIsDataInitialized();
-            return {false};
+        } else {
+            SetIsDataInitialized(offset, size);
         }
-
-        DAWN_TRY(InitializeToZero(commandContext));
-        return {true};
     }
 
     MaybeError Buffer::EnsureDataInitializedAsDestination(CommandRecordingContext* commandContext,
@@ -434,7 +437,7 @@ namespace dawn::native::d3d12 {
         if (IsFullBufferOverwrittenInTextureToBufferCopy(copy)) {
             SetIsDataInitialized();
         } else {
-            DAWN_TRY(InitializeToZero(commandContext));
+            DAWN_TRY(InitializeToZero(commandContext, 0, GetAllocatedSize()));
         }
 
         return {};
@@ -445,13 +448,17 @@ namespace dawn::native::d3d12 {
                      GetLabel());
     }
 
-    MaybeError Buffer::InitializeToZero(CommandRecordingContext* commandContext) {
+    MaybeError Buffer::InitializeToZero(CommandRecordingContext* commandContext,
+                                        uint64_t offset,
+                                        uint64_t size) {
         ASSERT(NeedsInitialization());
 
         // TODO(crbug.com/dawn/484): skip initializing the buffer when it is created on a heap
         // that has already been zero initialized.
-        DAWN_TRY(ClearBuffer(commandContext, uint8_t(0u)));
-        SetIsDataInitialized();
+        for (const IntervalSet::Interval& range : GetUninitializedRanges(offset, size)) {
+            DAWN_TRY(ClearBuffer(commandContext, uint8_t(0u), range.offset, range.size));
+            SetIsDataInitialized(range.offset, range.size);
+        }
         GetDevice()->IncrementLazyClearCountForTesting();
 
         return {};
@@ -469,7 +476,8 @@ namespace dawn::native::d3d12 {
         if (D3D12HeapType(GetUsage()) == D3D12_HEAP_TYPE_UPLOAD) {
             DAWN_TRY(MapInternal(true, static_cast<size_t>(offset), static_cast<size_t>(size),
                                  "D3D12 map at clear buffer"));
-            memset(mMappedData, clearValue, size);
+            // mMappedData points to the start of the resource, irrespective of the offset.
+            memset(static_cast<uint8_t*>(mMappedData) + offset, clearValue, size);
             UnmapImpl();
         } else if (clearValue == 0u) {
             DAWN_TRY(device->ClearBufferToZero(commandContext, this, offset, size));
@@ -43,10 +43,12 @@ namespace dawn::native::d3d12 {
         bool CheckIsResidentForTesting() const;
 
         MaybeError EnsureDataInitialized(CommandRecordingContext* commandContext);
-        ResultOrError<bool> EnsureDataInitializedAsDestination(
-            CommandRecordingContext* commandContext,
-            uint64_t offset,
-            uint64_t size);
+        MaybeError EnsureDataInitialized(CommandRecordingContext* commandContext,
+                                         uint64_t offset,
+                                         uint64_t size);
+        void EnsureDataInitializedAsDestination(CommandRecordingContext* commandContext,
+                                                uint64_t offset,
+                                                uint64_t size);
         MaybeError EnsureDataInitializedAsDestination(CommandRecordingContext* commandContext,
                                                       const CopyTextureToBufferCmd* copy);
 
@@ -71,7 +73,9 @@ namespace dawn::native::d3d12 {
                                                   D3D12_RESOURCE_BARRIER* barrier,
                                                   wgpu::BufferUsage newUsage);
 
-        MaybeError InitializeToZero(CommandRecordingContext* commandContext);
+        MaybeError InitializeToZero(CommandRecordingContext* commandContext,
+                                    uint64_t offset,
+                                    uint64_t size);
         MaybeError ClearBuffer(CommandRecordingContext* commandContext,
                                uint8_t clearValue,
                                uint64_t offset = 0,
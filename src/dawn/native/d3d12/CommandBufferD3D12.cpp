@@ -720,12 +720,10 @@ namespace dawn::native::d3d12 {
                     Buffer* srcBuffer = ToBackend(copy->source.Get());
                     Buffer* dstBuffer = ToBackend(copy->destination.Get());
 
-                    DAWN_TRY(srcBuffer->EnsureDataInitialized(commandContext));
-                    bool cleared;
-                    DAWN_TRY_ASSIGN(cleared,
-                                    dstBuffer->EnsureDataInitializedAsDestination(
-                                        commandContext, copy->destinationOffset, copy->size));
-                    DAWN_UNUSED(cleared);
+                    DAWN_TRY(srcBuffer->EnsureDataInitialized(commandContext, copy->sourceOffset,
+                                                              copy->size));
+                    dstBuffer->EnsureDataInitializedAsDestination(
+                        commandContext, copy->destinationOffset, copy->size);
 
                     srcBuffer->TrackUsageAndTransitionNow(commandContext,
                                                           wgpu::BufferUsage::CopySrc);
@@ -929,11 +927,9 @@ namespace dawn::native::d3d12 {
                     }
                     Buffer* dstBuffer = ToBackend(cmd->buffer.Get());
 
-                    bool clearedToZero;
-                    DAWN_TRY_ASSIGN(clearedToZero, dstBuffer->EnsureDataInitializedAsDestination(
-                                                       commandContext, cmd->offset, cmd->size));
-
-                    if (!clearedToZero) {
+                    if (!dstBuffer->IsDataUninitialized(cmd->offset, cmd->size)) {
+                        dstBuffer->EnsureDataInitializedAsDestination(commandContext, cmd->offset,
+                                                                      cmd->size);
                         DAWN_TRY(device->ClearBufferToZero(commandContext, cmd->buffer.Get(),
                                                            cmd->offset, cmd->size));
                     }
@@ -949,11 +945,8 @@ namespace dawn::native::d3d12 {
                     Buffer* destination = ToBackend(cmd->destination.Get());
                     uint64_t destinationOffset = cmd->destinationOffset;
 
-                    bool cleared;
-                    DAWN_TRY_ASSIGN(cleared, destination->EnsureDataInitializedAsDestination(
-                                                 commandContext, destinationOffset,
-                                                 queryCount * sizeof(uint64_t)));
-                    DAWN_UNUSED(cleared);
+                    destination->EnsureDataInitializedAsDestination(
+                        commandContext, destinationOffset, queryCount * sizeof(uint64_t));
 
                     // Resolving unavailable queries is undefined behaviour on D3D12, we only can
                     // resolve the available part of sparse queries. In order to resolve the
@@ -1042,10 +1035,7 @@ namespace dawn::native::d3d12 {
                     ASSERT(uploadHandle.mappedBuffer != nullptr);
                     memcpy(uploadHandle.mappedBuffer, data, size);
 
-                    bool cleared;
-                    DAWN_TRY_ASSIGN(cleared, dstBuffer->EnsureDataInitializedAsDestination(
-                                                 commandContext, offset, size));
-                    DAWN_UNUSED(cleared);
+                    dstBuffer->EnsureDataInitializedAsDestination(commandContext, offset, size);
                     dstBuffer->TrackUsageAndTransitionNow(commandContext,
                                                           wgpu::BufferUsage::CopyDst);
                     commandList->CopyBufferRegion(
@@ -466,10 +466,8 @@ namespace dawn::native::d3d12 {
 
         Buffer* dstBuffer = ToBackend(destination);
 
-        bool cleared;
-        DAWN_TRY_ASSIGN(cleared, dstBuffer->EnsureDataInitializedAsDestination(
-                                     commandRecordingContext, destinationOffset, size));
-        DAWN_UNUSED(cleared);
+        dstBuffer->EnsureDataInitializedAsDestination(commandRecordingContext, destinationOffset,
+                                                      size);
 
         CopyFromStagingToBufferImpl(commandRecordingContext, source, sourceOffset, destination,
                                     destinationOffset, size);
@@ -767,7 +767,8 @@ namespace dawn::native::d3d12 {
         tint::transform::Manager transformManager;
         tint::transform::DataMap transformInputs;
 
-        const tint::Program* program = GetTintProgram();
+        const tint::Program* program;
+        DAWN_TRY_ASSIGN(program, GetTintProgram());
         tint::Program programAsValue;
 
         AddExternalTextureTransform(layout, &transformManager, &transformInputs);
@@ -33,7 +33,10 @@ namespace dawn::native::metal {
         id<MTLBuffer> GetMTLBuffer() const;
 
         bool EnsureDataInitialized(CommandRecordingContext* commandContext);
-        bool EnsureDataInitializedAsDestination(CommandRecordingContext* commandContext,
+        bool EnsureDataInitialized(CommandRecordingContext* commandContext,
+                                   uint64_t offset,
+                                   uint64_t size);
+        void EnsureDataInitializedAsDestination(CommandRecordingContext* commandContext,
                                                 uint64_t offset,
                                                 uint64_t size);
         bool EnsureDataInitializedAsDestination(CommandRecordingContext* commandContext,
@@ -53,7 +56,9 @@ namespace dawn::native::metal {
         bool IsCPUWritableAtCreation() const override;
         MaybeError MapAtCreationImpl() override;
 
-        void InitializeToZero(CommandRecordingContext* commandContext);
+        void InitializeToZero(CommandRecordingContext* commandContext,
+                              uint64_t offset,
+                              uint64_t size);
         void ClearBuffer(CommandRecordingContext* commandContext,
                          uint8_t clearValue,
                          uint64_t offset = 0,
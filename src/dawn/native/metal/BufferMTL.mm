@@ -158,7 +158,7 @@ namespace dawn::native::metal {
     MaybeError Buffer::MapAsyncImpl(wgpu::MapMode mode, size_t offset, size_t size) {
         CommandRecordingContext* commandContext =
             ToBackend(GetDevice())->GetPendingCommandContext();
-        EnsureDataInitialized(commandContext);
+        EnsureDataInitialized(commandContext, offset, size);
 
         return {};
     }
@@ -177,28 +177,32 @@ namespace dawn::native::metal {
     }
 
     bool Buffer::EnsureDataInitialized(CommandRecordingContext* commandContext) {
-        if (!NeedsInitialization()) {
+        return EnsureDataInitialized(commandContext, 0, GetAllocatedSize());
+    }
+
+    bool Buffer::EnsureDataInitialized(CommandRecordingContext* commandContext,
+                                       uint64_t offset,
+                                       uint64_t size) {
+        if (!NeedsInitialization(offset, size)) {
             return false;
         }
 
-        InitializeToZero(commandContext);
+        InitializeToZero(commandContext, offset, size);
         return true;
     }
 
-    bool Buffer::EnsureDataInitializedAsDestination(CommandRecordingContext* commandContext,
+    void Buffer::EnsureDataInitializedAsDestination(CommandRecordingContext* commandContext,
                                                     uint64_t offset,
                                                     uint64_t size) {
         if (!NeedsInitialization()) {
-            return false;
+            return;
         }
 
         if (IsFullBufferRange(offset, size)) {
             SetIsDataInitialized();
-            return false;
+        } else {
+            SetIsDataInitialized(offset, size);
         }
-
-        InitializeToZero(commandContext);
-        return true;
     }
 
     bool Buffer::EnsureDataInitializedAsDestination(CommandRecordingContext* commandContext,
@@ -212,16 +216,19 @@ namespace dawn::native::metal {
             return false;
         }
 
-        InitializeToZero(commandContext);
+        InitializeToZero(commandContext, 0, GetAllocatedSize());
         return true;
     }
 
-    void Buffer::InitializeToZero(CommandRecordingContext* commandContext) {
+    void Buffer::InitializeToZero(CommandRecordingContext* commandContext,
+                                  uint64_t offset,
+                                  uint64_t size) {
         ASSERT(NeedsInitialization());
 
-        ClearBuffer(commandContext, uint8_t(0u));
-
-        SetIsDataInitialized();
+        for (const IntervalSet::Interval& range : GetUninitializedRanges(offset, size)) {
+            ClearBuffer(commandContext, uint8_t(0u), range.offset, range.size);
+            SetIsDataInitialized(range.offset, range.size);
+        }
         GetDevice()->IncrementLazyClearCountForTesting();
     }
 
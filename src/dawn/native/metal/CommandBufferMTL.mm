@@ -747,7 +747,8 @@ namespace dawn::native::metal {
                         break;
                     }
 
-                    ToBackend(copy->source)->EnsureDataInitialized(commandContext);
+                    ToBackend(copy->source)
+                        ->EnsureDataInitialized(commandContext, copy->sourceOffset, copy->size);
                     ToBackend(copy->destination)
                         ->EnsureDataInitializedAsDestination(commandContext,
                                                              copy->destinationOffset, copy->size);
@@ -952,10 +953,9 @@ namespace dawn::native::metal {
                     }
                     Buffer* dstBuffer = ToBackend(cmd->buffer.Get());
 
-                    bool clearedToZero = dstBuffer->EnsureDataInitializedAsDestination(
-                        commandContext, cmd->offset, cmd->size);
-
-                    if (!clearedToZero) {
+                    if (!dstBuffer->IsDataUninitialized(cmd->offset, cmd->size)) {
+                        dstBuffer->EnsureDataInitializedAsDestination(commandContext, cmd->offset,
+                                                                      cmd->size);
                         [commandContext->EnsureBlit() fillBuffer:dstBuffer->GetMTLBuffer()
                                                            range:NSMakeRange(cmd->offset, cmd->size)
                                                            value:0u];
@@ -134,11 +134,14 @@ namespace dawn::native::metal {
                                                          std::move(accessControls),
                                                          /* mayCollide */ true);
 
+        const tint::Program* tintProgram;
+        DAWN_TRY_ASSIGN(tintProgram, GetTintProgram());
+
         tint::Program program;
         tint::transform::DataMap transformOutputs;
         {
             TRACE_EVENT0(GetDevice()->GetPlatform(), General, "RunTransforms");
-            DAWN_TRY_ASSIGN(program, RunTransforms(&transformManager, GetTintProgram(),
+            DAWN_TRY_ASSIGN(program, RunTransforms(&transformManager, tintProgram,
                                                    transformInputs, &transformOutputs, nullptr));
         }
 
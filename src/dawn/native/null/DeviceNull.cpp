@@ -205,7 +205,7 @@ namespace dawn::native::null {
                                                uint64_t destinationOffset,
                                                uint64_t size) {
         if (IsToggleEnabled(Toggle::LazyClearResourceOnFirstUse)) {
-            destination->SetIsDataInitialized();
+            destination->SetIsDataInitialized(destinationOffset, size);
         }
 
         auto operation = std::make_unique<CopyFromStagingToBufferOperation>();
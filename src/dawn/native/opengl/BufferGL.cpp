@@ -17,6 +17,8 @@
 #include "dawn/native/CommandBuffer.h"
 #include "dawn/native/opengl/DeviceGL.h"
 
+#include <cstring>
+
 namespace dawn::native::opengl {
 
     // Buffer
@@ -41,6 +43,31 @@ namespace dawn::native::opengl {
         device->gl.GenBuffers(1, &mBuffer);
         device->gl.BindBuffer(GL_ARRAY_BUFFER, mBuffer);
 
+        // Buffers mapped for writing are only read by the GPU, so they can stay mapped. The
+        // frontend only returns their mapping after the GPU commands using them completed.
+        if (device->UsesPersistentlyMappedUploads() && (GetUsage() & wgpu::BufferUsage::MapWrite)) {
+            constexpr GLbitfield kMapFlags =
+                GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            device->gl.BufferStorage(GL_ARRAY_BUFFER, mAllocatedSize, nullptr, kMapFlags);
+            mPersistentlyMappedData =
+                device->gl.MapBufferRange(GL_ARRAY_BUFFER, 0, mAllocatedSize, kMapFlags);
+            ASSERT(mPersistentlyMappedData != nullptr);
+
+            // The buffers with mappedAtCreation == true will be initialized in
+            // BufferBase::MapAtCreation().
+            if (!descriptor->mappedAtCreation) {
+                uint8_t clearValue = 0u;
+                if (device->IsToggleEnabled(Toggle::NonzeroClearResourcesOnCreationForTesting)) {
+                    clearValue = 1u;
+                }
+                memset(mPersistentlyMappedData, clearValue, mAllocatedSize);
+                if (clearValue == 0u) {
+                    SetIsDataInitialized();
+                }
+            }
+            return;
+        }
+
         // The buffers with mappedAtCreation == true will be initialized in
         // BufferBase::MapAtCreation().
         if (device->IsToggleEnabled(Toggle::NonzeroClearResourcesOnCreationForTesting) &&
@@ -68,26 +95,28 @@ namespace dawn::native::opengl {
     }
 
     bool Buffer::EnsureDataInitialized() {
-        if (!NeedsInitialization()) {
+        return EnsureDataInitialized(0, GetAllocatedSize());
+    }
+
+    bool Buffer::EnsureDataInitialized(uint64_t offset, uint64_t size) {
+        if (!NeedsInitialization(offset, size)) {
             return false;
         }
 
-        InitializeToZero();
+        InitializeToZero(offset, size);
         return true;
     }
 
-    bool Buffer::EnsureDataInitializedAsDestination(uint64_t offset, uint64_t size) {
+    void Buffer::EnsureDataInitializedAsDestination(uint64_t offset, uint64_t size) {
         if (!NeedsInitialization()) {
-            return false;
+            return;
         }
 
         if (IsFullBufferRange(offset, size)) {
             SetIsDataInitialized();
-            return false;
+        } else {
+            SetIsDataInitialized(offset, size);
         }
-
-        InitializeToZero();
-        return true;
     }
 
     bool Buffer::EnsureDataInitializedAsDestination(const CopyTextureToBufferCmd* copy) {
@@ -100,22 +129,32 @@ namespace dawn::native::opengl {
             return false;
         }
 
-        InitializeToZero();
+        InitializeToZero(0, GetAllocatedSize());
         return true;
     }
 
-    void Buffer::InitializeToZero() {
+    void Buffer::InitializeToZero(uint64_t offset, uint64_t size) {
         ASSERT(NeedsInitialization());
 
-        const uint64_t size = GetAllocatedSize();
         Device* device = ToBackend(GetDevice());
-
-        const std::vector<uint8_t> clearValues(size, 0u);
-        device->gl.BindBuffer(GL_ARRAY_BUFFER, mBuffer);
-        device->gl.BufferSubData(GL_ARRAY_BUFFER, 0, size, clearValues.data());
+        if (mPersistentlyMappedData != nullptr) {
+            // Clear through the mapping so that the clear is ordered with the CPU writes that
+            // follow a MapAsync, instead of being a GPU command that could run after them.
+            uint8_t* data = static_cast<uint8_t*>(mPersistentlyMappedData);
+            for (const IntervalSet::Interval& range : GetUninitializedRanges(offset, size)) {
+                memset(data + range.offset, 0, range.size);
+                SetIsDataInitialized(range.offset, range.size);
+            }
+        } else {
+            device->gl.BindBuffer(GL_ARRAY_BUFFER, mBuffer);
+            for (const IntervalSet::Interval& range : GetUninitializedRanges(offset, size)) {
+                const std::vector<uint8_t> clearValues(range.size, 0u);
+                device->gl.BufferSubData(GL_ARRAY_BUFFER, range.offset, range.size,
+                                         clearValues.data());
+                SetIsDataInitialized(range.offset, range.size);
+            }
+        }
         device->IncrementLazyClearCountForTesting();
-
-        SetIsDataInitialized();
     }
 
     bool Buffer::IsCPUWritableAtCreation() const {
@@ -125,6 +164,11 @@ namespace dawn::native::opengl {
     }
 
     MaybeError Buffer::MapAtCreationImpl() {
+        if (mPersistentlyMappedData != nullptr) {
+            mMappedData = mPersistentlyMappedData;
+            return {};
+        }
+
         const OpenGLFunctions& gl = ToBackend(GetDevice())->gl;
         gl.BindBuffer(GL_ARRAY_BUFFER, mBuffer);
         mMappedData = gl.MapBufferRange(GL_ARRAY_BUFFER, 0, GetSize(), GL_MAP_WRITE_BIT);
@@ -143,7 +187,13 @@ namespace dawn::native::opengl {
             size = 4;
         }
 
-        EnsureDataInitialized();
+        EnsureDataInitialized(offset, size);
+
+        if (mPersistentlyMappedData != nullptr) {
+            ASSERT(mode & wgpu::MapMode::Write);
+            mMappedData = mPersistentlyMappedData;
+            return {};
+        }
 
         // This does GPU->CPU synchronization, we could require a high
         // version of OpenGL that would let us map the buffer unsynchronized.
@@ -168,6 +218,11 @@ namespace dawn::native::opengl {
     }
 
     void Buffer::UnmapImpl() {
+        if (mPersistentlyMappedData != nullptr) {
+            mMappedData = nullptr;
+            return;
+        }
+
         const OpenGLFunctions& gl = ToBackend(GetDevice())->gl;
 
         gl.BindBuffer(GL_ARRAY_BUFFER, mBuffer);
@@ -177,8 +232,10 @@ namespace dawn::native::opengl {
 
     void Buffer::DestroyImpl() {
         BufferBase::DestroyImpl();
+        // Deleting the buffer also unmaps it.
         ToBackend(GetDevice())->gl.DeleteBuffers(1, &mBuffer);
         mBuffer = 0;
+        mPersistentlyMappedData = nullptr;
     }
 
 }  // namespace dawn::native::opengl
@@ -34,7 +34,8 @@ namespace dawn::native::opengl {
         GLuint GetHandle() const;
 
         bool EnsureDataInitialized();
-        bool EnsureDataInitializedAsDestination(uint64_t offset, uint64_t size);
+        bool EnsureDataInitialized(uint64_t offset, uint64_t size);
+        void EnsureDataInitializedAsDestination(uint64_t offset, uint64_t size);
         bool EnsureDataInitializedAsDestination(const CopyTextureToBufferCmd* copy);
 
       private:
@@ -47,10 +48,12 @@ namespace dawn::native::opengl {
         MaybeError MapAtCreationImpl() override;
         void* GetMappedPointerImpl() override;
 
-        void InitializeToZero();
+        void InitializeToZero(uint64_t offset, uint64_t size);
 
         GLuint mBuffer = 0;
         void* mMappedData = nullptr;
+        // The mapping of the whole buffer when it stays mapped for its whole lifetime.
+        void* mPersistentlyMappedData = nullptr;
     };
 
 }  // namespace dawn::native::opengl
@@ -18,6 +18,7 @@
 #include "dawn/native/BindGroupTracker.h"
 #include "dawn/native/CommandEncoder.h"
 #include "dawn/native/Commands.h"
+#include "dawn/native/DynamicUploader.h"
 #include "dawn/native/ExternalTexture.h"
 #include "dawn/native/RenderBundle.h"
 #include "dawn/native/VertexFormat.h"
@@ -25,6 +26,7 @@
 #include "dawn/native/opengl/ComputePipelineGL.h"
 #include "dawn/native/opengl/DeviceGL.h"
 #include "dawn/native/opengl/Forward.h"
+#include "dawn/native/opengl/FramebufferCacheGL.h"
 #include "dawn/native/opengl/PersistentPipelineStateGL.h"
 #include "dawn/native/opengl/PipelineLayoutGL.h"
 #include "dawn/native/opengl/RenderPipelineGL.h"
@@ -162,9 +164,11 @@ namespace dawn::native::opengl {
                 mLastPipeline = pipeline;
             }
 
-            void Apply(const OpenGLFunctions& gl) {
+            void Apply(const OpenGLFunctions& gl,
+                       PersistentPipelineState& persistentPipelineState) {
                 if (mIndexBufferDirty && mIndexBuffer != nullptr) {
-                    gl.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer->GetHandle());
+                    persistentPipelineState.BindBuffer(gl, GL_ELEMENT_ARRAY_BUFFER,
+                                                       mIndexBuffer->GetHandle());
                     mIndexBufferDirty = false;
                 }
 
@@ -184,7 +188,7 @@ namespace dawn::native::opengl {
                         GLenum formatType = VertexFormatType(attribute.format);
 
                         GLboolean normalized = VertexFormatIsNormalized(attribute.format);
-                        gl.BindBuffer(GL_ARRAY_BUFFER, buffer);
+                        persistentPipelineState.BindBuffer(gl, GL_ARRAY_BUFFER, buffer);
                         if (VertexFormatIsInt(attribute.format)) {
                             gl.VertexAttribIPointer(
                                 attribIndex, components, formatType, vertexBuffer.arrayStride,
@@ -225,18 +229,20 @@ namespace dawn::native::opengl {
                 mPipeline = pipeline;
             }
 
-            void Apply(const OpenGLFunctions& gl) {
+            void Apply(const OpenGLFunctions& gl,
+                       PersistentPipelineState& persistentPipelineState) {
                 BeforeApply();
                 for (BindGroupIndex index :
                      IterateBitSet(mDirtyBindGroupsObjectChangedOrIsDynamic)) {
-                    ApplyBindGroup(gl, index, mBindGroups[index], mDynamicOffsetCounts[index],
-                                   mDynamicOffsets[index].data());
+                    ApplyBindGroup(gl, persistentPipelineState, index, mBindGroups[index],
+                                   mDynamicOffsetCounts[index], mDynamicOffsets[index].data());
                 }
                 AfterApply();
             }
 
           private:
             void ApplyBindGroup(const OpenGLFunctions& gl,
+                                PersistentPipelineState& persistentPipelineState,
                                 BindGroupIndex index,
                                 BindGroupBase* group,
                                 uint32_t dynamicOffsetCount,
@@ -275,7 +281,8 @@ namespace dawn::native::opengl {
                                     UNREACHABLE();
                             }
 
-                            gl.BindBufferRange(target, index, buffer, offset, binding.size);
+                            persistentPipelineState.BindBufferRange(gl, target, index, buffer,
+                                                                    offset, binding.size);
                             break;
                         }
 
@@ -288,9 +295,11 @@ namespace dawn::native::opengl {
                                 // Only use filtering for certain texture units, because int
                                 // and uint texture are only complete without filtering
                                 if (unit.shouldUseFiltering) {
-                                    gl.BindSampler(unit.unit, sampler->GetFilteringHandle());
+                                    persistentPipelineState.BindSampler(
+                                        gl, unit.unit, sampler->GetFilteringHandle());
                                 } else {
-                                    gl.BindSampler(unit.unit, sampler->GetNonFilteringHandle());
+                                    persistentPipelineState.BindSampler(
+                                        gl, unit.unit, sampler->GetNonFilteringHandle());
                                 }
                             }
                             break;
@@ -304,10 +313,11 @@ namespace dawn::native::opengl {
                             GLuint viewIndex = indices[bindingIndex];
 
                             for (auto unit : mPipeline->GetTextureUnitsForTextureView(viewIndex)) {
-                                gl.ActiveTexture(GL_TEXTURE0 + unit);
-                                gl.BindTexture(target, handle);
+                                persistentPipelineState.BindTexture(gl, unit, target, handle);
                                 if (ToBackend(view->GetTexture())->GetGLFormat().format ==
                                     GL_DEPTH_STENCIL) {
+                                    // The texture parameters are set on the active unit.
+                                    persistentPipelineState.SetActiveTexture(gl, unit);
                                     Aspect aspect = view->GetAspects();
                                     ASSERT(HasOneBit(aspect));
                                     switch (aspect) {
@@ -358,9 +368,10 @@ namespace dawn::native::opengl {
                                 UNREACHABLE();
                             }
 
-                            gl.BindImageTexture(imageIndex, handle, view->GetBaseMipLevel(),
-                                                isLayered, view->GetBaseArrayLayer(), access,
-                                                texture->GetGLFormat().internalFormat);
+                            persistentPipelineState.BindImageTexture(
+                                gl, imageIndex, handle, view->GetBaseMipLevel(), isLayered,
+                                view->GetBaseArrayLayer(), access,
+                                texture->GetGLFormat().internalFormat);
                             break;
                         }
 
@@ -375,58 +386,48 @@ namespace dawn::native::opengl {
         };
 
         void ResolveMultisampledRenderTargets(const OpenGLFunctions& gl,
+                                              FramebufferCache* framebufferCache,
                                               const BeginRenderPassCmd* renderPass) {
             ASSERT(renderPass != nullptr);
 
-            GLuint readFbo = 0;
-            GLuint writeFbo = 0;
-
             for (ColorAttachmentIndex i :
                  IterateBitSet(renderPass->attachmentState->GetColorAttachmentsMask())) {
                 if (renderPass->colorAttachments[i].resolveTarget != nullptr) {
-                    if (readFbo == 0) {
-                        ASSERT(writeFbo == 0);
-                        gl.GenFramebuffers(1, &readFbo);
-                        gl.GenFramebuffers(1, &writeFbo);
-                    }
-
-                    const TextureBase* colorTexture =
-                        renderPass->colorAttachments[i].view->GetTexture();
+                    const Texture* colorTexture =
+                        ToBackend(renderPass->colorAttachments[i].view->GetTexture());
                     ASSERT(colorTexture->IsMultisampledTexture());
                     ASSERT(colorTexture->GetArrayLayers() == 1);
                     ASSERT(renderPass->colorAttachments[i].view->GetBaseMipLevel() == 0);
 
-                    GLuint colorHandle = ToBackend(colorTexture)->GetHandle();
-                    gl.BindFramebuffer(GL_READ_FRAMEBUFFER, readFbo);
-                    gl.FramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
-                                            ToBackend(colorTexture)->GetGLTarget(), colorHandle, 0);
-
-                    const TextureBase* resolveTexture =
-                        renderPass->colorAttachments[i].resolveTarget->GetTexture();
-                    GLuint resolveTextureHandle = ToBackend(resolveTexture)->GetHandle();
-                    GLuint resolveTargetMipmapLevel =
-                        renderPass->colorAttachments[i].resolveTarget->GetBaseMipLevel();
-                    gl.BindFramebuffer(GL_DRAW_FRAMEBUFFER, writeFbo);
+                    FramebufferCacheQuery readQuery;
+                    readQuery.AddAttachment(GL_COLOR_ATTACHMENT0, colorTexture, 0);
+
+                    const TextureViewBase* resolveTarget =
+                        renderPass->colorAttachments[i].resolveTarget.Get();
+                    const Texture* resolveTexture = ToBackend(resolveTarget->GetTexture());
+                    GLint resolveTargetMipmapLevel = resolveTarget->GetBaseMipLevel();
+                    FramebufferCacheQuery writeQuery;
                     if (resolveTexture->GetArrayLayers() == 1) {
-                        gl.FramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
-                                                GL_TEXTURE_2D, resolveTextureHandle,
-                                                resolveTargetMipmapLevel);
+                        writeQuery.AddAttachment(GL_COLOR_ATTACHMENT0, resolveTexture,
+                                                 resolveTargetMipmapLevel);
                     } else {
-                        GLuint resolveTargetArrayLayer =
-                            renderPass->colorAttachments[i].resolveTarget->GetBaseArrayLayer();
-                        gl.FramebufferTextureLayer(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
-                                                   resolveTextureHandle, resolveTargetMipmapLevel,
-                                                   resolveTargetArrayLayer);
+                        writeQuery.AddLayerAttachment(GL_COLOR_ATTACHMENT0, resolveTexture,
+                                                      resolveTargetMipmapLevel,
+                                                      resolveTarget->GetBaseArrayLayer());
                     }
 
+                    // Getting the framebuffers may change the draw framebuffer binding, so they
+                    // are bound after.
+                    GLuint readFbo = framebufferCache->GetFramebuffer(readQuery);
+                    GLuint writeFbo = framebufferCache->GetFramebuffer(writeQuery);
+                    gl.BindFramebuffer(GL_READ_FRAMEBUFFER, readFbo);
+                    gl.BindFramebuffer(GL_DRAW_FRAMEBUFFER, writeFbo);
+
                     gl.BlitFramebuffer(0, 0, renderPass->width, renderPass->height, 0, 0,
                                        renderPass->width, renderPass->height, GL_COLOR_BUFFER_BIT,
                                        GL_NEAREST);
                 }
             }
-
-            gl.DeleteFramebuffers(1, &readFbo);
-            gl.DeleteFramebuffers(1, &writeFbo);
         }
 
         // OpenGL SPEC requires the source/destination region must be a region that is contained
@@ -453,19 +454,13 @@ namespace dawn::native::opengl {
         }
 
         void CopyTextureToTextureWithBlit(const OpenGLFunctions& gl,
+                                          FramebufferCache* framebufferCache,
                                           const TextureCopy& src,
                                           const TextureCopy& dst,
                                           const Extent3D& copySize) {
             Texture* srcTexture = ToBackend(src.texture.Get());
             Texture* dstTexture = ToBackend(dst.texture.Get());
 
-            // Generate temporary framebuffers for the blits.
-            GLuint readFBO = 0, drawFBO = 0;
-            gl.GenFramebuffers(1, &readFBO);
-            gl.GenFramebuffers(1, &drawFBO);
-            gl.BindFramebuffer(GL_READ_FRAMEBUFFER, readFBO);
-            gl.BindFramebuffer(GL_DRAW_FRAMEBUFFER, drawFBO);
-
             // Reset state that may affect glBlitFramebuffer().
             gl.Disable(GL_SCISSOR_TEST);
             GLenum blitMask = 0;
@@ -480,7 +475,9 @@ namespace dawn::native::opengl {
             }
             // Iterate over all layers, doing a single blit for each.
             for (uint32_t layer = 0; layer < copySize.depthOrArrayLayers; ++layer) {
-                // Bind all required aspects for this layer.
+                // Attach all required aspects for this layer.
+                FramebufferCacheQuery readQuery;
+                FramebufferCacheQuery drawQuery;
                 for (Aspect aspect : IterateEnumMask(src.aspect)) {
                     GLenum glAttachment;
                     switch (aspect) {
@@ -501,35 +498,33 @@ namespace dawn::native::opengl {
                     }
                     if (srcTexture->GetArrayLayers() == 1 &&
                         srcTexture->GetDimension() == wgpu::TextureDimension::e2D) {
-                        gl.FramebufferTexture2D(GL_READ_FRAMEBUFFER, glAttachment,
-                                                srcTexture->GetGLTarget(), srcTexture->GetHandle(),
-                                                src.mipLevel);
+                        readQuery.AddAttachment(glAttachment, srcTexture, src.mipLevel);
                     } else {
-                        gl.FramebufferTextureLayer(GL_READ_FRAMEBUFFER, glAttachment,
-                                                   srcTexture->GetHandle(),
-                                                   static_cast<GLint>(src.mipLevel),
-                                                   static_cast<GLint>(src.origin.z + layer));
+                        readQuery.AddLayerAttachment(glAttachment, srcTexture, src.mipLevel,
+                                                     static_cast<GLint>(src.origin.z + layer));
                     }
                     if (dstTexture->GetArrayLayers() == 1 &&
                         dstTexture->GetDimension() == wgpu::TextureDimension::e2D) {
-                        gl.FramebufferTexture2D(GL_DRAW_FRAMEBUFFER, glAttachment,
-                                                dstTexture->GetGLTarget(), dstTexture->GetHandle(),
-                                                dst.mipLevel);
+                        drawQuery.AddAttachment(glAttachment, dstTexture, dst.mipLevel);
                     } else {
-                        gl.FramebufferTextureLayer(GL_DRAW_FRAMEBUFFER, glAttachment,
-                                                   dstTexture->GetHandle(),
-                                                   static_cast<GLint>(dst.mipLevel),
-                                                   static_cast<GLint>(dst.origin.z + layer));
+                        drawQuery.AddLayerAttachment(glAttachment, dstTexture, dst.mipLevel,
+                                                     static_cast<GLint>(dst.origin.z + layer));
                     }
                 }
+
+                // Getting the framebuffers may change the draw framebuffer binding, so they are
+                // bound after.
+                GLuint readFBO = framebufferCache->GetFramebuffer(readQuery);
+                GLuint drawFBO = framebufferCache->GetFramebuffer(drawQuery);
+                gl.BindFramebuffer(GL_READ_FRAMEBUFFER, readFBO);
+                gl.BindFramebuffer(GL_DRAW_FRAMEBUFFER, drawFBO);
+
                 gl.BlitFramebuffer(src.origin.x, src.origin.y, src.origin.x + copySize.width,
                                    src.origin.y + copySize.height, dst.origin.x, dst.origin.y,
                                    dst.origin.x + copySize.width, dst.origin.y + copySize.height,
                                    blitMask, GL_NEAREST);
             }
             gl.Enable(GL_SCISSOR_TEST);
-            gl.DeleteFramebuffers(1, &readFBO);
-            gl.DeleteFramebuffers(1, &drawFBO);
         }
         bool TextureFormatIsSnorm(wgpu::TextureFormat format) {
             return format == wgpu::TextureFormat::RGBA8Snorm ||
@@ -544,6 +539,7 @@ namespace dawn::native::opengl {
 
     MaybeError CommandBuffer::Execute() {
         const OpenGLFunctions& gl = ToBackend(GetDevice())->gl;
+        FramebufferCache* framebufferCache = ToBackend(GetDevice())->GetFramebufferCache();
 
         auto LazyClearSyncScope = [](const SyncScopeResourceUsage& scope) {
             for (size_t i = 0; i < scope.textures.size(); i++) {
@@ -600,7 +596,7 @@ namespace dawn::native::opengl {
                         break;
                     }
 
-                    ToBackend(copy->source)->EnsureDataInitialized();
+                    ToBackend(copy->source)->EnsureDataInitialized(copy->sourceOffset, copy->size);
                     ToBackend(copy->destination)
                         ->EnsureDataInitializedAsDestination(copy->destinationOffset, copy->size);
 
@@ -686,13 +682,10 @@ namespace dawn::native::opengl {
                         GetSubresourcesAffectedByCopy(src, copy->copySize);
                     texture->EnsureSubresourceContentInitialized(subresources);
                     // The only way to move data from a texture to a buffer in GL is via
-                    // glReadPixels with a pack buffer. Create a temporary FBO for the copy.
+                    // glReadPixels with a pack buffer, reading from a framebuffer with the
+                    // copied subresource attached.
                     gl.BindTexture(target, texture->GetHandle());
 
-                    GLuint readFBO = 0;
-                    gl.GenFramebuffers(1, &readFBO);
-                    gl.BindFramebuffer(GL_READ_FRAMEBUFFER, readFBO);
-
                     const TexelBlockInfo& blockInfo = formatInfo.GetAspectInfo(src.aspect).block;
 
                     gl.BindBuffer(GL_PIXEL_PACK_BUFFER, buffer->GetHandle());
@@ -730,8 +723,10 @@ namespace dawn::native::opengl {
                     switch (texture->GetDimension()) {
                         case wgpu::TextureDimension::e2D: {
                             if (texture->GetArrayLayers() == 1) {
-                                gl.FramebufferTexture2D(GL_READ_FRAMEBUFFER, glAttachment, target,
-                                                        texture->GetHandle(), src.mipLevel);
+                                FramebufferCacheQuery query;
+                                query.AddAttachment(glAttachment, texture, src.mipLevel);
+                                gl.BindFramebuffer(GL_READ_FRAMEBUFFER,
+                                                   framebufferCache->GetFramebuffer(query));
                                 gl.ReadPixels(src.origin.x, src.origin.y, copySize.width,
                                               copySize.height, glFormat, glType, offset);
                                 break;
@@ -743,9 +738,11 @@ namespace dawn::native::opengl {
                         case wgpu::TextureDimension::e3D: {
                             const uint64_t bytesPerImage = dst.bytesPerRow * dst.rowsPerImage;
                             for (uint32_t z = 0; z < copySize.depthOrArrayLayers; ++z) {
-                                gl.FramebufferTextureLayer(GL_READ_FRAMEBUFFER, glAttachment,
-                                                           texture->GetHandle(), src.mipLevel,
-                                                           src.origin.z + z);
+                                FramebufferCacheQuery query;
+                                query.AddLayerAttachment(glAttachment, texture, src.mipLevel,
+                                                         src.origin.z + z);
+                                gl.BindFramebuffer(GL_READ_FRAMEBUFFER,
+                                                   framebufferCache->GetFramebuffer(query));
                                 gl.ReadPixels(src.origin.x, src.origin.y, copySize.width,
                                               copySize.height, glFormat, glType, offset);
 
@@ -761,7 +758,6 @@ namespace dawn::native::opengl {
                     gl.PixelStorei(GL_PACK_ROW_LENGTH, 0);
 
                     gl.BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
-                    gl.DeleteFramebuffers(1, &readFBO);
                     break;
                 }
 
@@ -801,7 +797,7 @@ namespace dawn::native::opengl {
                                             copySize.width, copySize.height,
                                             copy->copySize.depthOrArrayLayers);
                     } else {
-                        CopyTextureToTextureWithBlit(gl, src, dst, copySize);
+                        CopyTextureToTextureWithBlit(gl, framebufferCache, src, dst, copySize);
                     }
                     break;
                 }
@@ -814,10 +810,8 @@ namespace dawn::native::opengl {
                     }
                     Buffer* dstBuffer = ToBackend(cmd->buffer.Get());
 
-                    bool clearedToZero =
+                    if (!dstBuffer->IsDataUninitialized(cmd->offset, cmd->size)) {
                         dstBuffer->EnsureDataInitializedAsDestination(cmd->offset, cmd->size);
-
-                    if (!clearedToZero) {
                         const std::vector<uint8_t> clearValues(cmd->size, 0u);
                         gl.BindBuffer(GL_ARRAY_BUFFER, dstBuffer->GetHandle());
                         gl.BufferSubData(GL_ARRAY_BUFFER, cmd->offset, cmd->size,
@@ -856,6 +850,22 @@ namespace dawn::native::opengl {
 
                     Buffer* dstBuffer = ToBackend(write->buffer.Get());
                     uint8_t* data = mCommands.NextData<uint8_t>(size);
+                    Device* device = ToBackend(GetDevice());
+
+                    if (device->UsesPersistentlyMappedUploads()) {
+                        UploadHandle uploadHandle;
+                        DAWN_TRY_ASSIGN(uploadHandle, device->GetDynamicUploader()->Allocate(
+                                                          size, device->GetPendingCommandSerial(),
+                                                          kCopyBufferToBufferOffsetAlignment));
+                        ASSERT(uploadHandle.mappedBuffer != nullptr);
+                        memcpy(uploadHandle.mappedBuffer, data, size);
+
+                        DAWN_TRY(device->CopyFromStagingToBuffer(uploadHandle.stagingBuffer,
+                                                                 uploadHandle.startOffset,
+                                                                 dstBuffer, offset, size));
+                        break;
+                    }
+
                     dstBuffer->EnsureDataInitializedAsDestination(offset, size);
 
                     gl.BindBuffer(GL_ARRAY_BUFFER, dstBuffer->GetHandle());
@@ -872,7 +882,9 @@ namespace dawn::native::opengl {
     }
 
     MaybeError CommandBuffer::ExecuteComputePass() {
-        const OpenGLFunctions& gl = ToBackend(GetDevice())->gl;
+        Device* device = ToBackend(GetDevice());
+        const OpenGLFunctions& gl = device->gl;
+        PersistentPipelineState persistentPipelineState;
         ComputePipeline* lastPipeline = nullptr;
         BindGroupTracker bindGroupTracker = {};
 
@@ -881,12 +893,13 @@ namespace dawn::native::opengl {
             switch (type) {
                 case Command::EndComputePass: {
                     mCommands.NextCommand<EndComputePassCmd>();
+                    device->AddGLCallStats(persistentPipelineState.GetCallStats());
                     return {};
                 }
 
                 case Command::Dispatch: {
                     DispatchCmd* dispatch = mCommands.NextCommand<DispatchCmd>();
-                    bindGroupTracker.Apply(gl);
+                    bindGroupTracker.Apply(gl, persistentPipelineState);
 
                     gl.DispatchCompute(dispatch->x, dispatch->y, dispatch->z);
                     gl.MemoryBarrier(GL_ALL_BARRIER_BITS);
@@ -895,12 +908,13 @@ namespace dawn::native::opengl {
 
                 case Command::DispatchIndirect: {
                     DispatchIndirectCmd* dispatch = mCommands.NextCommand<DispatchIndirectCmd>();
-                    bindGroupTracker.Apply(gl);
+                    bindGroupTracker.Apply(gl, persistentPipelineState);
 
                     uint64_t indirectBufferOffset = dispatch->indirectOffset;
                     Buffer* indirectBuffer = ToBackend(dispatch->indirectBuffer.Get());
 
-                    gl.BindBuffer(GL_DISPATCH_INDIRECT_BUFFER, indirectBuffer->GetHandle());
+                    persistentPipelineState.BindBuffer(gl, GL_DISPATCH_INDIRECT_BUFFER,
+                                                       indirectBuffer->GetHandle());
                     gl.DispatchComputeIndirect(static_cast<GLintptr>(indirectBufferOffset));
                     gl.MemoryBarrier(GL_ALL_BARRIER_BITS);
                     break;
@@ -909,7 +923,7 @@ namespace dawn::native::opengl {
                 case Command::SetComputePipeline: {
                     SetComputePipelineCmd* cmd = mCommands.NextCommand<SetComputePipelineCmd>();
                     lastPipeline = ToBackend(cmd->pipeline).Get();
-                    lastPipeline->ApplyNow();
+                    lastPipeline->ApplyNow(persistentPipelineState);
 
                     bindGroupTracker.OnSetPipeline(lastPipeline);
                     break;
@@ -949,56 +963,33 @@ namespace dawn::native::opengl {
     }
 
     MaybeError CommandBuffer::ExecuteRenderPass(BeginRenderPassCmd* renderPass) {
-        const OpenGLFunctions& gl = ToBackend(GetDevice())->gl;
-        GLuint fbo = 0;
+        Device* device = ToBackend(GetDevice());
+        const OpenGLFunctions& gl = device->gl;
+        PersistentPipelineState persistentPipelineState;
 
-        // Create the framebuffer used for this render pass and calls the correct glDrawBuffers
+        // Get the framebuffer used for this render pass, with the attachments as draw buffers.
         {
-            // TODO(kainino@chromium.org): This is added to possibly work around an issue seen on
-            // Windows/Intel. It should break any feedback loop before the clears, even if there
-            // shouldn't be any negative effects from this. Investigate whether it's actually
-            // needed.
-            gl.BindFramebuffer(GL_READ_FRAMEBUFFER, 0);
-            // TODO(kainino@chromium.org): possible future optimization: create these framebuffers
-            // at Framebuffer build time (or maybe CommandBuffer build time) so they don't have to
-            // be created and destroyed at draw time.
-            gl.GenFramebuffers(1, &fbo);
-            gl.BindFramebuffer(GL_DRAW_FRAMEBUFFER, fbo);
-
-            // Mapping from attachmentSlot to GL framebuffer attachment points. Defaults to zero
-            // (GL_NONE).
-            ityp::array<ColorAttachmentIndex, GLenum, kMaxColorAttachments> drawBuffers = {};
-
-            // Construct GL framebuffer
-
-            ColorAttachmentIndex attachmentCount(uint8_t(0));
+            FramebufferCacheQuery query;
             for (ColorAttachmentIndex i :
                  IterateBitSet(renderPass->attachmentState->GetColorAttachmentsMask())) {
                 TextureViewBase* textureView = renderPass->colorAttachments[i].view.Get();
-                GLuint texture = ToBackend(textureView->GetTexture())->GetHandle();
+                const Texture* texture = ToBackend(textureView->GetTexture());
 
                 GLenum glAttachment = GL_COLOR_ATTACHMENT0 + static_cast<uint8_t>(i);
 
                 // Attach color buffers.
-                if (textureView->GetTexture()->GetArrayLayers() == 1) {
-                    GLenum target = ToBackend(textureView->GetTexture())->GetGLTarget();
-                    gl.FramebufferTexture2D(GL_DRAW_FRAMEBUFFER, glAttachment, target, texture,
-                                            textureView->GetBaseMipLevel());
+                if (texture->GetArrayLayers() == 1) {
+                    query.AddAttachment(glAttachment, texture, textureView->GetBaseMipLevel());
                 } else {
-                    gl.FramebufferTextureLayer(GL_DRAW_FRAMEBUFFER, glAttachment, texture,
-                                               textureView->GetBaseMipLevel(),
-                                               textureView->GetBaseArrayLayer());
+                    query.AddLayerAttachment(glAttachment, texture, textureView->GetBaseMipLevel(),
+                                             textureView->GetBaseArrayLayer());
                 }
-                drawBuffers[i] = glAttachment;
-                attachmentCount = i;
-                attachmentCount++;
             }
-            gl.DrawBuffers(static_cast<uint8_t>(attachmentCount), drawBuffers.data());
 
             if (renderPass->attachmentState->HasDepthStencilAttachment()) {
                 TextureViewBase* textureView = renderPass->depthStencilAttachment.view.Get();
-                GLuint texture = ToBackend(textureView->GetTexture())->GetHandle();
-                const Format& format = textureView->GetTexture()->GetFormat();
+                const Texture* texture = ToBackend(textureView->GetTexture());
+                const Format& format = texture->GetFormat();
 
                 // Attach depth/stencil buffer.
                 GLenum glAttachment = 0;
@@ -1012,27 +1003,30 @@ namespace dawn::native::opengl {
                     UNREACHABLE();
                 }
 
-                if (textureView->GetTexture()->GetArrayLayers() == 1) {
-                    GLenum target = ToBackend(textureView->GetTexture())->GetGLTarget();
-                    gl.FramebufferTexture2D(GL_DRAW_FRAMEBUFFER, glAttachment, target, texture,
-                                            textureView->GetBaseMipLevel());
+                if (texture->GetArrayLayers() == 1) {
+                    query.AddAttachment(glAttachment, texture, textureView->GetBaseMipLevel());
                 } else {
-                    gl.FramebufferTextureLayer(GL_DRAW_FRAMEBUFFER, glAttachment, texture,
-                                               textureView->GetBaseMipLevel(),
-                                               textureView->GetBaseArrayLayer());
+                    query.AddLayerAttachment(glAttachment, texture, textureView->GetBaseMipLevel(),
+                                             textureView->GetBaseArrayLayer());
                 }
             }
-        }
 
-        ASSERT(gl.CheckFramebufferStatus(GL_DRAW_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE);
+            GLuint fbo = device->GetFramebufferCache()->GetFramebuffer(query);
+
+            // TODO(kainino@chromium.org): This is added to possibly work around an issue seen on
+            // Windows/Intel. It should break any feedback loop before the clears, even if there
+            // shouldn't be any negative effects from this. Investigate whether it's actually
+            // needed.
+            persistentPipelineState.BindFramebuffer(gl, GL_READ_FRAMEBUFFER, 0);
+            persistentPipelineState.BindFramebuffer(gl, GL_DRAW_FRAMEBUFFER, fbo);
+        }
 
         // Set defaults for dynamic state before executing clears and commands.
-        PersistentPipelineState persistentPipelineState;
         persistentPipelineState.SetDefaultState(gl);
-        gl.BlendColor(0, 0, 0, 0);
-        gl.Viewport(0, 0, renderPass->width, renderPass->height);
-        gl.DepthRangef(0.0, 1.0);
-        gl.Scissor(0, 0, renderPass->width, renderPass->height);
+        persistentPipelineState.SetBlendColor(gl, {0, 0, 0, 0});
+        persistentPipelineState.SetViewport(gl, 0, 0, renderPass->width, renderPass->height);
+        persistentPipelineState.SetDepthRange(gl, 0.0, 1.0);
+        persistentPipelineState.SetScissor(gl, 0, 0, renderPass->width, renderPass->height);
 
         // Clear framebuffer attachments as needed
         {
@@ -1043,7 +1037,7 @@ namespace dawn::native::opengl {
 
                 // Load op - color
                 if (attachmentInfo->loadOp == wgpu::LoadOp::Clear) {
-                    gl.ColorMask(true, true, true, true);
+                    persistentPipelineState.SetColorMask(gl, true, true, true, true);
 
                     wgpu::TextureComponentType baseType =
                         attachmentInfo->view->GetFormat().GetAspectInfo(Aspect::Color).baseType;
@@ -1088,10 +1082,11 @@ namespace dawn::native::opengl {
                                       (attachmentInfo->stencilLoadOp == wgpu::LoadOp::Clear);
 
                 if (doDepthClear) {
-                    gl.DepthMask(GL_TRUE);
+                    persistentPipelineState.SetDepthMask(gl, GL_TRUE);
                 }
                 if (doStencilClear) {
-                    gl.StencilMask(GetStencilMaskFromStencilFormat(attachmentFormat.format));
+                    persistentPipelineState.SetStencilWriteMask(
+                        gl, GetStencilMaskFromStencilFormat(attachmentFormat.format));
                 }
 
                 if (doDepthClear && doStencilClear) {
@@ -1118,8 +1113,8 @@ namespace dawn::native::opengl {
             switch (type) {
                 case Command::Draw: {
                     DrawCmd* draw = iter->NextCommand<DrawCmd>();
-                    vertexStateBufferBindingTracker.Apply(gl);
-                    bindGroupTracker.Apply(gl);
+                    vertexStateBufferBindingTracker.Apply(gl, persistentPipelineState);
+                    bindGroupTracker.Apply(gl, persistentPipelineState);
 
                     if (draw->firstInstance > 0) {
                         gl.DrawArraysInstancedBaseInstance(
@@ -1136,8 +1131,8 @@ namespace dawn::native::opengl {
 
                 case Command::DrawIndexed: {
                     DrawIndexedCmd* draw = iter->NextCommand<DrawIndexedCmd>();
-                    vertexStateBufferBindingTracker.Apply(gl);
-                    bindGroupTracker.Apply(gl);
+                    vertexStateBufferBindingTracker.Apply(gl, persistentPipelineState);
+                    bindGroupTracker.Apply(gl, persistentPipelineState);
 
                     if (draw->firstInstance > 0) {
                         gl.DrawElementsInstancedBaseVertexBaseInstance(
@@ -1170,13 +1165,14 @@ namespace dawn::native::opengl {
 
                 case Command::DrawIndirect: {
                     DrawIndirectCmd* draw = iter->NextCommand<DrawIndirectCmd>();
-                    vertexStateBufferBindingTracker.Apply(gl);
-                    bindGroupTracker.Apply(gl);
+                    vertexStateBufferBindingTracker.Apply(gl, persistentPipelineState);
+                    bindGroupTracker.Apply(gl, persistentPipelineState);
 
                     uint64_t indirectBufferOffset = draw->indirectOffset;
                     Buffer* indirectBuffer = ToBackend(draw->indirectBuffer.Get());
 
-                    gl.BindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer->GetHandle());
+                    persistentPipelineState.BindBuffer(gl, GL_DRAW_INDIRECT_BUFFER,
+                                                       indirectBuffer->GetHandle());
                     gl.DrawArraysIndirect(
                         lastPipeline->GetGLPrimitiveTopology(),
                         reinterpret_cast<void*>(static_cast<intptr_t>(indirectBufferOffset)));
@@ -1186,13 +1182,14 @@ namespace dawn::native::opengl {
                 case Command::DrawIndexedIndirect: {
                     DrawIndexedIndirectCmd* draw = iter->NextCommand<DrawIndexedIndirectCmd>();
 
-                    vertexStateBufferBindingTracker.Apply(gl);
-                    bindGroupTracker.Apply(gl);
+                    vertexStateBufferBindingTracker.Apply(gl, persistentPipelineState);
+                    bindGroupTracker.Apply(gl, persistentPipelineState);
 
                     Buffer* indirectBuffer = ToBackend(draw->indirectBuffer.Get());
                     ASSERT(indirectBuffer != nullptr);
 
-                    gl.BindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer->GetHandle());
+                    persistentPipelineState.BindBuffer(gl, GL_DRAW_INDIRECT_BUFFER,
+                                                       indirectBuffer->GetHandle());
                     gl.DrawElementsIndirect(
                         lastPipeline->GetGLPrimitiveTopology(), indexBufferFormat,
                         reinterpret_cast<void*>(static_cast<intptr_t>(draw->indirectOffset)));
@@ -1259,9 +1256,10 @@ namespace dawn::native::opengl {
                     mCommands.NextCommand<EndRenderPassCmd>();
 
                     if (renderPass->attachmentState->GetSampleCount() > 1) {
-                        ResolveMultisampledRenderTargets(gl, renderPass);
+                        ResolveMultisampledRenderTargets(gl, device->GetFramebufferCache(),
+                                                         renderPass);
                     }
-                    gl.DeleteFramebuffers(1, &fbo);
+                    device->AddGLCallStats(persistentPipelineState.GetCallStats());
                     return {};
                 }
 
@@ -1273,29 +1271,21 @@ namespace dawn::native::opengl {
 
                 case Command::SetViewport: {
                     SetViewportCmd* cmd = mCommands.NextCommand<SetViewportCmd>();
-                    if (gl.IsAtLeastGL(4, 1)) {
-                        gl.ViewportIndexedf(0, cmd->x, cmd->y, cmd->width, cmd->height);
-                    } else {
-                        // Floating-point viewport coords are unsupported on OpenGL ES, but
-                        // truncation is ok because other APIs do not guarantee subpixel precision
-                        // either.
-                        gl.Viewport(static_cast<int>(cmd->x), static_cast<int>(cmd->y),
-                                    static_cast<int>(cmd->width), static_cast<int>(cmd->height));
-                    }
-                    gl.DepthRangef(cmd->minDepth, cmd->maxDepth);
+                    persistentPipelineState.SetViewport(gl, cmd->x, cmd->y, cmd->width,
+                                                        cmd->height);
+                    persistentPipelineState.SetDepthRange(gl, cmd->minDepth, cmd->maxDepth);
                     break;
                 }
 
                 case Command::SetScissorRect: {
                     SetScissorRectCmd* cmd = mCommands.NextCommand<SetScissorRectCmd>();
-                    gl.Scissor(cmd->x, cmd->y, cmd->width, cmd->height);
+                    persistentPipelineState.SetScissor(gl, cmd->x, cmd->y, cmd->width, cmd->height);
                     break;
                 }
 
                 case Command::SetBlendConstant: {
                     SetBlendConstantCmd* cmd = mCommands.NextCommand<SetBlendConstantCmd>();
-                    const std::array<float, 4> blendColor = ConvertToFloatColor(cmd->color);
-                    gl.BlendColor(blendColor[0], blendColor[1], blendColor[2], blendColor[3]);
+                    persistentPipelineState.SetBlendColor(gl, ConvertToFloatColor(cmd->color));
                     break;
                 }
 
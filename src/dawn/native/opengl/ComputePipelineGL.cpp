@@ -38,8 +38,8 @@ namespace dawn::native::opengl {
         return {};
     }
 
-    void ComputePipeline::ApplyNow() {
-        PipelineGL::ApplyNow(ToBackend(GetDevice())->gl);
+    void ComputePipeline::ApplyNow(PersistentPipelineState& persistentPipelineState) {
+        PipelineGL::ApplyNow(ToBackend(GetDevice())->gl, persistentPipelineState);
     }
 
 }  // namespace dawn::native::opengl
@@ -24,6 +24,7 @@
 namespace dawn::native::opengl {
 
     class Device;
+    class PersistentPipelineState;
 
     class ComputePipeline final : public ComputePipelineBase, public PipelineGL {
       public:
@@ -31,7 +32,7 @@ namespace dawn::native::opengl {
             Device* device,
             const ComputePipelineDescriptor* descriptor);
 
-        void ApplyNow();
+        void ApplyNow(PersistentPipelineState& persistentPipelineState);
 
         MaybeError Initialize() override;
 
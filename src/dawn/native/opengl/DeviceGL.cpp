@@ -23,12 +23,14 @@
 #include "dawn/native/opengl/BufferGL.h"
 #include "dawn/native/opengl/CommandBufferGL.h"
 #include "dawn/native/opengl/ComputePipelineGL.h"
+#include "dawn/native/opengl/FramebufferCacheGL.h"
 #include "dawn/native/opengl/PipelineLayoutGL.h"
 #include "dawn/native/opengl/QuerySetGL.h"
 #include "dawn/native/opengl/QueueGL.h"
 #include "dawn/native/opengl/RenderPipelineGL.h"
 #include "dawn/native/opengl/SamplerGL.h"
 #include "dawn/native/opengl/ShaderModuleGL.h"
+#include "dawn/native/opengl/StagingBufferGL.h"
 #include "dawn/native/opengl/SwapChainGL.h"
 #include "dawn/native/opengl/TextureGL.h"
 
@@ -56,6 +58,7 @@ namespace dawn::native::opengl {
     MaybeError Device::Initialize() {
         InitTogglesFromDriver();
         mFormatTable = BuildGLFormatTable();
+        mFramebufferCache = std::make_unique<FramebufferCache>(this);
 
         return DeviceBase::Initialize(new Queue(this));
     }
@@ -74,6 +77,10 @@ namespace dawn::native::opengl {
         bool supportsDepthStencilRead =
             gl.IsAtLeastGL(3, 0) || gl.IsGLExtensionSupported("GL_NV_read_depth_stencil");
 
+        // TODO(crbug.com/dawn/343): Also use GL_EXT_buffer_storage on OpenGL ES once its procs
+        // are loaded.
+        bool supportsBufferStorage = gl.IsAtLeastGL(4, 4);
+
         bool supportsSampleVariables = gl.IsAtLeastGL(4, 0) || gl.IsAtLeastGLES(3, 2) ||
                                        gl.IsGLExtensionSupported("GL_OES_sample_variables");
 
@@ -98,6 +105,7 @@ namespace dawn::native::opengl {
         SetToggle(Toggle::DisableSnormRead, !supportsSnormRead);
         SetToggle(Toggle::DisableDepthStencilRead, !supportsDepthStencilRead);
         SetToggle(Toggle::DisableSampleVariables, !supportsSampleVariables);
+        SetToggle(Toggle::DisablePersistentlyMappedUploads, !supportsBufferStorage);
         SetToggle(Toggle::FlushBeforeClientWaitSync, gl.GetVersion().IsES());
         // For OpenGL ES, we must use dummy fragment shader for vertex-only render pipeline.
         SetToggle(Toggle::UseDummyFragmentInVertexOnlyPipeline, gl.GetVersion().IsES());
@@ -237,7 +245,16 @@ namespace dawn::native::opengl {
         return new Texture(this, textureDescriptor, tex, TextureBase::TextureState::OwnedInternal);
     }
 
+    void Device::FencePendingUploads() {
+        // The copies from the staging buffers are issued outside of a submit. Fence them so that
+        // their serial completes only once the GPU read the staging memory.
+        if (GetFutureSerial() > GetLastSubmittedCommandSerial()) {
+            SubmitFenceSync();
+        }
+    }
+
     MaybeError Device::TickImpl() {
+        FencePendingUploads();
         return {};
     }
 
@@ -269,8 +286,20 @@ namespace dawn::native::opengl {
         return fenceSerial;
     }
 
+    bool Device::UsesPersistentlyMappedUploads() const {
+        return !IsToggleEnabled(Toggle::DisablePersistentlyMappedUploads) &&
+               gl.IsAtLeastGL(4, 4);
+    }
+
     ResultOrError<std::unique_ptr<StagingBufferBase>> Device::CreateStagingBuffer(size_t size) {
-        return DAWN_UNIMPLEMENTED_ERROR("Device unable to create staging buffer.");
+        if (!UsesPersistentlyMappedUploads()) {
+            return DAWN_UNIMPLEMENTED_ERROR("Device unable to create staging buffer.");
+        }
+
+        std::unique_ptr<StagingBufferBase> stagingBuffer =
+            std::make_unique<StagingBuffer>(size, this);
+        DAWN_TRY(stagingBuffer->Initialize());
+        return std::move(stagingBuffer);
     }
 
     MaybeError Device::CopyFromStagingToBuffer(StagingBufferBase* source,
@@ -278,7 +307,16 @@ namespace dawn::native::opengl {
                                                BufferBase* destination,
                                                uint64_t destinationOffset,
                                                uint64_t size) {
-        return DAWN_UNIMPLEMENTED_ERROR("Device unable to copy from staging buffer.");
+        ASSERT(UsesPersistentlyMappedUploads());
+
+        ToBackend(destination)->EnsureDataInitializedAsDestination(destinationOffset, size);
+
+        // The staging memory is mapped coherently so the copy sees the CPU writes done before it.
+        gl.BindBuffer(GL_COPY_READ_BUFFER, ToBackend(source)->GetHandle());
+        gl.BindBuffer(GL_COPY_WRITE_BUFFER, ToBackend(destination)->GetHandle());
+        gl.CopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, sourceOffset,
+                             destinationOffset, size);
+        return {};
     }
 
     MaybeError Device::CopyFromStagingToTexture(const StagingBufferBase* source,
@@ -290,9 +328,12 @@ namespace dawn::native::opengl {
 
     void Device::DestroyImpl() {
         ASSERT(GetState() == State::Disconnected);
+
+        mFramebufferCache = nullptr;
     }
 
     MaybeError Device::WaitForIdleForDestruction() {
+        FencePendingUploads();
         gl.Finish();
         DAWN_TRY(CheckPassedSerials());
         ASSERT(mFencesInFlight.empty());
@@ -312,4 +353,16 @@ namespace dawn::native::opengl {
         return 1.0f;
     }
 
+    FramebufferCache* Device::GetFramebufferCache() const {
+        return mFramebufferCache.get();
+    }
+
+    void Device::AddGLCallStats(const GLCallStats& stats) {
+        mGLCallStats += stats;
+    }
+
+    GLCallStats Device::GetGLCallStats() const {
+        return mGLCallStats;
+    }
+
 }  // namespace dawn::native::opengl
@@ -23,7 +23,9 @@
 #include "dawn/native/opengl/Forward.h"
 #include "dawn/native/opengl/GLFormat.h"
 #include "dawn/native/opengl/OpenGLFunctions.h"
+#include "dawn/native/opengl/PersistentPipelineStateGL.h"
 
+#include <memory>
 #include <queue>
 
 // Remove windows.h macros after glad's include of windows.h
@@ -35,6 +37,8 @@ typedef void* EGLImage;
 
 namespace dawn::native::opengl {
 
+    class FramebufferCache;
+
     class Device final : public DeviceBase {
       public:
         static ResultOrError<Ref<Device>> Create(AdapterBase* adapter,
@@ -79,6 +83,16 @@ namespace dawn::native::opengl {
 
         float GetTimestampPeriodInNS() const override;
 
+        FramebufferCache* GetFramebufferCache() const;
+
+        // Whether the uploads of Queue::WriteBuffer, of the WriteBuffer commands and of the buffers
+        // mapped for writing go through persistently mapped staging buffers.
+        bool UsesPersistentlyMappedUploads() const;
+
+        // The GL calls issued and elided by the state shadowing of all the passes executed.
+        void AddGLCallStats(const GLCallStats& stats);
+        GLCallStats GetGLCallStats() const;
+
       private:
         Device(AdapterBase* adapter,
                const DeviceDescriptor* descriptor,
@@ -117,6 +131,7 @@ namespace dawn::native::opengl {
             const RenderPipelineDescriptor* descriptor) override;
 
         void InitTogglesFromDriver();
+        void FencePendingUploads();
         ResultOrError<ExecutionSerial> CheckAndUpdateCompletedSerials() override;
         void DestroyImpl() override;
         MaybeError WaitForIdleForDestruction() override;
@@ -124,6 +139,10 @@ namespace dawn::native::opengl {
         std::queue<std::pair<GLsync, ExecutionSerial>> mFencesInFlight;
 
         GLFormatTable mFormatTable;
+
+        std::unique_ptr<FramebufferCache> mFramebufferCache;
+
+        GLCallStats mGLCallStats;
     };
 
 }  // namespace dawn::native::opengl
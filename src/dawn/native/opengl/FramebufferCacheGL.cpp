@@ -0,0 +1,199 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/native/opengl/FramebufferCacheGL.h"
+
+#include "dawn/common/Assert.h"
+#include "dawn/common/HashUtils.h"
+#include "dawn/native/opengl/DeviceGL.h"
+#include "dawn/native/opengl/TextureGL.h"
+
+#include <algorithm>
+
+namespace dawn::native::opengl {
+
+    void FramebufferCacheQuery::AddAttachment(GLenum attachmentPoint,
+                                              const Texture* texture,
+                                              GLint level) {
+        AddLayerAttachment(attachmentPoint, texture, level, -1);
+    }
+
+    void FramebufferCacheQuery::AddLayerAttachment(GLenum attachmentPoint,
+                                                   const Texture* texture,
+                                                   GLint level,
+                                                   GLint layer) {
+        ASSERT(attachmentCount < kMaxFramebufferAttachments);
+        attachments[attachmentCount] = {attachmentPoint, texture, level, layer};
+        attachmentCount++;
+    }
+
+    // FramebufferCache
+
+    FramebufferCache::FramebufferCache(Device* device) : mDevice(device) {
+    }
+
+    FramebufferCache::~FramebufferCache() {
+        for (const auto& [key, framebuffer] : mCache) {
+            mDevice->gl.DeleteFramebuffers(1, &framebuffer);
+        }
+        mCache.clear();
+        mKeysPerTexture.clear();
+    }
+
+    GLuint FramebufferCache::GetFramebuffer(const FramebufferCacheQuery& query) {
+        auto it = mCache.find(query);
+        if (it != mCache.end()) {
+            mHits++;
+            return it->second;
+        }
+
+        GLuint framebuffer = CreateFramebuffer(query);
+        mCache.emplace(query, framebuffer);
+        for (uint32_t i = 0; i < query.attachmentCount; ++i) {
+            const Texture* texture = query.attachments[i].texture;
+            bool isFirstUse = std::none_of(query.attachments.begin(),
+                                           query.attachments.begin() + i,
+                                           [&](const FramebufferCacheQuery::Attachment& other) {
+                                               return other.texture == texture;
+                                           });
+            if (isFirstUse) {
+                mKeysPerTexture[texture].push_back(query);
+            }
+        }
+
+        mMisses++;
+        return framebuffer;
+    }
+
+    void FramebufferCache::EvictFramebuffersUsing(const Texture* texture) {
+        auto textureIt = mKeysPerTexture.find(texture);
+        if (textureIt == mKeysPerTexture.end()) {
+            return;
+        }
+        std::vector<FramebufferCacheQuery> keys = std::move(textureIt->second);
+        mKeysPerTexture.erase(textureIt);
+
+        for (const FramebufferCacheQuery& key : keys) {
+            auto it = mCache.find(key);
+            ASSERT(it != mCache.end());
+
+            // GL keeps the framebuffer alive until the commands using it are done.
+            mDevice->gl.DeleteFramebuffers(1, &it->second);
+            mCache.erase(it);
+
+            // Forget the deleted framebuffer for the other textures it used.
+            for (uint32_t i = 0; i < key.attachmentCount; ++i) {
+                const Texture* otherTexture = key.attachments[i].texture;
+                if (otherTexture == texture) {
+                    continue;
+                }
+
+                auto otherIt = mKeysPerTexture.find(otherTexture);
+                if (otherIt == mKeysPerTexture.end()) {
+                    continue;
+                }
+                std::vector<FramebufferCacheQuery>& otherKeys = otherIt->second;
+                auto keyIt = std::find_if(otherKeys.begin(), otherKeys.end(),
+                                          [&](const FramebufferCacheQuery& other) {
+                                              return CacheFuncs()(key, other);
+                                          });
+                if (keyIt != otherKeys.end()) {
+                    otherKeys.erase(keyIt);
+                }
+                if (otherKeys.empty()) {
+                    mKeysPerTexture.erase(otherIt);
+                }
+            }
+        }
+    }
+
+    FramebufferCache::Stats FramebufferCache::GetStats() const {
+        Stats stats;
+        stats.hits = mHits;
+        stats.misses = mMisses;
+        stats.framebufferCount = static_cast<uint32_t>(mCache.size());
+        return stats;
+    }
+
+    GLuint FramebufferCache::CreateFramebuffer(const FramebufferCacheQuery& query) const {
+        const OpenGLFunctions& gl = mDevice->gl;
+
+        GLuint framebuffer = 0;
+        gl.GenFramebuffers(1, &framebuffer);
+        gl.BindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffer);
+
+        // Mapping from color attachment index to GL framebuffer attachment points. Defaults to
+        // zero (GL_NONE).
+        std::array<GLenum, kMaxColorAttachments> drawBuffers = {};
+        uint32_t drawBufferCount = 0;
+
+        for (uint32_t i = 0; i < query.attachmentCount; ++i) {
+            const FramebufferCacheQuery::Attachment& attachment = query.attachments[i];
+            GLuint handle = attachment.texture->GetHandle();
+            if (attachment.layer < 0) {
+                gl.FramebufferTexture2D(GL_DRAW_FRAMEBUFFER, attachment.attachmentPoint,
+                                        attachment.texture->GetGLTarget(), handle,
+                                        attachment.level);
+            } else {
+                gl.FramebufferTextureLayer(GL_DRAW_FRAMEBUFFER, attachment.attachmentPoint,
+                                           handle, attachment.level, attachment.layer);
+            }
+
+            if (attachment.attachmentPoint >= GL_COLOR_ATTACHMENT0 &&
+                attachment.attachmentPoint < GL_COLOR_ATTACHMENT0 + kMaxColorAttachments) {
+                uint32_t index = attachment.attachmentPoint - GL_COLOR_ATTACHMENT0;
+                drawBuffers[index] = attachment.attachmentPoint;
+                drawBufferCount = std::max(drawBufferCount, index + 1);
+            }
+        }
+        gl.DrawBuffers(drawBufferCount, drawBuffers.data());
+
+        // The attachments of a cached framebuffer never change, so its completeness only needs
+        // to be checked once.
+        ASSERT(gl.CheckFramebufferStatus(GL_DRAW_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE);
+
+        return framebuffer;
+    }
+
+    size_t FramebufferCache::CacheFuncs::operator()(const FramebufferCacheQuery& query) const {
+        size_t hash = Hash(query.attachmentCount);
+        for (uint32_t i = 0; i < query.attachmentCount; ++i) {
+            const FramebufferCacheQuery::Attachment& attachment = query.attachments[i];
+            HashCombine(&hash, attachment.attachmentPoint, attachment.texture, attachment.level,
+                        attachment.layer);
+        }
+        return hash;
+    }
+
+    bool FramebufferCache::CacheFuncs::operator()(const FramebufferCacheQuery& a,
+                                                  const FramebufferCacheQuery& b) const {
+        if (a.attachmentCount != b.attachmentCount) {
+            return false;
+        }
+
+        for (uint32_t i = 0; i < a.attachmentCount; ++i) {
+            const FramebufferCacheQuery::Attachment& attachmentA = a.attachments[i];
+            const FramebufferCacheQuery::Attachment& attachmentB = b.attachments[i];
+            if (attachmentA.attachmentPoint != attachmentB.attachmentPoint ||
+                attachmentA.texture != attachmentB.texture ||
+                attachmentA.level != attachmentB.level ||
+                attachmentA.layer != attachmentB.layer) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+}  // namespace dawn::native::opengl
@@ -0,0 +1,101 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_OPENGL_FRAMEBUFFERCACHEGL_H_
+#define DAWNNATIVE_OPENGL_FRAMEBUFFERCACHEGL_H_
+
+#include "dawn/common/Constants.h"
+#include "dawn/common/NonCopyable.h"
+#include "dawn/native/opengl/opengl_platform.h"
+
+#include <array>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace dawn::native::opengl {
+
+    class Device;
+    class Texture;
+
+    // Color attachments and the depth-stencil attachment.
+    static constexpr uint32_t kMaxFramebufferAttachments = kMaxColorAttachments + 1;
+
+    // This is a key to query the FramebufferCache. Each attachment is a single mip level of a
+    // texture and, for textures with layers, a single layer.
+    struct FramebufferCacheQuery {
+        // Attaches the level with glFramebufferTexture2D.
+        void AddAttachment(GLenum attachmentPoint, const Texture* texture, GLint level);
+        // Attaches the layer of the level with glFramebufferTextureLayer.
+        void AddLayerAttachment(GLenum attachmentPoint,
+                                const Texture* texture,
+                                GLint level,
+                                GLint layer);
+
+        struct Attachment {
+            GLenum attachmentPoint;
+            const Texture* texture;
+            GLint level;
+            // The layer attached with glFramebufferTextureLayer, or -1.
+            GLint layer;
+        };
+        uint32_t attachmentCount = 0;
+        std::array<Attachment, kMaxFramebufferAttachments> attachments;
+    };
+
+    // Caches framebuffer objects so that render passes and copies on the same subresources don't
+    // create a new framebuffer and check its completeness each time. The framebuffers using a
+    // texture are deleted when the texture is destroyed.
+    class FramebufferCache : public NonCopyable {
+      public:
+        explicit FramebufferCache(Device* device);
+        ~FramebufferCache();
+
+        // Returns a framebuffer with the attachments of |query| and its color attachments as draw
+        // buffers. Creating it changes the GL_DRAW_FRAMEBUFFER binding.
+        GLuint GetFramebuffer(const FramebufferCacheQuery& query);
+
+        // Deletes the framebuffers that use |texture|. Called when |texture| is destroyed.
+        void EvictFramebuffersUsing(const Texture* texture);
+
+        struct Stats {
+            uint64_t hits = 0;
+            uint64_t misses = 0;
+            uint32_t framebufferCount = 0;
+        };
+        Stats GetStats() const;
+
+      private:
+        GLuint CreateFramebuffer(const FramebufferCacheQuery& query) const;
+
+        // Implements the functors necessary for to use queries as unordered_map keys.
+        struct CacheFuncs {
+            size_t operator()(const FramebufferCacheQuery& query) const;
+            bool operator()(const FramebufferCacheQuery& a, const FramebufferCacheQuery& b) const;
+        };
+        using Cache = std::unordered_map<FramebufferCacheQuery, GLuint, CacheFuncs, CacheFuncs>;
+
+        Device* mDevice = nullptr;
+
+        Cache mCache;
+        // The keys of the framebuffers that use each texture.
+        std::unordered_map<const Texture*, std::vector<FramebufferCacheQuery>> mKeysPerTexture;
+
+        uint64_t mHits = 0;
+        uint64_t mMisses = 0;
+    };
+
+}  // namespace dawn::native::opengl
+
+#endif  // DAWNNATIVE_OPENGL_FRAMEBUFFERCACHEGL_H_
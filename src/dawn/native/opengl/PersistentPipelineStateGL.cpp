@@ -14,14 +14,244 @@
 
 #include "dawn/native/opengl/PersistentPipelineStateGL.h"
 
+#include "dawn/common/Assert.h"
 #include "dawn/native/opengl/OpenGLFunctions.h"
 
 namespace dawn::native::opengl {
 
+    GLCallStats& GLCallStats::operator+=(const GLCallStats& other) {
+        issuedCallCount += other.issuedCallCount;
+        elidedCallCount += other.elidedCallCount;
+        return *this;
+    }
+
     void PersistentPipelineState::SetDefaultState(const OpenGLFunctions& gl) {
         CallGLStencilFunc(gl);
     }
 
+    template <typename T>
+    bool PersistentPipelineState::Update(std::optional<T>* shadow,
+                                         const T& value,
+                                         uint32_t callCount) {
+        if (*shadow == value) {
+            mCallStats.elidedCallCount += callCount;
+            return false;
+        }
+
+        *shadow = value;
+        mCallStats.issuedCallCount += callCount;
+        return true;
+    }
+
+    template <typename T>
+    std::optional<T>* PersistentPipelineState::GetIndexed(std::vector<std::optional<T>>* shadows,
+                                                          GLuint index) {
+        if (index >= shadows->size()) {
+            shadows->resize(index + 1);
+        }
+        return &(*shadows)[index];
+    }
+
+    void PersistentPipelineState::UseProgram(const OpenGLFunctions& gl, GLuint program) {
+        if (Update(&mProgram, program)) {
+            gl.UseProgram(program);
+        }
+    }
+
+    void PersistentPipelineState::BindVertexArray(const OpenGLFunctions& gl, GLuint vertexArray) {
+        if (Update(&mVertexArray, vertexArray)) {
+            gl.BindVertexArray(vertexArray);
+            mElementArrayBuffer.reset();
+        }
+    }
+
+    void PersistentPipelineState::BindBuffer(const OpenGLFunctions& gl,
+                                             GLenum target,
+                                             GLuint buffer) {
+        std::optional<GLuint>* shadow = nullptr;
+        switch (target) {
+            case GL_ARRAY_BUFFER:
+                shadow = &mArrayBuffer;
+                break;
+            case GL_ELEMENT_ARRAY_BUFFER:
+                shadow = &mElementArrayBuffer;
+                break;
+            case GL_DRAW_INDIRECT_BUFFER:
+                shadow = &mDrawIndirectBuffer;
+                break;
+            case GL_DISPATCH_INDIRECT_BUFFER:
+                shadow = &mDispatchIndirectBuffer;
+                break;
+            default:
+                UNREACHABLE();
+        }
+
+        if (Update(shadow, buffer)) {
+            gl.BindBuffer(target, buffer);
+        }
+    }
+
+    void PersistentPipelineState::BindBufferRange(const OpenGLFunctions& gl,
+                                                  GLenum target,
+                                                  GLuint index,
+                                                  GLuint buffer,
+                                                  GLintptr offset,
+                                                  GLsizeiptr size) {
+        std::vector<std::optional<BufferRange>>* shadows = nullptr;
+        switch (target) {
+            case GL_UNIFORM_BUFFER:
+                shadows = &mUniformBuffers;
+                break;
+            case GL_SHADER_STORAGE_BUFFER:
+                shadows = &mStorageBuffers;
+                break;
+            default:
+                UNREACHABLE();
+        }
+
+        if (Update(GetIndexed(shadows, index), BufferRange(buffer, offset, size))) {
+            gl.BindBufferRange(target, index, buffer, offset, size);
+        }
+    }
+
+    void PersistentPipelineState::BindSampler(const OpenGLFunctions& gl,
+                                              GLuint unit,
+                                              GLuint sampler) {
+        if (Update(GetIndexed(&mSamplers, unit), sampler)) {
+            gl.BindSampler(unit, sampler);
+        }
+    }
+
+    void PersistentPipelineState::BindTexture(const OpenGLFunctions& gl,
+                                              GLuint unit,
+                                              GLenum target,
+                                              GLuint texture) {
+        if (Update(GetIndexed(&mTextures, unit), TextureBinding(target, texture))) {
+            SetActiveTexture(gl, unit);
+            gl.BindTexture(target, texture);
+        }
+    }
+
+    void PersistentPipelineState::SetActiveTexture(const OpenGLFunctions& gl, GLuint unit) {
+        if (Update(&mActiveTextureUnit, unit)) {
+            gl.ActiveTexture(GL_TEXTURE0 + unit);
+        }
+    }
+
+    void PersistentPipelineState::BindImageTexture(const OpenGLFunctions& gl,
+                                                   GLuint unit,
+                                                   GLuint texture,
+                                                   GLint level,
+                                                   GLboolean layered,
+                                                   GLint layer,
+                                                   GLenum access,
+                                                   GLenum format) {
+        if (Update(GetIndexed(&mImages, unit),
+                   ImageBinding(texture, level, layered, layer, access, format))) {
+            gl.BindImageTexture(unit, texture, level, layered, layer, access, format);
+        }
+    }
+
+    void PersistentPipelineState::BindFramebuffer(const OpenGLFunctions& gl,
+                                                  GLenum target,
+                                                  GLuint framebuffer) {
+        switch (target) {
+            case GL_DRAW_FRAMEBUFFER:
+                if (Update(&mDrawFramebuffer, framebuffer)) {
+                    gl.BindFramebuffer(target, framebuffer);
+                }
+                break;
+            case GL_READ_FRAMEBUFFER:
+                if (Update(&mReadFramebuffer, framebuffer)) {
+                    gl.BindFramebuffer(target, framebuffer);
+                }
+                break;
+            default:
+                UNREACHABLE();
+        }
+    }
+
+    void PersistentPipelineState::SetEnabled(const OpenGLFunctions& gl,
+                                             GLenum capability,
+                                             bool enabled) {
+        std::optional<bool>* shadow = nullptr;
+        switch (capability) {
+            case GL_CULL_FACE:
+                shadow = &mCullFaceEnabled;
+                break;
+            case GL_DEPTH_TEST:
+                shadow = &mDepthTestEnabled;
+                break;
+            case GL_STENCIL_TEST:
+                shadow = &mStencilTestEnabled;
+                break;
+            case GL_POLYGON_OFFSET_FILL:
+                shadow = &mPolygonOffsetFillEnabled;
+                break;
+            case GL_SAMPLE_ALPHA_TO_COVERAGE:
+                shadow = &mSampleAlphaToCoverageEnabled;
+                break;
+            default:
+                UNREACHABLE();
+        }
+
+        if (!Update(shadow, enabled)) {
+            return;
+        }
+        if (enabled) {
+            gl.Enable(capability);
+        } else {
+            gl.Disable(capability);
+        }
+    }
+
+    void PersistentPipelineState::SetFrontFace(const OpenGLFunctions& gl, GLenum frontFace) {
+        if (Update(&mFrontFace, frontFace)) {
+            gl.FrontFace(frontFace);
+        }
+    }
+
+    void PersistentPipelineState::SetCullFace(const OpenGLFunctions& gl, GLenum cullFace) {
+        if (Update(&mCullFace, cullFace)) {
+            gl.CullFace(cullFace);
+        }
+    }
+
+    void PersistentPipelineState::SetPolygonOffset(const OpenGLFunctions& gl,
+                                                   float slopeScale,
+                                                   float depthBias,
+                                                   float depthBiasClamp) {
+        if (gl.PolygonOffsetClamp == nullptr) {
+            depthBiasClamp = 0.0f;
+        }
+        if (!Update(&mPolygonOffset, std::make_tuple(slopeScale, depthBias, depthBiasClamp))) {
+            return;
+        }
+        if (gl.PolygonOffsetClamp != nullptr) {
+            gl.PolygonOffsetClamp(slopeScale, depthBias, depthBiasClamp);
+        } else {
+            gl.PolygonOffset(slopeScale, depthBias);
+        }
+    }
+
+    void PersistentPipelineState::SetSampleMask(const OpenGLFunctions& gl, GLbitfield sampleMask) {
+        if (Update(&mSampleMask, sampleMask)) {
+            gl.SampleMaski(0, sampleMask);
+        }
+    }
+
+    void PersistentPipelineState::SetDepthMask(const OpenGLFunctions& gl, GLboolean depthMask) {
+        if (Update(&mDepthMask, depthMask)) {
+            gl.DepthMask(depthMask);
+        }
+    }
+
+    void PersistentPipelineState::SetDepthFunc(const OpenGLFunctions& gl, GLenum depthFunc) {
+        if (Update(&mDepthFunc, depthFunc)) {
+            gl.DepthFunc(depthFunc);
+        }
+    }
+
     void PersistentPipelineState::SetStencilFuncsAndMask(const OpenGLFunctions& gl,
                                                          GLenum stencilBackCompareFunction,
                                                          GLenum stencilFrontCompareFunction,
@@ -29,6 +259,7 @@ namespace dawn::native::opengl {
         if (mStencilBackCompareFunction == stencilBackCompareFunction &&
             mStencilFrontCompareFunction == stencilFrontCompareFunction &&
             mStencilReadMask == stencilReadMask) {
+            mCallStats.elidedCallCount += 2;
             return;
         }
 
@@ -41,6 +272,7 @@ namespace dawn::native::opengl {
     void PersistentPipelineState::SetStencilReference(const OpenGLFunctions& gl,
                                                       uint32_t stencilReference) {
         if (mStencilReference == stencilReference) {
+            mCallStats.elidedCallCount += 2;
             return;
         }
 
@@ -48,11 +280,173 @@ namespace dawn::native::opengl {
         CallGLStencilFunc(gl);
     }
 
+    void PersistentPipelineState::SetStencilOp(const OpenGLFunctions& gl,
+                                               GLenum face,
+                                               GLenum stencilFail,
+                                               GLenum depthFail,
+                                               GLenum pass) {
+        ASSERT(face == GL_BACK || face == GL_FRONT);
+        std::optional<StencilOps>* shadow = face == GL_BACK ? &mStencilBackOps : &mStencilFrontOps;
+        if (Update(shadow, StencilOps(stencilFail, depthFail, pass))) {
+            gl.StencilOpSeparate(face, stencilFail, depthFail, pass);
+        }
+    }
+
+    void PersistentPipelineState::SetStencilWriteMask(const OpenGLFunctions& gl,
+                                                      GLuint stencilWriteMask) {
+        if (Update(&mStencilWriteMask, stencilWriteMask)) {
+            gl.StencilMask(stencilWriteMask);
+        }
+    }
+
+    void PersistentPipelineState::SetBlendEnabled(const OpenGLFunctions& gl, bool enabled) {
+        if (!Update(&mBlendEnabled, enabled)) {
+            return;
+        }
+        mDrawBufferBlendEnabled.fill(enabled);
+        if (enabled) {
+            gl.Enable(GL_BLEND);
+        } else {
+            gl.Disable(GL_BLEND);
+        }
+    }
+
+    void PersistentPipelineState::SetBlendEnabled(const OpenGLFunctions& gl,
+                                                  GLuint drawBuffer,
+                                                  bool enabled) {
+        if (!Update(&mDrawBufferBlendEnabled[drawBuffer], enabled)) {
+            return;
+        }
+        mBlendEnabled.reset();
+        if (enabled) {
+            gl.Enablei(GL_BLEND, drawBuffer);
+        } else {
+            gl.Disablei(GL_BLEND, drawBuffer);
+        }
+    }
+
+    void PersistentPipelineState::SetBlendEquation(const OpenGLFunctions& gl,
+                                                   GLenum colorMode,
+                                                   GLenum alphaMode) {
+        BlendEquation equation(colorMode, alphaMode);
+        if (Update(&mBlendEquation, equation)) {
+            mDrawBufferBlendEquation.fill(equation);
+            gl.BlendEquationSeparate(colorMode, alphaMode);
+        }
+    }
+
+    void PersistentPipelineState::SetBlendEquation(const OpenGLFunctions& gl,
+                                                   GLuint drawBuffer,
+                                                   GLenum colorMode,
+                                                   GLenum alphaMode) {
+        if (Update(&mDrawBufferBlendEquation[drawBuffer], BlendEquation(colorMode, alphaMode))) {
+            mBlendEquation.reset();
+            gl.BlendEquationSeparatei(drawBuffer, colorMode, alphaMode);
+        }
+    }
+
+    void PersistentPipelineState::SetBlendFunc(const OpenGLFunctions& gl,
+                                               GLenum srcColor,
+                                               GLenum dstColor,
+                                               GLenum srcAlpha,
+                                               GLenum dstAlpha) {
+        BlendFunc func(srcColor, dstColor, srcAlpha, dstAlpha);
+        if (Update(&mBlendFunc, func)) {
+            mDrawBufferBlendFunc.fill(func);
+            gl.BlendFuncSeparate(srcColor, dstColor, srcAlpha, dstAlpha);
+        }
+    }
+
+    void PersistentPipelineState::SetBlendFunc(const OpenGLFunctions& gl,
+                                               GLuint drawBuffer,
+                                               GLenum srcColor,
+                                               GLenum dstColor,
+                                               GLenum srcAlpha,
+                                               GLenum dstAlpha) {
+        if (Update(&mDrawBufferBlendFunc[drawBuffer],
+                   BlendFunc(srcColor, dstColor, srcAlpha, dstAlpha))) {
+            mBlendFunc.reset();
+            gl.BlendFuncSeparatei(drawBuffer, srcColor, dstColor, srcAlpha, dstAlpha);
+        }
+    }
+
+    void PersistentPipelineState::SetColorMask(const OpenGLFunctions& gl,
+                                               bool red,
+                                               bool green,
+                                               bool blue,
+                                               bool alpha) {
+        ColorMask mask(red, green, blue, alpha);
+        if (Update(&mColorMask, mask)) {
+            mDrawBufferColorMask.fill(mask);
+            gl.ColorMask(red, green, blue, alpha);
+        }
+    }
+
+    void PersistentPipelineState::SetColorMask(const OpenGLFunctions& gl,
+                                               GLuint drawBuffer,
+                                               bool red,
+                                               bool green,
+                                               bool blue,
+                                               bool alpha) {
+        if (Update(&mDrawBufferColorMask[drawBuffer], ColorMask(red, green, blue, alpha))) {
+            mColorMask.reset();
+            gl.ColorMaski(drawBuffer, red, green, blue, alpha);
+        }
+    }
+
+    void PersistentPipelineState::SetBlendColor(const OpenGLFunctions& gl,
+                                                const std::array<float, 4>& blendColor) {
+        if (Update(&mBlendColor, blendColor)) {
+            gl.BlendColor(blendColor[0], blendColor[1], blendColor[2], blendColor[3]);
+        }
+    }
+
+    void PersistentPipelineState::SetViewport(const OpenGLFunctions& gl,
+                                              float x,
+                                              float y,
+                                              float width,
+                                              float height) {
+        if (!Update(&mViewport, {x, y, width, height})) {
+            return;
+        }
+        if (gl.IsAtLeastGL(4, 1)) {
+            gl.ViewportIndexedf(0, x, y, width, height);
+        } else {
+            // Floating-point viewport coords are unsupported on OpenGL ES, but truncation is ok
+            // because other APIs do not guarantee subpixel precision either.
+            gl.Viewport(static_cast<int>(x), static_cast<int>(y), static_cast<int>(width),
+                        static_cast<int>(height));
+        }
+    }
+
+    void PersistentPipelineState::SetDepthRange(const OpenGLFunctions& gl,
+                                                float minDepth,
+                                                float maxDepth) {
+        if (Update(&mDepthRange, std::make_tuple(minDepth, maxDepth))) {
+            gl.DepthRangef(minDepth, maxDepth);
+        }
+    }
+
+    void PersistentPipelineState::SetScissor(const OpenGLFunctions& gl,
+                                             GLint x,
+                                             GLint y,
+                                             GLsizei width,
+                                             GLsizei height) {
+        if (Update(&mScissor, std::make_tuple(x, y, width, height))) {
+            gl.Scissor(x, y, width, height);
+        }
+    }
+
+    const GLCallStats& PersistentPipelineState::GetCallStats() const {
+        return mCallStats;
+    }
+
     void PersistentPipelineState::CallGLStencilFunc(const OpenGLFunctions& gl) {
         gl.StencilFuncSeparate(GL_BACK, mStencilBackCompareFunction, mStencilReference,
                                mStencilReadMask);
         gl.StencilFuncSeparate(GL_FRONT, mStencilFrontCompareFunction, mStencilReference,
                                mStencilReadMask);
+        mCallStats.issuedCallCount += 2;
     }
 
 }  // namespace dawn::native::opengl
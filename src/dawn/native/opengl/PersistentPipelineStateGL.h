@@ -15,29 +15,198 @@
 #ifndef DAWNNATIVE_OPENGL_PERSISTENTPIPELINESTATEGL_H_
 #define DAWNNATIVE_OPENGL_PERSISTENTPIPELINESTATEGL_H_
 
+#include "dawn/common/Constants.h"
 #include "dawn/native/dawn_platform.h"
 #include "dawn/native/opengl/opengl_platform.h"
 
+#include <array>
+#include <optional>
+#include <tuple>
+#include <vector>
+
 namespace dawn::native::opengl {
 
     struct OpenGLFunctions;
 
+    // The number of GL calls made through a PersistentPipelineState, split between the calls that
+    // were issued and the ones that were elided because they wouldn't have changed the state.
+    struct GLCallStats {
+        uint64_t issuedCallCount = 0;
+        uint64_t elidedCallCount = 0;
+
+        GLCallStats& operator+=(const GLCallStats& other);
+    };
+
+    // Shadows the GL state set while executing a pass so that calls that would set the state to
+    // its current value are skipped. The state starts unknown, so the first call setting each
+    // piece of state is always issued. The shadow is only valid as long as all the calls changing
+    // the state it tracks go through it.
     class PersistentPipelineState {
       public:
         void SetDefaultState(const OpenGLFunctions& gl);
+
+        // Bindings
+        void UseProgram(const OpenGLFunctions& gl, GLuint program);
+        void BindVertexArray(const OpenGLFunctions& gl, GLuint vertexArray);
+        // |target| is one of the non-indexed buffer targets used in passes: GL_ARRAY_BUFFER,
+        // GL_ELEMENT_ARRAY_BUFFER, GL_DRAW_INDIRECT_BUFFER or GL_DISPATCH_INDIRECT_BUFFER.
+        void BindBuffer(const OpenGLFunctions& gl, GLenum target, GLuint buffer);
+        // |target| is GL_UNIFORM_BUFFER or GL_SHADER_STORAGE_BUFFER.
+        void BindBufferRange(const OpenGLFunctions& gl,
+                             GLenum target,
+                             GLuint index,
+                             GLuint buffer,
+                             GLintptr offset,
+                             GLsizeiptr size);
+        void BindSampler(const OpenGLFunctions& gl, GLuint unit, GLuint sampler);
+        // Only changes the active texture unit if the binding changes.
+        void BindTexture(const OpenGLFunctions& gl, GLuint unit, GLenum target, GLuint texture);
+        void SetActiveTexture(const OpenGLFunctions& gl, GLuint unit);
+        void BindImageTexture(const OpenGLFunctions& gl,
+                              GLuint unit,
+                              GLuint texture,
+                              GLint level,
+                              GLboolean layered,
+                              GLint layer,
+                              GLenum access,
+                              GLenum format);
+        void BindFramebuffer(const OpenGLFunctions& gl, GLenum target, GLuint framebuffer);
+
+        // Rasterization, depth and stencil state
+        void SetEnabled(const OpenGLFunctions& gl, GLenum capability, bool enabled);
+        void SetFrontFace(const OpenGLFunctions& gl, GLenum frontFace);
+        void SetCullFace(const OpenGLFunctions& gl, GLenum cullFace);
+        void SetPolygonOffset(const OpenGLFunctions& gl,
+                              float slopeScale,
+                              float depthBias,
+                              float depthBiasClamp);
+        void SetSampleMask(const OpenGLFunctions& gl, GLbitfield sampleMask);
+        void SetDepthMask(const OpenGLFunctions& gl, GLboolean depthMask);
+        void SetDepthFunc(const OpenGLFunctions& gl, GLenum depthFunc);
         void SetStencilFuncsAndMask(const OpenGLFunctions& gl,
                                     GLenum stencilBackCompareFunction,
                                     GLenum stencilFrontCompareFunction,
                                     uint32_t stencilReadMask);
         void SetStencilReference(const OpenGLFunctions& gl, uint32_t stencilReference);
+        void SetStencilOp(const OpenGLFunctions& gl,
+                          GLenum face,
+                          GLenum stencilFail,
+                          GLenum depthFail,
+                          GLenum pass);
+        void SetStencilWriteMask(const OpenGLFunctions& gl, GLuint stencilWriteMask);
+
+        // Blend state. The non-indexed functions set the state of all the draw buffers.
+        void SetBlendEnabled(const OpenGLFunctions& gl, bool enabled);
+        void SetBlendEnabled(const OpenGLFunctions& gl, GLuint drawBuffer, bool enabled);
+        void SetBlendEquation(const OpenGLFunctions& gl, GLenum colorMode, GLenum alphaMode);
+        void SetBlendEquation(const OpenGLFunctions& gl,
+                              GLuint drawBuffer,
+                              GLenum colorMode,
+                              GLenum alphaMode);
+        void SetBlendFunc(const OpenGLFunctions& gl,
+                          GLenum srcColor,
+                          GLenum dstColor,
+                          GLenum srcAlpha,
+                          GLenum dstAlpha);
+        void SetBlendFunc(const OpenGLFunctions& gl,
+                          GLuint drawBuffer,
+                          GLenum srcColor,
+                          GLenum dstColor,
+                          GLenum srcAlpha,
+                          GLenum dstAlpha);
+        void SetColorMask(const OpenGLFunctions& gl, bool red, bool green, bool blue, bool alpha);
+        void SetColorMask(const OpenGLFunctions& gl,
+                          GLuint drawBuffer,
+                          bool red,
+                          bool green,
+                          bool blue,
+                          bool alpha);
+        void SetBlendColor(const OpenGLFunctions& gl, const std::array<float, 4>& blendColor);
+
+        // Dynamic state of the render pass
+        void SetViewport(const OpenGLFunctions& gl, float x, float y, float width, float height);
+        void SetDepthRange(const OpenGLFunctions& gl, float minDepth, float maxDepth);
+        void SetScissor(const OpenGLFunctions& gl,
+                        GLint x,
+                        GLint y,
+                        GLsizei width,
+                        GLsizei height);
+
+        const GLCallStats& GetCallStats() const;
 
       private:
+        // Records |value| as the new value of |shadow| and returns whether the |callCount| GL
+        // calls setting it need to be issued.
+        template <typename T>
+        bool Update(std::optional<T>* shadow, const T& value, uint32_t callCount = 1);
+        // Returns the shadow at |index| of |shadows|, growing them if needed.
+        template <typename T>
+        std::optional<T>* GetIndexed(std::vector<std::optional<T>>* shadows, GLuint index);
+
         void CallGLStencilFunc(const OpenGLFunctions& gl);
 
+        GLCallStats mCallStats;
+
+        std::optional<GLuint> mProgram;
+        std::optional<GLuint> mVertexArray;
+        std::optional<GLuint> mArrayBuffer;
+        // The element array buffer binding is part of the state of the vertex array.
+        std::optional<GLuint> mElementArrayBuffer;
+        std::optional<GLuint> mDrawIndirectBuffer;
+        std::optional<GLuint> mDispatchIndirectBuffer;
+        using BufferRange = std::tuple<GLuint, GLintptr, GLsizeiptr>;
+        std::vector<std::optional<BufferRange>> mUniformBuffers;
+        std::vector<std::optional<BufferRange>> mStorageBuffers;
+        std::vector<std::optional<GLuint>> mSamplers;
+        // The target and texture last bound to each unit.
+        using TextureBinding = std::tuple<GLenum, GLuint>;
+        std::vector<std::optional<TextureBinding>> mTextures;
+        std::optional<GLuint> mActiveTextureUnit;
+        using ImageBinding = std::tuple<GLuint, GLint, GLboolean, GLint, GLenum, GLenum>;
+        std::vector<std::optional<ImageBinding>> mImages;
+        std::optional<GLuint> mDrawFramebuffer;
+        std::optional<GLuint> mReadFramebuffer;
+
+        std::optional<bool> mCullFaceEnabled;
+        std::optional<bool> mDepthTestEnabled;
+        std::optional<bool> mStencilTestEnabled;
+        std::optional<bool> mPolygonOffsetFillEnabled;
+        std::optional<bool> mSampleAlphaToCoverageEnabled;
+        std::optional<GLenum> mFrontFace;
+        std::optional<GLenum> mCullFace;
+        std::optional<std::tuple<float, float, float>> mPolygonOffset;
+        std::optional<GLbitfield> mSampleMask;
+        std::optional<GLboolean> mDepthMask;
+        std::optional<GLenum> mDepthFunc;
+
+        // The stencil functions are always set together, starting with the default state.
         GLenum mStencilBackCompareFunction = GL_ALWAYS;
         GLenum mStencilFrontCompareFunction = GL_ALWAYS;
         GLuint mStencilReadMask = 0xffffffff;
         GLuint mStencilReference = 0;
+        using StencilOps = std::tuple<GLenum, GLenum, GLenum>;
+        std::optional<StencilOps> mStencilBackOps;
+        std::optional<StencilOps> mStencilFrontOps;
+        std::optional<GLuint> mStencilWriteMask;
+
+        // The blend state of all the draw buffers is only known when it was last set with the
+        // non-indexed functions.
+        using BlendEquation = std::tuple<GLenum, GLenum>;
+        using BlendFunc = std::tuple<GLenum, GLenum, GLenum, GLenum>;
+        using ColorMask = std::tuple<bool, bool, bool, bool>;
+        std::optional<bool> mBlendEnabled;
+        std::optional<BlendEquation> mBlendEquation;
+        std::optional<BlendFunc> mBlendFunc;
+        std::optional<ColorMask> mColorMask;
+        std::array<std::optional<bool>, kMaxColorAttachments> mDrawBufferBlendEnabled;
+        std::array<std::optional<BlendEquation>, kMaxColorAttachments> mDrawBufferBlendEquation;
+        std::array<std::optional<BlendFunc>, kMaxColorAttachments> mDrawBufferBlendFunc;
+        std::array<std::optional<ColorMask>, kMaxColorAttachments> mDrawBufferColorMask;
+        std::optional<std::array<float, 4>> mBlendColor;
+
+        std::optional<std::array<float, 4>> mViewport;
+        std::optional<std::tuple<float, float>> mDepthRange;
+        std::optional<std::tuple<GLint, GLint, GLsizei, GLsizei>> mScissor;
     };
 
 }  // namespace dawn::native::opengl
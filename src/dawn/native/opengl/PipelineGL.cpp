@@ -17,15 +17,20 @@
 #include "dawn/common/BitSetIterator.h"
 #include "dawn/native/BindGroupLayout.h"
 #include "dawn/native/Device.h"
+#include "dawn/native/PersistentCache.h"
 #include "dawn/native/Pipeline.h"
 #include "dawn/native/opengl/Forward.h"
 #include "dawn/native/opengl/OpenGLFunctions.h"
+#include "dawn/native/opengl/PersistentPipelineStateGL.h"
 #include "dawn/native/opengl/PipelineLayoutGL.h"
 #include "dawn/native/opengl/SamplerGL.h"
 #include "dawn/native/opengl/ShaderModuleGL.h"
 
+#include <cstring>
+#include <iterator>
 #include <set>
 #include <sstream>
+#include <string>
 
 namespace dawn::native::opengl {
 
@@ -43,6 +48,57 @@ namespace dawn::native::opengl {
             UNREACHABLE();
         }
 
+        bool SupportsProgramBinaries(const OpenGLFunctions& gl) {
+            if (!gl.IsAtLeastGL(4, 1) && !gl.IsAtLeastGLES(3, 0)) {
+                return false;
+            }
+            // Drivers may support the functions without supporting any binary format.
+            GLint binaryFormatCount = 0;
+            gl.GetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormatCount);
+            return binaryFormatCount > 0;
+        }
+
+        // The program binary depends on the GLSL of each stage, which already contains the
+        // bindings of the layout, and on the driver that produced it.
+        PersistentCacheKey CreateProgramBinaryKey(const OpenGLFunctions& gl,
+                                                  const PipelineLayout* layout,
+                                                  wgpu::ShaderStage activeStages,
+                                                  const PerStage<std::string>& glslSources) {
+            std::stringstream stream;
+
+            // Prefix the key with the type to avoid collisions from another type that could have
+            // the same key.
+            stream << static_cast<uint32_t>(PersistentKeyType::ProgramBinary);
+            stream << "\n";
+
+            stream << "(ProgramBinary";
+            for (GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+                const char* value = reinterpret_cast<const char*>(gl.GetString(name));
+                stream << " " << (value != nullptr ? value : "");
+            }
+
+            stream << " bindings=";
+            const PipelineLayout::BindingIndexInfo& indices = layout->GetBindingIndexInfo();
+            for (BindGroupIndex group : IterateBitSet(layout->GetBindGroupLayoutsMask())) {
+                stream << "[";
+                for (GLuint index : indices[group]) {
+                    stream << index << ",";
+                }
+                stream << "]";
+            }
+
+            // Prefix the sources with their size so that they can't be confused with the rest of
+            // the key.
+            for (SingleShaderStage stage : IterateStages(activeStages)) {
+                stream << " stage=" << static_cast<uint32_t>(stage);
+                stream << " size=" << glslSources[stage].size() << " " << glslSources[stage];
+            }
+            stream << ")";
+
+            return PersistentCacheKey(std::istreambuf_iterator<char>{stream},
+                                      std::istreambuf_iterator<char>{});
+        }
+
     }  // namespace
 
     PipelineGL::PipelineGL() : mProgram(0) {
@@ -53,28 +109,6 @@ namespace dawn::native::opengl {
     MaybeError PipelineGL::InitializeBase(const OpenGLFunctions& gl,
                                           const PipelineLayout* layout,
                                           const PerStage<ProgrammableStage>& stages) {
-        auto CreateShader = [](const OpenGLFunctions& gl, GLenum type,
-                               const char* source) -> ResultOrError<GLuint> {
-            GLuint shader = gl.CreateShader(type);
-            gl.ShaderSource(shader, 1, &source, nullptr);
-            gl.CompileShader(shader);
-
-            GLint compileStatus = GL_FALSE;
-            gl.GetShaderiv(shader, GL_COMPILE_STATUS, &compileStatus);
-            if (compileStatus == GL_FALSE) {
-                GLint infoLogLength = 0;
-                gl.GetShaderiv(shader, GL_INFO_LOG_LENGTH, &infoLogLength);
-
-                if (infoLogLength > 1) {
-                    std::vector<char> buffer(infoLogLength);
-                    gl.GetShaderInfoLog(shader, infoLogLength, nullptr, &buffer[0]);
-                    return DAWN_FORMAT_VALIDATION_ERROR("%s\nProgram compilation failed:\n%s",
-                                                        source, buffer.data());
-                }
-            }
-            return shader;
-        };
-
         mProgram = gl.CreateProgram();
 
         // Compute the set of active stages.
@@ -85,20 +119,16 @@ namespace dawn::native::opengl {
             }
         }
 
-        // Create an OpenGL shader for each stage and gather the list of combined samplers.
+        // Generate the GLSL for each stage and gather the list of combined samplers.
         PerStage<CombinedSamplerInfo> combinedSamplers;
+        PerStage<std::string> glslSources;
         bool needsDummySampler = false;
-        std::vector<GLuint> glShaders;
         for (SingleShaderStage stage : IterateStages(activeStages)) {
             const ShaderModule* module = ToBackend(stages[stage].module.Get());
-            std::string glsl;
-            DAWN_TRY_ASSIGN(glsl, module->TranslateToGLSL(stages[stage].entryPoint.c_str(), stage,
-                                                          &combinedSamplers[stage], layout,
-                                                          &needsDummySampler));
-            GLuint shader;
-            DAWN_TRY_ASSIGN(shader, CreateShader(gl, GLShaderType(stage), glsl.c_str()));
-            gl.AttachShader(mProgram, shader);
-            glShaders.push_back(shader);
+            DAWN_TRY_ASSIGN(glslSources[stage],
+                            module->TranslateToGLSL(stages[stage].entryPoint.c_str(), stage,
+                                                    &combinedSamplers[stage], layout,
+                                                    &needsDummySampler));
         }
 
         if (needsDummySampler) {
@@ -110,19 +140,22 @@ namespace dawn::native::opengl {
                 ToBackend(layout->GetDevice()->GetOrCreateSampler(&desc).AcquireSuccess());
         }
 
-        // Link all the shaders together.
-        gl.LinkProgram(mProgram);
-
-        GLint linkStatus = GL_FALSE;
-        gl.GetProgramiv(mProgram, GL_LINK_STATUS, &linkStatus);
-        if (linkStatus == GL_FALSE) {
-            GLint infoLogLength = 0;
-            gl.GetProgramiv(mProgram, GL_INFO_LOG_LENGTH, &infoLogLength);
+        // Compiling and linking the shaders is expensive, so the linked program is stored in the
+        // PersistentCache and restored from it the next time the same GLSL is used, unless the
+        // driver rejects the binary.
+        PersistentCache* persistentCache = layout->GetDevice()->GetPersistentCache();
+        const bool useProgramBinary = persistentCache->IsEnabled() && SupportsProgramBinaries(gl);
+        PersistentCacheKey programBinaryKey;
+        bool isLinked = false;
+        if (useProgramBinary) {
+            programBinaryKey = CreateProgramBinaryKey(gl, layout, activeStages, glslSources);
+            isLinked = LoadProgramBinary(gl, persistentCache->LoadData(programBinaryKey));
+        }
 
-            if (infoLogLength > 1) {
-                std::vector<char> buffer(infoLogLength);
-                gl.GetProgramInfoLog(mProgram, infoLogLength, nullptr, &buffer[0]);
-                return DAWN_FORMAT_VALIDATION_ERROR("Program link failed:\n%s", buffer.data());
+        if (!isLinked) {
+            DAWN_TRY(CompileAndLinkProgram(gl, activeStages, glslSources, useProgramBinary));
+            if (useProgramBinary) {
+                StoreProgramBinary(gl, persistentCache, programBinaryKey);
             }
         }
 
@@ -180,6 +213,65 @@ namespace dawn::native::opengl {
             textureUnit++;
         }
 
+        return {};
+    }
+
+    MaybeError PipelineGL::CompileAndLinkProgram(const OpenGLFunctions& gl,
+                                                 wgpu::ShaderStage activeStages,
+                                                 const PerStage<std::string>& glslSources,
+                                                 bool makeBinaryRetrievable) {
+        auto CreateShader = [](const OpenGLFunctions& gl, GLenum type,
+                               const char* source) -> ResultOrError<GLuint> {
+            GLuint shader = gl.CreateShader(type);
+            gl.ShaderSource(shader, 1, &source, nullptr);
+            gl.CompileShader(shader);
+
+            GLint compileStatus = GL_FALSE;
+            gl.GetShaderiv(shader, GL_COMPILE_STATUS, &compileStatus);
+            if (compileStatus == GL_FALSE) {
+                GLint infoLogLength = 0;
+                gl.GetShaderiv(shader, GL_INFO_LOG_LENGTH, &infoLogLength);
+
+                if (infoLogLength > 1) {
+                    std::vector<char> buffer(infoLogLength);
+                    gl.GetShaderInfoLog(shader, infoLogLength, nullptr, &buffer[0]);
+                    return DAWN_FORMAT_VALIDATION_ERROR("%s\nProgram compilation failed:\n%s",
+                                                        source, buffer.data());
+                }
+            }
+            return shader;
+        };
+
+        // Create an OpenGL shader for each stage.
+        std::vector<GLuint> glShaders;
+        for (SingleShaderStage stage : IterateStages(activeStages)) {
+            GLuint shader;
+            DAWN_TRY_ASSIGN(shader,
+                            CreateShader(gl, GLShaderType(stage), glslSources[stage].c_str()));
+            gl.AttachShader(mProgram, shader);
+            glShaders.push_back(shader);
+        }
+
+        if (makeBinaryRetrievable) {
+            gl.ProgramParameteri(mProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        }
+
+        // Link all the shaders together.
+        gl.LinkProgram(mProgram);
+
+        GLint linkStatus = GL_FALSE;
+        gl.GetProgramiv(mProgram, GL_LINK_STATUS, &linkStatus);
+        if (linkStatus == GL_FALSE) {
+            GLint infoLogLength = 0;
+            gl.GetProgramiv(mProgram, GL_INFO_LOG_LENGTH, &infoLogLength);
+
+            if (infoLogLength > 1) {
+                std::vector<char> buffer(infoLogLength);
+                gl.GetProgramInfoLog(mProgram, infoLogLength, nullptr, &buffer[0]);
+                return DAWN_FORMAT_VALIDATION_ERROR("Program link failed:\n%s", buffer.data());
+            }
+        }
+
         for (GLuint glShader : glShaders) {
             gl.DetachShader(mProgram, glShader);
             gl.DeleteShader(glShader);
@@ -188,6 +280,51 @@ namespace dawn::native::opengl {
         return {};
     }
 
+    bool PipelineGL::LoadProgramBinary(const OpenGLFunctions& gl, const ScopedCachedBlob& blob) {
+        // The blob is the binary format followed by the binary.
+        if (blob.bufferSize <= sizeof(GLenum)) {
+            return false;
+        }
+        GLenum binaryFormat;
+        memcpy(&binaryFormat, blob.buffer.get(), sizeof(GLenum));
+
+        gl.ProgramBinary(mProgram, binaryFormat, blob.buffer.get() + sizeof(GLenum),
+                         static_cast<GLsizei>(blob.bufferSize - sizeof(GLenum)));
+
+        // The driver may reject binaries, for example after it was updated. The program is then
+        // left unlinked, so start over with a new one that is compiled from the GLSL.
+        GLint linkStatus = GL_FALSE;
+        gl.GetProgramiv(mProgram, GL_LINK_STATUS, &linkStatus);
+        if (linkStatus == GL_FALSE) {
+            gl.DeleteProgram(mProgram);
+            mProgram = gl.CreateProgram();
+            return false;
+        }
+        return true;
+    }
+
+    void PipelineGL::StoreProgramBinary(const OpenGLFunctions& gl,
+                                        PersistentCache* persistentCache,
+                                        const PersistentCacheKey& key) const {
+        GLint binaryLength = 0;
+        gl.GetProgramiv(mProgram, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+        if (binaryLength <= 0) {
+            return;
+        }
+
+        std::vector<uint8_t> blob(sizeof(GLenum) + binaryLength);
+        GLenum binaryFormat = 0;
+        GLsizei writtenLength = 0;
+        gl.GetProgramBinary(mProgram, binaryLength, &writtenLength, &binaryFormat,
+                            blob.data() + sizeof(GLenum));
+        if (writtenLength <= 0) {
+            return;
+        }
+        memcpy(blob.data(), &binaryFormat, sizeof(GLenum));
+
+        persistentCache->StoreData(key, blob.data(), sizeof(GLenum) + writtenLength);
+    }
+
     void PipelineGL::DeleteProgram(const OpenGLFunctions& gl) {
         gl.DeleteProgram(mProgram);
     }
@@ -207,11 +344,12 @@ namespace dawn::native::opengl {
         return mProgram;
     }
 
-    void PipelineGL::ApplyNow(const OpenGLFunctions& gl) {
-        gl.UseProgram(mProgram);
+    void PipelineGL::ApplyNow(const OpenGLFunctions& gl,
+                              PersistentPipelineState& persistentPipelineState) {
+        persistentPipelineState.UseProgram(gl, mProgram);
         for (GLuint unit : mDummySamplerUnits) {
             ASSERT(mDummySampler.Get() != nullptr);
-            gl.BindSampler(unit, mDummySampler->GetNonFilteringHandle());
+            persistentPipelineState.BindSampler(gl, unit, mDummySampler->GetNonFilteringHandle());
         }
     }
 
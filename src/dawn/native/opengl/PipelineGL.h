@@ -18,8 +18,10 @@
 #include "dawn/native/Pipeline.h"
 
 #include "dawn/native/PerStage.h"
+#include "dawn/native/PersistentCache.h"
 #include "dawn/native/opengl/opengl_platform.h"
 
+#include <string>
 #include <vector>
 
 namespace dawn::native {
@@ -29,6 +31,7 @@ namespace dawn::native {
 namespace dawn::native::opengl {
 
     struct OpenGLFunctions;
+    class PersistentPipelineState;
     class PipelineLayout;
     class Sampler;
 
@@ -48,13 +51,24 @@ namespace dawn::native::opengl {
         GLuint GetProgramHandle() const;
 
       protected:
-        void ApplyNow(const OpenGLFunctions& gl);
+        void ApplyNow(const OpenGLFunctions& gl, PersistentPipelineState& persistentPipelineState);
         MaybeError InitializeBase(const OpenGLFunctions& gl,
                                   const PipelineLayout* layout,
                                   const PerStage<ProgrammableStage>& stages);
         void DeleteProgram(const OpenGLFunctions& gl);
 
       private:
+        MaybeError CompileAndLinkProgram(const OpenGLFunctions& gl,
+                                         wgpu::ShaderStage activeStages,
+                                         const PerStage<std::string>& glslSources,
+                                         bool makeBinaryRetrievable);
+        // Links the program with the binary in |blob|. Returns false if there is no binary or
+        // the driver rejects it, in which case mProgram is replaced with a new empty program.
+        bool LoadProgramBinary(const OpenGLFunctions& gl, const ScopedCachedBlob& blob);
+        void StoreProgramBinary(const OpenGLFunctions& gl,
+                                PersistentCache* persistentCache,
+                                const PersistentCacheKey& key) const;
+
         GLuint mProgram;
         std::vector<std::vector<SamplerUnit>> mUnitsForSamplers;
         std::vector<std::vector<GLuint>> mUnitsForTextures;
@@ -43,7 +43,12 @@ namespace dawn::native::opengl {
                                       uint64_t bufferOffset,
                                       const void* data,
                                       size_t size) {
-        const OpenGLFunctions& gl = ToBackend(GetDevice())->gl;
+        Device* device = ToBackend(GetDevice());
+        if (device->UsesPersistentlyMappedUploads()) {
+            return QueueBase::WriteBufferImpl(buffer, bufferOffset, data, size);
+        }
+
+        const OpenGLFunctions& gl = device->gl;
 
         ToBackend(buffer)->EnsureDataInitializedAsDestination(bufferOffset, size);
 
@@ -41,19 +41,20 @@ namespace dawn::native::opengl {
 
         void ApplyFrontFaceAndCulling(const OpenGLFunctions& gl,
                                       wgpu::FrontFace face,
-                                      wgpu::CullMode mode) {
+                                      wgpu::CullMode mode,
+                                      PersistentPipelineState* persistentPipelineState) {
             // Note that we invert winding direction in OpenGL. Because Y axis is up in OpenGL,
             // which is different from WebGPU and other backends (Y axis is down).
             GLenum direction = (face == wgpu::FrontFace::CCW) ? GL_CW : GL_CCW;
-            gl.FrontFace(direction);
+            persistentPipelineState->SetFrontFace(gl, direction);
 
             if (mode == wgpu::CullMode::None) {
-                gl.Disable(GL_CULL_FACE);
+                persistentPipelineState->SetEnabled(gl, GL_CULL_FACE, false);
             } else {
-                gl.Enable(GL_CULL_FACE);
+                persistentPipelineState->SetEnabled(gl, GL_CULL_FACE, true);
 
                 GLenum cullMode = (mode == wgpu::CullMode::Front) ? GL_FRONT : GL_BACK;
-                gl.CullFace(cullMode);
+                persistentPipelineState->SetCullFace(gl, cullMode);
             }
         }
 
@@ -107,42 +108,49 @@ namespace dawn::native::opengl {
 
         void ApplyColorState(const OpenGLFunctions& gl,
                              ColorAttachmentIndex attachment,
-                             const ColorTargetState* state) {
+                             const ColorTargetState* state,
+                             PersistentPipelineState* persistentPipelineState) {
             GLuint colorBuffer = static_cast<GLuint>(static_cast<uint8_t>(attachment));
             if (state->blend != nullptr) {
-                gl.Enablei(GL_BLEND, colorBuffer);
-                gl.BlendEquationSeparatei(colorBuffer, GLBlendMode(state->blend->color.operation),
-                                          GLBlendMode(state->blend->alpha.operation));
-                gl.BlendFuncSeparatei(colorBuffer,
-                                      GLBlendFactor(state->blend->color.srcFactor, false),
-                                      GLBlendFactor(state->blend->color.dstFactor, false),
-                                      GLBlendFactor(state->blend->alpha.srcFactor, true),
-                                      GLBlendFactor(state->blend->alpha.dstFactor, true));
+                persistentPipelineState->SetBlendEnabled(gl, colorBuffer, true);
+                persistentPipelineState->SetBlendEquation(
+                    gl, colorBuffer, GLBlendMode(state->blend->color.operation),
+                    GLBlendMode(state->blend->alpha.operation));
+                persistentPipelineState->SetBlendFunc(
+                    gl, colorBuffer, GLBlendFactor(state->blend->color.srcFactor, false),
+                    GLBlendFactor(state->blend->color.dstFactor, false),
+                    GLBlendFactor(state->blend->alpha.srcFactor, true),
+                    GLBlendFactor(state->blend->alpha.dstFactor, true));
             } else {
-                gl.Disablei(GL_BLEND, colorBuffer);
+                persistentPipelineState->SetBlendEnabled(gl, colorBuffer, false);
             }
-            gl.ColorMaski(colorBuffer, state->writeMask & wgpu::ColorWriteMask::Red,
-                          state->writeMask & wgpu::ColorWriteMask::Green,
-                          state->writeMask & wgpu::ColorWriteMask::Blue,
-                          state->writeMask & wgpu::ColorWriteMask::Alpha);
+            persistentPipelineState->SetColorMask(gl, colorBuffer,
+                                                  state->writeMask & wgpu::ColorWriteMask::Red,
+                                                  state->writeMask & wgpu::ColorWriteMask::Green,
+                                                  state->writeMask & wgpu::ColorWriteMask::Blue,
+                                                  state->writeMask & wgpu::ColorWriteMask::Alpha);
         }
 
-        void ApplyColorState(const OpenGLFunctions& gl, const ColorTargetState* state) {
+        void ApplyColorState(const OpenGLFunctions& gl,
+                             const ColorTargetState* state,
+                             PersistentPipelineState* persistentPipelineState) {
             if (state->blend != nullptr) {
-                gl.Enable(GL_BLEND);
-                gl.BlendEquationSeparate(GLBlendMode(state->blend->color.operation),
-                                         GLBlendMode(state->blend->alpha.operation));
-                gl.BlendFuncSeparate(GLBlendFactor(state->blend->color.srcFactor, false),
-                                     GLBlendFactor(state->blend->color.dstFactor, false),
-                                     GLBlendFactor(state->blend->alpha.srcFactor, true),
-                                     GLBlendFactor(state->blend->alpha.dstFactor, true));
+                persistentPipelineState->SetBlendEnabled(gl, true);
+                persistentPipelineState->SetBlendEquation(
+                    gl, GLBlendMode(state->blend->color.operation),
+                    GLBlendMode(state->blend->alpha.operation));
+                persistentPipelineState->SetBlendFunc(
+                    gl, GLBlendFactor(state->blend->color.srcFactor, false),
+                    GLBlendFactor(state->blend->color.dstFactor, false),
+                    GLBlendFactor(state->blend->alpha.srcFactor, true),
+                    GLBlendFactor(state->blend->alpha.dstFactor, true));
             } else {
-                gl.Disable(GL_BLEND);
+                persistentPipelineState->SetBlendEnabled(gl, false);
             }
-            gl.ColorMask(state->writeMask & wgpu::ColorWriteMask::Red,
-                         state->writeMask & wgpu::ColorWriteMask::Green,
-                         state->writeMask & wgpu::ColorWriteMask::Blue,
-                         state->writeMask & wgpu::ColorWriteMask::Alpha);
+            persistentPipelineState->SetColorMask(gl, state->writeMask & wgpu::ColorWriteMask::Red,
+                                                  state->writeMask & wgpu::ColorWriteMask::Green,
+                                                  state->writeMask & wgpu::ColorWriteMask::Blue,
+                                                  state->writeMask & wgpu::ColorWriteMask::Alpha);
         }
 
         bool Equal(const BlendComponent& lhs, const BlendComponent& rhs) {
@@ -176,40 +184,38 @@ namespace dawn::native::opengl {
                                     const DepthStencilState* descriptor,
                                     PersistentPipelineState* persistentPipelineState) {
             // Depth writes only occur if depth is enabled
-            if (descriptor->depthCompare == wgpu::CompareFunction::Always &&
-                !descriptor->depthWriteEnabled) {
-                gl.Disable(GL_DEPTH_TEST);
-            } else {
-                gl.Enable(GL_DEPTH_TEST);
-            }
+            persistentPipelineState->SetEnabled(
+                gl, GL_DEPTH_TEST,
+                descriptor->depthCompare != wgpu::CompareFunction::Always ||
+                    descriptor->depthWriteEnabled);
 
             if (descriptor->depthWriteEnabled) {
-                gl.DepthMask(GL_TRUE);
+                persistentPipelineState->SetDepthMask(gl, GL_TRUE);
             } else {
-                gl.DepthMask(GL_FALSE);
+                persistentPipelineState->SetDepthMask(gl, GL_FALSE);
             }
 
-            gl.DepthFunc(ToOpenGLCompareFunction(descriptor->depthCompare));
+            persistentPipelineState->SetDepthFunc(
+                gl, ToOpenGLCompareFunction(descriptor->depthCompare));
 
-            if (StencilTestEnabled(descriptor)) {
-                gl.Enable(GL_STENCIL_TEST);
-            } else {
-                gl.Disable(GL_STENCIL_TEST);
-            }
+            persistentPipelineState->SetEnabled(gl, GL_STENCIL_TEST,
+                                                StencilTestEnabled(descriptor));
 
             GLenum backCompareFunction = ToOpenGLCompareFunction(descriptor->stencilBack.compare);
             GLenum frontCompareFunction = ToOpenGLCompareFunction(descriptor->stencilFront.compare);
             persistentPipelineState->SetStencilFuncsAndMask(
                 gl, backCompareFunction, frontCompareFunction, descriptor->stencilReadMask);
 
-            gl.StencilOpSeparate(GL_BACK, OpenGLStencilOperation(descriptor->stencilBack.failOp),
-                                 OpenGLStencilOperation(descriptor->stencilBack.depthFailOp),
-                                 OpenGLStencilOperation(descriptor->stencilBack.passOp));
-            gl.StencilOpSeparate(GL_FRONT, OpenGLStencilOperation(descriptor->stencilFront.failOp),
-                                 OpenGLStencilOperation(descriptor->stencilFront.depthFailOp),
-                                 OpenGLStencilOperation(descriptor->stencilFront.passOp));
+            persistentPipelineState->SetStencilOp(
+                gl, GL_BACK, OpenGLStencilOperation(descriptor->stencilBack.failOp),
+                OpenGLStencilOperation(descriptor->stencilBack.depthFailOp),
+                OpenGLStencilOperation(descriptor->stencilBack.passOp));
+            persistentPipelineState->SetStencilOp(
+                gl, GL_FRONT, OpenGLStencilOperation(descriptor->stencilFront.failOp),
+                OpenGLStencilOperation(descriptor->stencilFront.depthFailOp),
+                OpenGLStencilOperation(descriptor->stencilFront.passOp));
 
-            gl.StencilMask(descriptor->stencilWriteMask);
+            persistentPipelineState->SetStencilWriteMask(gl, descriptor->stencilWriteMask);
         }
 
     }  // anonymous namespace
@@ -286,45 +292,38 @@ namespace dawn::native::opengl {
 
     void RenderPipeline::ApplyNow(PersistentPipelineState& persistentPipelineState) {
         const OpenGLFunctions& gl = ToBackend(GetDevice())->gl;
-        PipelineGL::ApplyNow(gl);
+        PipelineGL::ApplyNow(gl, persistentPipelineState);
 
         ASSERT(mVertexArrayObject);
-        gl.BindVertexArray(mVertexArrayObject);
+        persistentPipelineState.BindVertexArray(gl, mVertexArrayObject);
 
-        ApplyFrontFaceAndCulling(gl, GetFrontFace(), GetCullMode());
+        ApplyFrontFaceAndCulling(gl, GetFrontFace(), GetCullMode(), &persistentPipelineState);
 
         ApplyDepthStencilState(gl, GetDepthStencilState(), &persistentPipelineState);
 
-        gl.SampleMaski(0, GetSampleMask());
-        if (IsAlphaToCoverageEnabled()) {
-            gl.Enable(GL_SAMPLE_ALPHA_TO_COVERAGE);
-        } else {
-            gl.Disable(GL_SAMPLE_ALPHA_TO_COVERAGE);
-        }
+        persistentPipelineState.SetSampleMask(gl, GetSampleMask());
+        persistentPipelineState.SetEnabled(gl, GL_SAMPLE_ALPHA_TO_COVERAGE,
+                                           IsAlphaToCoverageEnabled());
 
         if (IsDepthBiasEnabled()) {
-            gl.Enable(GL_POLYGON_OFFSET_FILL);
-            float depthBias = GetDepthBias();
-            float slopeScale = GetDepthBiasSlopeScale();
-            if (gl.PolygonOffsetClamp != nullptr) {
-                gl.PolygonOffsetClamp(slopeScale, depthBias, GetDepthBiasClamp());
-            } else {
-                gl.PolygonOffset(slopeScale, depthBias);
-            }
+            persistentPipelineState.SetEnabled(gl, GL_POLYGON_OFFSET_FILL, true);
+            persistentPipelineState.SetPolygonOffset(gl, GetDepthBiasSlopeScale(), GetDepthBias(),
+                                                     GetDepthBiasClamp());
         } else {
-            gl.Disable(GL_POLYGON_OFFSET_FILL);
+            persistentPipelineState.SetEnabled(gl, GL_POLYGON_OFFSET_FILL, false);
         }
 
         if (!GetDevice()->IsToggleEnabled(Toggle::DisableIndexedDrawBuffers)) {
             for (ColorAttachmentIndex attachmentSlot : IterateBitSet(GetColorAttachmentsMask())) {
-                ApplyColorState(gl, attachmentSlot, GetColorTargetState(attachmentSlot));
+                ApplyColorState(gl, attachmentSlot, GetColorTargetState(attachmentSlot),
+                                &persistentPipelineState);
             }
         } else {
             const ColorTargetState* prevDescriptor = nullptr;
             for (ColorAttachmentIndex attachmentSlot : IterateBitSet(GetColorAttachmentsMask())) {
                 const ColorTargetState* descriptor = GetColorTargetState(attachmentSlot);
                 if (!prevDescriptor) {
-                    ApplyColorState(gl, descriptor);
+                    ApplyColorState(gl, descriptor, &persistentPipelineState);
                     prevDescriptor = descriptor;
                 } else if ((descriptor->blend == nullptr) != (prevDescriptor->blend == nullptr)) {
                     // TODO(crbug.com/dawn/582): GLES < 3.2 does not support different blend states
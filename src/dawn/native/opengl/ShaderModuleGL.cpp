@@ -89,8 +89,11 @@ namespace dawn::native::opengl {
 
         AddExternalTextureTransform(layout, &transformManager, &transformInputs);
 
+        const tint::Program* tintProgram;
+        DAWN_TRY_ASSIGN(tintProgram, GetTintProgram());
+
         tint::Program program;
-        DAWN_TRY_ASSIGN(program, RunTransforms(&transformManager, GetTintProgram(), transformInputs,
+        DAWN_TRY_ASSIGN(program, RunTransforms(&transformManager, tintProgram, transformInputs,
                                                nullptr, nullptr));
         const OpenGLVersion& version = ToBackend(GetDevice())->gl.GetVersion();
 
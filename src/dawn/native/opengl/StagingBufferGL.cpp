@@ -0,0 +1,52 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/native/opengl/StagingBufferGL.h"
+
+#include "dawn/native/opengl/DeviceGL.h"
+
+namespace dawn::native::opengl {
+
+    StagingBuffer::StagingBuffer(size_t size, Device* device)
+        : StagingBufferBase(size), mDevice(device) {
+    }
+
+    MaybeError StagingBuffer::Initialize() {
+        const OpenGLFunctions& gl = mDevice->gl;
+        constexpr GLbitfield kMapFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT |
+                                         GL_MAP_COHERENT_BIT;
+
+        gl.GenBuffers(1, &mBuffer);
+        gl.BindBuffer(GL_COPY_READ_BUFFER, mBuffer);
+        gl.BufferStorage(GL_COPY_READ_BUFFER, GetSize(), nullptr, kMapFlags);
+        mMappedPointer = gl.MapBufferRange(GL_COPY_READ_BUFFER, 0, GetSize(), kMapFlags);
+        if (mMappedPointer == nullptr) {
+            return DAWN_INTERNAL_ERROR("Unable to map staging buffer.");
+        }
+
+        return {};
+    }
+
+    StagingBuffer::~StagingBuffer() {
+        // Deleting the buffer unmaps it. GL defers the deletion of the storage until the commands
+        // using it complete.
+        mMappedPointer = nullptr;
+        mDevice->gl.DeleteBuffers(1, &mBuffer);
+    }
+
+    GLuint StagingBuffer::GetHandle() const {
+        return mBuffer;
+    }
+
+}  // namespace dawn::native::opengl
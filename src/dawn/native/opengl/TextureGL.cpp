@@ -21,6 +21,7 @@
 #include "dawn/native/opengl/BufferGL.h"
 #include "dawn/native/opengl/CommandBufferGL.h"
 #include "dawn/native/opengl/DeviceGL.h"
+#include "dawn/native/opengl/FramebufferCacheGL.h"
 #include "dawn/native/opengl/UtilsGL.h"
 
 namespace dawn::native::opengl {
@@ -192,6 +193,7 @@ namespace dawn::native::opengl {
 
     void Texture::DestroyImpl() {
         TextureBase::DestroyImpl();
+        ToBackend(GetDevice())->GetFramebufferCache()->EvictFramebuffersUsing(this);
         if (GetTextureState() == TextureState::OwnedInternal) {
             ToBackend(GetDevice())->gl.DeleteTextures(1, &mHandle);
             mHandle = 0;
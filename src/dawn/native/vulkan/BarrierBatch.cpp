@@ -0,0 +1,172 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/native/vulkan/BarrierBatch.h"
+
+#include "dawn/common/Assert.h"
+#include "dawn/native/vulkan/BufferVk.h"
+#include "dawn/native/vulkan/CommandRecordingContext.h"
+#include "dawn/native/vulkan/DeviceVk.h"
+#include "dawn/native/vulkan/TextureVk.h"
+
+namespace dawn::native::vulkan {
+
+    BarrierBatch::BarrierBatch(Device* device)
+        : mDevice(device),
+          mUseSynchronization2(device->GetDeviceInfo().synchronization2Features.synchronization2 ==
+                               VK_TRUE) {
+    }
+
+    void BarrierBatch::TransitionBuffer(Buffer* buffer,
+                                        wgpu::BufferUsage usage,
+                                        VkPipelineStageFlags2KHR transferStage) {
+        VkBufferMemoryBarrier barrier;
+        VkPipelineStageFlags srcStages = 0;
+        VkPipelineStageFlags dstStages = 0;
+        if (!buffer->TransitionUsageAndGetResourceBarrier(usage, &barrier, &srcStages,
+                                                          &dstStages)) {
+            return;
+        }
+
+        mBufferBarriers.push_back(barrier);
+        mBufferBarrierStages.push_back(ComputeStageMasks(srcStages, dstStages, transferStage));
+    }
+
+    void BarrierBatch::TransitionTexture(CommandRecordingContext* recordingContext,
+                                         Texture* texture,
+                                         wgpu::TextureUsage usage,
+                                         const SubresourceRange& range,
+                                         VkPipelineStageFlags2KHR transferStage) {
+        VkPipelineStageFlags srcStages = 0;
+        VkPipelineStageFlags dstStages = 0;
+        texture->TransitionUsageAndGetResourceBarrier(recordingContext, usage, range,
+                                                      &mImageBarriers, &srcStages, &dstStages);
+
+        mImageBarrierStages.resize(mImageBarriers.size(),
+                                   ComputeStageMasks(srcStages, dstStages, transferStage));
+    }
+
+    void BarrierBatch::TransitionTextureForPass(CommandRecordingContext* recordingContext,
+                                                Texture* texture,
+                                                const TextureSubresourceUsage& textureUsages) {
+        VkPipelineStageFlags srcStages = 0;
+        VkPipelineStageFlags dstStages = 0;
+        texture->TransitionUsageForPass(recordingContext, textureUsages, &mImageBarriers,
+                                        &srcStages, &dstStages);
+
+        mImageBarrierStages.resize(mImageBarriers.size(),
+                                   ComputeStageMasks(srcStages, dstStages, 0));
+    }
+
+    bool BarrierBatch::IsEmpty() const {
+        return mBufferBarriers.empty() && mImageBarriers.empty();
+    }
+
+    void BarrierBatch::Record(CommandRecordingContext* recordingContext) {
+        if (IsEmpty()) {
+            return;
+        }
+
+        if (mUseSynchronization2) {
+            RecordSynchronization2(recordingContext);
+        } else {
+            ASSERT(mSrcStages != 0 && mDstStages != 0);
+            mDevice->fn.CmdPipelineBarrier(recordingContext->commandBuffer, mSrcStages, mDstStages,
+                                           0, 0, nullptr, mBufferBarriers.size(),
+                                           mBufferBarriers.data(), mImageBarriers.size(),
+                                           mImageBarriers.data());
+        }
+
+        recordingContext->pipelineBarrierCount++;
+        recordingContext->memoryBarrierCount += mBufferBarriers.size() + mImageBarriers.size();
+
+        mBufferBarriers.clear();
+        mImageBarriers.clear();
+        mBufferBarrierStages.clear();
+        mImageBarrierStages.clear();
+        mSrcStages = 0;
+        mDstStages = 0;
+    }
+
+    BarrierBatch::StageMasks BarrierBatch::ComputeStageMasks(
+        VkPipelineStageFlags srcStages,
+        VkPipelineStageFlags dstStages,
+        VkPipelineStageFlags2KHR transferStage) {
+        mSrcStages |= srcStages;
+        mDstStages |= dstStages;
+
+        // The bits of VkPipelineStageFlags have the same values in VkPipelineStageFlags2KHR.
+        StageMasks stages = {srcStages, dstStages};
+        if (transferStage != 0 && (dstStages & VK_PIPELINE_STAGE_TRANSFER_BIT)) {
+            stages.dst = (stages.dst & ~VkPipelineStageFlags2KHR(VK_PIPELINE_STAGE_TRANSFER_BIT)) |
+                         transferStage;
+        }
+        return stages;
+    }
+
+    void BarrierBatch::RecordSynchronization2(CommandRecordingContext* recordingContext) {
+        ASSERT(mBufferBarrierStages.size() == mBufferBarriers.size());
+        ASSERT(mImageBarrierStages.size() == mImageBarriers.size());
+
+        // The access flags also have the same values in VkAccessFlags2KHR.
+        std::vector<VkBufferMemoryBarrier2KHR> bufferBarriers(mBufferBarriers.size());
+        for (size_t i = 0; i < mBufferBarriers.size(); ++i) {
+            const VkBufferMemoryBarrier& barrier = mBufferBarriers[i];
+            VkBufferMemoryBarrier2KHR& barrier2 = bufferBarriers[i];
+            barrier2.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2_KHR;
+            barrier2.pNext = nullptr;
+            barrier2.srcStageMask = mBufferBarrierStages[i].src;
+            barrier2.srcAccessMask = barrier.srcAccessMask;
+            barrier2.dstStageMask = mBufferBarrierStages[i].dst;
+            barrier2.dstAccessMask = barrier.dstAccessMask;
+            barrier2.srcQueueFamilyIndex = barrier.srcQueueFamilyIndex;
+            barrier2.dstQueueFamilyIndex = barrier.dstQueueFamilyIndex;
+            barrier2.buffer = barrier.buffer;
+            barrier2.offset = barrier.offset;
+            barrier2.size = barrier.size;
+        }
+
+        std::vector<VkImageMemoryBarrier2KHR> imageBarriers(mImageBarriers.size());
+        for (size_t i = 0; i < mImageBarriers.size(); ++i) {
+            const VkImageMemoryBarrier& barrier = mImageBarriers[i];
+            VkImageMemoryBarrier2KHR& barrier2 = imageBarriers[i];
+            barrier2.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2_KHR;
+            barrier2.pNext = nullptr;
+            barrier2.srcStageMask = mImageBarrierStages[i].src;
+            barrier2.srcAccessMask = barrier.srcAccessMask;
+            barrier2.dstStageMask = mImageBarrierStages[i].dst;
+            barrier2.dstAccessMask = barrier.dstAccessMask;
+            barrier2.oldLayout = barrier.oldLayout;
+            barrier2.newLayout = barrier.newLayout;
+            barrier2.srcQueueFamilyIndex = barrier.srcQueueFamilyIndex;
+            barrier2.dstQueueFamilyIndex = barrier.dstQueueFamilyIndex;
+            barrier2.image = barrier.image;
+            barrier2.subresourceRange = barrier.subresourceRange;
+        }
+
+        VkDependencyInfoKHR dependencyInfo;
+        dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO_KHR;
+        dependencyInfo.pNext = nullptr;
+        dependencyInfo.dependencyFlags = 0;
+        dependencyInfo.memoryBarrierCount = 0;
+        dependencyInfo.pMemoryBarriers = nullptr;
+        dependencyInfo.bufferMemoryBarrierCount = static_cast<uint32_t>(bufferBarriers.size());
+        dependencyInfo.pBufferMemoryBarriers = bufferBarriers.data();
+        dependencyInfo.imageMemoryBarrierCount = static_cast<uint32_t>(imageBarriers.size());
+        dependencyInfo.pImageMemoryBarriers = imageBarriers.data();
+
+        mDevice->fn.CmdPipelineBarrier2KHR(recordingContext->commandBuffer, &dependencyInfo);
+    }
+
+}  // namespace dawn::native::vulkan
@@ -0,0 +1,89 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_VULKAN_BARRIERBATCH_H_
+#define DAWNNATIVE_VULKAN_BARRIERBATCH_H_
+
+#include "dawn/common/NonCopyable.h"
+#include "dawn/common/vulkan_platform.h"
+#include "dawn/native/PassResourceUsage.h"
+#include "dawn/native/dawn_platform.h"
+
+#include <vector>
+
+namespace dawn::native {
+    struct SubresourceRange;
+}  // namespace dawn::native
+
+namespace dawn::native::vulkan {
+
+    class Buffer;
+    struct CommandRecordingContext;
+    class Device;
+    class Texture;
+
+    // Accumulates the barriers of several resource transitions so that they are recorded with a
+    // single pipeline barrier command. When VK_KHR_synchronization2 is enabled, the barriers are
+    // recorded with vkCmdPipelineBarrier2KHR, which lets each of them keep its own stage masks
+    // instead of the union of the stages of all the barriers.
+    class BarrierBatch : public NonCopyable {
+      public:
+        explicit BarrierBatch(Device* device);
+
+        // Transitions the resource to |usage|, adding the barriers needed to the batch. With
+        // synchronization2, |transferStage| is used instead of VK_PIPELINE_STAGE_TRANSFER_BIT in
+        // the destination stages, for example VK_PIPELINE_STAGE_2_COPY_BIT_KHR for copies.
+        void TransitionBuffer(Buffer* buffer,
+                              wgpu::BufferUsage usage,
+                              VkPipelineStageFlags2KHR transferStage);
+        void TransitionTexture(CommandRecordingContext* recordingContext,
+                               Texture* texture,
+                               wgpu::TextureUsage usage,
+                               const SubresourceRange& range,
+                               VkPipelineStageFlags2KHR transferStage);
+        void TransitionTextureForPass(CommandRecordingContext* recordingContext,
+                                      Texture* texture,
+                                      const TextureSubresourceUsage& textureUsages);
+
+        bool IsEmpty() const;
+
+        // Records the barriers of the batch, if any, and empties it.
+        void Record(CommandRecordingContext* recordingContext);
+
+      private:
+        struct StageMasks {
+            VkPipelineStageFlags2KHR src;
+            VkPipelineStageFlags2KHR dst;
+        };
+        StageMasks ComputeStageMasks(VkPipelineStageFlags srcStages,
+                                     VkPipelineStageFlags dstStages,
+                                     VkPipelineStageFlags2KHR transferStage);
+        void RecordSynchronization2(CommandRecordingContext* recordingContext);
+
+        Device* mDevice;
+        bool mUseSynchronization2;
+
+        std::vector<VkBufferMemoryBarrier> mBufferBarriers;
+        std::vector<VkImageMemoryBarrier> mImageBarriers;
+        // The stages of each barrier, only used with synchronization2.
+        std::vector<StageMasks> mBufferBarrierStages;
+        std::vector<StageMasks> mImageBarrierStages;
+        // The union of the stages of all the barriers.
+        VkPipelineStageFlags mSrcStages = 0;
+        VkPipelineStageFlags mDstStages = 0;
+    };
+
+}  // namespace dawn::native::vulkan
+
+#endif  // DAWNNATIVE_VULKAN_BARRIERBATCH_H_
@@ -18,6 +18,7 @@
 #include "dawn/common/ityp_vector.h"
 #include "dawn/native/vulkan/BindGroupVk.h"
 #include "dawn/native/vulkan/DescriptorSetAllocator.h"
+#include "dawn/native/vulkan/DescriptorWriteBatch.h"
 #include "dawn/native/vulkan/DeviceVk.h"
 #include "dawn/native/vulkan/FencedDeleter.h"
 #include "dawn/native/vulkan/UtilsVulkan.h"
@@ -122,6 +123,8 @@ namespace dawn::native::vulkan {
                                     device->GetVkDevice(), &createInfo, nullptr, &*mHandle),
                                 "CreateDescriptorSetLayout"));
 
+        DAWN_TRY(InitializeUpdateTemplate());
+
         // Compute the size of descriptor pools used for this layout.
         std::map<VkDescriptorType, uint32_t> descriptorCountPerType;
 
@@ -134,16 +137,55 @@ namespace dawn::native::vulkan {
             descriptorCountPerType[vulkanType]++;
         }
 
-        // TODO(enga): Consider deduping allocators for layouts with the same descriptor type
-        // counts.
-        mDescriptorSetAllocator =
-            DescriptorSetAllocator::Create(this, std::move(descriptorCountPerType));
+        mDescriptorSetBucket =
+            device->GetDescriptorSetAllocator()->GetBucket(descriptorCountPerType);
 
         SetLabelImpl();
 
         return {};
     }
 
+    MaybeError BindGroupLayout::InitializeUpdateTemplate() {
+        Device* device = ToBackend(GetDevice());
+        // Vulkan doesn't allow templates without entries.
+        if (!device->GetDeviceInfo().HasExt(DeviceExt::DescriptorUpdateTemplate) ||
+            GetBindingCount() == BindingIndex(0)) {
+            return {};
+        }
+
+        // Each binding is written from the DescriptorInfo at its BindingIndex.
+        ityp::vector<BindingIndex, VkDescriptorUpdateTemplateEntry> entries;
+        entries.reserve(GetBindingCount());
+        for (BindingIndex bindingIndex{0}; bindingIndex < GetBindingCount(); ++bindingIndex) {
+            VkDescriptorUpdateTemplateEntry entry;
+            entry.dstBinding = static_cast<uint32_t>(bindingIndex);
+            entry.dstArrayElement = 0;
+            entry.descriptorCount = 1;
+            entry.descriptorType = VulkanDescriptorType(GetBindingInfo(bindingIndex));
+            entry.offset = static_cast<uint32_t>(bindingIndex) * sizeof(DescriptorInfo);
+            entry.stride = sizeof(DescriptorInfo);
+
+            entries.emplace_back(entry);
+        }
+
+        VkDescriptorUpdateTemplateCreateInfo createInfo;
+        createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+        createInfo.pNext = nullptr;
+        createInfo.flags = 0;
+        createInfo.descriptorUpdateEntryCount = static_cast<uint32_t>(entries.size());
+        createInfo.pDescriptorUpdateEntries = entries.data();
+        createInfo.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+        createInfo.descriptorSetLayout = mHandle;
+        // Only used for push descriptors.
+        createInfo.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        createInfo.pipelineLayout = VK_NULL_HANDLE;
+        createInfo.set = 0;
+
+        return CheckVkSuccess(device->fn.CreateDescriptorUpdateTemplate(
+                                  device->GetVkDevice(), &createInfo, nullptr, &*mUpdateTemplate),
+                              "CreateDescriptorUpdateTemplate");
+    }
+
     BindGroupLayout::BindGroupLayout(DeviceBase* device,
                                      const BindGroupLayoutDescriptor* descriptor,
                                      PipelineCompatibilityToken pipelineCompatibilityToken)
@@ -158,6 +200,10 @@ namespace dawn::native::vulkan {
 
         Device* device = ToBackend(GetDevice());
 
+        // Descriptor sets can't be written after their layout is destroyed and the pending writes
+        // of our bind groups may use the update template, so do them now.
+        device->GetDescriptorWriteBatch()->Flush();
+
         // DescriptorSetLayout aren't used by execution on the GPU and can be deleted at any time,
         // so we can destroy mHandle immediately instead of using the FencedDeleter.
         // (Swiftshader implements this wrong b/154522740).
@@ -168,18 +214,29 @@ namespace dawn::native::vulkan {
             device->fn.DestroyDescriptorSetLayout(device->GetVkDevice(), mHandle, nullptr);
             mHandle = VK_NULL_HANDLE;
         }
-        mDescriptorSetAllocator = nullptr;
+        // Like DescriptorSetLayouts, update templates aren't used by execution on the GPU.
+        if (mUpdateTemplate != VK_NULL_HANDLE) {
+            device->fn.DestroyDescriptorUpdateTemplate(device->GetVkDevice(), mUpdateTemplate,
+                                                       nullptr);
+            mUpdateTemplate = VK_NULL_HANDLE;
+        }
     }
 
     VkDescriptorSetLayout BindGroupLayout::GetHandle() const {
         return mHandle;
     }
 
+    VkDescriptorUpdateTemplate BindGroupLayout::GetUpdateTemplate() const {
+        return mUpdateTemplate;
+    }
+
     ResultOrError<Ref<BindGroup>> BindGroupLayout::AllocateBindGroup(
         Device* device,
         const BindGroupDescriptor* descriptor) {
         DescriptorSetAllocation descriptorSetAllocation;
-        DAWN_TRY_ASSIGN(descriptorSetAllocation, mDescriptorSetAllocator->Allocate());
+        DescriptorSetAllocator* allocator = device->GetDescriptorSetAllocator();
+        DAWN_TRY_ASSIGN(descriptorSetAllocation,
+                        allocator->Allocate(mDescriptorSetBucket, mHandle));
 
         return AcquireRef(
             mBindGroupAllocator.Allocate(device, descriptor, descriptorSetAllocation));
@@ -187,7 +244,7 @@ namespace dawn::native::vulkan {
 
     void BindGroupLayout::DeallocateBindGroup(BindGroup* bindGroup,
                                               DescriptorSetAllocation* descriptorSetAllocation) {
-        mDescriptorSetAllocator->Deallocate(descriptorSetAllocation);
+        ToBackend(GetDevice())->GetDescriptorSetAllocator()->Deallocate(descriptorSetAllocation);
         mBindGroupAllocator.Deallocate(bindGroup);
     }
 
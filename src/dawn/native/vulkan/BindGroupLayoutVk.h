@@ -19,6 +19,7 @@
 
 #include "dawn/common/SlabAllocator.h"
 #include "dawn/common/vulkan_platform.h"
+#include "dawn/native/vulkan/DescriptorSetAllocator.h"
 
 #include <vector>
 
@@ -26,23 +27,13 @@ namespace dawn::native::vulkan {
 
     class BindGroup;
     struct DescriptorSetAllocation;
-    class DescriptorSetAllocator;
     class Device;
 
     VkDescriptorType VulkanDescriptorType(const BindingInfo& bindingInfo);
 
-    // In Vulkan descriptor pools have to be sized to an exact number of descriptors. This means
-    // it's hard to have something where we can mix different types of descriptor sets because
-    // we don't know if their vector of number of descriptors will be similar.
-    //
-    // That's why that in addition to containing the VkDescriptorSetLayout to create
-    // VkDescriptorSets for its bindgroups, the layout also acts as an allocator for the descriptor
-    // sets.
-    //
-    // The allocations is done with one pool per descriptor set, which is inefficient, but at least
-    // the pools are reused when no longer used. Minimizing the number of descriptor pool allocation
-    // is important because creating them can incur GPU memory allocation which is usually an
-    // expensive syscall.
+    // In addition to containing the VkDescriptorSetLayout to create VkDescriptorSets for its
+    // bindgroups, the layout allocates them from the bucket of the device's DescriptorSetAllocator
+    // matching its descriptor counts.
     class BindGroupLayout final : public BindGroupLayoutBase {
       public:
         static ResultOrError<Ref<BindGroupLayout>> Create(
@@ -55,6 +46,9 @@ namespace dawn::native::vulkan {
                         PipelineCompatibilityToken pipelineCompatibilityToken);
 
         VkDescriptorSetLayout GetHandle() const;
+        // The template writing all the bindings from an array of DescriptorInfo indexed by
+        // BindingIndex, or VK_NULL_HANDLE if templates aren't supported or the layout is empty.
+        VkDescriptorUpdateTemplate GetUpdateTemplate() const;
 
         ResultOrError<Ref<BindGroup>> AllocateBindGroup(Device* device,
                                                         const BindGroupDescriptor* descriptor);
@@ -64,15 +58,17 @@ namespace dawn::native::vulkan {
       private:
         ~BindGroupLayout() override;
         MaybeError Initialize();
+        MaybeError InitializeUpdateTemplate();
         void DestroyImpl() override;
 
         // Dawn API
         void SetLabelImpl() override;
 
         VkDescriptorSetLayout mHandle = VK_NULL_HANDLE;
+        VkDescriptorUpdateTemplate mUpdateTemplate = VK_NULL_HANDLE;
 
         SlabAllocator<BindGroup> mBindGroupAllocator;
-        Ref<DescriptorSetAllocator> mDescriptorSetAllocator;
+        DescriptorSetAllocator::BucketIndex mDescriptorSetBucket = 0;
     };
 
 }  // namespace dawn::native::vulkan
@@ -19,6 +19,7 @@
 #include "dawn/native/ExternalTexture.h"
 #include "dawn/native/vulkan/BindGroupLayoutVk.h"
 #include "dawn/native/vulkan/BufferVk.h"
+#include "dawn/native/vulkan/DescriptorWriteBatch.h"
 #include "dawn/native/vulkan/DeviceVk.h"
 #include "dawn/native/vulkan/FencedDeleter.h"
 #include "dawn/native/vulkan/SamplerVk.h"
@@ -26,6 +27,8 @@
 #include "dawn/native/vulkan/UtilsVulkan.h"
 #include "dawn/native/vulkan/VulkanError.h"
 
+#include <vector>
+
 namespace dawn::native::vulkan {
 
     // static
@@ -39,28 +42,22 @@ namespace dawn::native::vulkan {
                          DescriptorSetAllocation descriptorSetAllocation)
         : BindGroupBase(this, device, descriptor),
           mDescriptorSetAllocation(descriptorSetAllocation) {
-        // Now do a write of a single descriptor set with all possible chained data allocated on the
-        // stack.
-        const uint32_t bindingCount = static_cast<uint32_t>((GetLayout()->GetBindingCount()));
-        ityp::stack_vec<uint32_t, VkWriteDescriptorSet, kMaxOptimalBindingsPerGroup> writes(
+        // Gather the content of all the descriptors on the stack, then give them to the device
+        // that will write the descriptor set before the next submit.
+        BindGroupLayout* layout = ToBackend(GetLayout());
+        const BindingIndex bindingCount = layout->GetBindingCount();
+        ityp::stack_vec<BindingIndex, DescriptorInfo, kMaxOptimalBindingsPerGroup> infos(
             bindingCount);
-        ityp::stack_vec<uint32_t, VkDescriptorBufferInfo, kMaxOptimalBindingsPerGroup>
-            writeBufferInfo(bindingCount);
-        ityp::stack_vec<uint32_t, VkDescriptorImageInfo, kMaxOptimalBindingsPerGroup>
-            writeImageInfo(bindingCount);
-
-        uint32_t numWrites = 0;
-        for (const auto [_, bindingIndex] : GetLayout()->GetBindingMap()) {
-            const BindingInfo& bindingInfo = GetLayout()->GetBindingInfo(bindingIndex);
-
-            auto& write = writes[numWrites];
-            write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            write.pNext = nullptr;
-            write.dstSet = GetHandle();
-            write.dstBinding = static_cast<uint32_t>(bindingIndex);
-            write.dstArrayElement = 0;
-            write.descriptorCount = 1;
-            write.descriptorType = VulkanDescriptorType(bindingInfo);
+
+        // Bindings of destroyed resources aren't written since it would be a Vulkan Validation
+        // Layers error. This bind group won't be used as it is an error to submit a command
+        // buffer that references destroyed resources. Skipped bindings are rare, and in
+        // increasing order.
+        std::vector<BindingIndex> skippedBindings;
+
+        for (BindingIndex bindingIndex{0}; bindingIndex < bindingCount; ++bindingIndex) {
+            const BindingInfo& bindingInfo = layout->GetBindingInfo(bindingIndex);
+            DescriptorInfo& info = infos[bindingIndex];
 
             switch (bindingInfo.bindingType) {
                 case BindingInfoType::Buffer: {
@@ -68,23 +65,21 @@ namespace dawn::native::vulkan {
 
                     VkBuffer handle = ToBackend(binding.buffer)->GetHandle();
                     if (handle == VK_NULL_HANDLE) {
-                        // The Buffer was destroyed. Skip this descriptor write since it would be
-                        // a Vulkan Validation Layers error. This bind group won't be used as it
-                        // is an error to submit a command buffer that references destroyed
-                        // resources.
+                        // The Buffer was destroyed.
+                        skippedBindings.push_back(bindingIndex);
                         continue;
                     }
-                    writeBufferInfo[numWrites].buffer = handle;
-                    writeBufferInfo[numWrites].offset = binding.offset;
-                    writeBufferInfo[numWrites].range = binding.size;
-                    write.pBufferInfo = &writeBufferInfo[numWrites];
+                    // The descriptor set references the VkBuffer as long as it exists.
+                    ToBackend(binding.buffer)->PinHandle();
+                    info.buffer.buffer = handle;
+                    info.buffer.offset = binding.offset;
+                    info.buffer.range = binding.size;
                     break;
                 }
 
                 case BindingInfoType::Sampler: {
                     Sampler* sampler = ToBackend(GetBindingAsSampler(bindingIndex));
-                    writeImageInfo[numWrites].sampler = sampler->GetHandle();
-                    write.pImageInfo = &writeImageInfo[numWrites];
+                    info.image.sampler = sampler->GetHandle();
                     break;
                 }
 
@@ -94,20 +89,15 @@ namespace dawn::native::vulkan {
                     VkImageView handle = view->GetHandle();
                     if (handle == VK_NULL_HANDLE) {
                         // The Texture was destroyed before the TextureView was created.
-                        // Skip this descriptor write since it would be
-                        // a Vulkan Validation Layers error. This bind group won't be used as it
-                        // is an error to submit a command buffer that references destroyed
-                        // resources.
+                        skippedBindings.push_back(bindingIndex);
                         continue;
                     }
-                    writeImageInfo[numWrites].imageView = handle;
+                    info.image.imageView = handle;
 
                     // The layout may be GENERAL here because of interactions between the Sampled
                     // and ReadOnlyStorage usages. See the logic in VulkanImageLayout.
-                    writeImageInfo[numWrites].imageLayout = VulkanImageLayout(
-                        ToBackend(view->GetTexture()), wgpu::TextureUsage::TextureBinding);
-
-                    write.pImageInfo = &writeImageInfo[numWrites];
+                    info.image.imageLayout = VulkanImageLayout(ToBackend(view->GetTexture()),
+                                                               wgpu::TextureUsage::TextureBinding);
                     break;
                 }
 
@@ -117,16 +107,11 @@ namespace dawn::native::vulkan {
                     VkImageView handle = view->GetHandle();
                     if (handle == VK_NULL_HANDLE) {
                         // The Texture was destroyed before the TextureView was created.
-                        // Skip this descriptor write since it would be
-                        // a Vulkan Validation Layers error. This bind group won't be used as it
-                        // is an error to submit a command buffer that references destroyed
-                        // resources.
+                        skippedBindings.push_back(bindingIndex);
                         continue;
                     }
-                    writeImageInfo[numWrites].imageView = handle;
-                    writeImageInfo[numWrites].imageLayout = VK_IMAGE_LAYOUT_GENERAL;
-
-                    write.pImageInfo = &writeImageInfo[numWrites];
+                    info.image.imageView = handle;
+                    info.image.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
                     break;
                 }
 
@@ -134,13 +119,27 @@ namespace dawn::native::vulkan {
                     UNREACHABLE();
                     break;
             }
-
-            numWrites++;
         }
 
-        // TODO(crbug.com/dawn/855): Batch these updates
-        device->fn.UpdateDescriptorSets(device->GetVkDevice(), numWrites, writes.data(), 0,
-                                        nullptr);
+        // The update template writes all the bindings so it can't be used when some are skipped.
+        DescriptorWriteBatch* writeBatch = device->GetDescriptorWriteBatch();
+        VkDescriptorUpdateTemplate updateTemplate = layout->GetUpdateTemplate();
+        if (updateTemplate != VK_NULL_HANDLE && skippedBindings.empty()) {
+            writeBatch->EnqueueTemplateUpdate(GetHandle(), updateTemplate, infos.data(),
+                                              bindingCount);
+        } else {
+            auto nextSkippedBinding = skippedBindings.begin();
+            for (BindingIndex bindingIndex{0}; bindingIndex < bindingCount; ++bindingIndex) {
+                if (nextSkippedBinding != skippedBindings.end() &&
+                    *nextSkippedBinding == bindingIndex) {
+                    ++nextSkippedBinding;
+                    continue;
+                }
+                writeBatch->EnqueueWrite(GetHandle(), bindingIndex,
+                                         VulkanDescriptorType(layout->GetBindingInfo(bindingIndex)),
+                                         infos[bindingIndex]);
+            }
+        }
 
         SetLabelImpl();
     }
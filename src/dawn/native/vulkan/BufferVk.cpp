@@ -19,9 +19,11 @@
 #include "dawn/native/vulkan/FencedDeleter.h"
 #include "dawn/native/vulkan/ResourceHeapVk.h"
 #include "dawn/native/vulkan/ResourceMemoryAllocatorVk.h"
+#include "dawn/native/vulkan/TransferQueue.h"
 #include "dawn/native/vulkan/UtilsVulkan.h"
 #include "dawn/native/vulkan/VulkanError.h"
 
+#include <array>
 #include <cstring>
 
 namespace dawn::native::vulkan {
@@ -177,22 +179,8 @@ namespace dawn::native::vulkan {
             return DAWN_OUT_OF_MEMORY_ERROR("Buffer size is HUGE and could cause overflows");
         }
 
-        VkBufferCreateInfo createInfo;
-        createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-        createInfo.pNext = nullptr;
-        createInfo.flags = 0;
-        createInfo.size = mAllocatedSize;
-        // Add CopyDst for non-mappable buffer initialization with mappedAtCreation
-        // and robust resource initialization.
-        createInfo.usage = VulkanBufferUsage(GetUsage() | wgpu::BufferUsage::CopyDst);
-        createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-        createInfo.queueFamilyIndexCount = 0;
-        createInfo.pQueueFamilyIndices = 0;
-
         Device* device = ToBackend(GetDevice());
-        DAWN_TRY(CheckVkOOMThenSuccess(
-            device->fn.CreateBuffer(device->GetVkDevice(), &createInfo, nullptr, &*mHandle),
-            "vkCreateBuffer"));
+        DAWN_TRY(CreateHandle(&mHandle));
 
         // Gather requirements for the buffer's memory and allocate it.
         VkMemoryRequirements requirements;
@@ -212,6 +200,13 @@ namespace dawn::native::vulkan {
                                         mMemoryAllocation.GetOffset()),
             "vkBindBufferMemory"));
 
+        // Sub-allocated buffers can be moved to defragment the memory until their VkBuffer is
+        // referenced by objects other than the commands of a submit.
+        if (mMemoryAllocation.GetInfo().mMethod == AllocationMethod::kSubAllocated) {
+            mIsMovable = true;
+            device->GetResourceMemoryAllocator()->AddMovableBuffer(this);
+        }
+
         // The buffers with mappedAtCreation == true will be initialized in
         // BufferBase::MapAtCreation().
         if (device->IsToggleEnabled(Toggle::NonzeroClearResourcesOnCreationForTesting) &&
@@ -236,12 +231,104 @@ namespace dawn::native::vulkan {
         return {};
     }
 
+    MaybeError Buffer::CreateHandle(VkBuffer* handle) {
+        VkBufferCreateInfo createInfo;
+        createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        createInfo.pNext = nullptr;
+        createInfo.flags = 0;
+        createInfo.size = mAllocatedSize;
+        // Add CopyDst for non-mappable buffer initialization with mappedAtCreation
+        // and robust resource initialization.
+        createInfo.usage = VulkanBufferUsage(GetUsage() | wgpu::BufferUsage::CopyDst);
+        createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        createInfo.queueFamilyIndexCount = 0;
+        createInfo.pQueueFamilyIndices = 0;
+
+        Device* device = ToBackend(GetDevice());
+
+        // Buffers that can be written with Queue::WriteBuffer are shared with the transfer queue
+        // doing the uploads, if there is one.
+        TransferQueue* transferQueue = device->GetTransferQueue();
+        if (transferQueue != nullptr && (GetUsage() & wgpu::BufferUsage::CopyDst)) {
+            const std::array<uint32_t, 2>& queueFamilies =
+                transferQueue->GetSharedQueueFamilyIndices();
+            createInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+            createInfo.queueFamilyIndexCount = static_cast<uint32_t>(queueFamilies.size());
+            createInfo.pQueueFamilyIndices = queueFamilies.data();
+            mIsSharedWithTransferQueue = true;
+        }
+        return CheckVkOOMThenSuccess(
+            device->fn.CreateBuffer(device->GetVkDevice(), &createInfo, nullptr, &**handle),
+            "vkCreateBuffer");
+    }
+
     Buffer::~Buffer() = default;
 
     VkBuffer Buffer::GetHandle() const {
         return mHandle;
     }
 
+    const ResourceMemoryAllocation& Buffer::GetMemoryAllocation() const {
+        return mMemoryAllocation;
+    }
+
+    void Buffer::PinHandle() {
+        if (mIsMovable) {
+            mIsMovable = false;
+            ToBackend(GetDevice())->GetResourceMemoryAllocator()->RemoveMovableBuffer(this);
+        }
+    }
+
+    ResultOrError<bool> Buffer::MoveToExistingHeaps(
+        CommandRecordingContext* recordingContext,
+        const std::function<bool(const ResourceHeapBase*)>& isHeapUsable) {
+        ASSERT(mIsMovable);
+        Device* device = ToBackend(GetDevice());
+        ResourceMemoryAllocator* allocator = device->GetResourceMemoryAllocator();
+
+        VkBuffer newHandle = VK_NULL_HANDLE;
+        DAWN_TRY(CreateHandle(&newHandle));
+
+        VkMemoryRequirements requirements;
+        device->fn.GetBufferMemoryRequirements(device->GetVkDevice(), newHandle, &requirements);
+        ResourceMemoryAllocation newAllocation =
+            allocator->AllocateInExistingHeaps(requirements, MemoryKind::Linear, isHeapUsable);
+        if (newAllocation.GetInfo().mMethod == AllocationMethod::kInvalid) {
+            device->fn.DestroyBuffer(device->GetVkDevice(), newHandle, nullptr);
+            return false;
+        }
+
+        DAWN_TRY_WITH_CLEANUP(
+            CheckVkSuccess(
+                device->fn.BindBufferMemory(device->GetVkDevice(), newHandle,
+                                            ToBackend(newAllocation.GetResourceHeap())->GetMemory(),
+                                            newAllocation.GetOffset()),
+                "vkBindBufferMemory"),
+            {
+                allocator->Deallocate(&newAllocation);
+                device->fn.DestroyBuffer(device->GetVkDevice(), newHandle, nullptr);
+            });
+
+        TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopySrc);
+        VkBufferCopy region;
+        region.srcOffset = 0;
+        region.dstOffset = 0;
+        region.size = GetAllocatedSize();
+        device->fn.CmdCopyBuffer(recordingContext->commandBuffer, mHandle, newHandle, 1, &region);
+
+        // The old VkBuffer and memory are freed once the copy is complete.
+        device->GetFencedDeleter()->DeleteWhenUnused(mHandle);
+        allocator->Deallocate(&mMemoryAllocation);
+
+        mHandle = newHandle;
+        mMemoryAllocation = newAllocation;
+        // The new VkBuffer was last written by the copy, which the next transition waits for.
+        mLastUsage = wgpu::BufferUsage::CopyDst;
+        SetLabelImpl();
+
+        return true;
+    }
+
     void Buffer::TransitionUsageNow(CommandRecordingContext* recordingContext,
                                     wgpu::BufferUsage usage) {
         VkBufferMemoryBarrier barrier;
@@ -253,6 +340,8 @@ namespace dawn::native::vulkan {
             ToBackend(GetDevice())
                 ->fn.CmdPipelineBarrier(recordingContext->commandBuffer, srcStages, dstStages, 0, 0,
                                         nullptr, 1u, &barrier, 0, nullptr);
+            recordingContext->pipelineBarrierCount++;
+            recordingContext->memoryBarrierCount++;
         }
     }
 
@@ -260,6 +349,8 @@ namespace dawn::native::vulkan {
                                                       VkBufferMemoryBarrier* barrier,
                                                       VkPipelineStageFlags* srcStages,
                                                       VkPipelineStageFlags* dstStages) {
+        mLastMainQueueUsageSerial = GetDevice()->GetPendingCommandSerial();
+
         bool lastIncludesTarget = IsSubset(usage, mLastUsage);
         bool lastReadOnly = IsSubset(mLastUsage, kReadOnlyBufferUsages);
 
@@ -293,6 +384,41 @@ namespace dawn::native::vulkan {
         return true;
     }
 
+    bool Buffer::IsSharedWithTransferQueue() const {
+        return mIsSharedWithTransferQueue;
+    }
+
+    ExecutionSerial Buffer::GetLastMainQueueUsageSerial() const {
+        return mLastMainQueueUsageSerial;
+    }
+
+    void Buffer::TransitionToCopyDstOnTransferQueue(CommandRecordingContext* recordingContext) {
+        ASSERT(mIsSharedWithTransferQueue);
+
+        // The transfer queue waits for the commands of the main queue using the buffer, so only
+        // the previous uploads on the transfer queue need a barrier.
+        if (mLastUsage != wgpu::BufferUsage::None) {
+            VkBufferMemoryBarrier barrier;
+            barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+            barrier.pNext = nullptr;
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.srcQueueFamilyIndex = 0;
+            barrier.dstQueueFamilyIndex = 0;
+            barrier.buffer = mHandle;
+            barrier.offset = 0;
+            barrier.size = GetAllocatedSize();
+
+            ToBackend(GetDevice())
+                ->fn.CmdPipelineBarrier(recordingContext->commandBuffer,
+                                        VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                        VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 1u,
+                                        &barrier, 0, nullptr);
+        }
+
+        mLastUsage = wgpu::BufferUsage::CopyDst;
+    }
+
     bool Buffer::IsCPUWritableAtCreation() const {
         // TODO(enga): Handle CPU-visible memory on UMA
         return mMemoryAllocation.GetMappedPointer() != nullptr;
@@ -308,7 +434,7 @@ namespace dawn::native::vulkan {
         CommandRecordingContext* recordingContext = device->GetPendingRecordingContext();
 
         // TODO(crbug.com/dawn/852): initialize mapped buffer in CPU side.
-        EnsureDataInitialized(recordingContext);
+        EnsureDataInitialized(recordingContext, offset, size);
 
         if (mode & wgpu::MapMode::Read) {
             TransitionUsageNow(recordingContext, wgpu::BufferUsage::MapRead);
@@ -332,6 +458,9 @@ namespace dawn::native::vulkan {
     void Buffer::DestroyImpl() {
         BufferBase::DestroyImpl();
 
+        // Destroyed buffers are no longer moved by the defragmentation.
+        PinHandle();
+
         ToBackend(GetDevice())->GetResourceMemoryAllocator()->Deallocate(&mMemoryAllocation);
 
         if (mHandle != VK_NULL_HANDLE) {
@@ -341,28 +470,32 @@ namespace dawn::native::vulkan {
     }
 
     bool Buffer::EnsureDataInitialized(CommandRecordingContext* recordingContext) {
-        if (!NeedsInitialization()) {
+        return EnsureDataInitialized(recordingContext, 0, GetAllocatedSize());
+    }
+
+    bool Buffer::EnsureDataInitialized(CommandRecordingContext* recordingContext,
+                                       uint64_t offset,
+                                       uint64_t size) {
+        if (!NeedsInitialization(offset, size)) {
             return false;
         }
 
-        InitializeToZero(recordingContext);
+        InitializeToZero(recordingContext, offset, size);
         return true;
     }
 
-    bool Buffer::EnsureDataInitializedAsDestination(CommandRecordingContext* recordingContext,
+    void Buffer::EnsureDataInitializedAsDestination(CommandRecordingContext* recordingContext,
                                                     uint64_t offset,
                                                     uint64_t size) {
         if (!NeedsInitialization()) {
-            return false;
+            return;
         }
 
         if (IsFullBufferRange(offset, size)) {
             SetIsDataInitialized();
-            return false;
+        } else {
+            SetIsDataInitialized(offset, size);
         }
-
-        InitializeToZero(recordingContext);
-        return true;
     }
 
     bool Buffer::EnsureDataInitializedAsDestination(CommandRecordingContext* recordingContext,
@@ -376,7 +509,7 @@ namespace dawn::native::vulkan {
             return false;
         }
 
-        InitializeToZero(recordingContext);
+        InitializeToZero(recordingContext, 0, GetAllocatedSize());
         return true;
     }
 
@@ -385,12 +518,16 @@ namespace dawn::native::vulkan {
                      reinterpret_cast<uint64_t&>(mHandle), "Dawn_Buffer", GetLabel());
     }
 
-    void Buffer::InitializeToZero(CommandRecordingContext* recordingContext) {
+    void Buffer::InitializeToZero(CommandRecordingContext* recordingContext,
+                                  uint64_t offset,
+                                  uint64_t size) {
         ASSERT(NeedsInitialization());
 
-        ClearBuffer(recordingContext, 0u);
+        for (const IntervalSet::Interval& range : GetUninitializedRanges(offset, size)) {
+            ClearBuffer(recordingContext, 0u, range.offset, range.size);
+            SetIsDataInitialized(range.offset, range.size);
+        }
         GetDevice()->IncrementLazyClearCountForTesting();
-        SetIsDataInitialized();
     }
 
     void Buffer::ClearBuffer(CommandRecordingContext* recordingContext,
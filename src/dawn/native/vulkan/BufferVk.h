@@ -21,6 +21,8 @@
 #include "dawn/common/vulkan_platform.h"
 #include "dawn/native/ResourceMemoryAllocation.h"
 
+#include <functional>
+
 namespace dawn::native::vulkan {
 
     struct CommandRecordingContext;
@@ -32,6 +34,19 @@ namespace dawn::native::vulkan {
                                                  const BufferDescriptor* descriptor);
 
         VkBuffer GetHandle() const;
+        const ResourceMemoryAllocation& GetMemoryAllocation() const;
+
+        // Must be called when the VkBuffer is referenced by objects that outlive the commands of
+        // a submit, like descriptor sets or secondary command buffers, after which the buffer
+        // can no longer be moved to other memory.
+        void PinHandle();
+
+        // Moves the buffer to a new VkBuffer sub-allocated in the existing memory blocks that
+        // |isHeapUsable| accepts, recording the copy of its content in |recordingContext|.
+        // Returns false if there isn't enough space in them.
+        ResultOrError<bool> MoveToExistingHeaps(
+            CommandRecordingContext* recordingContext,
+            const std::function<bool(const ResourceHeapBase*)>& isHeapUsable);
 
         // Transitions the buffer to be used as `usage`, recording any necessary barrier in
         // `commands`.
@@ -42,9 +57,21 @@ namespace dawn::native::vulkan {
                                                   VkPipelineStageFlags* srcStages,
                                                   VkPipelineStageFlags* dstStages);
 
-        // All the Ensure methods return true if the buffer was initialized to zero.
+        // Whether the buffer can be uploaded to on the dedicated transfer queue.
+        bool IsSharedWithTransferQueue() const;
+        // The last serial of the main queue whose commands use the buffer.
+        ExecutionSerial GetLastMainQueueUsageSerial() const;
+        // Records in the commands of the transfer queue the barrier ordering an upload with the
+        // previous uploads to the buffer.
+        void TransitionToCopyDstOnTransferQueue(CommandRecordingContext* recordingContext);
+
+        // The Ensure methods returning a bool return true if some of the buffer was initialized
+        // to zero.
         bool EnsureDataInitialized(CommandRecordingContext* recordingContext);
-        bool EnsureDataInitializedAsDestination(CommandRecordingContext* recordingContext,
+        bool EnsureDataInitialized(CommandRecordingContext* recordingContext,
+                                   uint64_t offset,
+                                   uint64_t size);
+        void EnsureDataInitializedAsDestination(CommandRecordingContext* recordingContext,
                                                 uint64_t offset,
                                                 uint64_t size);
         bool EnsureDataInitializedAsDestination(CommandRecordingContext* recordingContext,
@@ -58,7 +85,10 @@ namespace dawn::native::vulkan {
         using BufferBase::BufferBase;
 
         MaybeError Initialize(bool mappedAtCreation);
-        void InitializeToZero(CommandRecordingContext* recordingContext);
+        MaybeError CreateHandle(VkBuffer* handle);
+        void InitializeToZero(CommandRecordingContext* recordingContext,
+                              uint64_t offset,
+                              uint64_t size);
         void ClearBuffer(CommandRecordingContext* recordingContext,
                          uint32_t clearValue,
                          uint64_t offset = 0,
@@ -75,6 +105,12 @@ namespace dawn::native::vulkan {
         ResourceMemoryAllocation mMemoryAllocation;
 
         wgpu::BufferUsage mLastUsage = wgpu::BufferUsage::None;
+
+        bool mIsSharedWithTransferQueue = false;
+        ExecutionSerial mLastMainQueueUsageSerial = ExecutionSerial(0);
+
+        // Whether the buffer can be moved by the defragmentation of the memory.
+        bool mIsMovable = false;
     };
 
 }  // namespace dawn::native::vulkan
@@ -21,22 +21,27 @@
 #include "dawn/native/DynamicUploader.h"
 #include "dawn/native/EnumMaskIterator.h"
 #include "dawn/native/RenderBundle.h"
+#include "dawn/native/vulkan/BarrierBatch.h"
 #include "dawn/native/vulkan/BindGroupVk.h"
 #include "dawn/native/vulkan/BufferVk.h"
 #include "dawn/native/vulkan/CommandRecordingContext.h"
 #include "dawn/native/vulkan/ComputePipelineVk.h"
 #include "dawn/native/vulkan/DeviceVk.h"
-#include "dawn/native/vulkan/FencedDeleter.h"
+#include "dawn/native/vulkan/FramebufferCache.h"
 #include "dawn/native/vulkan/PipelineLayoutVk.h"
 #include "dawn/native/vulkan/QuerySetVk.h"
+#include "dawn/native/vulkan/RenderBundleVk.h"
 #include "dawn/native/vulkan/RenderPassCache.h"
 #include "dawn/native/vulkan/RenderPipelineVk.h"
 #include "dawn/native/vulkan/StagingBufferVk.h"
 #include "dawn/native/vulkan/TextureVk.h"
 #include "dawn/native/vulkan/UtilsVulkan.h"
 #include "dawn/native/vulkan/VulkanError.h"
+#include "dawn/platform/DawnPlatform.h"
+#include "dawn/platform/tracing/TraceEvent.h"
 
 #include <algorithm>
+#include <unordered_map>
 
 namespace dawn::native::vulkan {
 
@@ -153,95 +158,132 @@ namespace dawn::native::vulkan {
             }
         };
 
+        // Subresources of a texture that are lazily cleared before a pass or a batch of copies.
+        struct LazyTextureClear {
+            Texture* texture;
+            SubresourceRange range;
+        };
+
+        // Adds |range| of |texture| to |clears| if it isn't initialized yet.
+        void AddLazyTextureClear(std::vector<LazyTextureClear>* clears,
+                                 Texture* texture,
+                                 const SubresourceRange& range) {
+            if (!texture->NeedsLazyClear(range)) {
+                return;
+            }
+            // Several copies of a batch can read the same subresources.
+            for (const LazyTextureClear& clear : *clears) {
+                if (clear.texture == texture && clear.range == range) {
+                    return;
+                }
+            }
+            clears->push_back({texture, range});
+        }
+
+        // Records the lazy clears of |clears| after a single barrier transitioning all of them to
+        // CopyDst, instead of one barrier per cleared texture.
+        void RecordLazyTextureClears(Device* device,
+                                     CommandRecordingContext* recordingContext,
+                                     const std::vector<LazyTextureClear>& clears) {
+            if (clears.empty()) {
+                return;
+            }
+
+            BarrierBatch barriers(device);
+            for (const LazyTextureClear& clear : clears) {
+                barriers.TransitionTexture(recordingContext, clear.texture,
+                                           wgpu::TextureUsage::CopyDst, clear.range, 0);
+            }
+            barriers.Record(recordingContext);
+
+            for (const LazyTextureClear& clear : clears) {
+                clear.texture->LazyClearInCopyDst(recordingContext, clear.range);
+            }
+        }
+
         // Records the necessary barriers for a synchronization scope using the resource usage
         // data pre-computed in the frontend. Also performs lazy initialization if required.
         void TransitionAndClearForSyncScope(Device* device,
                                             CommandRecordingContext* recordingContext,
                                             const SyncScopeResourceUsage& scope) {
-            std::vector<VkBufferMemoryBarrier> bufferBarriers;
-            std::vector<VkImageMemoryBarrier> imageBarriers;
-            VkPipelineStageFlags srcStages = 0;
-            VkPipelineStageFlags dstStages = 0;
-
-            for (size_t i = 0; i < scope.buffers.size(); ++i) {
-                Buffer* buffer = ToBackend(scope.buffers[i]);
-                buffer->EnsureDataInitialized(recordingContext);
-
-                VkBufferMemoryBarrier bufferBarrier;
-                if (buffer->TransitionUsageAndGetResourceBarrier(
-                        scope.bufferUsages[i], &bufferBarrier, &srcStages, &dstStages)) {
-                    bufferBarriers.push_back(bufferBarrier);
-                }
-            }
-
+            // Clear subresources that are not render attachments. Render attachments will be
+            // cleared in RecordBeginRenderPass by setting the loadop to clear when the texture
+            // subresource has not been initialized before the render pass.
+            std::vector<LazyTextureClear> clears;
             for (size_t i = 0; i < scope.textures.size(); ++i) {
                 Texture* texture = ToBackend(scope.textures[i]);
-
-                // Clear subresources that are not render attachments. Render attachments will be
-                // cleared in RecordBeginRenderPass by setting the loadop to clear when the texture
-                // subresource has not been initialized before the render pass.
                 scope.textureUsages[i].Iterate(
                     [&](const SubresourceRange& range, wgpu::TextureUsage usage) {
                         if (usage & ~wgpu::TextureUsage::RenderAttachment) {
-                            texture->EnsureSubresourceContentInitialized(recordingContext, range);
+                            AddLazyTextureClear(&clears, texture, range);
                         }
                     });
-                texture->TransitionUsageForPass(recordingContext, scope.textureUsages[i],
-                                                &imageBarriers, &srcStages, &dstStages);
+            }
+            RecordLazyTextureClears(device, recordingContext, clears);
+
+            BarrierBatch barriers(device);
+
+            for (size_t i = 0; i < scope.buffers.size(); ++i) {
+                Buffer* buffer = ToBackend(scope.buffers[i]);
+                buffer->EnsureDataInitialized(recordingContext);
+                barriers.TransitionBuffer(buffer, scope.bufferUsages[i], 0);
             }
 
-            if (bufferBarriers.size() || imageBarriers.size()) {
-                device->fn.CmdPipelineBarrier(recordingContext->commandBuffer, srcStages, dstStages,
-                                              0, 0, nullptr, bufferBarriers.size(),
-                                              bufferBarriers.data(), imageBarriers.size(),
-                                              imageBarriers.data());
+            for (size_t i = 0; i < scope.textures.size(); ++i) {
+                barriers.TransitionTextureForPass(recordingContext, ToBackend(scope.textures[i]),
+                                                  scope.textureUsages[i]);
             }
+
+            barriers.Record(recordingContext);
         }
 
-        MaybeError RecordBeginRenderPass(CommandRecordingContext* recordingContext,
-                                         Device* device,
-                                         BeginRenderPassCmd* renderPass) {
-            VkCommandBuffer commands = recordingContext->commandBuffer;
+        // Queries the VkRenderPass of |renderPass| from the cache.
+        ResultOrError<VkRenderPass> GetRenderPass(Device* device, BeginRenderPassCmd* renderPass) {
+            RenderPassCacheQuery query;
 
-            // Query a VkRenderPass from the cache
-            VkRenderPass renderPassVK = VK_NULL_HANDLE;
-            {
-                RenderPassCacheQuery query;
+            for (ColorAttachmentIndex i :
+                 IterateBitSet(renderPass->attachmentState->GetColorAttachmentsMask())) {
+                const auto& attachmentInfo = renderPass->colorAttachments[i];
 
-                for (ColorAttachmentIndex i :
-                     IterateBitSet(renderPass->attachmentState->GetColorAttachmentsMask())) {
-                    const auto& attachmentInfo = renderPass->colorAttachments[i];
+                bool hasResolveTarget = attachmentInfo.resolveTarget != nullptr;
 
-                    bool hasResolveTarget = attachmentInfo.resolveTarget != nullptr;
+                query.SetColor(i, attachmentInfo.view->GetFormat().format, attachmentInfo.loadOp,
+                               attachmentInfo.storeOp, hasResolveTarget);
+            }
 
-                    query.SetColor(i, attachmentInfo.view->GetFormat().format,
-                                   attachmentInfo.loadOp, attachmentInfo.storeOp, hasResolveTarget);
-                }
+            if (renderPass->attachmentState->HasDepthStencilAttachment()) {
+                const auto& attachmentInfo = renderPass->depthStencilAttachment;
 
-                if (renderPass->attachmentState->HasDepthStencilAttachment()) {
-                    const auto& attachmentInfo = renderPass->depthStencilAttachment;
+                query.SetDepthStencil(attachmentInfo.view->GetTexture()->GetFormat().format,
+                                      attachmentInfo.depthLoadOp, attachmentInfo.depthStoreOp,
+                                      attachmentInfo.stencilLoadOp, attachmentInfo.stencilStoreOp,
+                                      attachmentInfo.depthReadOnly ||
+                                          attachmentInfo.stencilReadOnly);
+            }
 
-                    query.SetDepthStencil(
-                        attachmentInfo.view->GetTexture()->GetFormat().format,
-                        attachmentInfo.depthLoadOp, attachmentInfo.depthStoreOp,
-                        attachmentInfo.stencilLoadOp, attachmentInfo.stencilStoreOp,
-                        attachmentInfo.depthReadOnly || attachmentInfo.stencilReadOnly);
-                }
+            query.SetSampleCount(renderPass->attachmentState->GetSampleCount());
 
-                query.SetSampleCount(renderPass->attachmentState->GetSampleCount());
+            return device->GetRenderPassCache()->GetRenderPass(query);
+        }
 
-                DAWN_TRY_ASSIGN(renderPassVK, device->GetRenderPassCache()->GetRenderPass(query));
-            }
+        // Begins the render pass and returns its VkRenderPass.
+        ResultOrError<VkRenderPass> RecordBeginRenderPass(CommandRecordingContext* recordingContext,
+                                                          Device* device,
+                                                          BeginRenderPassCmd* renderPass,
+                                                          VkSubpassContents contents) {
+            VkCommandBuffer commands = recordingContext->commandBuffer;
 
-            // Create a framebuffer that will be used once for the render pass and gather the clear
-            // values for the attachments at the same time.
-            std::array<VkClearValue, kMaxColorAttachments + 1> clearValues;
-            VkFramebuffer framebuffer = VK_NULL_HANDLE;
-            uint32_t attachmentCount = 0;
-            {
-                // Fill in the attachment info that will be chained in the framebuffer create info.
-                std::array<VkImageView, kMaxColorAttachments * 2 + 1> attachments;
+            VkRenderPass renderPassVK;
+            DAWN_TRY_ASSIGN(renderPassVK, GetRenderPass(device, renderPass));
 
+            // Get a framebuffer for the render pass from the cache and gather the clear values for
+            // the attachments at the same time.
+            std::array<VkClearValue, kMaxFramebufferAttachments> clearValues;
+            FramebufferCacheQuery framebufferQuery;
+            framebufferQuery.renderPass = renderPassVK;
+            framebufferQuery.width = renderPass->width;
+            framebufferQuery.height = renderPass->height;
+            {
                 for (ColorAttachmentIndex i :
                      IterateBitSet(renderPass->attachmentState->GetColorAttachmentsMask())) {
                     auto& attachmentInfo = renderPass->colorAttachments[i];
@@ -250,14 +292,15 @@ namespace dawn::native::vulkan {
                         continue;
                     }
 
-                    attachments[attachmentCount] = view->GetHandle();
+                    const uint32_t attachmentIndex = framebufferQuery.attachmentCount;
+                    framebufferQuery.AddAttachment(view);
 
                     switch (view->GetFormat().GetAspectInfo(Aspect::Color).baseType) {
                         case wgpu::TextureComponentType::Float: {
                             const std::array<float, 4> appliedClearColor =
                                 ConvertToFloatColor(attachmentInfo.clearColor);
                             for (uint32_t i = 0; i < 4; ++i) {
-                                clearValues[attachmentCount].color.float32[i] =
+                                clearValues[attachmentIndex].color.float32[i] =
                                     appliedClearColor[i];
                             }
                             break;
@@ -266,7 +309,7 @@ namespace dawn::native::vulkan {
                             const std::array<uint32_t, 4> appliedClearColor =
                                 ConvertToUnsignedIntegerColor(attachmentInfo.clearColor);
                             for (uint32_t i = 0; i < 4; ++i) {
-                                clearValues[attachmentCount].color.uint32[i] = appliedClearColor[i];
+                                clearValues[attachmentIndex].color.uint32[i] = appliedClearColor[i];
                             }
                             break;
                         }
@@ -274,7 +317,7 @@ namespace dawn::native::vulkan {
                             const std::array<int32_t, 4> appliedClearColor =
                                 ConvertToSignedIntegerColor(attachmentInfo.clearColor);
                             for (uint32_t i = 0; i < 4; ++i) {
-                                clearValues[attachmentCount].color.int32[i] = appliedClearColor[i];
+                                clearValues[attachmentIndex].color.int32[i] = appliedClearColor[i];
                             }
                             break;
                         }
@@ -282,70 +325,62 @@ namespace dawn::native::vulkan {
                         case wgpu::TextureComponentType::DepthComparison:
                             UNREACHABLE();
                     }
-                    attachmentCount++;
                 }
 
                 if (renderPass->attachmentState->HasDepthStencilAttachment()) {
                     auto& attachmentInfo = renderPass->depthStencilAttachment;
                     TextureView* view = ToBackend(attachmentInfo.view.Get());
 
-                    attachments[attachmentCount] = view->GetHandle();
-
-                    clearValues[attachmentCount].depthStencil.depth = attachmentInfo.clearDepth;
-                    clearValues[attachmentCount].depthStencil.stencil = attachmentInfo.clearStencil;
+                    const uint32_t attachmentIndex = framebufferQuery.attachmentCount;
+                    framebufferQuery.AddAttachment(view);
 
-                    attachmentCount++;
+                    clearValues[attachmentIndex].depthStencil.depth = attachmentInfo.clearDepth;
+                    clearValues[attachmentIndex].depthStencil.stencil = attachmentInfo.clearStencil;
                 }
 
                 for (ColorAttachmentIndex i :
                      IterateBitSet(renderPass->attachmentState->GetColorAttachmentsMask())) {
                     if (renderPass->colorAttachments[i].resolveTarget != nullptr) {
-                        TextureView* view =
-                            ToBackend(renderPass->colorAttachments[i].resolveTarget.Get());
-
-                        attachments[attachmentCount] = view->GetHandle();
-
-                        attachmentCount++;
+                        framebufferQuery.AddAttachment(
+                            ToBackend(renderPass->colorAttachments[i].resolveTarget.Get()));
                     }
                 }
-
-                // Chain attachments and create the framebuffer
-                VkFramebufferCreateInfo createInfo;
-                createInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-                createInfo.pNext = nullptr;
-                createInfo.flags = 0;
-                createInfo.renderPass = renderPassVK;
-                createInfo.attachmentCount = attachmentCount;
-                createInfo.pAttachments = AsVkArray(attachments.data());
-                createInfo.width = renderPass->width;
-                createInfo.height = renderPass->height;
-                createInfo.layers = 1;
-
-                DAWN_TRY(
-                    CheckVkSuccess(device->fn.CreateFramebuffer(device->GetVkDevice(), &createInfo,
-                                                                nullptr, &*framebuffer),
-                                   "CreateFramebuffer"));
-
-                // We don't reuse VkFramebuffers so mark the framebuffer for deletion as soon as the
-                // commands currently being recorded are finished.
-                device->GetFencedDeleter()->DeleteWhenUnused(framebuffer);
             }
 
+            FramebufferCache::Framebuffer framebuffer;
+            DAWN_TRY_ASSIGN(framebuffer,
+                            device->GetFramebufferCache()->GetFramebuffer(framebufferQuery));
+
             VkRenderPassBeginInfo beginInfo;
             beginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
             beginInfo.pNext = nullptr;
             beginInfo.renderPass = renderPassVK;
-            beginInfo.framebuffer = framebuffer;
+            beginInfo.framebuffer = framebuffer.handle;
             beginInfo.renderArea.offset.x = 0;
             beginInfo.renderArea.offset.y = 0;
             beginInfo.renderArea.extent.width = renderPass->width;
             beginInfo.renderArea.extent.height = renderPass->height;
-            beginInfo.clearValueCount = attachmentCount;
+            beginInfo.clearValueCount = framebufferQuery.attachmentCount;
             beginInfo.pClearValues = clearValues.data();
 
-            device->fn.CmdBeginRenderPass(commands, &beginInfo, VK_SUBPASS_CONTENTS_INLINE);
+            // Imageless framebuffers get their attachments when the render pass begins.
+            std::array<VkImageView, kMaxFramebufferAttachments> attachments;
+            VkRenderPassAttachmentBeginInfo attachmentBeginInfo;
+            if (framebuffer.isImageless) {
+                for (uint32_t i = 0; i < framebufferQuery.attachmentCount; ++i) {
+                    attachments[i] = framebufferQuery.attachments[i]->GetHandle();
+                }
+
+                attachmentBeginInfo.attachmentCount = framebufferQuery.attachmentCount;
+                attachmentBeginInfo.pAttachments = AsVkArray(attachments.data());
+                PNextChainBuilder beginInfoChain(&beginInfo);
+                beginInfoChain.Add(&attachmentBeginInfo,
+                                   VK_STRUCTURE_TYPE_RENDER_PASS_ATTACHMENT_BEGIN_INFO);
+            }
+
+            device->fn.CmdBeginRenderPass(commands, &beginInfo, contents);
 
-            return {};
+            return renderPassVK;
         }
 
         // Reset the query sets used on render pass because the reset command must be called outside
@@ -432,8 +467,523 @@ namespace dawn::native::vulkan {
             }
         }
 
+        // Returns, for each render pass of |commands|, whether it only executes render bundles and
+        // sets dynamic state. The bundles of these render passes can be executed as secondary
+        // command buffers because there are no other commands to record in the render pass.
+        std::vector<bool> FindRenderPassesOnlyExecutingBundles(Device* device,
+                                                               CommandIterator* commands) {
+            std::vector<bool> onlyExecutesBundles;
+            bool inRenderPass = false;
+            bool hasBundles = false;
+            bool hasOtherCommands = false;
+
+            Command type;
+            while (commands->NextCommandId(&type)) {
+                switch (type) {
+                    case Command::BeginRenderPass:
+                        commands->NextCommand<BeginRenderPassCmd>();
+                        inRenderPass = true;
+                        hasBundles = false;
+                        hasOtherCommands = false;
+                        break;
+
+                    case Command::EndRenderPass:
+                        commands->NextCommand<EndRenderPassCmd>();
+                        onlyExecutesBundles.push_back(hasBundles && !hasOtherCommands);
+                        inRenderPass = false;
+                        break;
+
+                    case Command::ExecuteBundles: {
+                        ExecuteBundlesCmd* cmd = commands->NextCommand<ExecuteBundlesCmd>();
+                        auto bundles = commands->NextData<Ref<RenderBundleBase>>(cmd->count);
+                        // Executing an empty list of bundles records nothing.
+                        hasBundles |= cmd->count > 0;
+                        for (uint32_t i = 0; i < cmd->count; ++i) {
+                            if (!RenderBundleCommandBuffers::GetOrCreate(device, bundles[i].Get())
+                                     ->CanUseSecondaryCommandBuffer()) {
+                                hasOtherCommands = true;
+                            }
+                        }
+                        break;
+                    }
+
+                    case Command::SetBlendConstant:
+                    case Command::SetStencilReference:
+                    case Command::SetViewport:
+                    case Command::SetScissorRect:
+                        SkipCommand(commands, type);
+                        break;
+
+                    default:
+                        hasOtherCommands |= inRenderPass;
+                        SkipCommand(commands, type);
+                        break;
+                }
+            }
+            commands->Reset();
+
+            return onlyExecutesBundles;
+        }
+
+        // Returns, for each render pass of |commands|, whether it executes render bundles. The
+        // commands of render bundles can't be recorded on worker threads since the iterator of a
+        // bundle is shared by all the render passes executing it.
+        std::vector<bool> FindRenderPassesExecutingBundles(CommandIterator* commands) {
+            std::vector<bool> executesBundles;
+
+            Command type;
+            while (commands->NextCommandId(&type)) {
+                switch (type) {
+                    case Command::BeginRenderPass:
+                        commands->NextCommand<BeginRenderPassCmd>();
+                        executesBundles.push_back(false);
+                        break;
+
+                    case Command::ExecuteBundles:
+                        executesBundles.back() = true;
+                        SkipCommand(commands, type);
+                        break;
+
+                    default:
+                        SkipCommand(commands, type);
+                        break;
+                }
+            }
+            commands->Reset();
+
+            return executesBundles;
+        }
+
+        // Skips the commands of the current render pass, up to and including its EndRenderPass.
+        void SkipRenderPassCommands(CommandIterator* commands) {
+            Command type;
+            while (commands->NextCommandId(&type)) {
+                SkipCommand(commands, type);
+                if (type == Command::EndRenderPass) {
+                    return;
+                }
+            }
+
+            // EndRenderPass should have been found
+            UNREACHABLE();
+        }
+
+        // A copy or clear command outside of passes.
+        struct BatchedCopy {
+            Command type;
+            void* cmd;
+            // Set when the batch is prepared for ClearBuffer commands whose range was never
+            // written, and will be cleared to zero by the lazy initialization of the buffer.
+            bool skip = false;
+        };
+
+        // Groups the consecutive copy and clear commands of `commands` in batches whose barriers
+        // are all recorded before the first command of the batch, instead of one barrier before
+        // each command. A batch ends before a command that uses a resource written by a previous
+        // command of the batch or writes a resource used by a previous command, since there must
+        // be a barrier between the two commands.
+        std::vector<std::vector<BatchedCopy>> FindCopyBatches(CommandIterator* commands) {
+            std::vector<std::vector<BatchedCopy>> batches;
+            std::vector<BatchedCopy> batch;
+            // Whether each resource used in the current batch is written.
+            std::unordered_map<const ApiObjectBase*, bool> resourcesWritten;
+
+            auto EndBatch = [&]() {
+                if (!batch.empty()) {
+                    batches.push_back(std::move(batch));
+                    batch.clear();
+                }
+                resourcesWritten.clear();
+            };
+            auto AddCopy = [&](Command type, void* cmd, const ApiObjectBase* source,
+                               const ApiObjectBase* destination) {
+                auto Conflicts = [&](const ApiObjectBase* resource, bool isWrite) {
+                    auto it = resourcesWritten.find(resource);
+                    return it != resourcesWritten.end() && (isWrite || it->second);
+                };
+                if ((source != nullptr && Conflicts(source, false)) ||
+                    Conflicts(destination, true)) {
+                    EndBatch();
+                }
+
+                if (source != nullptr) {
+                    resourcesWritten.emplace(source, false);
+                }
+                resourcesWritten[destination] = true;
+                batch.push_back({type, cmd});
+            };
+
+            Command type;
+            while (commands->NextCommandId(&type)) {
+                switch (type) {
+                    case Command::CopyBufferToBuffer: {
+                        CopyBufferToBufferCmd* cmd = commands->NextCommand<CopyBufferToBufferCmd>();
+                        AddCopy(type, cmd, cmd->source.Get(), cmd->destination.Get());
+                        break;
+                    }
+                    case Command::CopyBufferToTexture: {
+                        CopyBufferToTextureCmd* cmd =
+                            commands->NextCommand<CopyBufferToTextureCmd>();
+                        AddCopy(type, cmd, cmd->source.buffer.Get(),
+                                cmd->destination.texture.Get());
+                        break;
+                    }
+                    case Command::CopyTextureToBuffer: {
+                        CopyTextureToBufferCmd* cmd =
+                            commands->NextCommand<CopyTextureToBufferCmd>();
+                        AddCopy(type, cmd, cmd->source.texture.Get(),
+                                cmd->destination.buffer.Get());
+                        break;
+                    }
+                    case Command::CopyTextureToTexture: {
+                        CopyTextureToTextureCmd* cmd =
+                            commands->NextCommand<CopyTextureToTextureCmd>();
+                        AddCopy(type, cmd, cmd->source.texture.Get(),
+                                cmd->destination.texture.Get());
+                        break;
+                    }
+                    case Command::ClearBuffer: {
+                        ClearBufferCmd* cmd = commands->NextCommand<ClearBufferCmd>();
+                        AddCopy(type, cmd, nullptr, cmd->buffer.Get());
+                        break;
+                    }
+
+                    default:
+                        EndBatch();
+                        SkipCommand(commands, type);
+                        break;
+                }
+            }
+            EndBatch();
+            commands->Reset();
+
+            return batches;
+        }
+
+        // Lazily initializes the resources used by the commands of `batch` and records all of
+        // their barriers at once.
+        void PrepareCopyBatch(Device* device,
+                              CommandRecordingContext* recordingContext,
+                              std::vector<BatchedCopy>* batch) {
+            BarrierBatch barriers(device);
+            std::vector<LazyTextureClear> clears;
+
+            // The transitions of the textures are added to the batch once their lazy clears are
+            // recorded, since the clears transition them to CopyDst first.
+            struct TextureTransition {
+                Texture* texture;
+                wgpu::TextureUsage usage;
+                SubresourceRange range;
+            };
+            std::vector<TextureTransition> textureTransitions;
+
+            for (BatchedCopy& copy : *batch) {
+                switch (copy.type) {
+                    case Command::CopyBufferToBuffer: {
+                        CopyBufferToBufferCmd* cmd = static_cast<CopyBufferToBufferCmd*>(copy.cmd);
+                        if (cmd->size == 0) {
+                            break;
+                        }
+
+                        Buffer* srcBuffer = ToBackend(cmd->source.Get());
+                        Buffer* dstBuffer = ToBackend(cmd->destination.Get());
+
+                        srcBuffer->EnsureDataInitialized(recordingContext, cmd->sourceOffset,
+                                                         cmd->size);
+                        dstBuffer->EnsureDataInitializedAsDestination(
+                            recordingContext, cmd->destinationOffset, cmd->size);
+
+                        barriers.TransitionBuffer(srcBuffer, wgpu::BufferUsage::CopySrc,
+                                                  VK_PIPELINE_STAGE_2_COPY_BIT_KHR);
+                        barriers.TransitionBuffer(dstBuffer, wgpu::BufferUsage::CopyDst,
+                                                  VK_PIPELINE_STAGE_2_COPY_BIT_KHR);
+                        break;
+                    }
+
+                    case Command::CopyBufferToTexture: {
+                        CopyBufferToTextureCmd* cmd =
+                            static_cast<CopyBufferToTextureCmd*>(copy.cmd);
+                        if (cmd->copySize.width == 0 || cmd->copySize.height == 0 ||
+                            cmd->copySize.depthOrArrayLayers == 0) {
+                            break;
+                        }
+                        BufferCopy& src = cmd->source;
+                        TextureCopy& dst = cmd->destination;
+
+                        ToBackend(src.buffer)->EnsureDataInitialized(recordingContext);
+
+                        SubresourceRange range = GetSubresourcesAffectedByCopy(dst, cmd->copySize);
+                        if (IsCompleteSubresourceCopiedTo(dst.texture.Get(), cmd->copySize,
+                                                          dst.mipLevel)) {
+                            // Since texture has been overwritten, it has been "initialized"
+                            dst.texture->SetIsSubresourceContentInitialized(true, range);
+                        } else {
+                            AddLazyTextureClear(&clears, ToBackend(dst.texture.Get()), range);
+                        }
+
+                        barriers.TransitionBuffer(ToBackend(src.buffer.Get()),
+                                                  wgpu::BufferUsage::CopySrc,
+                                                  VK_PIPELINE_STAGE_2_COPY_BIT_KHR);
+                        textureTransitions.push_back(
+                            {ToBackend(dst.texture.Get()), wgpu::TextureUsage::CopyDst, range});
+                        break;
+                    }
+
+                    case Command::CopyTextureToBuffer: {
+                        CopyTextureToBufferCmd* cmd =
+                            static_cast<CopyTextureToBufferCmd*>(copy.cmd);
+                        if (cmd->copySize.width == 0 || cmd->copySize.height == 0 ||
+                            cmd->copySize.depthOrArrayLayers == 0) {
+                            break;
+                        }
+                        TextureCopy& src = cmd->source;
+                        BufferCopy& dst = cmd->destination;
+
+                        ToBackend(dst.buffer)
+                            ->EnsureDataInitializedAsDestination(recordingContext, cmd);
+
+                        SubresourceRange range = GetSubresourcesAffectedByCopy(src, cmd->copySize);
+                        AddLazyTextureClear(&clears, ToBackend(src.texture.Get()), range);
+
+                        textureTransitions.push_back(
+                            {ToBackend(src.texture.Get()), wgpu::TextureUsage::CopySrc, range});
+                        barriers.TransitionBuffer(ToBackend(dst.buffer.Get()),
+                                                  wgpu::BufferUsage::CopyDst,
+                                                  VK_PIPELINE_STAGE_2_COPY_BIT_KHR);
+                        break;
+                    }
+
+                    case Command::CopyTextureToTexture: {
+                        CopyTextureToTextureCmd* cmd =
+                            static_cast<CopyTextureToTextureCmd*>(copy.cmd);
+                        if (cmd->copySize.width == 0 || cmd->copySize.height == 0 ||
+                            cmd->copySize.depthOrArrayLayers == 0) {
+                            break;
+                        }
+                        TextureCopy& src = cmd->source;
+                        TextureCopy& dst = cmd->destination;
+                        SubresourceRange srcRange =
+                            GetSubresourcesAffectedByCopy(src, cmd->copySize);
+                        SubresourceRange dstRange =
+                            GetSubresourcesAffectedByCopy(dst, cmd->copySize);
+
+                        AddLazyTextureClear(&clears, ToBackend(src.texture.Get()), srcRange);
+                        if (IsCompleteSubresourceCopiedTo(dst.texture.Get(), cmd->copySize,
+                                                          dst.mipLevel)) {
+                            // Since destination texture has been overwritten, it has been
+                            // "initialized"
+                            dst.texture->SetIsSubresourceContentInitialized(true, dstRange);
+                        } else {
+                            AddLazyTextureClear(&clears, ToBackend(dst.texture.Get()), dstRange);
+                        }
+
+                        textureTransitions.push_back(
+                            {ToBackend(src.texture.Get()), wgpu::TextureUsage::CopySrc, srcRange});
+                        textureTransitions.push_back(
+                            {ToBackend(dst.texture.Get()), wgpu::TextureUsage::CopyDst, dstRange});
+                        break;
+                    }
+
+                    case Command::ClearBuffer: {
+                        ClearBufferCmd* cmd = static_cast<ClearBufferCmd*>(copy.cmd);
+                        if (cmd->size == 0) {
+                            break;
+                        }
+
+                        Buffer* dstBuffer = ToBackend(cmd->buffer.Get());
+                        copy.skip = dstBuffer->IsDataUninitialized(cmd->offset, cmd->size);
+                        if (!copy.skip) {
+                            dstBuffer->EnsureDataInitializedAsDestination(
+                                recordingContext, cmd->offset, cmd->size);
+                            barriers.TransitionBuffer(dstBuffer, wgpu::BufferUsage::CopyDst,
+                                                      VK_PIPELINE_STAGE_2_CLEAR_BIT_KHR);
+                        }
+                        break;
+                    }
+
+                    default:
+                        UNREACHABLE();
+                }
+            }
+
+            RecordLazyTextureClears(device, recordingContext, clears);
+            for (const TextureTransition& transition : textureTransitions) {
+                barriers.TransitionTexture(recordingContext, transition.texture, transition.usage,
+                                           transition.range, VK_PIPELINE_STAGE_2_COPY_BIT_KHR);
+            }
+
+            barriers.Record(recordingContext);
+        }
+
+        // Records a command that can be both in render passes and in render bundles.
+        void EncodeRenderBundleCommand(Device* device,
+                                       CommandRecordingContext* recordingContext,
+                                       DescriptorSetTracker* descriptorSets,
+                                       CommandIterator* iter,
+                                       Command type) {
+            VkCommandBuffer commands = recordingContext->commandBuffer;
+
+            switch (type) {
+                case Command::Draw: {
+                    DrawCmd* draw = iter->NextCommand<DrawCmd>();
+
+                    descriptorSets->Apply(device, recordingContext,
+                                          VK_PIPELINE_BIND_POINT_GRAPHICS);
+                    device->fn.CmdDraw(commands, draw->vertexCount, draw->instanceCount,
+                                       draw->firstVertex, draw->firstInstance);
+                    break;
+                }
+
+                case Command::DrawIndexed: {
+                    DrawIndexedCmd* draw = iter->NextCommand<DrawIndexedCmd>();
+
+                    descriptorSets->Apply(device, recordingContext,
+                                          VK_PIPELINE_BIND_POINT_GRAPHICS);
+                    device->fn.CmdDrawIndexed(commands, draw->indexCount, draw->instanceCount,
+                                              draw->firstIndex, draw->baseVertex,
+                                              draw->firstInstance);
+                    break;
+                }
+
+                case Command::DrawIndirect: {
+                    DrawIndirectCmd* draw = iter->NextCommand<DrawIndirectCmd>();
+                    Buffer* buffer = ToBackend(draw->indirectBuffer.Get());
+
+                    descriptorSets->Apply(device, recordingContext,
+                                          VK_PIPELINE_BIND_POINT_GRAPHICS);
+                    device->fn.CmdDrawIndirect(commands, buffer->GetHandle(),
+                                               static_cast<VkDeviceSize>(draw->indirectOffset), 1,
+                                               0);
+                    break;
+                }
+
+                case Command::DrawIndexedIndirect: {
+                    DrawIndexedIndirectCmd* draw = iter->NextCommand<DrawIndexedIndirectCmd>();
+                    Buffer* buffer = ToBackend(draw->indirectBuffer.Get());
+                    ASSERT(buffer != nullptr);
+
+                    descriptorSets->Apply(device, recordingContext,
+                                          VK_PIPELINE_BIND_POINT_GRAPHICS);
+                    device->fn.CmdDrawIndexedIndirect(
+                        commands, buffer->GetHandle(),
+                        static_cast<VkDeviceSize>(draw->indirectOffset), 1, 0);
+                    break;
+                }
+
+                case Command::InsertDebugMarker: {
+                    if (device->GetGlobalInfo().HasExt(InstanceExt::DebugUtils)) {
+                        InsertDebugMarkerCmd* cmd = iter->NextCommand<InsertDebugMarkerCmd>();
+                        const char* label = iter->NextData<char>(cmd->length + 1);
+                        VkDebugUtilsLabelEXT utilsLabel;
+                        utilsLabel.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
+                        utilsLabel.pNext = nullptr;
+                        utilsLabel.pLabelName = label;
+                        // Default color to black
+                        utilsLabel.color[0] = 0.0;
+                        utilsLabel.color[1] = 0.0;
+                        utilsLabel.color[2] = 0.0;
+                        utilsLabel.color[3] = 1.0;
+                        device->fn.CmdInsertDebugUtilsLabelEXT(commands, &utilsLabel);
+                    } else {
+                        SkipCommand(iter, Command::InsertDebugMarker);
+                    }
+                    break;
+                }
+
+                case Command::PopDebugGroup: {
+                    if (device->GetGlobalInfo().HasExt(InstanceExt::DebugUtils)) {
+                        iter->NextCommand<PopDebugGroupCmd>();
+                        device->fn.CmdEndDebugUtilsLabelEXT(commands);
+                    } else {
+                        SkipCommand(iter, Command::PopDebugGroup);
+                    }
+                    break;
+                }
+
+                case Command::PushDebugGroup: {
+                    if (device->GetGlobalInfo().HasExt(InstanceExt::DebugUtils)) {
+                        PushDebugGroupCmd* cmd = iter->NextCommand<PushDebugGroupCmd>();
+                        const char* label = iter->NextData<char>(cmd->length + 1);
+                        VkDebugUtilsLabelEXT utilsLabel;
+                        utilsLabel.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
+                        utilsLabel.pNext = nullptr;
+                        utilsLabel.pLabelName = label;
+                        // Default color to black
+                        utilsLabel.color[0] = 0.0;
+                        utilsLabel.color[1] = 0.0;
+                        utilsLabel.color[2] = 0.0;
+                        utilsLabel.color[3] = 1.0;
+                        device->fn.CmdBeginDebugUtilsLabelEXT(commands, &utilsLabel);
+                    } else {
+                        SkipCommand(iter, Command::PushDebugGroup);
+                    }
+                    break;
+                }
+
+                case Command::SetBindGroup: {
+                    SetBindGroupCmd* cmd = iter->NextCommand<SetBindGroupCmd>();
+                    BindGroup* bindGroup = ToBackend(cmd->group.Get());
+                    uint32_t* dynamicOffsets = nullptr;
+                    if (cmd->dynamicOffsetCount > 0) {
+                        dynamicOffsets = iter->NextData<uint32_t>(cmd->dynamicOffsetCount);
+                    }
+
+                    descriptorSets->OnSetBindGroup(cmd->index, bindGroup, cmd->dynamicOffsetCount,
+                                                  dynamicOffsets);
+                    break;
+                }
+
+                case Command::SetIndexBuffer: {
+                    SetIndexBufferCmd* cmd = iter->NextCommand<SetIndexBufferCmd>();
+                    VkBuffer indexBuffer = ToBackend(cmd->buffer)->GetHandle();
+
+                    device->fn.CmdBindIndexBuffer(commands, indexBuffer, cmd->offset,
+                                                  VulkanIndexType(cmd->format));
+                    break;
+                }
+
+                case Command::SetRenderPipeline: {
+                    SetRenderPipelineCmd* cmd = iter->NextCommand<SetRenderPipelineCmd>();
+                    RenderPipeline* pipeline = ToBackend(cmd->pipeline).Get();
+
+                    device->fn.CmdBindPipeline(commands, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                               pipeline->GetHandle());
+
+                    descriptorSets->OnSetPipeline(pipeline);
+                    break;
+                }
+
+                case Command::SetVertexBuffer: {
+                    SetVertexBufferCmd* cmd = iter->NextCommand<SetVertexBufferCmd>();
+                    VkBuffer buffer = ToBackend(cmd->buffer)->GetHandle();
+                    VkDeviceSize offset = static_cast<VkDeviceSize>(cmd->offset);
+
+                    device->fn.CmdBindVertexBuffers(commands, static_cast<uint8_t>(cmd->slot), 1,
+                                                    &*buffer, &offset);
+                    break;
+                }
+
+                default:
+                    UNREACHABLE();
+                    break;
+            }
+        }
+
     }  // anonymous namespace
 
+    void RecordRenderBundleCommands(Device* device,
+                                    CommandRecordingContext* recordingContext,
+                                    RenderBundleBase* bundle) {
+        DescriptorSetTracker descriptorSets = {};
+
+        CommandIterator* iter = bundle->GetCommands();
+        iter->Reset();
+        Command type;
+        while (iter->NextCommandId(&type)) {
+            EncodeRenderBundleCommand(device, recordingContext, &descriptorSets, iter, type);
+        }
+    }
+
     // static
     Ref<CommandBuffer> CommandBuffer::Create(CommandEncoder* encoder,
                                              const CommandBufferDescriptor* descriptor) {
@@ -502,6 +1052,71 @@ namespace dawn::native::vulkan {
         recordingContext->tempBuffers.emplace_back(tempBuffer);
     }
 
+    MaybeError CommandBuffer::PrerecordRenderPasses(Device::WorkerCommandPool* pool) {
+        TRACE_EVENT0(GetDevice()->GetPlatform(), Recording,
+                     "CommandBufferVk::PrerecordRenderPasses");
+        Device* device = ToBackend(GetDevice());
+
+        const std::vector<bool> renderPassesExecutingBundles =
+            FindRenderPassesExecutingBundles(&mCommands);
+        mPrerecordedRenderPasses.assign(renderPassesExecutingBundles.size(), VK_NULL_HANDLE);
+
+        size_t nextRenderPassNumber = 0;
+        Command type;
+        while (mCommands.NextCommandId(&type)) {
+            if (type != Command::BeginRenderPass) {
+                SkipCommand(&mCommands, type);
+                continue;
+            }
+
+            BeginRenderPassCmd* cmd = mCommands.NextCommand<BeginRenderPassCmd>();
+            const size_t renderPassNumber = nextRenderPassNumber++;
+            if (renderPassesExecutingBundles[renderPassNumber]) {
+                SkipRenderPassCommands(&mCommands);
+                continue;
+            }
+
+            // The load operations of the attachments may still change with the lazy clears, but
+            // they don't affect the compatibility of the render pass with the one it's executed
+            // in.
+            VkRenderPass renderPassVK;
+            DAWN_TRY_ASSIGN(renderPassVK, GetRenderPass(device, cmd));
+
+            CommandRecordingContext recordingContext;
+            DAWN_TRY_ASSIGN(recordingContext.commandBuffer,
+                            device->AllocateWorkerCommandBuffer(pool));
+
+            VkCommandBufferInheritanceInfo inheritanceInfo;
+            inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+            inheritanceInfo.pNext = nullptr;
+            inheritanceInfo.renderPass = renderPassVK;
+            inheritanceInfo.subpass = 0;
+            inheritanceInfo.framebuffer = VK_NULL_HANDLE;
+            inheritanceInfo.occlusionQueryEnable = VK_FALSE;
+            inheritanceInfo.queryFlags = 0;
+            inheritanceInfo.pipelineStatistics = 0;
+
+            VkCommandBufferBeginInfo beginInfo;
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.pNext = nullptr;
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT |
+                              VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+            beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+            DAWN_TRY(CheckVkSuccess(
+                device->fn.BeginCommandBuffer(recordingContext.commandBuffer, &beginInfo),
+                "vkBeginCommandBuffer"));
+            DAWN_TRY(RecordRenderPassCommands(&recordingContext, cmd, renderPassVK, false));
+            DAWN_TRY(CheckVkSuccess(device->fn.EndCommandBuffer(recordingContext.commandBuffer),
+                                    "vkEndCommandBuffer"));
+
+            mPrerecordedRenderPasses[renderPassNumber] = recordingContext.commandBuffer;
+        }
+        mCommands.Reset();
+
+        return {};
+    }
+
     MaybeError CommandBuffer::RecordCommands(CommandRecordingContext* recordingContext) {
         Device* device = ToBackend(GetDevice());
         VkCommandBuffer commands = recordingContext->commandBuffer;
@@ -521,29 +1136,47 @@ namespace dawn::native::vulkan {
             }
         };
 
+        const std::vector<bool> renderPassesOnlyExecutingBundles =
+            FindRenderPassesOnlyExecutingBundles(device, &mCommands);
+        std::vector<std::vector<BatchedCopy>> copyBatches = FindCopyBatches(&mCommands);
+
         size_t nextComputePassNumber = 0;
         size_t nextRenderPassNumber = 0;
+        size_t nextCopyBatch = 0;
+        size_t nextCopyInBatch = 0;
+
+        // Returns the next copy or clear command, recording the barriers of its whole batch when
+        // it is the first command of the batch.
+        auto NextBatchedCopy = [&]() -> BatchedCopy& {
+            ASSERT(nextCopyBatch < copyBatches.size());
+            std::vector<BatchedCopy>& batch = copyBatches[nextCopyBatch];
+            if (nextCopyInBatch == 0) {
+                PrepareCopyBatch(device, recordingContext, &batch);
+            }
+
+            BatchedCopy& copy = batch[nextCopyInBatch];
+            if (++nextCopyInBatch == batch.size()) {
+                nextCopyBatch++;
+                nextCopyInBatch = 0;
+            }
+            return copy;
+        };
 
         Command type;
         while (mCommands.NextCommandId(&type)) {
             switch (type) {
                 case Command::CopyBufferToBuffer: {
                     CopyBufferToBufferCmd* copy = mCommands.NextCommand<CopyBufferToBufferCmd>();
+                    NextBatchedCopy();
                     if (copy->size == 0) {
                         // Skip no-op copies.
                         break;
                     }
 
+                    // The resources were initialized and transitioned with the whole batch.
                     Buffer* srcBuffer = ToBackend(copy->source.Get());
                     Buffer* dstBuffer = ToBackend(copy->destination.Get());
 
-                    srcBuffer->EnsureDataInitialized(recordingContext);
-                    dstBuffer->EnsureDataInitializedAsDestination(
-                        recordingContext, copy->destinationOffset, copy->size);
-
-                    srcBuffer->TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopySrc);
-                    dstBuffer->TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopyDst);
-
                     VkBufferCopy region;
                     region.srcOffset = copy->sourceOffset;
                     region.dstOffset = copy->destinationOffset;
@@ -557,6 +1190,7 @@ namespace dawn::native::vulkan {
 
                 case Command::CopyBufferToTexture: {
                     CopyBufferToTextureCmd* copy = mCommands.NextCommand<CopyBufferToTextureCmd>();
+                    NextBatchedCopy();
                     if (copy->copySize.width == 0 || copy->copySize.height == 0 ||
                         copy->copySize.depthOrArrayLayers == 0) {
                         // Skip no-op copies.
@@ -565,27 +1199,9 @@ namespace dawn::native::vulkan {
                     auto& src = copy->source;
                     auto& dst = copy->destination;
 
-                    ToBackend(src.buffer)->EnsureDataInitialized(recordingContext);
-
                     VkBufferImageCopy region =
                         ComputeBufferImageCopyRegion(src, dst, copy->copySize);
-                    VkImageSubresourceLayers subresource = region.imageSubresource;
 
-                    SubresourceRange range =
-                        GetSubresourcesAffectedByCopy(copy->destination, copy->copySize);
-
-                    if (IsCompleteSubresourceCopiedTo(dst.texture.Get(), copy->copySize,
-                                                      subresource.mipLevel)) {
-                        // Since texture has been overwritten, it has been "initialized"
-                        dst.texture->SetIsSubresourceContentInitialized(true, range);
-                    } else {
-                        ToBackend(dst.texture)
-                            ->EnsureSubresourceContentInitialized(recordingContext, range);
-                    }
-                    ToBackend(src.buffer)
-                        ->TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopySrc);
-                    ToBackend(dst.texture)
-                        ->TransitionUsageNow(recordingContext, wgpu::TextureUsage::CopyDst, range);
                     VkBuffer srcBuffer = ToBackend(src.buffer)->GetHandle();
                     VkImage dstImage = ToBackend(dst.texture)->GetHandle();
 
@@ -599,6 +1215,7 @@ namespace dawn::native::vulkan {
 
                 case Command::CopyTextureToBuffer: {
                     CopyTextureToBufferCmd* copy = mCommands.NextCommand<CopyTextureToBufferCmd>();
+                    NextBatchedCopy();
                     if (copy->copySize.width == 0 || copy->copySize.height == 0 ||
                         copy->copySize.depthOrArrayLayers == 0) {
                         // Skip no-op copies.
@@ -607,23 +1224,9 @@ namespace dawn::native::vulkan {
                     auto& src = copy->source;
                     auto& dst = copy->destination;
 
-                    ToBackend(dst.buffer)
-                        ->EnsureDataInitializedAsDestination(recordingContext, copy);
-
                     VkBufferImageCopy region =
                         ComputeBufferImageCopyRegion(dst, src, copy->copySize);
 
-                    SubresourceRange range =
-                        GetSubresourcesAffectedByCopy(copy->source, copy->copySize);
-
-                    ToBackend(src.texture)
-                        ->EnsureSubresourceContentInitialized(recordingContext, range);
-
-                    ToBackend(src.texture)
-                        ->TransitionUsageNow(recordingContext, wgpu::TextureUsage::CopySrc, range);
-                    ToBackend(dst.buffer)
-                        ->TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopyDst);
-
                     VkImage srcImage = ToBackend(src.texture)->GetHandle();
                     VkBuffer dstBuffer = ToBackend(dst.buffer)->GetHandle();
                     // The Dawn CopySrc usage is always mapped to GENERAL
@@ -635,6 +1238,7 @@ namespace dawn::native::vulkan {
                 case Command::CopyTextureToTexture: {
                     CopyTextureToTextureCmd* copy =
                         mCommands.NextCommand<CopyTextureToTextureCmd>();
+                    NextBatchedCopy();
                     if (copy->copySize.width == 0 || copy->copySize.height == 0 ||
                         copy->copySize.depthOrArrayLayers == 0) {
                         // Skip no-op copies.
@@ -642,19 +1246,6 @@ namespace dawn::native::vulkan {
                     }
                     TextureCopy& src = copy->source;
                     TextureCopy& dst = copy->destination;
-                    SubresourceRange srcRange = GetSubresourcesAffectedByCopy(src, copy->copySize);
-                    SubresourceRange dstRange = GetSubresourcesAffectedByCopy(dst, copy->copySize);
-
-                    ToBackend(src.texture)
-                        ->EnsureSubresourceContentInitialized(recordingContext, srcRange);
-                    if (IsCompleteSubresourceCopiedTo(dst.texture.Get(), copy->copySize,
-                                                      dst.mipLevel)) {
-                        // Since destination texture has been overwritten, it has been "initialized"
-                        dst.texture->SetIsSubresourceContentInitialized(true, dstRange);
-                    } else {
-                        ToBackend(dst.texture)
-                            ->EnsureSubresourceContentInitialized(recordingContext, dstRange);
-                    }
 
                     if (src.texture.Get() == dst.texture.Get() && src.mipLevel == dst.mipLevel) {
                         // When there are overlapped subresources, the layout of the overlapped
@@ -665,14 +1256,6 @@ namespace dawn::native::vulkan {
                                                   copy->copySize.depthOrArrayLayers));
                     }
 
-                    // TODO after Yunchao's CL
-                    ToBackend(src.texture)
-                        ->TransitionUsageNow(recordingContext, wgpu::TextureUsage::CopySrc,
-                                             srcRange);
-                    ToBackend(dst.texture)
-                        ->TransitionUsageNow(recordingContext, wgpu::TextureUsage::CopyDst,
-                                             dstRange);
-
                     // In some situations we cannot do texture-to-texture copies with vkCmdCopyImage
                     // because as Vulkan SPEC always validates image copies with the virtual size of
                     // the image subresource, when the extent that fits in the copy region of one
@@ -715,17 +1298,16 @@ namespace dawn::native::vulkan {
 
                 case Command::ClearBuffer: {
                     ClearBufferCmd* cmd = mCommands.NextCommand<ClearBufferCmd>();
+                    // Fills of ranges that will be cleared to zero by the lazy initialization
+                    // of the buffer are skipped.
+                    bool clearedToZero = NextBatchedCopy().skip;
                     if (cmd->size == 0) {
                         // Skip no-op fills.
                         break;
                     }
 
-                    Buffer* dstBuffer = ToBackend(cmd->buffer.Get());
-                    bool clearedToZero = dstBuffer->EnsureDataInitializedAsDestination(
-                        recordingContext, cmd->offset, cmd->size);
-
                     if (!clearedToZero) {
-                        dstBuffer->TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopyDst);
+                        Buffer* dstBuffer = ToBackend(cmd->buffer.Get());
                         device->fn.CmdFillBuffer(recordingContext->commandBuffer,
                                                  dstBuffer->GetHandle(), cmd->offset, cmd->size,
                                                  0u);
@@ -742,7 +1324,12 @@ namespace dawn::native::vulkan {
                         GetResourceUsages().renderPasses[nextRenderPassNumber]);
 
                     LazyClearRenderPassAttachments(cmd);
-                    DAWN_TRY(RecordRenderPass(recordingContext, cmd));
+                    DAWN_TRY(RecordRenderPass(
+                        recordingContext, cmd,
+                        renderPassesOnlyExecutingBundles[nextRenderPassNumber],
+                        mPrerecordedRenderPasses.empty()
+                            ? VK_NULL_HANDLE
+                            : mPrerecordedRenderPasses[nextRenderPassNumber]));
 
                     nextRenderPassNumber++;
                     break;
@@ -892,6 +1479,9 @@ namespace dawn::native::vulkan {
             }
         }
 
+        // The prerecorded command buffers are owned by the pool they were allocated from.
+        mPrerecordedRenderPasses.clear();
+
         return {};
     }
 
@@ -1033,248 +1623,96 @@ namespace dawn::native::vulkan {
     }
 
     MaybeError CommandBuffer::RecordRenderPass(CommandRecordingContext* recordingContext,
-                                               BeginRenderPassCmd* renderPassCmd) {
+                                               BeginRenderPassCmd* renderPassCmd,
+                                               bool executeBundlesAsSecondaryCommandBuffers,
+                                               VkCommandBuffer prerecordedCommands) {
         Device* device = ToBackend(GetDevice());
-        VkCommandBuffer commands = recordingContext->commandBuffer;
-
-        DAWN_TRY(RecordBeginRenderPass(recordingContext, device, renderPassCmd));
+        const bool executesSecondaryCommandBuffers =
+            executeBundlesAsSecondaryCommandBuffers || prerecordedCommands != VK_NULL_HANDLE;
+
+        // Render passes that execute secondary command buffers can't have other commands.
+        VkRenderPass renderPassVK;
+        DAWN_TRY_ASSIGN(renderPassVK,
+                        RecordBeginRenderPass(recordingContext, device, renderPassCmd,
+                                              executesSecondaryCommandBuffers
+                                                  ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS
+                                                  : VK_SUBPASS_CONTENTS_INLINE));
+
+        if (prerecordedCommands != VK_NULL_HANDLE) {
+            device->fn.CmdExecuteCommands(recordingContext->commandBuffer, 1,
+                                          &prerecordedCommands);
+            device->IncrementExecuteCommandsCountForTesting();
+            SkipRenderPassCommands(&mCommands);
+        } else {
+            DAWN_TRY(RecordRenderPassCommands(recordingContext, renderPassCmd, renderPassVK,
+                                              executeBundlesAsSecondaryCommandBuffers));
+        }
 
-        // Set the default value for the dynamic state
-        {
-            device->fn.CmdSetLineWidth(commands, 1.0f);
-            device->fn.CmdSetDepthBounds(commands, 0.0f, 1.0f);
+        device->fn.CmdEndRenderPass(recordingContext->commandBuffer);
+        return {};
+    }
 
-            device->fn.CmdSetStencilReference(commands, VK_STENCIL_FRONT_AND_BACK, 0);
+    MaybeError CommandBuffer::RecordRenderPassCommands(
+        CommandRecordingContext* recordingContext,
+        BeginRenderPassCmd* renderPassCmd,
+        VkRenderPass renderPassVK,
+        bool executeBundlesAsSecondaryCommandBuffers) {
+        Device* device = ToBackend(GetDevice());
+        VkCommandBuffer commands = recordingContext->commandBuffer;
 
-            float blendConstants[4] = {
-                0.0f,
-                0.0f,
-                0.0f,
-                0.0f,
-            };
-            device->fn.CmdSetBlendConstants(commands, blendConstants);
-
-            // The viewport and scissor default to cover all of the attachments
-            VkViewport viewport;
-            viewport.x = 0.0f;
-            viewport.y = static_cast<float>(renderPassCmd->height);
-            viewport.width = static_cast<float>(renderPassCmd->width);
-            viewport.height = -static_cast<float>(renderPassCmd->height);
-            viewport.minDepth = 0.0f;
-            viewport.maxDepth = 1.0f;
-            device->fn.CmdSetViewport(commands, 0, 1, &viewport);
-
-            VkRect2D scissorRect;
-            scissorRect.offset.x = 0;
-            scissorRect.offset.y = 0;
-            scissorRect.extent.width = renderPassCmd->width;
-            scissorRect.extent.height = renderPassCmd->height;
-            device->fn.CmdSetScissor(commands, 0, 1, &scissorRect);
+        // Set the default value for the dynamic state. It is tracked even when it is only
+        // recorded in the secondary command buffers.
+        RenderPassDynamicState dynamicState(renderPassCmd->width, renderPassCmd->height);
+        if (!executeBundlesAsSecondaryCommandBuffers) {
+            dynamicState.Record(device, commands);
         }
 
         DescriptorSetTracker descriptorSets = {};
-        RenderPipeline* lastPipeline = nullptr;
-
-        auto EncodeRenderBundleCommand = [&](CommandIterator* iter, Command type) {
-            switch (type) {
-                case Command::Draw: {
-                    DrawCmd* draw = iter->NextCommand<DrawCmd>();
-
-                    descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
-                    device->fn.CmdDraw(commands, draw->vertexCount, draw->instanceCount,
-                                       draw->firstVertex, draw->firstInstance);
-                    break;
-                }
-
-                case Command::DrawIndexed: {
-                    DrawIndexedCmd* draw = iter->NextCommand<DrawIndexedCmd>();
-
-                    descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
-                    device->fn.CmdDrawIndexed(commands, draw->indexCount, draw->instanceCount,
-                                              draw->firstIndex, draw->baseVertex,
-                                              draw->firstInstance);
-                    break;
-                }
-
-                case Command::DrawIndirect: {
-                    DrawIndirectCmd* draw = iter->NextCommand<DrawIndirectCmd>();
-                    Buffer* buffer = ToBackend(draw->indirectBuffer.Get());
-
-                    descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
-                    device->fn.CmdDrawIndirect(commands, buffer->GetHandle(),
-                                               static_cast<VkDeviceSize>(draw->indirectOffset), 1,
-                                               0);
-                    break;
-                }
-
-                case Command::DrawIndexedIndirect: {
-                    DrawIndexedIndirectCmd* draw = iter->NextCommand<DrawIndexedIndirectCmd>();
-                    Buffer* buffer = ToBackend(draw->indirectBuffer.Get());
-                    ASSERT(buffer != nullptr);
-
-                    descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
-                    device->fn.CmdDrawIndexedIndirect(
-                        commands, buffer->GetHandle(),
-                        static_cast<VkDeviceSize>(draw->indirectOffset), 1, 0);
-                    break;
-                }
-
-                case Command::InsertDebugMarker: {
-                    if (device->GetGlobalInfo().HasExt(InstanceExt::DebugUtils)) {
-                        InsertDebugMarkerCmd* cmd = iter->NextCommand<InsertDebugMarkerCmd>();
-                        const char* label = iter->NextData<char>(cmd->length + 1);
-                        VkDebugUtilsLabelEXT utilsLabel;
-                        utilsLabel.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
-                        utilsLabel.pNext = nullptr;
-                        utilsLabel.pLabelName = label;
-                        // Default color to black
-                        utilsLabel.color[0] = 0.0;
-                        utilsLabel.color[1] = 0.0;
-                        utilsLabel.color[2] = 0.0;
-                        utilsLabel.color[3] = 1.0;
-                        device->fn.CmdInsertDebugUtilsLabelEXT(commands, &utilsLabel);
-                    } else {
-                        SkipCommand(iter, Command::InsertDebugMarker);
-                    }
-                    break;
-                }
-
-                case Command::PopDebugGroup: {
-                    if (device->GetGlobalInfo().HasExt(InstanceExt::DebugUtils)) {
-                        iter->NextCommand<PopDebugGroupCmd>();
-                        device->fn.CmdEndDebugUtilsLabelEXT(commands);
-                    } else {
-                        SkipCommand(iter, Command::PopDebugGroup);
-                    }
-                    break;
-                }
-
-                case Command::PushDebugGroup: {
-                    if (device->GetGlobalInfo().HasExt(InstanceExt::DebugUtils)) {
-                        PushDebugGroupCmd* cmd = iter->NextCommand<PushDebugGroupCmd>();
-                        const char* label = iter->NextData<char>(cmd->length + 1);
-                        VkDebugUtilsLabelEXT utilsLabel;
-                        utilsLabel.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
-                        utilsLabel.pNext = nullptr;
-                        utilsLabel.pLabelName = label;
-                        // Default color to black
-                        utilsLabel.color[0] = 0.0;
-                        utilsLabel.color[1] = 0.0;
-                        utilsLabel.color[2] = 0.0;
-                        utilsLabel.color[3] = 1.0;
-                        device->fn.CmdBeginDebugUtilsLabelEXT(commands, &utilsLabel);
-                    } else {
-                        SkipCommand(iter, Command::PushDebugGroup);
-                    }
-                    break;
-                }
-
-                case Command::SetBindGroup: {
-                    SetBindGroupCmd* cmd = iter->NextCommand<SetBindGroupCmd>();
-                    BindGroup* bindGroup = ToBackend(cmd->group.Get());
-                    uint32_t* dynamicOffsets = nullptr;
-                    if (cmd->dynamicOffsetCount > 0) {
-                        dynamicOffsets = iter->NextData<uint32_t>(cmd->dynamicOffsetCount);
-                    }
-
-                    descriptorSets.OnSetBindGroup(cmd->index, bindGroup, cmd->dynamicOffsetCount,
-                                                  dynamicOffsets);
-                    break;
-                }
-
-                case Command::SetIndexBuffer: {
-                    SetIndexBufferCmd* cmd = iter->NextCommand<SetIndexBufferCmd>();
-                    VkBuffer indexBuffer = ToBackend(cmd->buffer)->GetHandle();
-
-                    device->fn.CmdBindIndexBuffer(commands, indexBuffer, cmd->offset,
-                                                  VulkanIndexType(cmd->format));
-                    break;
-                }
-
-                case Command::SetRenderPipeline: {
-                    SetRenderPipelineCmd* cmd = iter->NextCommand<SetRenderPipelineCmd>();
-                    RenderPipeline* pipeline = ToBackend(cmd->pipeline).Get();
-
-                    device->fn.CmdBindPipeline(commands, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                               pipeline->GetHandle());
-                    lastPipeline = pipeline;
-
-                    descriptorSets.OnSetPipeline(pipeline);
-                    break;
-                }
-
-                case Command::SetVertexBuffer: {
-                    SetVertexBufferCmd* cmd = iter->NextCommand<SetVertexBufferCmd>();
-                    VkBuffer buffer = ToBackend(cmd->buffer)->GetHandle();
-                    VkDeviceSize offset = static_cast<VkDeviceSize>(cmd->offset);
-
-                    device->fn.CmdBindVertexBuffers(commands, static_cast<uint8_t>(cmd->slot), 1,
-                                                    &*buffer, &offset);
-                    break;
-                }
-
-                default:
-                    UNREACHABLE();
-                    break;
-            }
-        };
 
         Command type;
         while (mCommands.NextCommandId(&type)) {
             switch (type) {
                 case Command::EndRenderPass: {
                     mCommands.NextCommand<EndRenderPassCmd>();
-                    device->fn.CmdEndRenderPass(commands);
                     return {};
                 }
 
                 case Command::SetBlendConstant: {
                     SetBlendConstantCmd* cmd = mCommands.NextCommand<SetBlendConstantCmd>();
-                    const std::array<float, 4> blendConstants = ConvertToFloatColor(cmd->color);
-                    device->fn.CmdSetBlendConstants(commands, blendConstants.data());
+                    dynamicState.blendConstants = ConvertToFloatColor(cmd->color);
+                    if (!executeBundlesAsSecondaryCommandBuffers) {
+                        device->fn.CmdSetBlendConstants(commands,
+                                                        dynamicState.blendConstants.data());
+                    }
                     break;
                 }
 
                 case Command::SetStencilReference: {
                     SetStencilReferenceCmd* cmd = mCommands.NextCommand<SetStencilReferenceCmd>();
-                    device->fn.CmdSetStencilReference(commands, VK_STENCIL_FRONT_AND_BACK,
-                                                      cmd->reference);
+                    dynamicState.stencilReference = cmd->reference;
+                    if (!executeBundlesAsSecondaryCommandBuffers) {
+                        device->fn.CmdSetStencilReference(commands, VK_STENCIL_FRONT_AND_BACK,
+                                                          cmd->reference);
+                    }
                     break;
                 }
 
                 case Command::SetViewport: {
                     SetViewportCmd* cmd = mCommands.NextCommand<SetViewportCmd>();
-                    VkViewport viewport;
-                    viewport.x = cmd->x;
-                    viewport.y = cmd->y + cmd->height;
-                    viewport.width = cmd->width;
-                    viewport.height = -cmd->height;
-                    viewport.minDepth = cmd->minDepth;
-                    viewport.maxDepth = cmd->maxDepth;
-
-                    // Vulkan disallows width = 0, but VK_KHR_maintenance1 which we require allows
-                    // height = 0 so use that to do an empty viewport.
-                    if (viewport.width == 0) {
-                        viewport.height = 0;
-
-                        // Set the viewport x range to a range that's always valid.
-                        viewport.x = 0;
-                        viewport.width = 1;
+                    dynamicState.SetViewport(cmd->x, cmd->y, cmd->width, cmd->height,
+                                             cmd->minDepth, cmd->maxDepth);
+                    if (!executeBundlesAsSecondaryCommandBuffers) {
+                        device->fn.CmdSetViewport(commands, 0, 1, &dynamicState.viewport);
                     }
-
-                    device->fn.CmdSetViewport(commands, 0, 1, &viewport);
                     break;
                 }
 
                 case Command::SetScissorRect: {
                     SetScissorRectCmd* cmd = mCommands.NextCommand<SetScissorRectCmd>();
-                    VkRect2D rect;
-                    rect.offset.x = cmd->x;
-                    rect.offset.y = cmd->y;
-                    rect.extent.width = cmd->width;
-                    rect.extent.height = cmd->height;
-
-                    device->fn.CmdSetScissor(commands, 0, 1, &rect);
+                    dynamicState.SetScissorRect(cmd->x, cmd->y, cmd->width, cmd->height);
+                    if (!executeBundlesAsSecondaryCommandBuffers) {
+                        device->fn.CmdSetScissor(commands, 0, 1, &dynamicState.scissorRect);
+                    }
                     break;
                 }
 
@@ -1282,11 +1720,29 @@ namespace dawn::native::vulkan {
                     ExecuteBundlesCmd* cmd = mCommands.NextCommand<ExecuteBundlesCmd>();
                     auto bundles = mCommands.NextData<Ref<RenderBundleBase>>(cmd->count);
 
+                    if (executeBundlesAsSecondaryCommandBuffers) {
+                        // vkCmdExecuteCommands requires at least one command buffer.
+                        if (cmd->count == 0) {
+                            break;
+                        }
+                        std::vector<VkCommandBuffer> bundleCommands(cmd->count);
+                        for (uint32_t i = 0; i < cmd->count; ++i) {
+                            RenderBundleCommandBuffers* commandBuffers =
+                                RenderBundleCommandBuffers::GetOrCreate(device, bundles[i].Get());
+                            DAWN_TRY_ASSIGN(bundleCommands[i], commandBuffers->GetCommandBuffer(
+                                                                   renderPassVK, dynamicState));
+                        }
+                        device->fn.CmdExecuteCommands(commands, cmd->count, bundleCommands.data());
+                        device->IncrementExecuteCommandsCountForTesting();
+                        break;
+                    }
+
                     for (uint32_t i = 0; i < cmd->count; ++i) {
                         CommandIterator* iter = bundles[i]->GetCommands();
                         iter->Reset();
                         while (iter->NextCommandId(&type)) {
-                            EncodeRenderBundleCommand(iter, type);
+                            EncodeRenderBundleCommand(device, recordingContext,
+                                                      &descriptorSets, iter, type);
                         }
                     }
                     break;
@@ -1316,7 +1772,8 @@ namespace dawn::native::vulkan {
                 }
 
                 default: {
-                    EncodeRenderBundleCommand(&mCommands, type);
+                    EncodeRenderBundleCommand(device, recordingContext, &descriptorSets,
+                                              &mCommands, type);
                     break;
                 }
             }
@@ -17,9 +17,12 @@
 
 #include "dawn/native/CommandBuffer.h"
 #include "dawn/native/Error.h"
+#include "dawn/native/vulkan/DeviceVk.h"
 
 #include "dawn/common/vulkan_platform.h"
 
+#include <vector>
+
 namespace dawn::native {
     struct BeginRenderPassCmd;
     struct TextureCopy;
@@ -28,13 +31,24 @@ namespace dawn::native {
 namespace dawn::native::vulkan {
 
     struct CommandRecordingContext;
-    class Device;
+
+    // Records the commands of |bundle| in the command buffer of |recordingContext|, starting
+    // without any pipeline or bind group set.
+    void RecordRenderBundleCommands(Device* device,
+                                    CommandRecordingContext* recordingContext,
+                                    RenderBundleBase* bundle);
 
     class CommandBuffer final : public CommandBufferBase {
       public:
         static Ref<CommandBuffer> Create(CommandEncoder* encoder,
                                          const CommandBufferDescriptor* descriptor);
 
+        // Records the render passes in secondary command buffers allocated from |pool|, so that
+        // RecordCommands only has to execute them. It can be called on a worker thread since it
+        // doesn't change the state of the resources, and the render passes executing render
+        // bundles are left for RecordCommands.
+        MaybeError PrerecordRenderPasses(Device::WorkerCommandPool* pool);
+
         MaybeError RecordCommands(CommandRecordingContext* recordingContext);
 
       private:
@@ -42,12 +56,25 @@ namespace dawn::native::vulkan {
 
         MaybeError RecordComputePass(CommandRecordingContext* recordingContext,
                                      const ComputePassResourceUsage& resourceUsages);
+        // Records the render pass, executing |prerecordedCommands| for its commands if it isn't
+        // VK_NULL_HANDLE.
         MaybeError RecordRenderPass(CommandRecordingContext* recordingContext,
-                                    BeginRenderPassCmd* renderPass);
+                                    BeginRenderPassCmd* renderPass,
+                                    bool executeBundlesAsSecondaryCommandBuffers,
+                                    VkCommandBuffer prerecordedCommands);
+        // Records the commands inside the render pass, up to its EndRenderPass.
+        MaybeError RecordRenderPassCommands(CommandRecordingContext* recordingContext,
+                                            BeginRenderPassCmd* renderPass,
+                                            VkRenderPass renderPassVK,
+                                            bool executeBundlesAsSecondaryCommandBuffers);
         void RecordCopyImageWithTemporaryBuffer(CommandRecordingContext* recordingContext,
                                                 const TextureCopy& srcCopy,
                                                 const TextureCopy& dstCopy,
                                                 const Extent3D& copySize);
+
+        // The secondary command buffers recorded by PrerecordRenderPasses, indexed by render pass
+        // number. VK_NULL_HANDLE for the render passes that weren't prerecorded.
+        std::vector<VkCommandBuffer> mPrerecordedRenderPasses;
     };
 
 }  // namespace dawn::native::vulkan
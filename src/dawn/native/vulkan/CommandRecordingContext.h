@@ -30,6 +30,11 @@ namespace dawn::native::vulkan {
         // formats.
         std::vector<Ref<Buffer>> tempBuffers;
 
+        // The number of pipeline barrier commands recorded and of the memory barriers they
+        // contain, reported in the statistics of the submit.
+        uint32_t pipelineBarrierCount = 0;
+        uint32_t memoryBarrierCount = 0;
+
         // For Device state tracking only.
         VkCommandPool commandPool = VK_NULL_HANDLE;
         bool used = false;
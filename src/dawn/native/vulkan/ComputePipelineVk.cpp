@@ -17,6 +17,7 @@
 #include "dawn/native/CreatePipelineAsyncTask.h"
 #include "dawn/native/vulkan/DeviceVk.h"
 #include "dawn/native/vulkan/FencedDeleter.h"
+#include "dawn/native/vulkan/PipelineCacheVk.h"
 #include "dawn/native/vulkan/PipelineLayoutVk.h"
 #include "dawn/native/vulkan/ShaderModuleVk.h"
 #include "dawn/native/vulkan/UtilsVulkan.h"
@@ -75,9 +76,11 @@ namespace dawn::native::vulkan {
         }
 
         DAWN_TRY(CheckVkSuccess(
-            device->fn.CreateComputePipelines(device->GetVkDevice(), ::VK_NULL_HANDLE, 1,
+            device->fn.CreateComputePipelines(device->GetVkDevice(),
+                                              device->GetPipelineCache()->GetHandle(), 1,
                                               &createInfo, nullptr, &*mHandle),
             "CreateComputePipeline"));
+        device->GetPipelineCache()->DidCreatePipeline();
 
         SetLabelImpl();
 
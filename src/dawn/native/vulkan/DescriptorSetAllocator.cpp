@@ -14,91 +14,128 @@
 
 #include "dawn/native/vulkan/DescriptorSetAllocator.h"
 
-#include "dawn/native/vulkan/BindGroupLayoutVk.h"
+#include "dawn/common/Math.h"
 #include "dawn/native/vulkan/DeviceVk.h"
-#include "dawn/native/vulkan/FencedDeleter.h"
 #include "dawn/native/vulkan/VulkanError.h"
+#include "dawn/platform/DawnPlatform.h"
+#include "dawn/platform/tracing/TraceEvent.h"
+
+#include <algorithm>
 
 namespace dawn::native::vulkan {
 
     // TODO(enga): Figure out this value.
     static constexpr uint32_t kMaxDescriptorsPerPool = 512;
 
-    // static
-    Ref<DescriptorSetAllocator> DescriptorSetAllocator::Create(
-        BindGroupLayout* layout,
-        std::map<VkDescriptorType, uint32_t> descriptorCountPerType) {
-        return AcquireRef(new DescriptorSetAllocator(layout, descriptorCountPerType));
+    DescriptorSetAllocator::DescriptorSetAllocator(Device* device) : mDevice(device) {
     }
 
-    DescriptorSetAllocator::DescriptorSetAllocator(
-        BindGroupLayout* layout,
-        std::map<VkDescriptorType, uint32_t> descriptorCountPerType)
-        : ObjectBase(layout->GetDevice()), mLayout(layout) {
-        ASSERT(layout != nullptr);
+    DescriptorSetAllocator::~DescriptorSetAllocator() {
+        // This is only destroyed with the device, when the GPU is done with all the descriptor
+        // sets, so the pools can be destroyed immediately.
+        for (const DescriptorPool& pool : mPools) {
+            mDevice->fn.DestroyDescriptorPool(mDevice->GetVkDevice(), pool.vkPool, nullptr);
+        }
+    }
 
-        // Compute the total number of descriptors for this layout.
+    DescriptorSetAllocator::BucketIndex DescriptorSetAllocator::GetBucket(
+        const std::map<VkDescriptorType, uint32_t>& descriptorCountPerType) {
+        // Rounding the counts lets layouts with close but different counts share pools, at the
+        // cost of some unused descriptors.
+        std::map<VkDescriptorType, uint32_t> roundedCountPerType;
         uint32_t totalDescriptorCount = 0;
-        mPoolSizes.reserve(descriptorCountPerType.size());
         for (const auto& [type, count] : descriptorCountPerType) {
             ASSERT(count > 0);
-            totalDescriptorCount += count;
-            mPoolSizes.push_back(VkDescriptorPoolSize{type, count});
+            uint32_t roundedCount = static_cast<uint32_t>(NextPowerOfTwo(count));
+            roundedCountPerType[type] = roundedCount;
+            totalDescriptorCount += roundedCount;
         }
 
+        auto [it, inserted] =
+            mBucketIndices.emplace(roundedCountPerType, static_cast<BucketIndex>(mBuckets.size()));
+        if (!inserted) {
+            return it->second;
+        }
+
+        Bucket bucket;
         if (totalDescriptorCount == 0) {
             // Vulkan requires that valid usage of vkCreateDescriptorPool must have a non-zero
             // number of pools, each of which has non-zero descriptor counts.
             // Since the descriptor set layout is empty, we should be able to allocate
             // |kMaxDescriptorsPerPool| sets from this 1-sized descriptor pool.
             // The type of this descriptor pool doesn't matter because it is never used.
-            mPoolSizes.push_back(VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1});
-            mMaxSets = kMaxDescriptorsPerPool;
+            bucket.poolSizes.push_back(VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1});
+            bucket.maxSets = kMaxDescriptorsPerPool;
         } else {
-            ASSERT(totalDescriptorCount <= kMaxBindingsPerPipelineLayout);
-            static_assert(kMaxBindingsPerPipelineLayout <= kMaxDescriptorsPerPool);
-
-            // Compute the total number of descriptors sets that fits given the max.
-            mMaxSets = kMaxDescriptorsPerPool / totalDescriptorCount;
-            ASSERT(mMaxSets > 0);
-
-            // Grow the number of desciptors in the pool to fit the computed |mMaxSets|.
-            for (auto& poolSize : mPoolSizes) {
-                poolSize.descriptorCount *= mMaxSets;
+            // Compute the total number of descriptors sets that fits given the max, with at least
+            // one set for layouts that have more descriptors once rounded.
+            bucket.maxSets = std::max(1u, kMaxDescriptorsPerPool / totalDescriptorCount);
+
+            // Grow the number of desciptors in the pool to fit the computed |maxSets|.
+            bucket.poolSizes.reserve(roundedCountPerType.size());
+            for (const auto& [type, count] : roundedCountPerType) {
+                bucket.poolSizes.push_back(VkDescriptorPoolSize{type, count * bucket.maxSets});
             }
         }
-    }
+        mBuckets.push_back(std::move(bucket));
 
-    DescriptorSetAllocator::~DescriptorSetAllocator() {
-        for (auto& pool : mDescriptorPools) {
-            ASSERT(pool.freeSetIndices.size() == mMaxSets);
-            if (pool.vkPool != VK_NULL_HANDLE) {
-                Device* device = ToBackend(GetDevice());
-                device->GetFencedDeleter()->DeleteWhenUnused(pool.vkPool);
-            }
-        }
+        return it->second;
     }
 
-    ResultOrError<DescriptorSetAllocation> DescriptorSetAllocator::Allocate() {
-        if (mAvailableDescriptorPoolIndices.empty()) {
-            DAWN_TRY(AllocateDescriptorPool());
-        }
-
-        ASSERT(!mAvailableDescriptorPoolIndices.empty());
-
-        const PoolIndex poolIndex = mAvailableDescriptorPoolIndices.back();
-        DescriptorPool* pool = &mDescriptorPools[poolIndex];
-
-        ASSERT(!pool->freeSetIndices.empty());
+    ResultOrError<DescriptorSetAllocation> DescriptorSetAllocator::Allocate(
+        BucketIndex bucketIndex,
+        VkDescriptorSetLayout layout) {
+        ASSERT(bucketIndex < mBuckets.size());
+        Bucket* bucket = &mBuckets[bucketIndex];
+
+        // Pools are sized for the rounded descriptor counts of the bucket so that |maxSets| sets
+        // always fit, but some implementations may still run out of pool memory before that. In
+        // that case the set is allocated from another pool.
+        for (uint32_t attempt = 0; attempt < 2; ++attempt) {
+            if (bucket->currentPool == kNoPool ||
+                mPools[bucket->currentPool].allocatedSetCount == bucket->maxSets) {
+                const PoolIndex fullPool = bucket->currentPool;
+                if (!bucket->resetPools.empty()) {
+                    bucket->currentPool = bucket->resetPools.back();
+                    bucket->resetPools.pop_back();
+                } else {
+                    DAWN_TRY(AllocateDescriptorPool(bucketIndex));
+                }
+
+                // A pool considered full after running out of memory might not have any set in
+                // use, in which case FinishDeallocation will never reclaim it. Reset it now that
+                // it is no longer the current pool so that it is reused.
+                if (fullPool != kNoPool && ResetPoolIfUnused(fullPool)) {
+                    TraceStats();
+                }
+            }
 
-        SetIndex setIndex = pool->freeSetIndices.back();
-        pool->freeSetIndices.pop_back();
+            const PoolIndex poolIndex = bucket->currentPool;
+            DescriptorPool* pool = &mPools[poolIndex];
+
+            VkDescriptorSetAllocateInfo allocateInfo;
+            allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+            allocateInfo.pNext = nullptr;
+            allocateInfo.descriptorPool = pool->vkPool;
+            allocateInfo.descriptorSetCount = 1;
+            allocateInfo.pSetLayouts = &*layout;
+
+            VkDescriptorSet set;
+            VkResult result = VkResult::WrapUnsafe(
+                mDevice->fn.AllocateDescriptorSets(mDevice->GetVkDevice(), &allocateInfo, &*set));
+            if (result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL) {
+                // Consider the pool full so that the next attempt uses another one.
+                pool->allocatedSetCount = bucket->maxSets;
+                continue;
+            }
+            DAWN_TRY(CheckVkSuccess(result, "AllocateDescriptorSets"));
 
-        if (pool->freeSetIndices.empty()) {
-            mAvailableDescriptorPoolIndices.pop_back();
+            pool->allocatedSetCount++;
+            pool->liveSetCount++;
+            return DescriptorSetAllocation{set, poolIndex};
         }
 
-        return DescriptorSetAllocation{pool->sets[setIndex], poolIndex, setIndex};
+        return DAWN_INTERNAL_ERROR("Failed to allocate a descriptor set from a new pool.");
     }
 
     void DescriptorSetAllocator::Deallocate(DescriptorSetAllocation* allocationInfo) {
@@ -108,81 +145,91 @@ namespace dawn::native::vulkan {
         // We can't reuse the descriptor set right away because the Vulkan spec says in the
         // documentation for vkCmdBindDescriptorSets that the set may be consumed any time between
         // host execution of the command and the end of the draw/dispatch.
-        Device* device = ToBackend(GetDevice());
-        const ExecutionSerial serial = device->GetPendingCommandSerial();
-        mPendingDeallocations.Enqueue({allocationInfo->poolIndex, allocationInfo->setIndex},
-                                      serial);
-
-        if (mLastDeallocationSerial != serial) {
-            device->EnqueueDeferredDeallocation(this);
-            mLastDeallocationSerial = serial;
-        }
+        mPendingDeallocations.Enqueue(allocationInfo->poolIndex,
+                                      mDevice->GetPendingCommandSerial());
 
         // Clear the content of allocation so that use after frees are more visible.
         *allocationInfo = {};
     }
 
     void DescriptorSetAllocator::FinishDeallocation(ExecutionSerial completedSerial) {
-        for (const Deallocation& dealloc : mPendingDeallocations.IterateUpTo(completedSerial)) {
-            ASSERT(dealloc.poolIndex < mDescriptorPools.size());
+        bool hasResetPools = false;
+        for (PoolIndex poolIndex : mPendingDeallocations.IterateUpTo(completedSerial)) {
+            ASSERT(poolIndex < mPools.size());
+            DescriptorPool& pool = mPools[poolIndex];
+
+            ASSERT(pool.liveSetCount > 0);
+            pool.liveSetCount--;
+            hasResetPools |= ResetPoolIfUnused(poolIndex);
+        }
+        mPendingDeallocations.ClearUpTo(completedSerial);
 
-            auto& freeSetIndices = mDescriptorPools[dealloc.poolIndex].freeSetIndices;
-            if (freeSetIndices.empty()) {
-                mAvailableDescriptorPoolIndices.emplace_back(dealloc.poolIndex);
+        if (hasResetPools) {
+            TraceStats();
+        }
+    }
+
+    DescriptorSetAllocator::Stats DescriptorSetAllocator::GetStats() const {
+        Stats stats;
+        stats.bucketCount = static_cast<uint32_t>(mBuckets.size());
+        stats.poolCount = static_cast<uint32_t>(mPools.size());
+        for (const DescriptorPool& pool : mPools) {
+            const Bucket& bucket = mBuckets[pool.bucketIndex];
+            for (const VkDescriptorPoolSize& poolSize : bucket.poolSizes) {
+                stats.descriptorCapacity += poolSize.descriptorCount;
             }
-            freeSetIndices.emplace_back(dealloc.setIndex);
+            stats.setCapacity += bucket.maxSets;
+            stats.setsInUse += pool.liveSetCount;
         }
-        mPendingDeallocations.ClearUpTo(completedSerial);
+        return stats;
     }
 
-    MaybeError DescriptorSetAllocator::AllocateDescriptorPool() {
+    MaybeError DescriptorSetAllocator::AllocateDescriptorPool(BucketIndex bucketIndex) {
+        Bucket& bucket = mBuckets[bucketIndex];
+
         VkDescriptorPoolCreateInfo createInfo;
         createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
         createInfo.pNext = nullptr;
         createInfo.flags = 0;
-        createInfo.maxSets = mMaxSets;
-        createInfo.poolSizeCount = static_cast<PoolIndex>(mPoolSizes.size());
-        createInfo.pPoolSizes = mPoolSizes.data();
-
-        Device* device = ToBackend(GetDevice());
+        createInfo.maxSets = bucket.maxSets;
+        createInfo.poolSizeCount = static_cast<uint32_t>(bucket.poolSizes.size());
+        createInfo.pPoolSizes = bucket.poolSizes.data();
 
         VkDescriptorPool descriptorPool;
-        DAWN_TRY(CheckVkSuccess(device->fn.CreateDescriptorPool(device->GetVkDevice(), &createInfo,
-                                                                nullptr, &*descriptorPool),
+        DAWN_TRY(CheckVkSuccess(mDevice->fn.CreateDescriptorPool(
+                                    mDevice->GetVkDevice(), &createInfo, nullptr, &*descriptorPool),
                                 "CreateDescriptorPool"));
 
-        std::vector<VkDescriptorSetLayout> layouts(mMaxSets, mLayout->GetHandle());
-
-        VkDescriptorSetAllocateInfo allocateInfo;
-        allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-        allocateInfo.pNext = nullptr;
-        allocateInfo.descriptorPool = descriptorPool;
-        allocateInfo.descriptorSetCount = mMaxSets;
-        allocateInfo.pSetLayouts = AsVkArray(layouts.data());
-
-        std::vector<VkDescriptorSet> sets(mMaxSets);
-        MaybeError result =
-            CheckVkSuccess(device->fn.AllocateDescriptorSets(device->GetVkDevice(), &allocateInfo,
-                                                             AsVkArray(sets.data())),
-                           "AllocateDescriptorSets");
-        if (result.IsError()) {
-            // On an error we can destroy the pool immediately because no command references it.
-            device->fn.DestroyDescriptorPool(device->GetVkDevice(), descriptorPool, nullptr);
-            DAWN_TRY(std::move(result));
-        }
+        bucket.currentPool = static_cast<PoolIndex>(mPools.size());
+        mPools.push_back(DescriptorPool{descriptorPool, bucketIndex, 0, 0});
 
-        std::vector<SetIndex> freeSetIndices;
-        freeSetIndices.reserve(mMaxSets);
+        TraceStats();
+        return {};
+    }
 
-        for (SetIndex i = 0; i < mMaxSets; ++i) {
-            freeSetIndices.push_back(i);
+    bool DescriptorSetAllocator::ResetPoolIfUnused(PoolIndex poolIndex) {
+        ASSERT(poolIndex < mPools.size());
+        DescriptorPool& pool = mPools[poolIndex];
+        if (pool.liveSetCount > 0) {
+            return false;
         }
 
-        mAvailableDescriptorPoolIndices.push_back(mDescriptorPools.size());
-        mDescriptorPools.emplace_back(
-            DescriptorPool{descriptorPool, std::move(sets), std::move(freeSetIndices)});
+        // All the sets of the pool are unused, free them all at once. The current pool stays the
+        // current pool, others can become it again. vkResetDescriptorPool can only return
+        // VK_SUCCESS.
+        mDevice->fn.ResetDescriptorPool(mDevice->GetVkDevice(), pool.vkPool, 0);
+        Bucket& bucket = mBuckets[pool.bucketIndex];
+        if (bucket.currentPool != poolIndex) {
+            bucket.resetPools.push_back(poolIndex);
+        }
+        pool.allocatedSetCount = 0;
+        return true;
+    }
 
-        return {};
+    void DescriptorSetAllocator::TraceStats() const {
+        Stats stats = GetStats();
+        TRACE_COUNTER1(mDevice->GetPlatform(), General, "DescriptorPoolCount", stats.poolCount);
+        TRACE_COUNTER1(mDevice->GetPlatform(), General, "DescriptorSetsInUse", stats.setsInUse);
     }
 
 }  // namespace dawn::native::vulkan
@@ -15,11 +15,11 @@
 #ifndef DAWNNATIVE_VULKAN_DESCRIPTORSETALLOCATOR_H_
 #define DAWNNATIVE_VULKAN_DESCRIPTORSETALLOCATOR_H_
 
+#include "dawn/common/NonCopyable.h"
 #include "dawn/common/SerialQueue.h"
 #include "dawn/common/vulkan_platform.h"
 #include "dawn/native/Error.h"
 #include "dawn/native/IntegerTypes.h"
-#include "dawn/native/ObjectBase.h"
 #include "dawn/native/vulkan/DescriptorSetAllocation.h"
 
 #include <map>
@@ -27,48 +27,78 @@
 
 namespace dawn::native::vulkan {
 
-    class BindGroupLayout;
+    class Device;
+
+    // In Vulkan descriptor pools have to be sized to an exact number of descriptors of each type.
+    // To avoid having mostly empty pools for each BindGroupLayout, layouts are put in buckets by
+    // their descriptor counts per type, rounded up to a power of two, and all the layouts of a
+    // bucket allocate their descriptor sets from the same pools.
+    //
+    // Descriptor sets aren't freed individually. Instead a pool is reset with
+    // vkResetDescriptorPool, and reused by its bucket, once all of its sets are no longer used by
+    // the GPU.
+    class DescriptorSetAllocator : public NonCopyable {
+      public:
+        using BucketIndex = uint32_t;
 
-    class DescriptorSetAllocator : public ObjectBase {
-        using PoolIndex = uint32_t;
-        using SetIndex = uint16_t;
+        explicit DescriptorSetAllocator(Device* device);
+        ~DescriptorSetAllocator();
 
-      public:
-        static Ref<DescriptorSetAllocator> Create(
-            BindGroupLayout* layout,
-            std::map<VkDescriptorType, uint32_t> descriptorCountPerType);
+        // Returns the bucket that layouts with these descriptor counts allocate from.
+        BucketIndex GetBucket(const std::map<VkDescriptorType, uint32_t>& descriptorCountPerType);
 
-        ResultOrError<DescriptorSetAllocation> Allocate();
+        ResultOrError<DescriptorSetAllocation> Allocate(BucketIndex bucketIndex,
+                                                        VkDescriptorSetLayout layout);
         void Deallocate(DescriptorSetAllocation* allocationInfo);
         void FinishDeallocation(ExecutionSerial completedSerial);
 
-      private:
-        DescriptorSetAllocator(BindGroupLayout* layout,
-                               std::map<VkDescriptorType, uint32_t> descriptorCountPerType);
-        ~DescriptorSetAllocator();
-
-        MaybeError AllocateDescriptorPool();
-
-        BindGroupLayout* mLayout;
+        struct Stats {
+            uint32_t bucketCount = 0;
+            uint32_t poolCount = 0;
+            // The number of descriptors of all the pools.
+            uint64_t descriptorCapacity = 0;
+            // The number of descriptor sets that fit in all the pools, and how many of them are
+            // allocated and not yet reclaimed.
+            uint64_t setCapacity = 0;
+            uint64_t setsInUse = 0;
+        };
+        Stats GetStats() const;
 
-        std::vector<VkDescriptorPoolSize> mPoolSizes;
-        SetIndex mMaxSets;
+      private:
+        using PoolIndex = uint32_t;
+        static constexpr PoolIndex kNoPool = ~PoolIndex(0);
+
+        MaybeError AllocateDescriptorPool(BucketIndex bucketIndex);
+        // Resets the pool and makes it available to its bucket again if none of its sets are
+        // used. Returns whether it was reset.
+        bool ResetPoolIfUnused(PoolIndex poolIndex);
+        void TraceStats() const;
+
+        Device* mDevice;
+
+        struct Bucket {
+            std::vector<VkDescriptorPoolSize> poolSizes;
+            uint32_t maxSets;
+            // The pool descriptor sets are allocated from until it is full.
+            PoolIndex currentPool = kNoPool;
+            // Pools that were reset and can become the current pool.
+            std::vector<PoolIndex> resetPools;
+        };
+        std::vector<Bucket> mBuckets;
+        std::map<std::map<VkDescriptorType, uint32_t>, BucketIndex> mBucketIndices;
 
         struct DescriptorPool {
             VkDescriptorPool vkPool;
-            std::vector<VkDescriptorSet> sets;
-            std::vector<SetIndex> freeSetIndices;
+            BucketIndex bucketIndex;
+            // The number of sets allocated since the last reset, and the number of those that
+            // may still be used by the GPU.
+            uint32_t allocatedSetCount;
+            uint32_t liveSetCount;
         };
+        std::vector<DescriptorPool> mPools;
 
-        std::vector<PoolIndex> mAvailableDescriptorPoolIndices;
-        std::vector<DescriptorPool> mDescriptorPools;
-
-        struct Deallocation {
-            PoolIndex poolIndex;
-            SetIndex setIndex;
-        };
-        SerialQueue<ExecutionSerial, Deallocation> mPendingDeallocations;
-        ExecutionSerial mLastDeallocationSerial = ExecutionSerial(0);
+        // The pools of the descriptor sets deallocated at each serial.
+        SerialQueue<ExecutionSerial, PoolIndex> mPendingDeallocations;
     };
 
 }  // namespace dawn::native::vulkan
@@ -0,0 +1,107 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/native/vulkan/DescriptorWriteBatch.h"
+
+#include "dawn/common/Assert.h"
+#include "dawn/native/vulkan/DeviceVk.h"
+
+namespace dawn::native::vulkan {
+
+    namespace {
+
+        bool IsBufferDescriptor(VkDescriptorType type) {
+            switch (type) {
+                case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+                case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
+                case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+                case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+    }  // anonymous namespace
+
+    DescriptorWriteBatch::DescriptorWriteBatch(Device* device) : mDevice(device) {
+    }
+
+    DescriptorWriteBatch::~DescriptorWriteBatch() {
+        ASSERT(mWrites.empty());
+        ASSERT(mTemplateUpdates.empty());
+    }
+
+    void DescriptorWriteBatch::EnqueueTemplateUpdate(VkDescriptorSet set,
+                                                     VkDescriptorUpdateTemplate updateTemplate,
+                                                     const DescriptorInfo* infos,
+                                                     BindingIndex bindingCount) {
+        ASSERT(updateTemplate != VK_NULL_HANDLE);
+        mTemplateUpdates.push_back({set, updateTemplate, mTemplateInfos.size()});
+        mTemplateInfos.insert(mTemplateInfos.end(), infos,
+                              infos + static_cast<uint32_t>(bindingCount));
+    }
+
+    void DescriptorWriteBatch::EnqueueWrite(VkDescriptorSet set,
+                                            BindingIndex bindingIndex,
+                                            VkDescriptorType type,
+                                            const DescriptorInfo& info) {
+        VkWriteDescriptorSet write;
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.pNext = nullptr;
+        write.dstSet = set;
+        write.dstBinding = static_cast<uint32_t>(bindingIndex);
+        write.dstArrayElement = 0;
+        write.descriptorCount = 1;
+        write.descriptorType = type;
+        write.pImageInfo = nullptr;
+        write.pBufferInfo = nullptr;
+        write.pTexelBufferView = nullptr;
+
+        mWrites.push_back(write);
+        mWriteInfos.push_back(info);
+    }
+
+    void DescriptorWriteBatch::Flush() {
+        if (!mWrites.empty()) {
+            for (size_t i = 0; i < mWrites.size(); ++i) {
+                if (IsBufferDescriptor(mWrites[i].descriptorType)) {
+                    mWrites[i].pBufferInfo = &mWriteInfos[i].buffer;
+                } else {
+                    mWrites[i].pImageInfo = &mWriteInfos[i].image;
+                }
+            }
+            mDevice->fn.UpdateDescriptorSets(mDevice->GetVkDevice(),
+                                             static_cast<uint32_t>(mWrites.size()),
+                                             mWrites.data(), 0, nullptr);
+        }
+
+        for (const TemplateUpdate& update : mTemplateUpdates) {
+            mDevice->fn.UpdateDescriptorSetWithTemplate(mDevice->GetVkDevice(), update.set,
+                                                        update.updateTemplate,
+                                                        &mTemplateInfos[update.firstInfo]);
+        }
+
+        Discard();
+    }
+
+    void DescriptorWriteBatch::Discard() {
+        // clear() keeps the capacity so that the next batches don't allocate.
+        mWrites.clear();
+        mWriteInfos.clear();
+        mTemplateUpdates.clear();
+        mTemplateInfos.clear();
+    }
+
+}  // namespace dawn::native::vulkan
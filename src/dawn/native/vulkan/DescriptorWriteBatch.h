@@ -0,0 +1,81 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_VULKAN_DESCRIPTORWRITEBATCH_H_
+#define DAWNNATIVE_VULKAN_DESCRIPTORWRITEBATCH_H_
+
+#include "dawn/common/NonCopyable.h"
+#include "dawn/common/vulkan_platform.h"
+#include "dawn/native/IntegerTypes.h"
+
+#include <vector>
+
+namespace dawn::native::vulkan {
+
+    class Device;
+
+    // The content of one descriptor. An array of them indexed by BindingIndex is the data
+    // consumed by the VkDescriptorUpdateTemplate of a BindGroupLayout.
+    union DescriptorInfo {
+        VkDescriptorBufferInfo buffer;
+        VkDescriptorImageInfo image;
+    };
+
+    // Descriptor sets only need to be written before commands binding them are recorded, so
+    // instead of updating them when each bind group is created, the updates are accumulated here
+    // and done all at once when Flush is called, before recording the commands of a submit. The
+    // descriptor sets and the resources they point to can't be freed before that: they are only
+    // deleted on a Tick, which calls Flush first, and the BindGroupLayout owning the sets and the
+    // update template flushes the batch when it is destroyed.
+    class DescriptorWriteBatch : public NonCopyable {
+      public:
+        explicit DescriptorWriteBatch(Device* device);
+        ~DescriptorWriteBatch();
+
+        // Writes all the bindings of `set` with `updateTemplate`, `infos` being indexed by
+        // BindingIndex.
+        void EnqueueTemplateUpdate(VkDescriptorSet set,
+                                   VkDescriptorUpdateTemplate updateTemplate,
+                                   const DescriptorInfo* infos,
+                                   BindingIndex bindingCount);
+        // Writes the single descriptor of binding `bindingIndex` of `set`.
+        void EnqueueWrite(VkDescriptorSet set,
+                          BindingIndex bindingIndex,
+                          VkDescriptorType type,
+                          const DescriptorInfo& info);
+
+        void Flush();
+        // Drops the pending updates, used when the device is destroyed.
+        void Discard();
+
+      private:
+        Device* mDevice;
+
+        // The pointers to the infos of the writes are only set in Flush since mWriteInfos may be
+        // reallocated until then. mWriteInfos[i] is the info of mWrites[i].
+        std::vector<VkWriteDescriptorSet> mWrites;
+        std::vector<DescriptorInfo> mWriteInfos;
+
+        struct TemplateUpdate {
+            VkDescriptorSet set;
+            VkDescriptorUpdateTemplate updateTemplate;
+            size_t firstInfo;
+        };
+        std::vector<TemplateUpdate> mTemplateUpdates;
+        std::vector<DescriptorInfo> mTemplateInfos;
+    };
+
+}  // namespace dawn::native::vulkan
+
+#endif  // DAWNNATIVE_VULKAN_DESCRIPTORWRITEBATCH_H_
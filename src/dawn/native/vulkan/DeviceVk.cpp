@@ -27,7 +27,10 @@
 #include "dawn/native/vulkan/BufferVk.h"
 #include "dawn/native/vulkan/CommandBufferVk.h"
 #include "dawn/native/vulkan/ComputePipelineVk.h"
+#include "dawn/native/vulkan/DescriptorWriteBatch.h"
 #include "dawn/native/vulkan/FencedDeleter.h"
+#include "dawn/native/vulkan/FramebufferCache.h"
+#include "dawn/native/vulkan/PipelineCacheVk.h"
 #include "dawn/native/vulkan/PipelineLayoutVk.h"
 #include "dawn/native/vulkan/QuerySetVk.h"
 #include "dawn/native/vulkan/QueueVk.h"
@@ -39,8 +42,11 @@
 #include "dawn/native/vulkan/StagingBufferVk.h"
 #include "dawn/native/vulkan/SwapChainVk.h"
 #include "dawn/native/vulkan/TextureVk.h"
+#include "dawn/native/vulkan/TransferQueue.h"
 #include "dawn/native/vulkan/UtilsVulkan.h"
 #include "dawn/native/vulkan/VulkanError.h"
+#include "dawn/platform/DawnPlatform.h"
+#include "dawn/platform/tracing/TraceEvent.h"
 
 namespace dawn::native::vulkan {
 
@@ -85,7 +91,16 @@ namespace dawn::native::vulkan {
             mDeleter = std::make_unique<FencedDeleter>(this);
         }
 
+        DAWN_TRY(CreateTimelineSemaphore());
+
+        if (mTransferQueueFamily.has_value()) {
+            mTransferQueue = std::make_unique<TransferQueue>(this, *mTransferQueueFamily);
+        }
+
+        mDescriptorSetAllocator = std::make_unique<DescriptorSetAllocator>(this);
+        mDescriptorWriteBatch = std::make_unique<DescriptorWriteBatch>(this);
         mRenderPassCache = std::make_unique<RenderPassCache>(this);
+        mFramebufferCache = std::make_unique<FramebufferCache>(this);
         mResourceMemoryAllocator = std::make_unique<ResourceMemoryAllocator>(this);
 
         mExternalMemoryService = std::make_unique<external_memory::Service>(this);
@@ -97,7 +112,13 @@ namespace dawn::native::vulkan {
         // the decision if it is not applicable.
         ApplyDepth24PlusS8Toggle();
 
-        return DeviceBase::Initialize(Queue::Create(this));
+        DAWN_TRY(DeviceBase::Initialize(Queue::Create(this)));
+
+        // The pipeline cache is seeded from the PersistentCache which is created by
+        // DeviceBase::Initialize.
+        DAWN_TRY_ASSIGN(mPipelineCache, PipelineCache::Create(this));
+
+        return {};
     }
 
     Device::~Device() {
@@ -175,23 +196,46 @@ namespace dawn::native::vulkan {
     }
 
     MaybeError Device::TickImpl() {
+        // Write the descriptor sets before any of them, or of the resources they reference, is
+        // deleted below.
+        mDescriptorWriteBatch->Flush();
+
         RecycleCompletedCommands();
 
         ExecutionSerial completedSerial = GetCompletedCommandSerial();
 
-        for (Ref<DescriptorSetAllocator>& allocator :
-             mDescriptorAllocatorsPendingDeallocation.IterateUpTo(completedSerial)) {
-            allocator->FinishDeallocation(completedSerial);
-        }
-
+        mDescriptorSetAllocator->FinishDeallocation(completedSerial);
         mResourceMemoryAllocator->Tick(completedSerial);
         mDeleter->Tick(completedSerial);
-        mDescriptorAllocatorsPendingDeallocation.ClearUpTo(completedSerial);
+        if (mTransferQueue != nullptr) {
+            mTransferQueue->Tick(completedSerial);
+        }
+
+        for (VkCommandBuffer commandBuffer :
+             mSecondaryCommandBuffersToFree.IterateUpTo(completedSerial)) {
+            fn.FreeCommandBuffers(mVkDevice, mSecondaryCommandPool, 1, &commandBuffer);
+        }
+        mSecondaryCommandBuffersToFree.ClearUpTo(completedSerial);
+
+        for (WorkerCommandPool& pool : mWorkerCommandPoolsInFlight.IterateUpTo(completedSerial)) {
+            mUnusedWorkerCommandPools.push_back(std::move(pool));
+        }
+        mWorkerCommandPoolsInFlight.ClearUpTo(completedSerial);
+
+        // The defragmentation copies buffers to new memory, which is only done when the GPU is
+        // idle so that it doesn't delay other work.
+        if (IsToggleEnabled(Toggle::VulkanDefragmentMemoryWhenIdle) && !mRecordingContext.used &&
+            completedSerial == GetLastSubmittedCommandSerial() &&
+            (mTransferQueue == nullptr || !mTransferQueue->HasPendingCommands())) {
+            DAWN_TRY(mResourceMemoryAllocator->Defragment(GetPendingRecordingContext()));
+        }
 
         if (mRecordingContext.used) {
             DAWN_TRY(SubmitPendingCommands());
         }
 
+        DAWN_TRY(mPipelineCache->Tick());
+
         return {};
     }
 
@@ -218,20 +262,36 @@ namespace dawn::native::vulkan {
         return mQueue;
     }
 
+    DescriptorSetAllocator* Device::GetDescriptorSetAllocator() const {
+        return mDescriptorSetAllocator.get();
+    }
+
+    DescriptorWriteBatch* Device::GetDescriptorWriteBatch() const {
+        return mDescriptorWriteBatch.get();
+    }
+
     FencedDeleter* Device::GetFencedDeleter() const {
         return mDeleter.get();
     }
 
+    PipelineCache* Device::GetPipelineCache() const {
+        return mPipelineCache.get();
+    }
+
     RenderPassCache* Device::GetRenderPassCache() const {
         return mRenderPassCache.get();
     }
 
-    ResourceMemoryAllocator* Device::GetResourceMemoryAllocator() const {
-        return mResourceMemoryAllocator.get();
+    FramebufferCache* Device::GetFramebufferCache() const {
+        return mFramebufferCache.get();
     }
 
-    void Device::EnqueueDeferredDeallocation(DescriptorSetAllocator* allocator) {
-        mDescriptorAllocatorsPendingDeallocation.Enqueue(allocator, GetPendingCommandSerial());
+    TransferQueue* Device::GetTransferQueue() const {
+        return mTransferQueue.get();
+    }
+
+    ResourceMemoryAllocator* Device::GetResourceMemoryAllocator() const {
+        return mResourceMemoryAllocator.get();
     }
 
     CommandRecordingContext* Device::GetPendingRecordingContext() {
@@ -248,6 +308,16 @@ namespace dawn::native::vulkan {
         DAWN_TRY(CheckVkSuccess(fn.EndCommandBuffer(mRecordingContext.commandBuffer),
                                 "vkEndCommandBuffer"));
 
+        // The uploads done on the transfer queue for this serial are submitted first and the
+        // commands of the serial wait for them.
+        if (mTransferQueue != nullptr) {
+            VkSemaphore uploadsDone;
+            DAWN_TRY_ASSIGN(uploadsDone, mTransferQueue->SubmitPendingCommands(mTimelineSemaphore));
+            if (uploadsDone != VK_NULL_HANDLE) {
+                mRecordingContext.waitSemaphores.push_back(uploadsDone);
+            }
+        }
+
         std::vector<VkPipelineStageFlags> dstStageMasks(mRecordingContext.waitSemaphores.size(),
                                                         VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
 
@@ -263,15 +333,44 @@ namespace dawn::native::vulkan {
         submitInfo.signalSemaphoreCount =
             static_cast<uint32_t>(mRecordingContext.signalSemaphores.size());
         submitInfo.pSignalSemaphores = AsVkArray(mRecordingContext.signalSemaphores.data());
+        PNextChainBuilder submitInfoChain(&submitInfo);
+
+        ExecutionSerial submitSerial = GetPendingCommandSerial();
 
+        // The timeline semaphore is signaled along with the binary semaphores. Their values are
+        // ignored but there must be one for each semaphore.
+        std::vector<VkSemaphore> signalSemaphores;
+        std::vector<uint64_t> signalValues;
+        VkTimelineSemaphoreSubmitInfo timelineSubmitInfo;
         VkFence fence = VK_NULL_HANDLE;
-        DAWN_TRY_ASSIGN(fence, GetUnusedFence());
+        if (mTimelineSemaphore != VK_NULL_HANDLE) {
+            signalSemaphores = mRecordingContext.signalSemaphores;
+            signalSemaphores.push_back(mTimelineSemaphore);
+            signalValues.resize(signalSemaphores.size(), 0);
+            signalValues.back() = static_cast<uint64_t>(submitSerial);
+
+            submitInfo.signalSemaphoreCount = static_cast<uint32_t>(signalSemaphores.size());
+            submitInfo.pSignalSemaphores = AsVkArray(signalSemaphores.data());
+
+            timelineSubmitInfo.waitSemaphoreValueCount = 0;
+            timelineSubmitInfo.pWaitSemaphoreValues = nullptr;
+            timelineSubmitInfo.signalSemaphoreValueCount =
+                static_cast<uint32_t>(signalValues.size());
+            timelineSubmitInfo.pSignalSemaphoreValues = signalValues.data();
+            submitInfoChain.Add(&timelineSubmitInfo,
+                                VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO);
+        } else {
+            DAWN_TRY_ASSIGN(fence, GetUnusedFence());
+        }
+
         DAWN_TRY_WITH_CLEANUP(
             CheckVkSuccess(fn.QueueSubmit(mQueue, 1, &submitInfo, fence), "vkQueueSubmit"), {
                 // If submitting to the queue fails, move the fence back into the unused fence
                 // list, as if it were never acquired. Not doing so would leak the fence since
                 // it would be neither in the unused list nor in the in-flight list.
-                mUnusedFences.push_back(fence);
+                if (fence != VK_NULL_HANDLE) {
+                    mUnusedFences.push_back(fence);
+                }
             });
 
         // Enqueue the semaphores before incrementing the serial, so that they can be deleted as
@@ -285,7 +384,18 @@ namespace dawn::native::vulkan {
 
         IncrementLastSubmittedCommandSerial();
         ExecutionSerial lastSubmittedSerial = GetLastSubmittedCommandSerial();
-        mFencesInFlight.emplace(fence, lastSubmittedSerial);
+        ASSERT(lastSubmittedSerial == submitSerial);
+        if (fence != VK_NULL_HANDLE) {
+            mFencesInFlight.emplace(fence, lastSubmittedSerial);
+        }
+
+        mBarrierStats.pipelineBarrierCount += mRecordingContext.pipelineBarrierCount;
+        mBarrierStats.lastSubmitPipelineBarrierCount = mRecordingContext.pipelineBarrierCount;
+        mBarrierStats.lastSubmitMemoryBarrierCount = mRecordingContext.memoryBarrierCount;
+        TRACE_COUNTER1(GetPlatform(), General, "VulkanPipelineBarriersPerSubmit",
+                       mRecordingContext.pipelineBarrierCount);
+        TRACE_COUNTER1(GetPlatform(), General, "VulkanMemoryBarriersPerSubmit",
+                       mRecordingContext.memoryBarrierCount);
 
         CommandPoolAndBuffer submittedCommands = {mRecordingContext.commandPool,
                                                   mRecordingContext.commandBuffer};
@@ -296,6 +406,18 @@ namespace dawn::native::vulkan {
         return {};
     }
 
+    Device::BarrierStats Device::GetBarrierStats() const {
+        return mBarrierStats;
+    }
+
+    uint64_t Device::GetExecuteCommandsCountForTesting() const {
+        return mExecuteCommandsCountForTesting;
+    }
+
+    void Device::IncrementExecuteCommandsCountForTesting() {
+        mExecuteCommandsCountForTesting++;
+    }
+
     ResultOrError<VulkanDeviceKnobs> Device::CreateDevice(VkPhysicalDevice physicalDevice) {
         VulkanDeviceKnobs usedKnobs = {};
 
@@ -373,6 +495,38 @@ namespace dawn::native::vulkan {
             usedKnobs.features.pipelineStatisticsQuery = VK_TRUE;
         }
 
+        if (mDeviceInfo.HasExt(DeviceExt::ImagelessFramebuffer) &&
+            mDeviceInfo.imagelessFramebufferFeatures.imagelessFramebuffer == VK_TRUE) {
+            ASSERT(usedKnobs.HasExt(DeviceExt::ImagelessFramebuffer));
+
+            // Imageless framebuffers let the FramebufferCache share framebuffers between render
+            // passes that use different attachments of the same kind.
+            usedKnobs.imagelessFramebufferFeatures.imagelessFramebuffer = VK_TRUE;
+            featuresChain.Add(&usedKnobs.imagelessFramebufferFeatures,
+                              VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_IMAGELESS_FRAMEBUFFER_FEATURES);
+        }
+
+        if (mDeviceInfo.HasExt(DeviceExt::TimelineSemaphore) &&
+            mDeviceInfo.timelineSemaphoreFeatures.timelineSemaphore == VK_TRUE &&
+            !IsToggleEnabled(Toggle::VulkanDisableTimelineSemaphore)) {
+            ASSERT(usedKnobs.HasExt(DeviceExt::TimelineSemaphore));
+
+            // The timeline semaphore replaces the fences used to track the completed serials.
+            usedKnobs.timelineSemaphoreFeatures.timelineSemaphore = VK_TRUE;
+            featuresChain.Add(&usedKnobs.timelineSemaphoreFeatures,
+                              VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES);
+        }
+
+        if (mDeviceInfo.HasExt(DeviceExt::Synchronization2) &&
+            mDeviceInfo.synchronization2Features.synchronization2 == VK_TRUE) {
+            ASSERT(usedKnobs.HasExt(DeviceExt::Synchronization2));
+
+            // Synchronization2 lets the barriers of copies use per-barrier and finer stage masks.
+            usedKnobs.synchronization2Features.synchronization2 = VK_TRUE;
+            featuresChain.Add(&usedKnobs.synchronization2Features,
+                              VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES_KHR);
+        }
+
         if (IsFeatureEnabled(Feature::ShaderFloat16)) {
             const VulkanDeviceInfo& deviceInfo = ToBackend(GetAdapter())->GetDeviceInfo();
             ASSERT(deviceInfo.HasExt(DeviceExt::ShaderFloat16Int8) &&
@@ -415,6 +569,21 @@ namespace dawn::native::vulkan {
             mQueueFamily = static_cast<uint32_t>(universalQueueFamily);
         }
 
+        // Find a transfer-only queue family for the uploads. Its submits are ordered with the
+        // ones of the universal queue using the timeline semaphore.
+        if (IsToggleEnabled(Toggle::VulkanUseDedicatedTransferQueue) &&
+            usedKnobs.timelineSemaphoreFeatures.timelineSemaphore == VK_TRUE) {
+            constexpr uint32_t kUniversalFlags = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT;
+            for (unsigned int i = 0; i < mDeviceInfo.queueFamilies.size(); ++i) {
+                const VkQueueFamilyProperties& family = mDeviceInfo.queueFamilies[i];
+                if ((family.queueFlags & VK_QUEUE_TRANSFER_BIT) != 0 &&
+                    (family.queueFlags & kUniversalFlags) == 0 && family.queueCount > 0) {
+                    mTransferQueueFamily = static_cast<uint32_t>(i);
+                    break;
+                }
+            }
+        }
+
         // Choose to create a single universal queue
         std::vector<VkDeviceQueueCreateInfo> queuesToRequest;
         float zero = 0.0f;
@@ -429,6 +598,17 @@ namespace dawn::native::vulkan {
 
             queuesToRequest.push_back(queueCreateInfo);
         }
+        if (mTransferQueueFamily.has_value()) {
+            VkDeviceQueueCreateInfo queueCreateInfo;
+            queueCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+            queueCreateInfo.pNext = nullptr;
+            queueCreateInfo.flags = 0;
+            queueCreateInfo.queueFamilyIndex = *mTransferQueueFamily;
+            queueCreateInfo.queueCount = 1;
+            queueCreateInfo.pQueuePriorities = &zero;
+
+            queuesToRequest.push_back(queueCreateInfo);
+        }
 
         VkDeviceCreateInfo createInfo;
         createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
@@ -517,6 +697,29 @@ namespace dawn::native::vulkan {
         return const_cast<VulkanFunctions*>(&fn);
     }
 
+    MaybeError Device::CreateTimelineSemaphore() {
+        if (!mDeviceInfo.HasExt(DeviceExt::TimelineSemaphore) ||
+            mDeviceInfo.timelineSemaphoreFeatures.timelineSemaphore != VK_TRUE ||
+            IsToggleEnabled(Toggle::VulkanDisableTimelineSemaphore)) {
+            return {};
+        }
+
+        VkSemaphoreTypeCreateInfo typeCreateInfo;
+        typeCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+        typeCreateInfo.pNext = nullptr;
+        typeCreateInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        typeCreateInfo.initialValue = static_cast<uint64_t>(GetCompletedCommandSerial());
+
+        VkSemaphoreCreateInfo createInfo;
+        createInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        createInfo.pNext = &typeCreateInfo;
+        createInfo.flags = 0;
+
+        return CheckVkSuccess(
+            fn.CreateSemaphore(mVkDevice, &createInfo, nullptr, &*mTimelineSemaphore),
+            "vkCreateSemaphore");
+    }
+
     ResultOrError<VkFence> Device::GetUnusedFence() {
         if (!mUnusedFences.empty()) {
             VkFence fence = mUnusedFences.back();
@@ -539,6 +742,14 @@ namespace dawn::native::vulkan {
     }
 
     ResultOrError<ExecutionSerial> Device::CheckAndUpdateCompletedSerials() {
+        if (mTimelineSemaphore != VK_NULL_HANDLE) {
+            uint64_t completedValue = 0;
+            DAWN_TRY(CheckVkSuccess(
+                fn.GetSemaphoreCounterValue(mVkDevice, mTimelineSemaphore, &completedValue),
+                "vkGetSemaphoreCounterValue"));
+            return ExecutionSerial(completedValue);
+        }
+
         ExecutionSerial fenceSerial(0);
         while (!mFencesInFlight.empty()) {
             VkFence fence = mFencesInFlight.front().first;
@@ -565,6 +776,129 @@ namespace dawn::native::vulkan {
         return fenceSerial;
     }
 
+    MaybeError Device::WaitForSerial(ExecutionSerial serial) {
+        DAWN_TRY(CheckPassedSerials());
+        if (GetCompletedCommandSerial() >= serial) {
+            return {};
+        }
+        ASSERT(serial <= GetLastSubmittedCommandSerial());
+
+        if (mTimelineSemaphore != VK_NULL_HANDLE) {
+            uint64_t value = static_cast<uint64_t>(serial);
+            VkSemaphoreWaitInfo waitInfo;
+            waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+            waitInfo.pNext = nullptr;
+            waitInfo.flags = 0;
+            waitInfo.semaphoreCount = 1;
+            waitInfo.pSemaphores = &*mTimelineSemaphore;
+            waitInfo.pValues = &value;
+            DAWN_TRY(CheckVkSuccess(fn.WaitSemaphores(mVkDevice, &waitInfo, UINT64_MAX),
+                                    "vkWaitSemaphores"));
+            return CheckPassedSerials();
+        }
+
+        // Fences are in submission order so wait on them until the one of |serial| is ready.
+        while (GetCompletedCommandSerial() < serial) {
+            ASSERT(!mFencesInFlight.empty());
+            VkFence fence = mFencesInFlight.front().first;
+            DAWN_TRY(CheckVkSuccess(fn.WaitForFences(mVkDevice, 1, &*fence, true, UINT64_MAX),
+                                    "vkWaitForFences"));
+            DAWN_TRY(CheckPassedSerials());
+        }
+        return {};
+    }
+
+    ResultOrError<VkCommandBuffer> Device::AllocateSecondaryCommandBuffer() {
+        if (mSecondaryCommandPool == VK_NULL_HANDLE) {
+            VkCommandPoolCreateInfo createInfo;
+            createInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+            createInfo.pNext = nullptr;
+            createInfo.flags = 0;
+            createInfo.queueFamilyIndex = mQueueFamily;
+
+            DAWN_TRY(CheckVkSuccess(
+                fn.CreateCommandPool(mVkDevice, &createInfo, nullptr, &*mSecondaryCommandPool),
+                "vkCreateCommandPool"));
+        }
+
+        VkCommandBufferAllocateInfo allocateInfo;
+        allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocateInfo.pNext = nullptr;
+        allocateInfo.commandPool = mSecondaryCommandPool;
+        allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+        allocateInfo.commandBufferCount = 1;
+
+        VkCommandBuffer commandBuffer;
+        DAWN_TRY(CheckVkSuccess(fn.AllocateCommandBuffers(mVkDevice, &allocateInfo, &commandBuffer),
+                                "vkAllocateCommandBuffers"));
+        return commandBuffer;
+    }
+
+    void Device::FreeSecondaryCommandBufferWhenUnused(VkCommandBuffer commandBuffer) {
+        ASSERT(mSecondaryCommandPool != VK_NULL_HANDLE);
+        mSecondaryCommandBuffersToFree.Enqueue(commandBuffer, GetPendingCommandSerial());
+    }
+
+    ResultOrError<Device::WorkerCommandPool> Device::AcquireWorkerCommandPool() {
+        if (!mUnusedWorkerCommandPools.empty()) {
+            WorkerCommandPool pool = std::move(mUnusedWorkerCommandPools.back());
+            mUnusedWorkerCommandPools.pop_back();
+            DAWN_TRY_WITH_CLEANUP(CheckVkSuccess(fn.ResetCommandPool(mVkDevice, pool.pool, 0),
+                                                 "vkResetCommandPool"),
+                                  { DestroyWorkerCommandPool(pool); });
+
+            pool.usedCommandBufferCount = 0;
+            return std::move(pool);
+        }
+
+        WorkerCommandPool pool;
+        VkCommandPoolCreateInfo createInfo;
+        createInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        createInfo.pNext = nullptr;
+        createInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        createInfo.queueFamilyIndex = mQueueFamily;
+
+        DAWN_TRY(CheckVkSuccess(fn.CreateCommandPool(mVkDevice, &createInfo, nullptr, &*pool.pool),
+                                "vkCreateCommandPool"));
+        return std::move(pool);
+    }
+
+    void Device::ReleaseWorkerCommandPoolWhenUnused(WorkerCommandPool pool) {
+        mWorkerCommandPoolsInFlight.Enqueue(std::move(pool), GetPendingCommandSerial());
+    }
+
+    ResultOrError<VkCommandBuffer> Device::AllocateWorkerCommandBuffer(WorkerCommandPool* pool) {
+        // Reuse the command buffers that were reset with the pool before allocating new ones.
+        if (pool->usedCommandBufferCount < pool->commandBuffers.size()) {
+            return pool->commandBuffers[pool->usedCommandBufferCount++];
+        }
+
+        VkCommandBufferAllocateInfo allocateInfo;
+        allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocateInfo.pNext = nullptr;
+        allocateInfo.commandPool = pool->pool;
+        allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+        allocateInfo.commandBufferCount = 1;
+
+        VkCommandBuffer commandBuffer;
+        DAWN_TRY(CheckVkSuccess(fn.AllocateCommandBuffers(mVkDevice, &allocateInfo, &commandBuffer),
+                                "vkAllocateCommandBuffers"));
+        pool->commandBuffers.push_back(commandBuffer);
+        pool->usedCommandBufferCount++;
+        return commandBuffer;
+    }
+
+    void Device::DestroyWorkerCommandPool(const WorkerCommandPool& pool) {
+        // Like for the other command pools, free the command buffers before destroying the pool
+        // to be safe.
+        if (!pool.commandBuffers.empty()) {
+            fn.FreeCommandBuffers(mVkDevice, pool.pool,
+                                  static_cast<uint32_t>(pool.commandBuffers.size()),
+                                  pool.commandBuffers.data());
+        }
+        fn.DestroyCommandPool(mVkDevice, pool.pool, nullptr);
+    }
+
     MaybeError Device::PrepareRecordingContext() {
         ASSERT(!mRecordingContext.used);
         ASSERT(mRecordingContext.commandBuffer == VK_NULL_HANDLE);
@@ -651,6 +985,12 @@ namespace dawn::native::vulkan {
         // calling this function.
         ASSERT(size != 0);
 
+        if (mTransferQueue != nullptr && mTransferQueue->CanCopyToBuffer(ToBackend(destination))) {
+            return mTransferQueue->CopyFromStagingToBuffer(ToBackend(source), sourceOffset,
+                                                           ToBackend(destination),
+                                                           destinationOffset, size);
+        }
+
         CommandRecordingContext* recordingContext = GetPendingRecordingContext();
 
         ToBackend(destination)
@@ -684,15 +1024,23 @@ namespace dawn::native::vulkan {
         // operation for HOST_COHERENT memory. The Vulkan spec for vkQueueSubmit describes that it
         // does an implicit availability, visibility and domain operation.
 
-        CommandRecordingContext* recordingContext = GetPendingRecordingContext();
-
         VkBufferImageCopy region = ComputeBufferImageCopyRegion(src, *dst, copySizePixels);
         VkImageSubresourceLayers subresource = region.imageSubresource;
 
         SubresourceRange range = GetSubresourcesAffectedByCopy(*dst, copySizePixels);
+        bool isCompleteCopy =
+            IsCompleteSubresourceCopiedTo(dst->texture.Get(), copySizePixels, subresource.mipLevel);
+
+        if (mTransferQueue != nullptr &&
+            mTransferQueue->CanCopyToTexture(ToBackend(dst->texture.Get()), range,
+                                             isCompleteCopy)) {
+            return mTransferQueue->CopyFromStagingToTexture(
+                ToBackend(source), region, ToBackend(dst->texture.Get()), range, isCompleteCopy);
+        }
+
+        CommandRecordingContext* recordingContext = GetPendingRecordingContext();
 
-        if (IsCompleteSubresourceCopiedTo(dst->texture.Get(), copySizePixels,
-                                          subresource.mipLevel)) {
+        if (isCompleteCopy) {
             // Since texture has been overwritten, it has been "initialized"
             dst->texture->SetIsSubresourceContentInitialized(true, range);
         } else {
@@ -863,6 +1211,36 @@ namespace dawn::native::vulkan {
         // about, Device lost, which means workloads running on the GPU are no longer accessible
         // (so they are as good as waited on) or success.
         DAWN_UNUSED(waitIdleResult);
+        if (mTransferQueue != nullptr) {
+            mTransferQueue->WaitForIdleForDestruction();
+        }
+
+        // Make sure all the submits are complete by explicitly waiting on the last one.
+        if (mTimelineSemaphore != VK_NULL_HANDLE) {
+            uint64_t lastSubmittedValue = static_cast<uint64_t>(GetLastSubmittedCommandSerial());
+            VkSemaphoreWaitInfo waitInfo;
+            waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+            waitInfo.pNext = nullptr;
+            waitInfo.flags = 0;
+            waitInfo.semaphoreCount = 1;
+            waitInfo.pSemaphores = &*mTimelineSemaphore;
+            waitInfo.pValues = &lastSubmittedValue;
+
+            VkResult result = VkResult::WrapUnsafe(VK_TIMEOUT);
+            do {
+                // Like for fences below, don't inject errors if the device lost was injected.
+                if (GetState() == State::Disconnected) {
+                    result =
+                        VkResult::WrapUnsafe(fn.WaitSemaphores(mVkDevice, &waitInfo, UINT64_MAX));
+                    continue;
+                }
+
+                result = VkResult::WrapUnsafe(
+                    INJECT_ERROR_OR_RUN(fn.WaitSemaphores(mVkDevice, &waitInfo, UINT64_MAX),
+                                        VK_ERROR_DEVICE_LOST));
+            } while (result == VK_TIMEOUT);
+            // Ignore errors from vkWaitSemaphores for the same reasons as vkWaitForFences below.
+        }
 
         // Make sure all fences are complete by explicitly waiting on them all
         while (!mFencesInFlight.empty()) {
@@ -919,6 +1297,11 @@ namespace dawn::native::vulkan {
         // Enough of the Device's initialization happened that we can now do regular robust
         // deinitialization.
 
+        // The bind groups are all destroyed, there is no need to write their descriptor sets.
+        if (mDescriptorWriteBatch != nullptr) {
+            mDescriptorWriteBatch->Discard();
+        }
+
         // Immediately tag the recording context as unused so we don't try to submit it in Tick.
         mRecordingContext.used = false;
         if (mRecordingContext.commandPool != VK_NULL_HANDLE) {
@@ -968,17 +1351,43 @@ namespace dawn::native::vulkan {
         }
         mUnusedFences.clear();
 
-        ExecutionSerial completedSerial = GetCompletedCommandSerial();
-        for (Ref<DescriptorSetAllocator>& allocator :
-             mDescriptorAllocatorsPendingDeallocation.IterateUpTo(completedSerial)) {
-            allocator->FinishDeallocation(completedSerial);
+        if (mTimelineSemaphore != VK_NULL_HANDLE) {
+            fn.DestroySemaphore(mVkDevice, mTimelineSemaphore, nullptr);
+            mTimelineSemaphore = VK_NULL_HANDLE;
+        }
+
+        // The render bundles are all destroyed so all the secondary command buffers are waiting to
+        // be freed. Like above, free them before destroying their pool to be safe.
+        if (mSecondaryCommandPool != VK_NULL_HANDLE) {
+            for (VkCommandBuffer commandBuffer : mSecondaryCommandBuffersToFree.IterateAll()) {
+                fn.FreeCommandBuffers(mVkDevice, mSecondaryCommandPool, 1, &commandBuffer);
+            }
+            fn.DestroyCommandPool(mVkDevice, mSecondaryCommandPool, nullptr);
+            mSecondaryCommandPool = VK_NULL_HANDLE;
+        }
+        mSecondaryCommandBuffersToFree.Clear();
+
+        for (const WorkerCommandPool& pool : mWorkerCommandPoolsInFlight.IterateAll()) {
+            DestroyWorkerCommandPool(pool);
         }
+        mWorkerCommandPoolsInFlight.Clear();
+        for (const WorkerCommandPool& pool : mUnusedWorkerCommandPools) {
+            DestroyWorkerCommandPool(pool);
+        }
+        mUnusedWorkerCommandPools.clear();
+
+        // All the GPU work is complete so the descriptor pools and the framebuffers that weren't
+        // evicted can be destroyed immediately.
+        mDescriptorSetAllocator = nullptr;
+        mFramebufferCache = nullptr;
+        mTransferQueue = nullptr;
+
+        ExecutionSerial completedSerial = GetCompletedCommandSerial();
 
         // Releasing the uploader enqueues buffers to be released.
         // Call Tick() again to clear them before releasing the deleter.
         mResourceMemoryAllocator->Tick(completedSerial);
         mDeleter->Tick(completedSerial);
-        mDescriptorAllocatorsPendingDeallocation.ClearUpTo(completedSerial);
 
         // Allow recycled memory to be deleted.
         mResourceMemoryAllocator->DestroyPool();
@@ -987,6 +1396,13 @@ namespace dawn::native::vulkan {
         // to them are guaranteed to be finished executing.
         mRenderPassCache = nullptr;
 
+        // Keep the pipelines compiled during this run for the next one. No pipeline creation can
+        // be in flight anymore.
+        if (mPipelineCache != nullptr) {
+            IgnoreErrors(mPipelineCache->StoreIfDirty());
+            mPipelineCache = nullptr;
+        }
+
         // We need handle deleting all child objects by calling Tick() again with a large serial to
         // force all operations to look as if they were completed, and delete all objects before
         // destroying the Deleter and vkDevice.
@@ -30,6 +30,7 @@
 #include "dawn/native/vulkan/external_semaphore/SemaphoreService.h"
 
 #include <memory>
+#include <optional>
 #include <queue>
 
 namespace dawn::native::vulkan {
@@ -37,9 +38,13 @@ namespace dawn::native::vulkan {
     class Adapter;
     class BindGroupLayout;
     class BufferUploader;
+    class DescriptorWriteBatch;
+    class FramebufferCache;
     class FencedDeleter;
+    class PipelineCache;
     class RenderPassCache;
     class ResourceMemoryAllocator;
+    class TransferQueue;
 
     class Device final : public DeviceBase {
       public:
@@ -59,14 +64,55 @@ namespace dawn::native::vulkan {
         uint32_t GetGraphicsQueueFamily() const;
         VkQueue GetQueue() const;
 
+        DescriptorSetAllocator* GetDescriptorSetAllocator() const;
+        DescriptorWriteBatch* GetDescriptorWriteBatch() const;
         FencedDeleter* GetFencedDeleter() const;
+        PipelineCache* GetPipelineCache() const;
         RenderPassCache* GetRenderPassCache() const;
+        FramebufferCache* GetFramebufferCache() const;
         ResourceMemoryAllocator* GetResourceMemoryAllocator() const;
+        // Returns nullptr when uploads aren't done on a dedicated transfer queue.
+        TransferQueue* GetTransferQueue() const;
 
         CommandRecordingContext* GetPendingRecordingContext();
         MaybeError SubmitPendingCommands();
 
-        void EnqueueDeferredDeallocation(DescriptorSetAllocator* allocator);
+        // The number of pipeline barrier commands and of the memory barriers they contain, to
+        // check how well the barriers are batched.
+        struct BarrierStats {
+            uint64_t pipelineBarrierCount = 0;
+            uint32_t lastSubmitPipelineBarrierCount = 0;
+            uint32_t lastSubmitMemoryBarrierCount = 0;
+        };
+        BarrierStats GetBarrierStats() const;
+
+        // The number of vkCmdExecuteCommands recorded, to check when render passes execute
+        // secondary command buffers.
+        uint64_t GetExecuteCommandsCountForTesting() const;
+        void IncrementExecuteCommandsCountForTesting();
+
+        // Blocks until the GPU is done with the commands of |serial|.
+        MaybeError WaitForSerial(ExecutionSerial serial);
+
+        // Secondary command buffers are allocated from a pool that is never reset. They are freed
+        // one by one, once the GPU is done with the commands using them.
+        ResultOrError<VkCommandBuffer> AllocateSecondaryCommandBuffer();
+        void FreeSecondaryCommandBufferWhenUnused(VkCommandBuffer commandBuffer);
+
+        // A command pool for the secondary command buffers recorded on a worker thread. Command
+        // pools must only be used by one thread at a time so each thread recording commands
+        // needs its own. All the command buffers of the pool are reset at once, when the GPU is
+        // done with the commands of the submit that used them.
+        struct WorkerCommandPool {
+            VkCommandPool pool = VK_NULL_HANDLE;
+            std::vector<VkCommandBuffer> commandBuffers;
+            size_t usedCommandBufferCount = 0;
+        };
+        ResultOrError<WorkerCommandPool> AcquireWorkerCommandPool();
+        // Returns the pool to the device once the pending commands are complete.
+        void ReleaseWorkerCommandPoolWhenUnused(WorkerCommandPool pool);
+        // Can be called on any thread, as long as no other thread uses |pool|.
+        ResultOrError<VkCommandBuffer> AllocateWorkerCommandBuffer(WorkerCommandPool* pool);
 
         // Dawn Native API
 
@@ -164,24 +210,33 @@ namespace dawn::native::vulkan {
         VkDevice mVkDevice = VK_NULL_HANDLE;
         uint32_t mQueueFamily = 0;
         VkQueue mQueue = VK_NULL_HANDLE;
+        // The family of the dedicated transfer queue, if one is used.
+        std::optional<uint32_t> mTransferQueueFamily;
         uint32_t mComputeSubgroupSize = 0;
 
-        SerialQueue<ExecutionSerial, Ref<DescriptorSetAllocator>>
-            mDescriptorAllocatorsPendingDeallocation;
+        std::unique_ptr<DescriptorSetAllocator> mDescriptorSetAllocator;
+        std::unique_ptr<DescriptorWriteBatch> mDescriptorWriteBatch;
         std::unique_ptr<FencedDeleter> mDeleter;
         std::unique_ptr<ResourceMemoryAllocator> mResourceMemoryAllocator;
         std::unique_ptr<RenderPassCache> mRenderPassCache;
+        std::unique_ptr<FramebufferCache> mFramebufferCache;
+        std::unique_ptr<PipelineCache> mPipelineCache;
+        std::unique_ptr<TransferQueue> mTransferQueue;
 
         std::unique_ptr<external_memory::Service> mExternalMemoryService;
         std::unique_ptr<external_semaphore::Service> mExternalSemaphoreService;
 
+        MaybeError CreateTimelineSemaphore();
         ResultOrError<VkFence> GetUnusedFence();
         ResultOrError<ExecutionSerial> CheckAndUpdateCompletedSerials() override;
 
         // We track which operations are in flight on the GPU with an increasing serial.
-        // This works only because we have a single queue. Each submit to a queue is associated
-        // to a serial and a fence, such that when the fence is "ready" we know the operations
-        // have finished.
+        // This works only because we have a single queue. When VK_KHR_timeline_semaphore is
+        // supported, each submit signals the serial as the value of mTimelineSemaphore, whose
+        // value is then the last completed serial.
+        VkSemaphore mTimelineSemaphore = VK_NULL_HANDLE;
+        // Otherwise each submit to a queue is associated to a serial and a fence, such that when
+        // the fence is "ready" we know the operations have finished.
         std::queue<std::pair<VkFence, ExecutionSerial>> mFencesInFlight;
         // Fences in the unused list aren't reset yet.
         std::vector<VkFence> mUnusedFences;
@@ -198,6 +253,17 @@ namespace dawn::native::vulkan {
         std::vector<CommandPoolAndBuffer> mUnusedCommands;
         // There is always a valid recording context stored in mRecordingContext
         CommandRecordingContext mRecordingContext;
+        BarrierStats mBarrierStats;
+        uint64_t mExecuteCommandsCountForTesting = 0;
+
+        // Created the first time a secondary command buffer is allocated.
+        VkCommandPool mSecondaryCommandPool = VK_NULL_HANDLE;
+        SerialQueue<ExecutionSerial, VkCommandBuffer> mSecondaryCommandBuffersToFree;
+
+        SerialQueue<ExecutionSerial, WorkerCommandPool> mWorkerCommandPoolsInFlight;
+        // Worker command pools in the unused list haven't been reset yet.
+        std::vector<WorkerCommandPool> mUnusedWorkerCommandPools;
+        void DestroyWorkerCommandPool(const WorkerCommandPool& pool);
 
         MaybeError ImportExternalImage(const ExternalImageDescriptorVk* descriptor,
                                        ExternalMemoryHandle memoryHandle,
@@ -0,0 +1,296 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/native/vulkan/FramebufferCache.h"
+
+#include "dawn/common/Assert.h"
+#include "dawn/common/HashUtils.h"
+#include "dawn/native/vulkan/DeviceVk.h"
+#include "dawn/native/vulkan/FencedDeleter.h"
+#include "dawn/native/vulkan/TextureVk.h"
+#include "dawn/native/vulkan/UtilsVulkan.h"
+#include "dawn/native/vulkan/VulkanError.h"
+#include "dawn/platform/DawnPlatform.h"
+#include "dawn/platform/tracing/TraceEvent.h"
+
+#include <algorithm>
+
+namespace dawn::native::vulkan {
+
+    void FramebufferCacheQuery::AddAttachment(TextureView* view) {
+        ASSERT(attachmentCount < kMaxFramebufferAttachments);
+        attachments[attachmentCount] = view;
+        attachmentCount++;
+    }
+
+    // FramebufferCache
+
+    FramebufferCache::FramebufferCache(Device* device) : mDevice(device) {
+        const VulkanDeviceInfo& info = device->GetDeviceInfo();
+        mUseImagelessFramebuffers =
+            info.HasExt(DeviceExt::ImagelessFramebuffer) &&
+            info.imagelessFramebufferFeatures.imagelessFramebuffer == VK_TRUE;
+    }
+
+    FramebufferCache::~FramebufferCache() {
+        // This is only destroyed with the device, when the GPU is done with all the framebuffers,
+        // so they can be destroyed immediately.
+        for (const auto& [key, framebuffer] : mCache) {
+            mDevice->fn.DestroyFramebuffer(mDevice->GetVkDevice(), framebuffer, nullptr);
+        }
+        mCache.clear();
+        mKeysPerView.clear();
+    }
+
+    ResultOrError<FramebufferCache::Framebuffer> FramebufferCache::GetFramebuffer(
+        const FramebufferCacheQuery& query) {
+        Key key = ComputeKey(query);
+
+        auto it = mCache.find(key);
+        if (it != mCache.end()) {
+            mHits++;
+            TraceStats();
+            return Framebuffer{it->second, key.isImageless};
+        }
+
+        VkFramebuffer framebuffer;
+        DAWN_TRY_ASSIGN(framebuffer, CreateFramebuffer(query, key));
+        mCache.emplace(key, framebuffer);
+        if (!key.isImageless) {
+            for (uint32_t i = 0; i < key.attachmentCount; ++i) {
+                const TextureView* view = key.attachments[i].view;
+                bool isFirstUse = std::none_of(
+                    key.attachments.begin(), key.attachments.begin() + i,
+                    [&](const AttachmentKey& attachment) { return attachment.view == view; });
+                if (isFirstUse) {
+                    mKeysPerView[view].push_back(key);
+                }
+            }
+        }
+
+        mMisses++;
+        TraceStats();
+        return Framebuffer{framebuffer, key.isImageless};
+    }
+
+    void FramebufferCache::EvictFramebuffersUsing(const TextureView* view) {
+        auto viewIt = mKeysPerView.find(view);
+        if (viewIt == mKeysPerView.end()) {
+            return;
+        }
+        std::vector<Key> keys = std::move(viewIt->second);
+        mKeysPerView.erase(viewIt);
+
+        for (const Key& key : keys) {
+            auto it = mCache.find(key);
+            ASSERT(it != mCache.end());
+
+            // The framebuffer may still be used by commands that are pending or being recorded.
+            mDevice->GetFencedDeleter()->DeleteWhenUnused(it->second);
+            mCache.erase(it);
+
+            // Forget the evicted framebuffer for the other views it used so that their lists
+            // don't grow with each view they are used with, like swapchain views.
+            for (uint32_t i = 0; i < key.attachmentCount; ++i) {
+                const TextureView* otherView = key.attachments[i].view;
+                if (otherView == view) {
+                    continue;
+                }
+
+                auto otherIt = mKeysPerView.find(otherView);
+                if (otherIt == mKeysPerView.end()) {
+                    continue;
+                }
+                std::vector<Key>& otherKeys = otherIt->second;
+                auto keyIt =
+                    std::find_if(otherKeys.begin(), otherKeys.end(),
+                                 [&](const Key& other) { return CacheFuncs()(key, other); });
+                if (keyIt != otherKeys.end()) {
+                    otherKeys.erase(keyIt);
+                }
+                if (otherKeys.empty()) {
+                    mKeysPerView.erase(otherIt);
+                }
+            }
+        }
+    }
+
+    FramebufferCache::Stats FramebufferCache::GetStats() const {
+        Stats stats;
+        stats.hits = mHits;
+        stats.misses = mMisses;
+        stats.framebufferCount = static_cast<uint32_t>(mCache.size());
+        return stats;
+    }
+
+    bool FramebufferCache::CanUseImagelessFramebuffer(const FramebufferCacheQuery& query) const {
+        if (!mUseImagelessFramebuffers) {
+            return false;
+        }
+
+        for (uint32_t i = 0; i < query.attachmentCount; ++i) {
+            const TextureView* view = query.attachments[i];
+
+            // The attachments of imageless framebuffers must be described exactly like their
+            // images were created, which Dawn only knows for the images it creates itself.
+            const Texture* texture = ToBackend(view->GetTexture());
+            if (!texture->HasKnownImageCreateInfo()) {
+                return false;
+            }
+
+            // The view formats of the attachments must match the VkImageFormatListCreateInfo of
+            // their images, which only contains the format of the texture.
+            if (!texture->HasImageFormatList() ||
+                view->GetFormat().format != texture->GetFormat().format) {
+                return false;
+            }
+
+            // Versions of the specification differ on whether the size of an attachment is the
+            // size of its image or of the mip level of its view. They agree on the first level.
+            if (view->GetBaseMipLevel() != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    FramebufferCache::Key FramebufferCache::ComputeKey(const FramebufferCacheQuery& query) const {
+        Key key;
+        key.renderPass = query.renderPass;
+        key.width = query.width;
+        key.height = query.height;
+        key.isImageless = CanUseImagelessFramebuffer(query);
+        key.attachmentCount = query.attachmentCount;
+
+        for (uint32_t i = 0; i < query.attachmentCount; ++i) {
+            const TextureView* view = query.attachments[i];
+            AttachmentKey& attachment = key.attachments[i];
+
+            if (!key.isImageless) {
+                attachment.view = view;
+                continue;
+            }
+
+            const Texture* texture = ToBackend(view->GetTexture());
+            attachment.flags = texture->GetImageCreateFlags();
+            attachment.usage = texture->GetImageUsage();
+            attachment.format = VulkanImageFormat(mDevice, view->GetFormat().format);
+            attachment.width = texture->GetWidth();
+            attachment.height = texture->GetHeight();
+            attachment.layerCount = view->GetLayerCount();
+        }
+
+        return key;
+    }
+
+    ResultOrError<VkFramebuffer> FramebufferCache::CreateFramebuffer(
+        const FramebufferCacheQuery& query,
+        const Key& key) const {
+        VkFramebufferCreateInfo createInfo;
+        createInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        createInfo.pNext = nullptr;
+        createInfo.flags = 0;
+        createInfo.renderPass = key.renderPass;
+        createInfo.attachmentCount = key.attachmentCount;
+        createInfo.pAttachments = nullptr;
+        createInfo.width = key.width;
+        createInfo.height = key.height;
+        createInfo.layers = 1;
+        PNextChainBuilder createInfoChain(&createInfo);
+
+        std::array<VkImageView, kMaxFramebufferAttachments> views;
+        std::array<VkFramebufferAttachmentImageInfo, kMaxFramebufferAttachments> imageInfos;
+        VkFramebufferAttachmentsCreateInfo attachmentsCreateInfo;
+
+        if (key.isImageless) {
+            for (uint32_t i = 0; i < key.attachmentCount; ++i) {
+                const AttachmentKey& attachment = key.attachments[i];
+
+                VkFramebufferAttachmentImageInfo& imageInfo = imageInfos[i];
+                imageInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_ATTACHMENT_IMAGE_INFO;
+                imageInfo.pNext = nullptr;
+                imageInfo.flags = attachment.flags;
+                imageInfo.usage = attachment.usage;
+                imageInfo.width = attachment.width;
+                imageInfo.height = attachment.height;
+                imageInfo.layerCount = attachment.layerCount;
+                imageInfo.viewFormatCount = 1;
+                imageInfo.pViewFormats = &attachment.format;
+            }
+
+            attachmentsCreateInfo.attachmentImageInfoCount = key.attachmentCount;
+            attachmentsCreateInfo.pAttachmentImageInfos = imageInfos.data();
+            createInfoChain.Add(&attachmentsCreateInfo,
+                                VK_STRUCTURE_TYPE_FRAMEBUFFER_ATTACHMENTS_CREATE_INFO);
+
+            createInfo.flags |= VK_FRAMEBUFFER_CREATE_IMAGELESS_BIT;
+        } else {
+            for (uint32_t i = 0; i < query.attachmentCount; ++i) {
+                views[i] = query.attachments[i]->GetHandle();
+            }
+            createInfo.pAttachments = AsVkArray(views.data());
+        }
+
+        VkFramebuffer framebuffer;
+        DAWN_TRY(CheckVkSuccess(mDevice->fn.CreateFramebuffer(mDevice->GetVkDevice(), &createInfo,
+                                                              nullptr, &*framebuffer),
+                                "CreateFramebuffer"));
+        return framebuffer;
+    }
+
+    void FramebufferCache::TraceStats() const {
+        TRACE_COUNTER1(mDevice->GetPlatform(), General, "FramebufferCacheHits", mHits);
+        TRACE_COUNTER1(mDevice->GetPlatform(), General, "FramebufferCacheMisses", mMisses);
+    }
+
+    size_t FramebufferCache::CacheFuncs::operator()(const Key& key) const {
+        size_t hash = Hash(key.renderPass.GetHandle());
+        HashCombine(&hash, key.width, key.height, key.isImageless, key.attachmentCount);
+
+        for (uint32_t i = 0; i < key.attachmentCount; ++i) {
+            const AttachmentKey& attachment = key.attachments[i];
+            if (key.isImageless) {
+                HashCombine(&hash, attachment.flags, attachment.usage, attachment.format,
+                            attachment.width, attachment.height, attachment.layerCount);
+            } else {
+                HashCombine(&hash, attachment.view);
+            }
+        }
+
+        return hash;
+    }
+
+    bool FramebufferCache::CacheFuncs::operator()(const Key& a, const Key& b) const {
+        if (a.renderPass != b.renderPass || a.width != b.width || a.height != b.height ||
+            a.isImageless != b.isImageless || a.attachmentCount != b.attachmentCount) {
+            return false;
+        }
+
+        for (uint32_t i = 0; i < a.attachmentCount; ++i) {
+            const AttachmentKey& attachmentA = a.attachments[i];
+            const AttachmentKey& attachmentB = b.attachments[i];
+            if (attachmentA.view != attachmentB.view || attachmentA.flags != attachmentB.flags ||
+                attachmentA.usage != attachmentB.usage ||
+                attachmentA.format != attachmentB.format ||
+                attachmentA.width != attachmentB.width ||
+                attachmentA.height != attachmentB.height ||
+                attachmentA.layerCount != attachmentB.layerCount) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+}  // namespace dawn::native::vulkan
@@ -0,0 +1,135 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_VULKAN_FRAMEBUFFERCACHE_H_
+#define DAWNNATIVE_VULKAN_FRAMEBUFFERCACHE_H_
+
+#include "dawn/common/Constants.h"
+#include "dawn/common/NonCopyable.h"
+#include "dawn/common/vulkan_platform.h"
+#include "dawn/native/Error.h"
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+namespace dawn::native::vulkan {
+
+    class Device;
+    class TextureView;
+
+    // Color attachments, the depth-stencil attachment and a resolve target for each color
+    // attachment.
+    static constexpr uint32_t kMaxFramebufferAttachments = kMaxColorAttachments * 2 + 1;
+
+    // This is a key to query the FramebufferCache. The attachments must be added in the
+    // "color-depthstencil-resolve" order used by the RenderPassCache.
+    struct FramebufferCacheQuery {
+        void AddAttachment(TextureView* view);
+
+        VkRenderPass renderPass = VK_NULL_HANDLE;
+        uint32_t width = 0;
+        uint32_t height = 0;
+
+        uint32_t attachmentCount = 0;
+        std::array<TextureView*, kMaxFramebufferAttachments> attachments;
+    };
+
+    // Caches VkFramebuffers so that render passes with the same render pass and attachments don't
+    // create a new framebuffer each time.
+    //
+    // When VK_KHR_imageless_framebuffer is supported, framebuffers are created from a description
+    // of the attachments' images and the views are given when the render pass begins, so render
+    // passes using different textures of the same kind share the same framebuffer. Otherwise, or
+    // when the parameters of one of the images aren't known, framebuffers are keyed by their
+    // VkImageViews and are evicted when one of the views is destroyed.
+    class FramebufferCache : public NonCopyable {
+      public:
+        explicit FramebufferCache(Device* device);
+        ~FramebufferCache();
+
+        struct Framebuffer {
+            VkFramebuffer handle;
+            // Whether the attachments must be given with a VkRenderPassAttachmentBeginInfo when
+            // beginning the render pass.
+            bool isImageless;
+        };
+        ResultOrError<Framebuffer> GetFramebuffer(const FramebufferCacheQuery& query);
+
+        // Removes the framebuffers that use |view| from the cache and deletes them once they are
+        // no longer used by the GPU. Called when |view| is destroyed.
+        void EvictFramebuffersUsing(const TextureView* view);
+
+        struct Stats {
+            uint64_t hits = 0;
+            uint64_t misses = 0;
+            uint32_t framebufferCount = 0;
+        };
+        Stats GetStats() const;
+
+      private:
+        struct AttachmentKey {
+            // The view of the attachment, for framebuffers that aren't imageless.
+            const TextureView* view = nullptr;
+
+            // The description of the attachment, for imageless framebuffers.
+            VkImageCreateFlags flags = 0;
+            VkImageUsageFlags usage = 0;
+            VkFormat format = VK_FORMAT_UNDEFINED;
+            uint32_t width = 0;
+            uint32_t height = 0;
+            uint32_t layerCount = 0;
+        };
+
+        struct Key {
+            VkRenderPass renderPass = VK_NULL_HANDLE;
+            uint32_t width = 0;
+            uint32_t height = 0;
+            bool isImageless = false;
+
+            uint32_t attachmentCount = 0;
+            std::array<AttachmentKey, kMaxFramebufferAttachments> attachments;
+        };
+
+        bool CanUseImagelessFramebuffer(const FramebufferCacheQuery& query) const;
+        Key ComputeKey(const FramebufferCacheQuery& query) const;
+
+        // Does the actual VkFramebuffer creation on a cache miss.
+        ResultOrError<VkFramebuffer> CreateFramebuffer(const FramebufferCacheQuery& query,
+                                                       const Key& key) const;
+
+        void TraceStats() const;
+
+        // Implements the functors necessary for to use Keys as unordered_map keys.
+        struct CacheFuncs {
+            size_t operator()(const Key& key) const;
+            bool operator()(const Key& a, const Key& b) const;
+        };
+        using Cache = std::unordered_map<Key, VkFramebuffer, CacheFuncs, CacheFuncs>;
+
+        Device* mDevice = nullptr;
+        bool mUseImagelessFramebuffers = false;
+
+        Cache mCache;
+        // The keys of the framebuffers that use each view, for the framebuffers that aren't
+        // imageless.
+        std::unordered_map<const TextureView*, std::vector<Key>> mKeysPerView;
+
+        uint64_t mHits = 0;
+        uint64_t mMisses = 0;
+    };
+
+}  // namespace dawn::native::vulkan
+
+#endif  // DAWNNATIVE_VULKAN_FRAMEBUFFERCACHE_H_
@@ -0,0 +1,128 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/native/vulkan/PipelineCacheVk.h"
+
+#include "dawn/native/vulkan/DeviceVk.h"
+#include "dawn/native/vulkan/VulkanError.h"
+
+#include <vector>
+
+namespace dawn::native::vulkan {
+
+    namespace {
+
+        template <typename T>
+        void AppendToKey(PersistentCacheKey* key, const T& value) {
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+            key->insert(key->end(), bytes, bytes + sizeof(T));
+        }
+
+    }  // anonymous namespace
+
+    // static
+    ResultOrError<std::unique_ptr<PipelineCache>> PipelineCache::Create(Device* device) {
+        std::unique_ptr<PipelineCache> cache(new PipelineCache(device));
+        DAWN_TRY(cache->Initialize());
+        return std::move(cache);
+    }
+
+    PipelineCache::PipelineCache(Device* device) : mDevice(device) {
+    }
+
+    PipelineCache::~PipelineCache() {
+        if (mHandle != VK_NULL_HANDLE) {
+            mDevice->fn.DestroyPipelineCache(mDevice->GetVkDevice(), mHandle, nullptr);
+            mHandle = VK_NULL_HANDLE;
+        }
+    }
+
+    MaybeError PipelineCache::Initialize() {
+        const VkPhysicalDeviceProperties& properties = mDevice->GetDeviceInfo().properties;
+        AppendToKey(&mKey, static_cast<uint32_t>(PersistentKeyType::PipelineCache));
+        AppendToKey(&mKey, properties.vendorID);
+        AppendToKey(&mKey, properties.deviceID);
+        AppendToKey(&mKey, properties.driverVersion);
+        AppendToKey(&mKey, properties.pipelineCacheUUID);
+
+        // The driver validates the header of the initial data and ignores it if it doesn't match.
+        ScopedCachedBlob blob = mDevice->GetPersistentCache()->LoadData(mKey);
+
+        VkPipelineCacheCreateInfo createInfo;
+        createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        createInfo.pNext = nullptr;
+        createInfo.flags = 0;
+        createInfo.initialDataSize = blob.bufferSize;
+        createInfo.pInitialData = blob.buffer.get();
+
+        return CheckVkSuccess(mDevice->fn.CreatePipelineCache(mDevice->GetVkDevice(), &createInfo,
+                                                              nullptr, &*mHandle),
+                              "vkCreatePipelineCache");
+    }
+
+    VkPipelineCache PipelineCache::GetHandle() const {
+        return mHandle;
+    }
+
+    void PipelineCache::DidCreatePipeline() {
+        mPipelinesCreatedSinceStore.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    MaybeError PipelineCache::Tick() {
+        // Serializing the cache costs as much as its size so wait for a burst of pipeline
+        // creations, like at application startup, to be over before storing it.
+        uint64_t pipelinesCreated = mPipelinesCreatedSinceStore.load(std::memory_order_relaxed);
+        if (pipelinesCreated != mPipelinesCreatedAtLastTick) {
+            mPipelinesCreatedAtLastTick = pipelinesCreated;
+            return {};
+        }
+
+        mPipelinesCreatedAtLastTick = 0;
+        return StoreIfDirty();
+    }
+
+    MaybeError PipelineCache::StoreIfDirty() {
+        // Reading the cache data is wasted work if there is nowhere to store it.
+        if (!mDevice->GetPersistentCache()->IsEnabled()) {
+            return {};
+        }
+
+        // Pipelines created while the data is being read mark the cache dirty again.
+        if (mPipelinesCreatedSinceStore.exchange(0) == 0) {
+            return {};
+        }
+
+        size_t dataSize = 0;
+        DAWN_TRY(CheckVkSuccess(mDevice->fn.GetPipelineCacheData(mDevice->GetVkDevice(), mHandle,
+                                                                 &dataSize, nullptr),
+                                "vkGetPipelineCacheData"));
+        if (dataSize == 0) {
+            return {};
+        }
+
+        std::vector<uint8_t> data(dataSize);
+        VkResult result = VkResult::WrapUnsafe(mDevice->fn.GetPipelineCacheData(
+            mDevice->GetVkDevice(), mHandle, &dataSize, data.data()));
+        if (result == VK_INCOMPLETE) {
+            // The cache grew between the two calls, try again on a later tick.
+            DidCreatePipeline();
+            return {};
+        }
+        DAWN_TRY(CheckVkSuccess(result, "vkGetPipelineCacheData"));
+
+        mDevice->GetPersistentCache()->StoreData(mKey, data.data(), dataSize);
+        return {};
+    }
+
+}  // namespace dawn::native::vulkan
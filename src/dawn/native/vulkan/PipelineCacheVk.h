@@ -0,0 +1,67 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_VULKAN_PIPELINECACHEVK_H_
+#define DAWNNATIVE_VULKAN_PIPELINECACHEVK_H_
+
+#include "dawn/common/vulkan_platform.h"
+#include "dawn/native/Error.h"
+#include "dawn/native/PersistentCache.h"
+
+#include <atomic>
+#include <memory>
+
+namespace dawn::native::vulkan {
+
+    class Device;
+
+    // Wraps the device's VkPipelineCache so that the driver's pipeline compilation results are
+    // kept across process restarts. The cache is seeded from the PersistentCache when the device
+    // is created and its content is written back once pipeline creation settles down, and when
+    // the device is destroyed. The key includes the pipelineCacheUUID so that a driver update
+    // starts from an empty cache instead of one the driver would reject.
+    // GetHandle() can be used concurrently from the pipeline creation worker threads since
+    // VkPipelineCache is internally synchronized.
+    class PipelineCache {
+      public:
+        static ResultOrError<std::unique_ptr<PipelineCache>> Create(Device* device);
+        ~PipelineCache();
+
+        VkPipelineCache GetHandle() const;
+
+        // Must be called after each pipeline creation that used GetHandle().
+        void DidCreatePipeline();
+
+        // Writes the cache content back to the PersistentCache if pipelines were created since the
+        // last store and none was created since the previous tick.
+        MaybeError Tick();
+        // Writes the cache content back if pipelines were created since the last store.
+        MaybeError StoreIfDirty();
+
+      private:
+        explicit PipelineCache(Device* device);
+
+        MaybeError Initialize();
+
+        Device* mDevice;
+        PersistentCacheKey mKey;
+        VkPipelineCache mHandle = VK_NULL_HANDLE;
+
+        std::atomic<uint64_t> mPipelinesCreatedSinceStore = {0};
+        uint64_t mPipelinesCreatedAtLastTick = 0;
+    };
+
+}  // namespace dawn::native::vulkan
+
+#endif  // DAWNNATIVE_VULKAN_PIPELINECACHEVK_H_
@@ -15,18 +15,88 @@
 #include "dawn/native/vulkan/QueueVk.h"
 
 #include "dawn/common/Math.h"
+#include "dawn/native/AsyncTask.h"
 #include "dawn/native/Buffer.h"
 #include "dawn/native/CommandValidation.h"
 #include "dawn/native/Commands.h"
 #include "dawn/native/DynamicUploader.h"
 #include "dawn/native/vulkan/CommandBufferVk.h"
 #include "dawn/native/vulkan/CommandRecordingContext.h"
+#include "dawn/native/vulkan/DescriptorWriteBatch.h"
 #include "dawn/native/vulkan/DeviceVk.h"
 #include "dawn/platform/DawnPlatform.h"
 #include "dawn/platform/tracing/TraceEvent.h"
 
 namespace dawn::native::vulkan {
 
+    namespace {
+
+        // Prerecords the render passes of the command buffers in parallel, with a task per
+        // command buffer on the worker threads of the device. Each task uses its own command pool
+        // since a command pool can't be used by several threads at the same time.
+        MaybeError PrerecordRenderPassesInParallel(Device* device,
+                                                   uint32_t commandCount,
+                                                   CommandBufferBase* const* commands) {
+            std::vector<CommandBuffer*> commandBuffers;
+            for (uint32_t i = 0; i < commandCount; ++i) {
+                if (!commands[i]->GetResourceUsages().renderPasses.empty()) {
+                    commandBuffers.push_back(ToBackend(commands[i]));
+                }
+            }
+
+            // There is nothing to gain from a single task.
+            if (commandBuffers.size() < 2) {
+                return {};
+            }
+
+            std::vector<Device::WorkerCommandPool> pools;
+            auto ReleasePools = [&]() {
+                for (Device::WorkerCommandPool& pool : pools) {
+                    device->ReleaseWorkerCommandPoolWhenUnused(std::move(pool));
+                }
+            };
+            for (size_t i = 0; i < commandBuffers.size(); ++i) {
+                Device::WorkerCommandPool pool;
+                DAWN_TRY_ASSIGN_WITH_CLEANUP(pool, device->AcquireWorkerCommandPool(),
+                                             { ReleasePools(); });
+                pools.push_back(std::move(pool));
+            }
+
+            std::vector<std::unique_ptr<ErrorData>> errors(commandBuffers.size());
+            auto Prerecord = [&](size_t i) {
+                MaybeError result = commandBuffers[i]->PrerecordRenderPasses(&pools[i]);
+                if (result.IsError()) {
+                    errors[i] = result.AcquireError();
+                }
+            };
+
+            // Post all the command buffers but the first one, which is recorded on this thread
+            // while the workers record the others.
+            AsyncTaskManager* taskManager = device->GetAsyncTaskManager();
+            std::vector<Ref<AsyncTaskManager::WaitableTask>> tasks;
+            for (size_t i = 1; i < commandBuffers.size(); ++i) {
+                tasks.push_back(taskManager->PostTask([&Prerecord, i]() { Prerecord(i); }));
+            }
+            Prerecord(0);
+
+            // Record the command buffers that no worker got to yet on this thread as well.
+            for (size_t i = 1; i < commandBuffers.size(); ++i) {
+                if (!taskManager->RunNow(tasks[i - 1].Get())) {
+                    Prerecord(i);
+                }
+            }
+
+            ReleasePools();
+            for (std::unique_ptr<ErrorData>& error : errors) {
+                if (error != nullptr) {
+                    return std::move(error);
+                }
+            }
+            return {};
+        }
+
+    }  // anonymous namespace
+
     // static
     Queue* Queue::Create(Device* device) {
         return new Queue(device);
@@ -43,9 +113,15 @@ namespace dawn::native::vulkan {
 
         DAWN_TRY(device->Tick());
 
+        // The descriptor sets of the bind groups must be written before they are bound.
+        device->GetDescriptorWriteBatch()->Flush();
+
         TRACE_EVENT_BEGIN0(GetDevice()->GetPlatform(), Recording,
                            "CommandBufferVk::RecordCommands");
         CommandRecordingContext* recordingContext = device->GetPendingRecordingContext();
+        if (device->IsToggleEnabled(Toggle::VulkanRecordCommandBuffersInParallel)) {
+            DAWN_TRY(PrerecordRenderPassesInParallel(device, commandCount, commands));
+        }
         for (uint32_t i = 0; i < commandCount; ++i) {
             DAWN_TRY(ToBackend(commands[i])->RecordCommands(recordingContext));
         }
@@ -0,0 +1,217 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/native/vulkan/RenderBundleVk.h"
+
+#include "dawn/native/Commands.h"
+#include "dawn/native/vulkan/BufferVk.h"
+#include "dawn/native/vulkan/CommandBufferVk.h"
+#include "dawn/native/vulkan/CommandRecordingContext.h"
+#include "dawn/native/vulkan/DeviceVk.h"
+#include "dawn/native/vulkan/VulkanError.h"
+
+namespace dawn::native::vulkan {
+
+    namespace {
+
+        // The number of secondary command buffers kept for each render bundle. Bundles are
+        // usually executed in a handful of render passes so more than that isn't worth the
+        // memory.
+        constexpr size_t kMaxCommandBuffersPerBundle = 4;
+
+    }  // anonymous namespace
+
+    // RenderPassDynamicState
+
+    RenderPassDynamicState::RenderPassDynamicState(uint32_t width, uint32_t height) {
+        // The viewport and scissor default to cover all of the attachments
+        SetViewport(0.0f, 0.0f, static_cast<float>(width), static_cast<float>(height), 0.0f, 1.0f);
+        SetScissorRect(0, 0, width, height);
+    }
+
+    void RenderPassDynamicState::SetViewport(float x,
+                                             float y,
+                                             float width,
+                                             float height,
+                                             float minDepth,
+                                             float maxDepth) {
+        viewport.x = x;
+        viewport.y = y + height;
+        viewport.width = width;
+        viewport.height = -height;
+        viewport.minDepth = minDepth;
+        viewport.maxDepth = maxDepth;
+
+        // Vulkan disallows width = 0, but VK_KHR_maintenance1 which we require allows height = 0
+        // so use that to do an empty viewport.
+        if (viewport.width == 0) {
+            viewport.height = 0;
+
+            // Set the viewport x range to a range that's always valid.
+            viewport.x = 0;
+            viewport.width = 1;
+        }
+    }
+
+    void RenderPassDynamicState::SetScissorRect(uint32_t x,
+                                                uint32_t y,
+                                                uint32_t width,
+                                                uint32_t height) {
+        scissorRect.offset.x = x;
+        scissorRect.offset.y = y;
+        scissorRect.extent.width = width;
+        scissorRect.extent.height = height;
+    }
+
+    void RenderPassDynamicState::Record(Device* device, VkCommandBuffer commands) const {
+        device->fn.CmdSetLineWidth(commands, 1.0f);
+        device->fn.CmdSetDepthBounds(commands, 0.0f, 1.0f);
+        device->fn.CmdSetStencilReference(commands, VK_STENCIL_FRONT_AND_BACK, stencilReference);
+        device->fn.CmdSetBlendConstants(commands, blendConstants.data());
+        device->fn.CmdSetViewport(commands, 0, 1, &viewport);
+        device->fn.CmdSetScissor(commands, 0, 1, &scissorRect);
+    }
+
+    bool RenderPassDynamicState::operator==(const RenderPassDynamicState& other) const {
+        return viewport.x == other.viewport.x && viewport.y == other.viewport.y &&
+               viewport.width == other.viewport.width &&
+               viewport.height == other.viewport.height &&
+               viewport.minDepth == other.viewport.minDepth &&
+               viewport.maxDepth == other.viewport.maxDepth &&
+               scissorRect.offset.x == other.scissorRect.offset.x &&
+               scissorRect.offset.y == other.scissorRect.offset.y &&
+               scissorRect.extent.width == other.scissorRect.extent.width &&
+               scissorRect.extent.height == other.scissorRect.extent.height &&
+               blendConstants == other.blendConstants && stencilReference == other.stencilReference;
+    }
+
+    // RenderBundleCommandBuffers
+
+    // static
+    RenderBundleCommandBuffers* RenderBundleCommandBuffers::GetOrCreate(Device* device,
+                                                                        RenderBundleBase* bundle) {
+        RenderBundleBackendData* data = bundle->GetBackendData();
+        if (data == nullptr) {
+            data = new RenderBundleCommandBuffers(device, bundle);
+            bundle->SetBackendData(std::unique_ptr<RenderBundleBackendData>(data));
+        }
+        return static_cast<RenderBundleCommandBuffers*>(data);
+    }
+
+    RenderBundleCommandBuffers::RenderBundleCommandBuffers(Device* device, RenderBundleBase* bundle)
+        : mDevice(device), mBundle(bundle), mCanUseSecondaryCommandBuffer(true) {
+        // Indexed indirect draws that are validated point to the validated copy of their indirect
+        // parameters, which is different for each execution of the bundle.
+        if (!device->IsValidationEnabled()) {
+            return;
+        }
+
+        CommandIterator* iter = bundle->GetCommands();
+        iter->Reset();
+        Command type;
+        while (iter->NextCommandId(&type)) {
+            if (type == Command::DrawIndexedIndirect) {
+                mCanUseSecondaryCommandBuffer = false;
+            }
+            SkipCommand(iter, type);
+        }
+        iter->Reset();
+    }
+
+    RenderBundleCommandBuffers::~RenderBundleCommandBuffers() {
+        for (const Entry& entry : mEntries) {
+            mDevice->FreeSecondaryCommandBufferWhenUnused(entry.commandBuffer);
+        }
+        mEntries.clear();
+    }
+
+    bool RenderBundleCommandBuffers::CanUseSecondaryCommandBuffer() const {
+        return mCanUseSecondaryCommandBuffer;
+    }
+
+    ResultOrError<VkCommandBuffer> RenderBundleCommandBuffers::GetCommandBuffer(
+        VkRenderPass renderPass,
+        const RenderPassDynamicState& state) {
+        ASSERT(mCanUseSecondaryCommandBuffer);
+
+        for (const Entry& entry : mEntries) {
+            if (entry.renderPass == renderPass && entry.state == state) {
+                return entry.commandBuffer;
+            }
+        }
+
+        VkCommandBuffer commandBuffer;
+        DAWN_TRY_ASSIGN(commandBuffer, RecordCommandBuffer(renderPass, state));
+
+        if (mEntries.size() == kMaxCommandBuffersPerBundle) {
+            // The evicted command buffer may still be used by commands that are pending.
+            mDevice->FreeSecondaryCommandBufferWhenUnused(mEntries.front().commandBuffer);
+            mEntries.erase(mEntries.begin());
+        }
+        mEntries.push_back({renderPass, state, commandBuffer});
+
+        return commandBuffer;
+    }
+
+    ResultOrError<VkCommandBuffer> RenderBundleCommandBuffers::RecordCommandBuffer(
+        VkRenderPass renderPass,
+        const RenderPassDynamicState& state) {
+        VkCommandBuffer commandBuffer;
+        DAWN_TRY_ASSIGN(commandBuffer, mDevice->AllocateSecondaryCommandBuffer());
+
+        // The command buffer references the VkBuffers used by the bundle as long as it exists.
+        for (BufferBase* buffer : mBundle->GetResourceUsage().buffers) {
+            ToBackend(buffer)->PinHandle();
+        }
+
+        // The framebuffer isn't known since the command buffer is used with all the framebuffers
+        // compatible with |renderPass|.
+        VkCommandBufferInheritanceInfo inheritanceInfo;
+        inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+        inheritanceInfo.pNext = nullptr;
+        inheritanceInfo.renderPass = renderPass;
+        inheritanceInfo.subpass = 0;
+        inheritanceInfo.framebuffer = VK_NULL_HANDLE;
+        inheritanceInfo.occlusionQueryEnable = VK_FALSE;
+        inheritanceInfo.queryFlags = 0;
+        inheritanceInfo.pipelineStatistics = 0;
+
+        // The command buffer is executed by each render pass using it, possibly several times
+        // in the same submit.
+        VkCommandBufferBeginInfo beginInfo;
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.pNext = nullptr;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT |
+                          VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
+        beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+        DAWN_TRY_WITH_CLEANUP(
+            CheckVkSuccess(mDevice->fn.BeginCommandBuffer(commandBuffer, &beginInfo),
+                           "vkBeginCommandBuffer"),
+            { mDevice->FreeSecondaryCommandBufferWhenUnused(commandBuffer); });
+
+        state.Record(mDevice, commandBuffer);
+
+        CommandRecordingContext recordingContext;
+        recordingContext.commandBuffer = commandBuffer;
+        RecordRenderBundleCommands(mDevice, &recordingContext, mBundle);
+
+        DAWN_TRY_WITH_CLEANUP(
+            CheckVkSuccess(mDevice->fn.EndCommandBuffer(commandBuffer), "vkEndCommandBuffer"),
+            { mDevice->FreeSecondaryCommandBufferWhenUnused(commandBuffer); });
+
+        return commandBuffer;
+    }
+
+}  // namespace dawn::native::vulkan
@@ -0,0 +1,94 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_VULKAN_RENDERBUNDLEVK_H_
+#define DAWNNATIVE_VULKAN_RENDERBUNDLEVK_H_
+
+#include "dawn/common/vulkan_platform.h"
+#include "dawn/native/Error.h"
+#include "dawn/native/RenderBundle.h"
+
+#include <array>
+#include <vector>
+
+namespace dawn::native::vulkan {
+
+    class Device;
+
+    // The dynamic state of a render pass. Secondary command buffers don't inherit it from the
+    // render pass executing them, so it is part of what they are recorded for.
+    struct RenderPassDynamicState {
+        // Initializes to the default state of a render pass of this size.
+        RenderPassDynamicState(uint32_t width, uint32_t height);
+
+        void SetViewport(float x,
+                         float y,
+                         float width,
+                         float height,
+                         float minDepth,
+                         float maxDepth);
+        void SetScissorRect(uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+
+        // Records all of the state in |commands|.
+        void Record(Device* device, VkCommandBuffer commands) const;
+
+        bool operator==(const RenderPassDynamicState& other) const;
+
+        VkViewport viewport;
+        VkRect2D scissorRect;
+        std::array<float, 4> blendConstants = {0.0f, 0.0f, 0.0f, 0.0f};
+        uint32_t stencilReference = 0;
+    };
+
+    // Secondary command buffers prebuilt from the commands of a RenderBundle, so that executing
+    // the bundle is a single vkCmdExecuteCommands instead of encoding all of its commands again.
+    // They are recorded the first time the bundle is executed in a render pass and reused by
+    // render passes with the same VkRenderPass and dynamic state.
+    class RenderBundleCommandBuffers final : public RenderBundleBackendData {
+      public:
+        // Returns the command buffers of |bundle|, creating them if needed.
+        static RenderBundleCommandBuffers* GetOrCreate(Device* device, RenderBundleBase* bundle);
+
+        ~RenderBundleCommandBuffers() override;
+
+        // Whether the bundle can be executed with a secondary command buffer. Bundles whose
+        // commands are updated for each execution, like the indexed indirect draws that are
+        // validated, can't.
+        bool CanUseSecondaryCommandBuffer() const;
+
+        ResultOrError<VkCommandBuffer> GetCommandBuffer(VkRenderPass renderPass,
+                                                        const RenderPassDynamicState& state);
+
+      private:
+        RenderBundleCommandBuffers(Device* device, RenderBundleBase* bundle);
+
+        ResultOrError<VkCommandBuffer> RecordCommandBuffer(VkRenderPass renderPass,
+                                                           const RenderPassDynamicState& state);
+
+        Device* mDevice;
+        RenderBundleBase* mBundle;
+        bool mCanUseSecondaryCommandBuffer;
+
+        struct Entry {
+            VkRenderPass renderPass;
+            RenderPassDynamicState state;
+            VkCommandBuffer commandBuffer;
+        };
+        // The most recently recorded command buffers, oldest first.
+        std::vector<Entry> mEntries;
+    };
+
+}  // namespace dawn::native::vulkan
+
+#endif  // DAWNNATIVE_VULKAN_RENDERBUNDLEVK_H_
@@ -16,8 +16,8 @@
 
 namespace dawn::native::vulkan {
 
-    ResourceHeap::ResourceHeap(VkDeviceMemory memory, size_t memoryType)
-        : mMemory(memory), mMemoryType(memoryType) {
+    ResourceHeap::ResourceHeap(VkDeviceMemory memory, size_t memoryType, VkDeviceSize size)
+        : mMemory(memory), mMemoryType(memoryType), mSize(size) {
     }
 
     VkDeviceMemory ResourceHeap::GetMemory() const {
@@ -28,4 +28,8 @@ namespace dawn::native::vulkan {
         return mMemoryType;
     }
 
+    VkDeviceSize ResourceHeap::GetSize() const {
+        return mSize;
+    }
+
 }  // namespace dawn::native::vulkan
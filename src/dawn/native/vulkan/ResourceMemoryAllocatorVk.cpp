@@ -17,11 +17,18 @@
 #include "dawn/common/Math.h"
 #include "dawn/native/BuddyMemoryAllocator.h"
 #include "dawn/native/ResourceHeapAllocator.h"
+#include "dawn/native/vulkan/AdapterVk.h"
+#include "dawn/native/vulkan/BufferVk.h"
 #include "dawn/native/vulkan/DeviceVk.h"
 #include "dawn/native/vulkan/FencedDeleter.h"
 #include "dawn/native/vulkan/ResourceHeapVk.h"
+#include "dawn/native/vulkan/UtilsVulkan.h"
 #include "dawn/native/vulkan/VulkanError.h"
 
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+
 namespace dawn::native::vulkan {
 
     namespace {
@@ -35,6 +42,14 @@ namespace dawn::native::vulkan {
         // size
         constexpr uint64_t kBuddyHeapsSize = 2 * kMaxSizeForSubAllocation;
 
+        // The memory blocks that are used at most at this ratio are evacuated by the
+        // defragmentation.
+        constexpr uint64_t kSparseHeapMaxUsedSize = kBuddyHeapsSize / 4;
+
+        VkDeviceSize ComputeTotalSize(const std::vector<VkDeviceSize>& sizes) {
+            return std::accumulate(sizes.begin(), sizes.end(), VkDeviceSize(0));
+        }
+
     }  // anonymous namespace
 
     // SingleTypeAllocator is a combination of a BuddyMemoryAllocator and its client and can
@@ -42,8 +57,12 @@ namespace dawn::native::vulkan {
 
     class ResourceMemoryAllocator::SingleTypeAllocator : public ResourceHeapAllocator {
       public:
-        SingleTypeAllocator(Device* device, size_t memoryTypeIndex, VkDeviceSize memoryHeapSize)
+        SingleTypeAllocator(Device* device,
+                            ResourceMemoryAllocator* owner,
+                            size_t memoryTypeIndex,
+                            VkDeviceSize memoryHeapSize)
             : mDevice(device),
+              mOwner(owner),
               mMemoryTypeIndex(memoryTypeIndex),
               mMemoryHeapSize(memoryHeapSize),
               mPooledMemoryAllocator(this),
@@ -66,10 +85,25 @@ namespace dawn::native::vulkan {
             return mBuddySystem.Allocate(size, alignment);
         }
 
+        ResourceMemoryAllocation AllocateMemoryInExistingHeaps(
+            uint64_t size,
+            uint64_t alignment,
+            const std::function<bool(const ResourceHeapBase*)>& isHeapUsable) {
+            return mBuddySystem.AllocateInExistingHeaps(size, alignment, isHeapUsable);
+        }
+
         void DeallocateMemory(const ResourceMemoryAllocation& allocation) {
             mBuddySystem.Deallocate(allocation);
         }
 
+        std::vector<BuddyMemoryAllocator::HeapUsage> GetHeapUsages() const {
+            return mBuddySystem.GetHeapUsages();
+        }
+
+        uint64_t GetMemoryBlockSize() const {
+            return mBuddySystem.GetMemoryBlockSize();
+        }
+
         // Implementation of the MemoryAllocator interface to be a client of BuddyMemoryAllocator
 
         ResultOrError<std::unique_ptr<ResourceHeapBase>> AllocateResourceHeap(
@@ -93,15 +127,19 @@ namespace dawn::native::vulkan {
                 "vkAllocateMemory"));
 
             ASSERT(allocatedMemory != VK_NULL_HANDLE);
-            return {std::make_unique<ResourceHeap>(allocatedMemory, mMemoryTypeIndex)};
+            auto heap = std::make_unique<ResourceHeap>(allocatedMemory, mMemoryTypeIndex, size);
+            mOwner->OnHeapAllocated(heap.get());
+            return {std::move(heap)};
         }
 
         void DeallocateResourceHeap(std::unique_ptr<ResourceHeapBase> allocation) override {
+            mOwner->OnHeapFreed(ToBackend(allocation.get()));
             mDevice->GetFencedDeleter()->DeleteWhenUnused(ToBackend(allocation.get())->GetMemory());
         }
 
       private:
         Device* mDevice;
+        ResourceMemoryAllocator* mOwner;
         size_t mMemoryTypeIndex;
         VkDeviceSize mMemoryHeapSize;
         PooledResourceMemoryAllocator mPooledMemoryAllocator;
@@ -116,8 +154,12 @@ namespace dawn::native::vulkan {
 
         for (size_t i = 0; i < info.memoryTypes.size(); i++) {
             mAllocatorsPerType.emplace_back(std::make_unique<SingleTypeAllocator>(
-                mDevice, i, info.memoryHeaps[info.memoryTypes[i].heapIndex].size));
+                mDevice, this, i, info.memoryHeaps[info.memoryTypes[i].heapIndex].size));
         }
+
+        mAllocatedSizePerHeap.resize(info.memoryHeaps.size(), 0);
+        mQueriedHeapBudgets.resize(info.memoryHeaps.size());
+        UpdateHeapBudgets();
     }
 
     ResourceMemoryAllocator::~ResourceMemoryAllocator() = default;
@@ -134,22 +176,52 @@ namespace dawn::native::vulkan {
         // Sub-allocate non-mappable resources because at the moment the mapped pointer
         // is part of the resource and not the heap, which doesn't match the Vulkan model.
         // TODO(crbug.com/dawn/849): allow sub-allocating mappable resources, maybe.
-        if (requirements.size < kMaxSizeForSubAllocation && kind != MemoryKind::LinearMappable) {
-            // When sub-allocating, Vulkan requires that we respect bufferImageGranularity. Some
-            // hardware puts information on the memory's page table entry and allocating a linear
-            // resource in the same page as a non-linear (aka opaque) resource can cause issues.
-            // Probably because some texture compression flags are stored on the page table entry,
-            // and allocating a linear resource removes these flags.
-            //
-            // Anyway, just to be safe we ask that all sub-allocated resources are allocated with at
-            // least this alignment. TODO(crbug.com/dawn/849): this is suboptimal because multiple
-            // linear (resp. opaque) resources can coexist in the same page. In particular Nvidia
-            // GPUs often use a granularity of 64k which will lead to a lot of wasted spec. Revisit
-            // with a more efficient algorithm later.
-            uint64_t alignment =
-                std::max(requirements.alignment,
-                         mDevice->GetDeviceInfo().properties.limits.bufferImageGranularity);
+        bool canSubAllocate =
+            requirements.size < kMaxSizeForSubAllocation && kind != MemoryKind::LinearMappable;
+
+        // When sub-allocating, Vulkan requires that we respect bufferImageGranularity. Some
+        // hardware puts information on the memory's page table entry and allocating a linear
+        // resource in the same page as a non-linear (aka opaque) resource can cause issues.
+        // Probably because some texture compression flags are stored on the page table entry,
+        // and allocating a linear resource removes these flags.
+        //
+        // Anyway, just to be safe we ask that all sub-allocated resources are allocated with at
+        // least this alignment. TODO(crbug.com/dawn/849): this is suboptimal because multiple
+        // linear (resp. opaque) resources can coexist in the same page. In particular Nvidia
+        // GPUs often use a granularity of 64k which will lead to a lot of wasted spec. Revisit
+        // with a more efficient algorithm later.
+        uint64_t alignment =
+            std::max(requirements.alignment,
+                     mDevice->GetDeviceInfo().properties.limits.bufferImageGranularity);
+
+        // When the heap of the memory type is over its budget, avoid allocating more memory in
+        // it: use the space left in its memory blocks, then free the memory blocks kept for
+        // reuse, and then fall back to another compatible memory type whose heap isn't over its
+        // budget. The budget isn't a hard limit so the allocation still happens in the heap if
+        // there is no other choice.
+        if (IsOverBudget(memoryType, size)) {
+            if (canSubAllocate) {
+                ResourceMemoryAllocation subAllocation =
+                    mAllocatorsPerType[memoryType]->AllocateMemoryInExistingHeaps(
+                        size, alignment, [](const ResourceHeapBase*) { return true; });
+                if (subAllocation.GetInfo().mMethod != AllocationMethod::kInvalid) {
+                    return std::move(subAllocation);
+                }
+            }
+
+            DestroyPool();
 
+            if (IsOverBudget(memoryType, size)) {
+                int heapIndex =
+                    mDevice->GetDeviceInfo().memoryTypes[memoryType].heapIndex;
+                int fallbackType = FindBestTypeIndex(requirements, kind, heapIndex);
+                if (fallbackType >= 0 && !IsOverBudget(fallbackType, size)) {
+                    memoryType = fallbackType;
+                }
+            }
+        }
+
+        if (canSubAllocate) {
             ResourceMemoryAllocation subAllocation;
             DAWN_TRY_ASSIGN(subAllocation, mAllocatorsPerType[memoryType]->AllocateMemory(
                                                requirements.size, alignment));
@@ -180,6 +252,24 @@ namespace dawn::native::vulkan {
                                         static_cast<uint8_t*>(mappedPointer));
     }
 
+    ResourceMemoryAllocation ResourceMemoryAllocator::AllocateInExistingHeaps(
+        const VkMemoryRequirements& requirements,
+        MemoryKind kind,
+        const std::function<bool(const ResourceHeapBase*)>& isHeapUsable) {
+        if (requirements.size >= kMaxSizeForSubAllocation || kind == MemoryKind::LinearMappable) {
+            return ResourceMemoryAllocation{};
+        }
+
+        int memoryType = FindBestTypeIndex(requirements, kind);
+        ASSERT(memoryType >= 0);
+
+        uint64_t alignment =
+            std::max(requirements.alignment,
+                     mDevice->GetDeviceInfo().properties.limits.bufferImageGranularity);
+        return mAllocatorsPerType[memoryType]->AllocateMemoryInExistingHeaps(
+            requirements.size, alignment, isHeapUsable);
+    }
+
     void ResourceMemoryAllocator::Deallocate(ResourceMemoryAllocation* allocation) {
         switch (allocation->GetInfo().mMethod) {
             // Some memory allocation can never be initialized, for example when wrapping
@@ -192,6 +282,7 @@ namespace dawn::native::vulkan {
             case AllocationMethod::kDirect: {
                 ResourceHeap* heap = ToBackend(allocation->GetResourceHeap());
                 allocation->Invalidate();
+                OnHeapFreed(heap);
                 mDevice->GetFencedDeleter()->DeleteWhenUnused(heap->GetMemory());
                 delete heap;
                 break;
@@ -222,13 +313,22 @@ namespace dawn::native::vulkan {
             size_t memoryType = ToBackend(allocation.GetResourceHeap())->GetMemoryType();
 
             mAllocatorsPerType[memoryType]->DeallocateMemory(allocation);
+            mNeedsDefragmentation = true;
         }
 
         mSubAllocationsToDelete.ClearUpTo(completedSerial);
+
+        UpdateHeapBudgets();
     }
 
     int ResourceMemoryAllocator::FindBestTypeIndex(VkMemoryRequirements requirements,
                                                    MemoryKind kind) {
+        return FindBestTypeIndex(requirements, kind, -1);
+    }
+
+    int ResourceMemoryAllocator::FindBestTypeIndex(VkMemoryRequirements requirements,
+                                                   MemoryKind kind,
+                                                   int excludedHeap) {
         const VulkanDeviceInfo& info = mDevice->GetDeviceInfo();
         bool mappable = kind == MemoryKind::LinearMappable;
 
@@ -240,6 +340,10 @@ namespace dawn::native::vulkan {
                 continue;
             }
 
+            if (static_cast<int>(info.memoryTypes[i].heapIndex) == excludedHeap) {
+                continue;
+            }
+
             // Mappable resource must be host visible
             if (mappable &&
                 (info.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) == 0) {
@@ -289,4 +393,163 @@ namespace dawn::native::vulkan {
         }
     }
 
+    std::vector<ResourceMemoryAllocator::HeapBudget> ResourceMemoryAllocator::GetHeapBudgets()
+        const {
+        std::vector<HeapBudget> budgets = mQueriedHeapBudgets;
+        for (size_t i = 0; i < budgets.size(); ++i) {
+            // Apply the changes of the memory allocated by this allocator since the query.
+            const VkDeviceSize allocated = mAllocatedSizePerHeap[i];
+            const VkDeviceSize allocatedAtQuery = mAllocatedSizePerHeapAtBudgetQuery[i];
+            if (allocated >= allocatedAtQuery) {
+                budgets[i].usage += allocated - allocatedAtQuery;
+            } else {
+                budgets[i].usage -= std::min(budgets[i].usage, allocatedAtQuery - allocated);
+            }
+        }
+        return budgets;
+    }
+
+    void ResourceMemoryAllocator::UpdateHeapBudgets() {
+        const VulkanDeviceInfo& info = mDevice->GetDeviceInfo();
+        mAllocatedSizePerHeapAtBudgetQuery = mAllocatedSizePerHeap;
+
+        if (!info.HasExt(DeviceExt::MemoryBudget)) {
+            for (size_t i = 0; i < info.memoryHeaps.size(); ++i) {
+                mQueriedHeapBudgets[i] = {info.memoryHeaps[i].size, mAllocatedSizePerHeap[i]};
+            }
+            return;
+        }
+
+        VkPhysicalDeviceMemoryProperties2 properties;
+        properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+        properties.pNext = nullptr;
+        PNextChainBuilder propertiesChain(&properties);
+
+        VkPhysicalDeviceMemoryBudgetPropertiesEXT budgetProperties;
+        propertiesChain.Add(&budgetProperties,
+                            VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT);
+
+        mDevice->fn.GetPhysicalDeviceMemoryProperties2(
+            ToBackend(mDevice->GetAdapter())->GetPhysicalDevice(), &properties);
+
+        for (size_t i = 0; i < info.memoryHeaps.size(); ++i) {
+            mQueriedHeapBudgets[i] = {budgetProperties.heapBudget[i],
+                                      budgetProperties.heapUsage[i]};
+        }
+    }
+
+    bool ResourceMemoryAllocator::IsOverBudget(int memoryType, VkDeviceSize size) const {
+        size_t heapIndex = mDevice->GetDeviceInfo().memoryTypes[memoryType].heapIndex;
+        HeapBudget budget = GetHeapBudgets()[heapIndex];
+        return budget.usage > budget.budget || size > budget.budget - budget.usage;
+    }
+
+    void ResourceMemoryAllocator::OnHeapAllocated(const ResourceHeap* heap) {
+        size_t heapIndex = mDevice->GetDeviceInfo().memoryTypes[heap->GetMemoryType()].heapIndex;
+        mAllocatedSizePerHeap[heapIndex] += heap->GetSize();
+    }
+
+    void ResourceMemoryAllocator::OnHeapFreed(const ResourceHeap* heap) {
+        size_t heapIndex = mDevice->GetDeviceInfo().memoryTypes[heap->GetMemoryType()].heapIndex;
+        ASSERT(mAllocatedSizePerHeap[heapIndex] >= heap->GetSize());
+        mAllocatedSizePerHeap[heapIndex] -= heap->GetSize();
+    }
+
+    void ResourceMemoryAllocator::AddMovableBuffer(Buffer* buffer) {
+        mMovableBuffers.insert(buffer);
+    }
+
+    void ResourceMemoryAllocator::RemoveMovableBuffer(Buffer* buffer) {
+        mMovableBuffers.erase(buffer);
+    }
+
+    MaybeError ResourceMemoryAllocator::Defragment(CommandRecordingContext* recordingContext) {
+        if (!mNeedsDefragmentation) {
+            return {};
+        }
+        mNeedsDefragmentation = false;
+
+        // Free the memory blocks kept for reuse, which include the ones evacuated by the previous
+        // defragmentation once the copies of their buffers completed.
+        VkDeviceSize allocatedSize = ComputeTotalSize(mAllocatedSizePerHeap);
+        DestroyPool();
+        mDefragmentationStats.reclaimedBytes +=
+            allocatedSize - ComputeTotalSize(mAllocatedSizePerHeap);
+
+        for (auto& allocator : mAllocatorsPerType) {
+            DAWN_TRY(EvacuateSparseHeaps(allocator.get(), recordingContext));
+        }
+        return {};
+    }
+
+    MaybeError ResourceMemoryAllocator::EvacuateSparseHeaps(
+        SingleTypeAllocator* allocator,
+        CommandRecordingContext* recordingContext) {
+        std::vector<BuddyMemoryAllocator::HeapUsage> heapUsages = allocator->GetHeapUsages();
+        if (heapUsages.size() < 2) {
+            return {};
+        }
+
+        std::unordered_map<const ResourceHeapBase*, std::vector<Buffer*>> buffersPerHeap;
+        for (Buffer* buffer : mMovableBuffers) {
+            buffersPerHeap[buffer->GetMemoryAllocation().GetResourceHeap()].push_back(buffer);
+        }
+
+        // Evacuate the emptiest heaps first, as long as the space left in the other heaps is
+        // enough for their buffers. This is only an estimate since the free space of the other
+        // heaps may be fragmented, in which case some buffers aren't moved.
+        std::sort(heapUsages.begin(), heapUsages.end(),
+                  [](const BuddyMemoryAllocator::HeapUsage& a,
+                     const BuddyMemoryAllocator::HeapUsage& b) {
+                      return a.usedSize < b.usedSize;
+                  });
+
+        const uint64_t blockSize = allocator->GetMemoryBlockSize();
+        uint64_t freeSize = 0;
+        for (const BuddyMemoryAllocator::HeapUsage& usage : heapUsages) {
+            freeSize += blockSize - usage.usedSize;
+        }
+
+        std::unordered_set<const ResourceHeapBase*> evacuatedHeaps;
+        for (const BuddyMemoryAllocator::HeapUsage& usage : heapUsages) {
+            if (usage.usedSize > kSparseHeapMaxUsedSize) {
+                break;
+            }
+
+            // Only the heaps whose sub-allocations are all movable buffers can be freed.
+            auto buffers = buffersPerHeap.find(usage.heap);
+            if (buffers == buffersPerHeap.end() ||
+                buffers->second.size() != usage.subAllocationCount) {
+                continue;
+            }
+
+            uint64_t freeSizeInOtherHeaps = freeSize - (blockSize - usage.usedSize);
+            if (usage.usedSize > freeSizeInOtherHeaps) {
+                break;
+            }
+            freeSize = freeSizeInOtherHeaps - usage.usedSize;
+            evacuatedHeaps.insert(usage.heap);
+        }
+
+        auto IsHeapUsable = [&](const ResourceHeapBase* heap) {
+            return evacuatedHeaps.count(heap) == 0;
+        };
+        for (const ResourceHeapBase* heap : evacuatedHeaps) {
+            for (Buffer* buffer : buffersPerHeap[heap]) {
+                bool moved;
+                DAWN_TRY_ASSIGN(moved, buffer->MoveToExistingHeaps(recordingContext, IsHeapUsable));
+                if (moved) {
+                    mDefragmentationStats.movedBufferCount++;
+                    mDefragmentationStats.movedBytes += buffer->GetAllocatedSize();
+                }
+            }
+        }
+        return {};
+    }
+
+    ResourceMemoryAllocator::DefragmentationStats
+    ResourceMemoryAllocator::GetDefragmentationStats() const {
+        return mDefragmentationStats;
+    }
+
 }  // namespace dawn::native::vulkan
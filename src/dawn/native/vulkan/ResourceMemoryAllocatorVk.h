@@ -22,12 +22,17 @@
 #include "dawn/native/PooledResourceMemoryAllocator.h"
 #include "dawn/native/ResourceMemoryAllocation.h"
 
+#include <functional>
 #include <memory>
+#include <unordered_set>
 #include <vector>
 
 namespace dawn::native::vulkan {
 
+    class Buffer;
+    struct CommandRecordingContext;
     class Device;
+    class ResourceHeap;
 
     // Various kinds of memory that influence the result of the allocation. For example, to take
     // into account mappability and Vulkan's bufferImageGranularity.
@@ -44,6 +49,13 @@ namespace dawn::native::vulkan {
 
         ResultOrError<ResourceMemoryAllocation> Allocate(const VkMemoryRequirements& requirements,
                                                          MemoryKind kind);
+        // Sub-allocates only in the memory blocks that are already allocated and that
+        // |isHeapUsable| accepts. Returns an invalid allocation if there isn't enough space in
+        // them, or if the resource can't be sub-allocated.
+        ResourceMemoryAllocation AllocateInExistingHeaps(
+            const VkMemoryRequirements& requirements,
+            MemoryKind kind,
+            const std::function<bool(const ResourceHeapBase*)>& isHeapUsable);
         void Deallocate(ResourceMemoryAllocation* allocation);
 
         void DestroyPool();
@@ -52,13 +64,71 @@ namespace dawn::native::vulkan {
 
         int FindBestTypeIndex(VkMemoryRequirements requirements, MemoryKind kind);
 
+        struct HeapBudget {
+            // How much memory the process can allocate in the heap and how much it uses. They
+            // come from VK_EXT_memory_budget when it is supported. Otherwise the budget is the
+            // size of the heap and the usage is the memory allocated by this allocator.
+            VkDeviceSize budget;
+            VkDeviceSize usage;
+        };
+        // Returns the budget of each memory heap, estimated from the last time it was queried and
+        // the memory allocated and freed since then.
+        std::vector<HeapBudget> GetHeapBudgets() const;
+
+        // The buffers that are sub-allocated and whose memory can be moved to defragment it.
+        void AddMovableBuffer(Buffer* buffer);
+        void RemoveMovableBuffer(Buffer* buffer);
+
+        // Frees the memory blocks that are unused and moves the movable buffers out of the
+        // memory blocks that are sparsely used so that they are freed by the next call. The
+        // copies of the buffers are recorded in |recordingContext|, so it must only be called
+        // when the GPU is idle.
+        MaybeError Defragment(CommandRecordingContext* recordingContext);
+
+        struct DefragmentationStats {
+            uint64_t movedBufferCount = 0;
+            uint64_t movedBytes = 0;
+            // The size of the memory blocks freed by the defragmentation.
+            uint64_t reclaimedBytes = 0;
+        };
+        DefragmentationStats GetDefragmentationStats() const;
+
       private:
+        class SingleTypeAllocator;
+
+        // Like FindBestTypeIndex, but ignores the memory types of |excludedHeap| if it isn't -1.
+        int FindBestTypeIndex(VkMemoryRequirements requirements,
+                              MemoryKind kind,
+                              int excludedHeap);
+
+        // Queries the budgets with VK_EXT_memory_budget.
+        void UpdateHeapBudgets();
+        bool IsOverBudget(int memoryType, VkDeviceSize size) const;
+        void OnHeapAllocated(const ResourceHeap* heap);
+        void OnHeapFreed(const ResourceHeap* heap);
+
+        // Moves the buffers of the memory blocks that contain only movable buffers and that are
+        // sparsely used, as long as the other memory blocks have space for them.
+        MaybeError EvacuateSparseHeaps(SingleTypeAllocator* allocator,
+                                       CommandRecordingContext* recordingContext);
+
         Device* mDevice;
 
-        class SingleTypeAllocator;
         std::vector<std::unique_ptr<SingleTypeAllocator>> mAllocatorsPerType;
 
         SerialQueue<ExecutionSerial, ResourceMemoryAllocation> mSubAllocationsToDelete;
+
+        // The memory allocated in each heap, and the budgets and allocated memory when the
+        // budgets were last queried.
+        std::vector<VkDeviceSize> mAllocatedSizePerHeap;
+        std::vector<VkDeviceSize> mAllocatedSizePerHeapAtBudgetQuery;
+        std::vector<HeapBudget> mQueriedHeapBudgets;
+
+        std::unordered_set<Buffer*> mMovableBuffers;
+        // Whether sub-allocations were freed since the last defragmentation, which may have
+        // made memory blocks sparse or unused.
+        bool mNeedsDefragmentation = false;
+        DefragmentationStats mDefragmentationStats;
     };
 
 }  // namespace dawn::native::vulkan
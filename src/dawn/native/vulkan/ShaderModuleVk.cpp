@@ -14,6 +14,7 @@
 
 #include "dawn/native/vulkan/ShaderModuleVk.h"
 
+#include "dawn/native/PersistentCache.h"
 #include "dawn/native/SpirvValidation.h"
 #include "dawn/native/TintUtils.h"
 #include "dawn/native/vulkan/BindGroupLayoutVk.h"
@@ -28,8 +29,60 @@
 #include <tint/tint.h>
 #include <spirv-tools/libspirv.hpp>
 
+#include <map>
+#include <sstream>
+
 namespace dawn::native::vulkan {
 
+    namespace {
+
+        struct CompareBindingPoint {
+            constexpr bool operator()(const tint::transform::BindingPoint& lhs,
+                                      const tint::transform::BindingPoint& rhs) const {
+                if (lhs.group != rhs.group) {
+                    return lhs.group < rhs.group;
+                } else {
+                    return lhs.binding < rhs.binding;
+                }
+            }
+        };
+
+        void Serialize(std::stringstream& output,
+                       const tint::transform::BindingPoint& bindingPoint) {
+            output << "(BindingPoint";
+            output << " group=" << bindingPoint.group;
+            output << " binding=" << bindingPoint.binding;
+            output << ")";
+        }
+
+        void Serialize(std::stringstream& output,
+                       const tint::transform::MultiplanarExternalTexture::BindingPoints& points) {
+            output << "(ExternalTextureBindingPoints";
+            output << " plane1=";
+            Serialize(output, points.plane_1);
+            output << " params=";
+            Serialize(output, points.params);
+            output << ")";
+        }
+
+        template <typename T>
+        void Serialize(std::stringstream& output,
+                       const std::unordered_map<tint::transform::BindingPoint, T>& map) {
+            output << "(map";
+
+            std::map<tint::transform::BindingPoint, T, CompareBindingPoint> sorted(map.begin(),
+                                                                                   map.end());
+            for (auto& [bindingPoint, value] : sorted) {
+                output << " ";
+                Serialize(output, bindingPoint);
+                output << "=";
+                Serialize(output, value);
+            }
+            output << ")";
+        }
+
+    }  // anonymous namespace
+
     ShaderModule::ConcurrentTransformedShaderModuleCache::ConcurrentTransformedShaderModuleCache(
         Device* device)
         : mDevice(device) {
@@ -85,19 +138,6 @@ namespace dawn::native::vulkan {
     }
 
     MaybeError ShaderModule::Initialize(ShaderModuleParseResult* parseResult) {
-        if (GetDevice()->IsRobustnessEnabled()) {
-            ScopedTintICEHandler scopedICEHandler(GetDevice());
-
-            tint::transform::Robustness robustness;
-            tint::transform::DataMap transformInputs;
-
-            tint::Program program;
-            DAWN_TRY_ASSIGN(program, RunTransforms(&robustness, parseResult->tintProgram.get(),
-                                                   transformInputs, nullptr, nullptr));
-            // Rather than use a new ParseResult object, we just reuse the original parseResult
-            parseResult->tintProgram = std::make_unique<tint::Program>(std::move(program));
-        }
-
         return InitializeBase(parseResult);
     }
 
@@ -154,17 +194,6 @@ namespace dawn::native::vulkan {
             }
         }
 
-        tint::transform::Manager transformManager;
-        transformManager.append(std::make_unique<tint::transform::BindingRemapper>());
-        // Many Vulkan drivers can't handle multi-entrypoint shader modules.
-        transformManager.append(std::make_unique<tint::transform::SingleEntryPoint>());
-
-        tint::transform::DataMap transformInputs;
-        transformInputs.Add<BindingRemapper::Remappings>(std::move(bindingPoints),
-                                                         std::move(accessControls),
-                                                         /* mayCollide */ false);
-        transformInputs.Add<tint::transform::SingleEntryPoint::Config>(entryPointName);
-
         // Transform external textures into the binding locations specified in the bgl
         // TODO(dawn:1082): Replace this block with ShaderModuleBase::AddExternalTextureTransform.
         tint::transform::MultiplanarExternalTexture::BindingsMap newBindingsMap;
@@ -188,42 +217,122 @@ namespace dawn::native::vulkan {
             }
         }
 
-        if (!newBindingsMap.empty()) {
-            transformManager.Add<tint::transform::MultiplanarExternalTexture>();
-            transformInputs.Add<tint::transform::MultiplanarExternalTexture::NewBindingPoints>(
-                newBindingsMap);
-        }
+        const bool disableWorkgroupInit =
+            GetDevice()->IsToggleEnabled(Toggle::DisableWorkgroupInit);
 
-        tint::Program program;
-        {
-            TRACE_EVENT0(GetDevice()->GetPlatform(), General, "RunTransforms");
-            DAWN_TRY_ASSIGN(program, RunTransforms(&transformManager, GetTintProgram(),
-                                                   transformInputs, nullptr, nullptr));
-        }
+        // The generated SPIR-V only depends on the module's source and the inputs of the
+        // transforms and of the writer, so it is stored in the PersistentCache to skip Tint
+        // entirely the next time the same pipeline is created, even in another process. The key
+        // contains a version that must be bumped when the SPIR-V generation changes so that an
+        // updated Dawn doesn't load stale SPIR-V. The key copies the whole source so it is only
+        // built when there is a cache; a disabled cache ignores the key.
+        PersistentCacheKey spirvCacheKey;
+        if (GetDevice()->GetPersistentCache()->IsEnabled()) {
+            std::stringstream stream;
 
-        tint::writer::spirv::Options options;
-        options.emit_vertex_point_size = true;
-        options.disable_workgroup_init = GetDevice()->IsToggleEnabled(Toggle::DisableWorkgroupInit);
+            // Prefix the key with the type to avoid collisions from another type that could have
+            // the same key.
+            stream << static_cast<uint32_t>(PersistentKeyType::Shader);
+            stream << "\n";
 
-        std::vector<uint32_t> spirv;
-        {
-            TRACE_EVENT0(GetDevice()->GetPlatform(), General, "tint::writer::spirv::Generate()");
-            auto result = tint::writer::spirv::Generate(&program, options);
-            DAWN_INVALID_IF(!result.success, "An error occured while generating SPIR-V: %s.",
-                            result.error);
+            SerializeSource(stream);
+
+            stream << "(SpirvCompilationRequest";
+            stream << " version=1";
+            stream << " entryPointName=" << entryPointName;
+
+            stream << " remappedBindingPoints=";
+            Serialize(stream, bindingPoints);
+
+            stream << " externalTextureBindingPoints=";
+            Serialize(stream, newBindingsMap);
 
-            spirv = std::move(result.spirv);
+            stream << " isRobustnessEnabled=" << GetDevice()->IsRobustnessEnabled();
+            stream << " disableWorkgroupInit=" << disableWorkgroupInit;
+            stream << ")";
+            stream << "\n";
+
+            spirvCacheKey = PersistentCacheKey(std::istreambuf_iterator<char>{stream},
+                                               std::istreambuf_iterator<char>{});
         }
 
-        DAWN_TRY(
-            ValidateSpirv(GetDevice(), spirv, GetDevice()->IsToggleEnabled(Toggle::DumpShaders)));
+        std::vector<uint32_t> spirv;
+        ScopedCachedBlob cachedSpirv;
+        DAWN_TRY_ASSIGN(
+            cachedSpirv,
+            GetDevice()->GetPersistentCache()->GetOrCreate(
+                spirvCacheKey, [&](auto doCache) -> MaybeError {
+                    tint::transform::Manager transformManager;
+                    // Robustness is applied here rather than when the module is created so that
+                    // modules created from cached reflection don't need to be parsed eagerly.
+                    if (GetDevice()->IsRobustnessEnabled()) {
+                        transformManager.append(std::make_unique<tint::transform::Robustness>());
+                    }
+                    transformManager.append(std::make_unique<tint::transform::BindingRemapper>());
+                    // Many Vulkan drivers can't handle multi-entrypoint shader modules.
+                    transformManager.append(
+                        std::make_unique<tint::transform::SingleEntryPoint>());
+
+                    tint::transform::DataMap transformInputs;
+                    transformInputs.Add<BindingRemapper::Remappings>(std::move(bindingPoints),
+                                                                     std::move(accessControls),
+                                                                     /* mayCollide */ false);
+                    transformInputs.Add<tint::transform::SingleEntryPoint::Config>(
+                        entryPointName);
+
+                    if (!newBindingsMap.empty()) {
+                        transformManager.Add<tint::transform::MultiplanarExternalTexture>();
+                        transformInputs
+                            .Add<tint::transform::MultiplanarExternalTexture::NewBindingPoints>(
+                                newBindingsMap);
+                    }
+
+                    const tint::Program* tintProgram;
+                    DAWN_TRY_ASSIGN(tintProgram, GetTintProgram());
+
+                    tint::Program program;
+                    {
+                        TRACE_EVENT0(GetDevice()->GetPlatform(), General, "RunTransforms");
+                        DAWN_TRY_ASSIGN(program,
+                                        RunTransforms(&transformManager, tintProgram,
+                                                      transformInputs, nullptr, nullptr));
+                    }
+
+                    tint::writer::spirv::Options options;
+                    options.emit_vertex_point_size = true;
+                    options.disable_workgroup_init = disableWorkgroupInit;
+
+                    {
+                        TRACE_EVENT0(GetDevice()->GetPlatform(), General,
+                                     "tint::writer::spirv::Generate()");
+                        auto result = tint::writer::spirv::Generate(&program, options);
+                        DAWN_INVALID_IF(!result.success,
+                                        "An error occured while generating SPIR-V: %s.",
+                                        result.error);
+
+                        spirv = std::move(result.spirv);
+                    }
+
+                    DAWN_TRY(ValidateSpirv(GetDevice(), spirv,
+                                           GetDevice()->IsToggleEnabled(Toggle::DumpShaders)));
+
+                    doCache(spirv.data(), spirv.size() * sizeof(uint32_t));
+                    return {};
+                }));
+
+        const uint32_t* code = spirv.data();
+        size_t codeSize = spirv.size() * sizeof(uint32_t);
+        if (cachedSpirv.bufferSize > 0) {
+            code = reinterpret_cast<const uint32_t*>(cachedSpirv.buffer.get());
+            codeSize = cachedSpirv.bufferSize;
+        }
 
         VkShaderModuleCreateInfo createInfo;
         createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
         createInfo.pNext = nullptr;
         createInfo.flags = 0;
-        createInfo.codeSize = spirv.size() * sizeof(uint32_t);
-        createInfo.pCode = spirv.data();
+        createInfo.codeSize = codeSize;
+        createInfo.pCode = code;
 
         Device* device = ToBackend(GetDevice());
 
@@ -17,9 +17,12 @@
 #include "dawn/native/vulkan/FencedDeleter.h"
 #include "dawn/native/vulkan/ResourceHeapVk.h"
 #include "dawn/native/vulkan/ResourceMemoryAllocatorVk.h"
+#include "dawn/native/vulkan/TransferQueue.h"
 #include "dawn/native/vulkan/UtilsVulkan.h"
 #include "dawn/native/vulkan/VulkanError.h"
 
+#include <array>
+
 namespace dawn::native::vulkan {
 
     StagingBuffer::StagingBuffer(size_t size, Device* device)
@@ -37,6 +40,16 @@ namespace dawn::native::vulkan {
         createInfo.queueFamilyIndexCount = 0;
         createInfo.pQueueFamilyIndices = 0;
 
+        // Staging buffers are the sources of the uploads done on the transfer queue.
+        TransferQueue* transferQueue = mDevice->GetTransferQueue();
+        if (transferQueue != nullptr) {
+            const std::array<uint32_t, 2>& queueFamilies =
+                transferQueue->GetSharedQueueFamilyIndices();
+            createInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+            createInfo.queueFamilyIndexCount = static_cast<uint32_t>(queueFamilies.size());
+            createInfo.pQueueFamilyIndices = queueFamilies.data();
+        }
+
         DAWN_TRY(CheckVkSuccess(
             mDevice->fn.CreateBuffer(mDevice->GetVkDevice(), &createInfo, nullptr, &*mBuffer),
             "vkCreateBuffer"));
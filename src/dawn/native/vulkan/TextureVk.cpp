@@ -25,9 +25,11 @@
 #include "dawn/native/vulkan/CommandRecordingContext.h"
 #include "dawn/native/vulkan/DeviceVk.h"
 #include "dawn/native/vulkan/FencedDeleter.h"
+#include "dawn/native/vulkan/FramebufferCache.h"
 #include "dawn/native/vulkan/ResourceHeapVk.h"
 #include "dawn/native/vulkan/ResourceMemoryAllocatorVk.h"
 #include "dawn/native/vulkan/StagingBufferVk.h"
+#include "dawn/native/vulkan/TransferQueue.h"
 #include "dawn/native/vulkan/UtilsVulkan.h"
 #include "dawn/native/vulkan/VulkanError.h"
 
@@ -659,6 +661,32 @@ namespace dawn::native::vulkan {
         createInfo.queueFamilyIndexCount = 0;
         createInfo.pQueueFamilyIndices = nullptr;
         createInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        PNextChainBuilder createInfoChain(&createInfo);
+
+        // Imageless framebuffers describe their attachments with the list of formats their views
+        // can have, which must match the list the images were created with. Views of the texture
+        // always have its format, so give the image a list of just that format.
+        VkImageFormatListCreateInfo imageFormatListInfo;
+        const bool hasImageFormatList = device->GetDeviceInfo().HasExt(DeviceExt::ImageFormatList);
+        if (hasImageFormatList) {
+            imageFormatListInfo.viewFormatCount = 1;
+            imageFormatListInfo.pViewFormats = &createInfo.format;
+            createInfoChain.Add(&imageFormatListInfo,
+                                VK_STRUCTURE_TYPE_IMAGE_FORMAT_LIST_CREATE_INFO);
+        }
+
+        // Color textures that can be written with Queue::WriteTexture are shared with the
+        // transfer queue doing the uploads, if there is one.
+        TransferQueue* transferQueue = device->GetTransferQueue();
+        if (transferQueue != nullptr && (GetInternalUsage() & wgpu::TextureUsage::CopyDst) &&
+            GetFormat().aspects == Aspect::Color) {
+            const std::array<uint32_t, 2>& queueFamilies =
+                transferQueue->GetSharedQueueFamilyIndices();
+            createInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+            createInfo.queueFamilyIndexCount = static_cast<uint32_t>(queueFamilies.size());
+            createInfo.pQueueFamilyIndices = queueFamilies.data();
+            mIsSharedWithTransferQueue = true;
+        }
 
         ASSERT(IsSampleCountSupported(device, createInfo));
 
@@ -674,6 +702,10 @@ namespace dawn::native::vulkan {
         DAWN_TRY(CheckVkSuccess(
             device->fn.CreateImage(device->GetVkDevice(), &createInfo, nullptr, &*mHandle),
             "CreateImage"));
+        mHasKnownImageCreateInfo = true;
+        mImageUsage = createInfo.usage;
+        mImageCreateFlags = createInfo.flags;
+        mHasImageFormatList = hasImageFormatList;
 
         // Create the image memory and associate it with the container
         VkMemoryRequirements requirements;
@@ -827,6 +859,8 @@ namespace dawn::native::vulkan {
         CommandRecordingContext* recordingContext = device->GetPendingRecordingContext();
         device->fn.CmdPipelineBarrier(recordingContext->commandBuffer, srcStages, dstStages, 0, 0,
                                       nullptr, 0, nullptr, 1, &barrier);
+        recordingContext->pipelineBarrierCount++;
+        recordingContext->memoryBarrierCount++;
 
         // Queue submit to signal we are done with the texture
         recordingContext->signalSemaphores.push_back(mSignalSemaphore);
@@ -886,6 +920,24 @@ namespace dawn::native::vulkan {
         return mHandle;
     }
 
+    bool Texture::HasKnownImageCreateInfo() const {
+        return mHasKnownImageCreateInfo;
+    }
+
+    VkImageUsageFlags Texture::GetImageUsage() const {
+        ASSERT(mHasKnownImageCreateInfo);
+        return mImageUsage;
+    }
+
+    VkImageCreateFlags Texture::GetImageCreateFlags() const {
+        ASSERT(mHasKnownImageCreateInfo);
+        return mImageCreateFlags;
+    }
+
+    bool Texture::HasImageFormatList() const {
+        return mHasImageFormatList;
+    }
+
     void Texture::TweakTransitionForExternalUsage(CommandRecordingContext* recordingContext,
                                                   std::vector<VkImageMemoryBarrier>* barriers,
                                                   size_t transitionBarrierStart) {
@@ -1011,6 +1063,8 @@ namespace dawn::native::vulkan {
                                          std::vector<VkImageMemoryBarrier>* imageBarriers,
                                          VkPipelineStageFlags* srcStages,
                                          VkPipelineStageFlags* dstStages) {
+        mLastMainQueueUsageSerial = GetDevice()->GetPendingCommandSerial();
+
         if (ShouldCombineBarriers()) {
             Aspect combinedAspect = ComputeAspectsForSubresourceStorage();
             SubresourceStorage<wgpu::TextureUsage> combinedUsages(combinedAspect, GetArrayLayers(),
@@ -1078,26 +1132,29 @@ namespace dawn::native::vulkan {
         VkPipelineStageFlags srcStages = 0;
         VkPipelineStageFlags dstStages = 0;
 
-        TransitionUsageAndGetResourceBarrier(usage, range, &barriers, &srcStages, &dstStages);
-
-        if (mExternalState != ExternalState::InternalOnly) {
-            TweakTransitionForExternalUsage(recordingContext, &barriers, 0);
-        }
+        TransitionUsageAndGetResourceBarrier(recordingContext, usage, range, &barriers, &srcStages,
+                                             &dstStages);
 
         if (!barriers.empty()) {
             ASSERT(srcStages != 0 && dstStages != 0);
             ToBackend(GetDevice())
                 ->fn.CmdPipelineBarrier(recordingContext->commandBuffer, srcStages, dstStages, 0, 0,
                                         nullptr, 0, nullptr, barriers.size(), barriers.data());
+            recordingContext->pipelineBarrierCount++;
+            recordingContext->memoryBarrierCount += barriers.size();
         }
     }
 
     void Texture::TransitionUsageAndGetResourceBarrier(
+        CommandRecordingContext* recordingContext,
         wgpu::TextureUsage usage,
         const SubresourceRange& range,
         std::vector<VkImageMemoryBarrier>* imageBarriers,
         VkPipelineStageFlags* srcStages,
         VkPipelineStageFlags* dstStages) {
+        mLastMainQueueUsageSerial = GetDevice()->GetPendingCommandSerial();
+        size_t transitionBarrierStart = imageBarriers->size();
+
         if (ShouldCombineBarriers()) {
             SubresourceRange updatedRange = range;
             updatedRange.aspects = ComputeAspectsForSubresourceStorage();
@@ -1107,6 +1164,11 @@ namespace dawn::native::vulkan {
             TransitionUsageAndGetResourceBarrierImpl(usage, range, imageBarriers, srcStages,
                                                      dstStages);
         }
+
+        if (mExternalState != ExternalState::InternalOnly) {
+            TweakTransitionForExternalUsage(recordingContext, imageBarriers,
+                                            transitionBarrierStart);
+        }
     }
 
     void Texture::TransitionUsageAndGetResourceBarrierImpl(
@@ -1135,9 +1197,51 @@ namespace dawn::native::vulkan {
         *dstStages |= VulkanPipelineStage(usage, format);
     }
 
+    bool Texture::IsSharedWithTransferQueue() const {
+        return mIsSharedWithTransferQueue;
+    }
+
+    ExecutionSerial Texture::GetLastMainQueueUsageSerial() const {
+        return mLastMainQueueUsageSerial;
+    }
+
+    void Texture::TransitionToCopyDstOnTransferQueue(CommandRecordingContext* recordingContext,
+                                                     const SubresourceRange& range) {
+        ASSERT(mIsSharedWithTransferQueue);
+        ASSERT(!ShouldCombineBarriers());
+
+        // The transfer queue waits for the commands of the main queue using the texture, so the
+        // barriers only have to order the upload with the previous uploads on the transfer queue.
+        // Access flags of other usages aren't supported on the transfer queue anyway.
+        std::vector<VkImageMemoryBarrier> barriers;
+        mSubresourceLastUsages->Update(
+            range, [&](const SubresourceRange& range, wgpu::TextureUsage* lastUsage) {
+                VkImageMemoryBarrier barrier =
+                    BuildMemoryBarrier(this, *lastUsage, wgpu::TextureUsage::CopyDst, range);
+                barrier.srcAccessMask =
+                    *lastUsage == wgpu::TextureUsage::None ? 0 : VK_ACCESS_TRANSFER_WRITE_BIT;
+                barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+                barriers.push_back(barrier);
+
+                *lastUsage = wgpu::TextureUsage::CopyDst;
+            });
+
+        ToBackend(GetDevice())
+            ->fn.CmdPipelineBarrier(recordingContext->commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                    VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr,
+                                    barriers.size(), barriers.data());
+    }
+
     MaybeError Texture::ClearTexture(CommandRecordingContext* recordingContext,
                                      const SubresourceRange& range,
                                      TextureBase::ClearValue clearValue) {
+        TransitionUsageNow(recordingContext, wgpu::TextureUsage::CopyDst, range);
+        return RecordClear(recordingContext, range, clearValue);
+    }
+
+    MaybeError Texture::RecordClear(CommandRecordingContext* recordingContext,
+                                    const SubresourceRange& range,
+                                    TextureBase::ClearValue clearValue) {
         Device* device = ToBackend(GetDevice());
 
         const bool isZero = clearValue == TextureBase::ClearValue::Zero;
@@ -1145,8 +1249,6 @@ namespace dawn::native::vulkan {
         int32_t sClearColor = isZero ? 0 : 1;
         float fClearColor = isZero ? 0.f : 1.f;
 
-        TransitionUsageNow(recordingContext, wgpu::TextureUsage::CopyDst, range);
-
         VkImageSubresourceRange imageRange = {};
         imageRange.levelCount = 1;
         imageRange.layerCount = 1;
@@ -1280,10 +1382,7 @@ namespace dawn::native::vulkan {
 
     void Texture::EnsureSubresourceContentInitialized(CommandRecordingContext* recordingContext,
                                                       const SubresourceRange& range) {
-        if (!GetDevice()->IsToggleEnabled(Toggle::LazyClearResourceOnFirstUse)) {
-            return;
-        }
-        if (!IsSubresourceContentInitialized(range)) {
+        if (NeedsLazyClear(range)) {
             // If subresource has not been initialized, clear it to black as it could contain dirty
             // bits from recycled memory
             GetDevice()->ConsumedError(
@@ -1291,6 +1390,19 @@ namespace dawn::native::vulkan {
         }
     }
 
+    bool Texture::NeedsLazyClear(const SubresourceRange& range) const {
+        return GetDevice()->IsToggleEnabled(Toggle::LazyClearResourceOnFirstUse) &&
+               !IsSubresourceContentInitialized(range);
+    }
+
+    void Texture::LazyClearInCopyDst(CommandRecordingContext* recordingContext,
+                                     const SubresourceRange& range) {
+        if (NeedsLazyClear(range)) {
+            GetDevice()->ConsumedError(
+                RecordClear(recordingContext, range, TextureBase::ClearValue::Zero));
+        }
+    }
+
     VkImageLayout Texture::GetCurrentLayoutForSwapChain() const {
         ASSERT(GetFormat().aspects == Aspect::Color);
         return VulkanImageLayout(this, mSubresourceLastUsages->Get(Aspect::Color, 0, 0));
@@ -1353,6 +1465,8 @@ namespace dawn::native::vulkan {
         Device* device = ToBackend(GetTexture()->GetDevice());
 
         if (mHandle != VK_NULL_HANDLE) {
+            // The framebuffers using the view can't be used anymore.
+            device->GetFramebufferCache()->EvictFramebuffersUsing(this);
             device->GetFencedDeleter()->DeleteWhenUnused(mHandle);
             mHandle = VK_NULL_HANDLE;
         }
@@ -18,6 +18,7 @@
 #include "dawn/native/Texture.h"
 
 #include "dawn/common/vulkan_platform.h"
+#include "dawn/native/IntegerTypes.h"
 #include "dawn/native/PassResourceUsage.h"
 #include "dawn/native/ResourceMemoryAllocation.h"
 #include "dawn/native/vulkan/ExternalHandle.h"
@@ -63,12 +64,30 @@ namespace dawn::native::vulkan {
 
         VkImage GetHandle() const;
 
+        // Returns whether the parameters the VkImage was created with are known, which is only
+        // the case for VkImages created by Dawn itself, and the usage and flags it was created
+        // with when they are.
+        bool HasKnownImageCreateInfo() const;
+        VkImageUsageFlags GetImageUsage() const;
+        VkImageCreateFlags GetImageCreateFlags() const;
+        // Whether the VkImage was created with a VkImageFormatListCreateInfo containing only the
+        // format of the texture.
+        bool HasImageFormatList() const;
+
         // Transitions the texture to be used as `usage`, recording any necessary barrier in
         // `commands`.
         // TODO(crbug.com/dawn/851): coalesce barriers and do them early when possible.
         void TransitionUsageNow(CommandRecordingContext* recordingContext,
                                 wgpu::TextureUsage usage,
                                 const SubresourceRange& range);
+        // Like TransitionUsageNow but appends the barriers to `imageBarriers` instead of recording
+        // them, so that they can be recorded along with other barriers.
+        void TransitionUsageAndGetResourceBarrier(CommandRecordingContext* recordingContext,
+                                                  wgpu::TextureUsage usage,
+                                                  const SubresourceRange& range,
+                                                  std::vector<VkImageMemoryBarrier>* imageBarriers,
+                                                  VkPipelineStageFlags* srcStages,
+                                                  VkPipelineStageFlags* dstStages);
         void TransitionUsageForPass(CommandRecordingContext* recordingContext,
                                     const TextureSubresourceUsage& textureUsages,
                                     std::vector<VkImageMemoryBarrier>* imageBarriers,
@@ -77,6 +96,23 @@ namespace dawn::native::vulkan {
 
         void EnsureSubresourceContentInitialized(CommandRecordingContext* recordingContext,
                                                  const SubresourceRange& range);
+        // Whether EnsureSubresourceContentInitialized would clear some of the subresources of
+        // |range|.
+        bool NeedsLazyClear(const SubresourceRange& range) const;
+        // Lazily clears the subresources of |range| like EnsureSubresourceContentInitialized but
+        // without transitioning them to CopyDst, so that the transitions of the lazy clears of
+        // several textures can be recorded with a single barrier. |range| must be in CopyDst.
+        void LazyClearInCopyDst(CommandRecordingContext* recordingContext,
+                                const SubresourceRange& range);
+
+        // Whether the texture can be uploaded to on the dedicated transfer queue.
+        bool IsSharedWithTransferQueue() const;
+        // The last serial of the main queue whose commands use the texture.
+        ExecutionSerial GetLastMainQueueUsageSerial() const;
+        // Records in the commands of the transfer queue the barrier transitioning |range| to the
+        // TRANSFER_DST_OPTIMAL layout and ordering an upload with the previous uploads.
+        void TransitionToCopyDstOnTransferQueue(CommandRecordingContext* recordingContext,
+                                                const SubresourceRange& range);
 
         VkImageLayout GetCurrentLayoutForSwapChain() const;
 
@@ -110,13 +146,12 @@ namespace dawn::native::vulkan {
         MaybeError ClearTexture(CommandRecordingContext* recordingContext,
                                 const SubresourceRange& range,
                                 TextureBase::ClearValue);
+        // Records the clear of |range|, which must already be in CopyDst.
+        MaybeError RecordClear(CommandRecordingContext* recordingContext,
+                               const SubresourceRange& range,
+                               TextureBase::ClearValue);
 
         // Implementation details of the barrier computations for the texture.
-        void TransitionUsageAndGetResourceBarrier(wgpu::TextureUsage usage,
-                                                  const SubresourceRange& range,
-                                                  std::vector<VkImageMemoryBarrier>* imageBarriers,
-                                                  VkPipelineStageFlags* srcStages,
-                                                  VkPipelineStageFlags* dstStages);
         void TransitionUsageForPassImpl(
             CommandRecordingContext* recordingContext,
             const SubresourceStorage<wgpu::TextureUsage>& subresourceUsages,
@@ -153,6 +188,10 @@ namespace dawn::native::vulkan {
         Aspect ComputeAspectsForSubresourceStorage() const;
 
         VkImage mHandle = VK_NULL_HANDLE;
+        bool mHasKnownImageCreateInfo = false;
+        VkImageUsageFlags mImageUsage = 0;
+        VkImageCreateFlags mImageCreateFlags = 0;
+        bool mHasImageFormatList = false;
         ResourceMemoryAllocation mMemoryAllocation;
         VkDeviceMemory mExternalAllocation = VK_NULL_HANDLE;
 
@@ -172,6 +211,9 @@ namespace dawn::native::vulkan {
         std::unique_ptr<SubresourceStorage<wgpu::TextureUsage>> mSubresourceLastUsages;
 
         bool mSupportsDisjointVkImage = false;
+
+        bool mIsSharedWithTransferQueue = false;
+        ExecutionSerial mLastMainQueueUsageSerial = ExecutionSerial(0);
     };
 
     class TextureView final : public TextureViewBase {
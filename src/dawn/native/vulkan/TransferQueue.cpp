@@ -0,0 +1,288 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/native/vulkan/TransferQueue.h"
+
+#include "dawn/native/vulkan/BufferVk.h"
+#include "dawn/native/vulkan/DeviceVk.h"
+#include "dawn/native/vulkan/FencedDeleter.h"
+#include "dawn/native/vulkan/StagingBufferVk.h"
+#include "dawn/native/vulkan/TextureVk.h"
+#include "dawn/native/vulkan/UtilsVulkan.h"
+#include "dawn/native/vulkan/VulkanError.h"
+
+#include <algorithm>
+
+namespace dawn::native::vulkan {
+
+    TransferQueue::TransferQueue(Device* device, uint32_t queueFamily)
+        : mDevice(device),
+          mQueueFamily(queueFamily),
+          mSharedQueueFamilyIndices({device->GetGraphicsQueueFamily(), queueFamily}) {
+        device->fn.GetDeviceQueue(device->GetVkDevice(), mQueueFamily, 0, &mQueue);
+    }
+
+    TransferQueue::~TransferQueue() {
+        // This is only destroyed with the device, when the GPU is done with all the uploads, so
+        // the command pools can be destroyed immediately. Uploads that weren't submitted are
+        // discarded like the pending commands of the main queue.
+        if (mRecordingContext.commandPool != VK_NULL_HANDLE) {
+            mUnusedCommands.push_back(
+                {mRecordingContext.commandPool, mRecordingContext.commandBuffer});
+            mRecordingContext = CommandRecordingContext();
+        }
+        for (const CommandPoolAndBuffer& commands : mCommandsInFlight.IterateAll()) {
+            mUnusedCommands.push_back(commands);
+        }
+        mCommandsInFlight.Clear();
+
+        VkDevice vkDevice = mDevice->GetVkDevice();
+        for (const CommandPoolAndBuffer& commands : mUnusedCommands) {
+            // Like for the main queue, free the command buffers before destroying their pool to
+            // avoid leaks in some drivers.
+            mDevice->fn.FreeCommandBuffers(vkDevice, commands.pool, 1, &commands.commandBuffer);
+            mDevice->fn.DestroyCommandPool(vkDevice, commands.pool, nullptr);
+        }
+        mUnusedCommands.clear();
+    }
+
+    const std::array<uint32_t, 2>& TransferQueue::GetSharedQueueFamilyIndices() const {
+        return mSharedQueueFamilyIndices;
+    }
+
+    bool TransferQueue::CanCopyToBuffer(const Buffer* destination) const {
+        // Uploads don't clear the rest of the buffer, it is lazily cleared on the main queue when
+        // it is read.
+        return destination->IsSharedWithTransferQueue() &&
+               destination->GetLastMainQueueUsageSerial() < mDevice->GetPendingCommandSerial();
+    }
+
+    bool TransferQueue::CanCopyToTexture(const Texture* destination,
+                                         const SubresourceRange& range,
+                                         bool isCompleteCopy) const {
+        // Transfer queues can't clear images, and copies to images on queues with a
+        // minImageTransferGranularity other than (1, 1, 1) must cover whole subresources. Copies
+        // of complete subresources handle both cases.
+        return destination->IsSharedWithTransferQueue() &&
+               destination->GetLastMainQueueUsageSerial() < mDevice->GetPendingCommandSerial() &&
+               isCompleteCopy;
+    }
+
+    MaybeError TransferQueue::CopyFromStagingToBuffer(const StagingBuffer* source,
+                                                      uint64_t sourceOffset,
+                                                      Buffer* destination,
+                                                      uint64_t destinationOffset,
+                                                      uint64_t size) {
+        ASSERT(CanCopyToBuffer(destination));
+
+        CommandRecordingContext* recordingContext;
+        DAWN_TRY_ASSIGN(recordingContext,
+                        GetPendingRecordingContext(destination->GetLastMainQueueUsageSerial()));
+
+        destination->EnsureDataInitializedAsDestination(recordingContext, destinationOffset, size);
+
+        destination->TransitionToCopyDstOnTransferQueue(recordingContext);
+
+        VkBufferCopy copy;
+        copy.srcOffset = sourceOffset;
+        copy.dstOffset = destinationOffset;
+        copy.size = size;
+
+        mDevice->fn.CmdCopyBuffer(recordingContext->commandBuffer, source->GetBufferHandle(),
+                                  destination->GetHandle(), 1, &copy);
+        return {};
+    }
+
+    MaybeError TransferQueue::CopyFromStagingToTexture(const StagingBuffer* source,
+                                                       const VkBufferImageCopy& region,
+                                                       Texture* destination,
+                                                       const SubresourceRange& range,
+                                                       bool isCompleteCopy) {
+        ASSERT(CanCopyToTexture(destination, range, isCompleteCopy));
+
+        CommandRecordingContext* recordingContext;
+        DAWN_TRY_ASSIGN(recordingContext,
+                        GetPendingRecordingContext(destination->GetLastMainQueueUsageSerial()));
+
+        // Since texture has been overwritten, it has been "initialized"
+        destination->SetIsSubresourceContentInitialized(true, range);
+        destination->TransitionToCopyDstOnTransferQueue(recordingContext, range);
+
+        mDevice->fn.CmdCopyBufferToImage(recordingContext->commandBuffer,
+                                         source->GetBufferHandle(), destination->GetHandle(),
+                                         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+        return {};
+    }
+
+    ResultOrError<VkSemaphore> TransferQueue::SubmitPendingCommands(
+        VkSemaphore mainTimelineSemaphore) {
+        if (!mRecordingContext.used) {
+            return VkSemaphore(VK_NULL_HANDLE);
+        }
+
+        VkDevice vkDevice = mDevice->GetVkDevice();
+        DAWN_TRY(CheckVkSuccess(mDevice->fn.EndCommandBuffer(mRecordingContext.commandBuffer),
+                                "vkEndCommandBuffer"));
+
+        VkSemaphoreCreateInfo semaphoreCreateInfo;
+        semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        semaphoreCreateInfo.pNext = nullptr;
+        semaphoreCreateInfo.flags = 0;
+
+        VkSemaphore uploadsDone = VK_NULL_HANDLE;
+        DAWN_TRY(CheckVkSuccess(
+            mDevice->fn.CreateSemaphore(vkDevice, &semaphoreCreateInfo, nullptr, &*uploadsDone),
+            "vkCreateSemaphore"));
+
+        // Wait for the main queue to be done with the destinations of the uploads. Binary
+        // semaphores ignore their value but still need one.
+        uint64_t waitValue = static_cast<uint64_t>(mPendingWaitSerial);
+        uint64_t signalValue = 0;
+        VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+
+        VkTimelineSemaphoreSubmitInfo timelineSubmitInfo;
+        timelineSubmitInfo.waitSemaphoreValueCount = 1;
+        timelineSubmitInfo.pWaitSemaphoreValues = &waitValue;
+        timelineSubmitInfo.signalSemaphoreValueCount = 1;
+        timelineSubmitInfo.pSignalSemaphoreValues = &signalValue;
+
+        VkSubmitInfo submitInfo;
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.pNext = nullptr;
+        submitInfo.waitSemaphoreCount = 1;
+        submitInfo.pWaitSemaphores = &*mainTimelineSemaphore;
+        submitInfo.pWaitDstStageMask = &waitStage;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &mRecordingContext.commandBuffer;
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores = &*uploadsDone;
+        PNextChainBuilder submitInfoChain(&submitInfo);
+        submitInfoChain.Add(&timelineSubmitInfo, VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO);
+
+        DAWN_TRY_WITH_CLEANUP(
+            CheckVkSuccess(mDevice->fn.QueueSubmit(mQueue, 1, &submitInfo, VK_NULL_HANDLE),
+                           "vkQueueSubmit"),
+            { mDevice->fn.DestroySemaphore(vkDevice, uploadsDone, nullptr); });
+
+        // The main queue waits on the uploads so they are complete when its pending serial is.
+        mCommandsInFlight.Enqueue({mRecordingContext.commandPool, mRecordingContext.commandBuffer},
+                                  mDevice->GetPendingCommandSerial());
+        mRecordingContext = CommandRecordingContext();
+        mPendingWaitSerial = ExecutionSerial(0);
+
+        return uploadsDone;
+    }
+
+    bool TransferQueue::HasPendingCommands() const {
+        return mRecordingContext.used;
+    }
+
+    void TransferQueue::Tick(ExecutionSerial completedSerial) {
+        for (const CommandPoolAndBuffer& commands :
+             mCommandsInFlight.IterateUpTo(completedSerial)) {
+            mUnusedCommands.push_back(commands);
+        }
+        mCommandsInFlight.ClearUpTo(completedSerial);
+    }
+
+    void TransferQueue::WaitForIdleForDestruction() {
+        // Ignore the result for the same reasons as the main queue.
+        VkResult waitIdleResult = VkResult::WrapUnsafe(mDevice->fn.QueueWaitIdle(mQueue));
+        DAWN_UNUSED(waitIdleResult);
+    }
+
+    ResultOrError<CommandRecordingContext*> TransferQueue::GetPendingRecordingContext(
+        ExecutionSerial lastMainQueueUsage) {
+        if (mRecordingContext.commandBuffer == VK_NULL_HANDLE) {
+            DAWN_TRY(PrepareRecordingContext());
+        }
+
+        mPendingWaitSerial = std::max(mPendingWaitSerial, lastMainQueueUsage);
+        mRecordingContext.used = true;
+
+        // The main queue must have commands to submit for the pending serial so that the uploads
+        // are submitted, even if they are the only commands.
+        mDevice->GetPendingRecordingContext();
+
+        return &mRecordingContext;
+    }
+
+    MaybeError TransferQueue::PrepareRecordingContext() {
+        ASSERT(mRecordingContext.commandBuffer == VK_NULL_HANDLE);
+        VkDevice vkDevice = mDevice->GetVkDevice();
+
+        if (!mUnusedCommands.empty()) {
+            CommandPoolAndBuffer commands = mUnusedCommands.back();
+            mUnusedCommands.pop_back();
+            DAWN_TRY_WITH_CLEANUP(
+                CheckVkSuccess(mDevice->fn.ResetCommandPool(vkDevice, commands.pool, 0),
+                               "vkResetCommandPool"),
+                {
+                    mDevice->fn.FreeCommandBuffers(vkDevice, commands.pool, 1,
+                                                   &commands.commandBuffer);
+                    mDevice->fn.DestroyCommandPool(vkDevice, commands.pool, nullptr);
+                });
+
+            mRecordingContext.commandPool = commands.pool;
+            mRecordingContext.commandBuffer = commands.commandBuffer;
+        } else {
+            VkCommandPoolCreateInfo createInfo;
+            createInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+            createInfo.pNext = nullptr;
+            createInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+            createInfo.queueFamilyIndex = mQueueFamily;
+
+            CommandPoolAndBuffer commands;
+            DAWN_TRY(CheckVkSuccess(
+                mDevice->fn.CreateCommandPool(vkDevice, &createInfo, nullptr, &*commands.pool),
+                "vkCreateCommandPool"));
+
+            VkCommandBufferAllocateInfo allocateInfo;
+            allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocateInfo.pNext = nullptr;
+            allocateInfo.commandPool = commands.pool;
+            allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocateInfo.commandBufferCount = 1;
+
+            DAWN_TRY_WITH_CLEANUP(
+                CheckVkSuccess(mDevice->fn.AllocateCommandBuffers(vkDevice, &allocateInfo,
+                                                                  &commands.commandBuffer),
+                               "vkAllocateCommandBuffers"),
+                { mDevice->fn.DestroyCommandPool(vkDevice, commands.pool, nullptr); });
+
+            mRecordingContext.commandPool = commands.pool;
+            mRecordingContext.commandBuffer = commands.commandBuffer;
+        }
+
+        VkCommandBufferBeginInfo beginInfo;
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.pNext = nullptr;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        beginInfo.pInheritanceInfo = nullptr;
+
+        DAWN_TRY_WITH_CLEANUP(
+            CheckVkSuccess(mDevice->fn.BeginCommandBuffer(mRecordingContext.commandBuffer,
+                                                          &beginInfo),
+                           "vkBeginCommandBuffer"),
+            {
+                // Keep the command buffer to be recycled with the pools in the unused list.
+                mUnusedCommands.push_back(
+                    {mRecordingContext.commandPool, mRecordingContext.commandBuffer});
+                mRecordingContext = CommandRecordingContext();
+            });
+
+        return {};
+    }
+
+}  // namespace dawn::native::vulkan
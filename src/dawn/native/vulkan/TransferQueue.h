@@ -0,0 +1,113 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_VULKAN_TRANSFERQUEUE_H_
+#define DAWNNATIVE_VULKAN_TRANSFERQUEUE_H_
+
+#include "dawn/common/SerialQueue.h"
+#include "dawn/common/vulkan_platform.h"
+#include "dawn/native/Error.h"
+#include "dawn/native/IntegerTypes.h"
+#include "dawn/native/vulkan/CommandRecordingContext.h"
+
+#include <array>
+#include <vector>
+
+namespace dawn::native {
+    struct SubresourceRange;
+}  // namespace dawn::native
+
+namespace dawn::native::vulkan {
+
+    class Buffer;
+    class Device;
+    class StagingBuffer;
+    class Texture;
+
+    // A queue of a transfer-only queue family used for the uploads from staging buffers of
+    // Queue::WriteBuffer and Queue::WriteTexture, so that large uploads run while the main queue
+    // renders instead of being serialized with its commands.
+    //
+    // The uploads recorded while the main queue records the commands of a serial are submitted
+    // right before them. The transfer queue waits on the main queue's timeline semaphore for the
+    // last serial that used the destinations of the uploads, and the main queue waits on a binary
+    // semaphore signaled by the uploads. The uploads are complete when the serial is complete.
+    //
+    // The resources that can be uploaded to on the transfer queue are created with
+    // VK_SHARING_MODE_CONCURRENT so that no queue family ownership transfer is needed.
+    class TransferQueue {
+      public:
+        TransferQueue(Device* device, uint32_t queueFamily);
+        ~TransferQueue();
+
+        // The queue family indices of the resources shared between the main queue and the
+        // transfer queue.
+        const std::array<uint32_t, 2>& GetSharedQueueFamilyIndices() const;
+
+        // Whether the upload can be done on the transfer queue. Uploads to resources that are
+        // used by the commands of the main queue for the pending serial must be done on the main
+        // queue because these commands will execute after the uploads of the transfer queue.
+        bool CanCopyToBuffer(const Buffer* destination) const;
+        bool CanCopyToTexture(const Texture* destination,
+                              const SubresourceRange& range,
+                              bool isCompleteCopy) const;
+
+        MaybeError CopyFromStagingToBuffer(const StagingBuffer* source,
+                                           uint64_t sourceOffset,
+                                           Buffer* destination,
+                                           uint64_t destinationOffset,
+                                           uint64_t size);
+        MaybeError CopyFromStagingToTexture(const StagingBuffer* source,
+                                            const VkBufferImageCopy& region,
+                                            Texture* destination,
+                                            const SubresourceRange& range,
+                                            bool isCompleteCopy);
+
+        // Submits the pending uploads and returns the semaphore that the main queue must wait on
+        // before executing the commands of the pending serial, or VK_NULL_HANDLE if there are no
+        // uploads.
+        ResultOrError<VkSemaphore> SubmitPendingCommands(VkSemaphore mainTimelineSemaphore);
+
+        // Whether there are uploads that aren't submitted yet.
+        bool HasPendingCommands() const;
+
+        void Tick(ExecutionSerial completedSerial);
+        void WaitForIdleForDestruction();
+
+      private:
+        ResultOrError<CommandRecordingContext*> GetPendingRecordingContext(
+            ExecutionSerial lastMainQueueUsage);
+        MaybeError PrepareRecordingContext();
+
+        Device* mDevice;
+        uint32_t mQueueFamily;
+        std::array<uint32_t, 2> mSharedQueueFamilyIndices;
+        VkQueue mQueue = VK_NULL_HANDLE;
+
+        CommandRecordingContext mRecordingContext;
+        // The last serial of the main queue that the pending uploads must wait for.
+        ExecutionSerial mPendingWaitSerial = ExecutionSerial(0);
+
+        struct CommandPoolAndBuffer {
+            VkCommandPool pool = VK_NULL_HANDLE;
+            VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+        };
+        SerialQueue<ExecutionSerial, CommandPoolAndBuffer> mCommandsInFlight;
+        // Command pools in the unused list haven't been reset yet.
+        std::vector<CommandPoolAndBuffer> mUnusedCommands;
+    };
+
+}  // namespace dawn::native::vulkan
+
+#endif  // DAWNNATIVE_VULKAN_TRANSFERQUEUE_H_
@@ -24,6 +24,7 @@
 #include "dawn/common/SwapChainUtils.h"
 #include "dawn/native/vulkan/DeviceVk.h"
 #include "dawn/native/vulkan/NativeSwapChainImplVk.h"
+#include "dawn/native/vulkan/ResourceMemoryAllocatorVk.h"
 #include "dawn/native/vulkan/TextureVk.h"
 
 namespace dawn::native::vulkan {
@@ -59,6 +60,22 @@ namespace dawn::native::vulkan {
         return static_cast<WGPUTextureFormat>(impl->GetPreferredFormat());
     }
 
+    std::vector<MemoryHeapInfo> GetMemoryHeapInfos(WGPUDevice device) {
+        Device* backendDevice = ToBackend(FromAPI(device));
+        const std::vector<VkMemoryHeap>& heaps = backendDevice->GetDeviceInfo().memoryHeaps;
+        std::vector<ResourceMemoryAllocator::HeapBudget> budgets =
+            backendDevice->GetResourceMemoryAllocator()->GetHeapBudgets();
+
+        std::vector<MemoryHeapInfo> infos(heaps.size());
+        for (size_t i = 0; i < heaps.size(); ++i) {
+            infos[i].size = heaps[i].size;
+            infos[i].isDeviceLocal = heaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT;
+            infos[i].budget = budgets[i].budget;
+            infos[i].usage = budgets[i].usage;
+        }
+        return infos;
+    }
+
     AdapterDiscoveryOptions::AdapterDiscoveryOptions()
         : AdapterDiscoveryOptionsBase(WGPUBackendType_Vulkan) {
     }
@@ -131,6 +131,9 @@ namespace dawn::native::vulkan {
         //
         {DeviceExt::BindMemory2, "VK_KHR_bind_memory2", VulkanVersion_1_1},
         {DeviceExt::Maintenance1, "VK_KHR_maintenance1", VulkanVersion_1_1},
+        {DeviceExt::Maintenance2, "VK_KHR_maintenance2", VulkanVersion_1_1},
+        {DeviceExt::DescriptorUpdateTemplate, "VK_KHR_descriptor_update_template",
+         VulkanVersion_1_1},
         {DeviceExt::StorageBufferStorageClass, "VK_KHR_storage_buffer_storage_class",
          VulkanVersion_1_1},
         {DeviceExt::GetPhysicalDeviceProperties2, "VK_KHR_get_physical_device_properties2",
@@ -148,6 +151,8 @@ namespace dawn::native::vulkan {
         {DeviceExt::DriverProperties, "VK_KHR_driver_properties", VulkanVersion_1_2},
         {DeviceExt::ImageFormatList, "VK_KHR_image_format_list", VulkanVersion_1_2},
         {DeviceExt::ShaderFloat16Int8, "VK_KHR_shader_float16_int8", VulkanVersion_1_2},
+        {DeviceExt::ImagelessFramebuffer, "VK_KHR_imageless_framebuffer", VulkanVersion_1_2},
+        {DeviceExt::TimelineSemaphore, "VK_KHR_timeline_semaphore", VulkanVersion_1_2},
 
         {DeviceExt::ExternalMemoryFD, "VK_KHR_external_memory_fd", NeverPromoted},
         {DeviceExt::ExternalMemoryDmaBuf, "VK_EXT_external_memory_dma_buf", NeverPromoted},
@@ -156,8 +161,10 @@ namespace dawn::native::vulkan {
         {DeviceExt::ExternalSemaphoreZirconHandle, "VK_FUCHSIA_external_semaphore", NeverPromoted},
 
         {DeviceExt::ImageDrmFormatModifier, "VK_EXT_image_drm_format_modifier", NeverPromoted},
+        {DeviceExt::MemoryBudget, "VK_EXT_memory_budget", NeverPromoted},
         {DeviceExt::Swapchain, "VK_KHR_swapchain", NeverPromoted},
         {DeviceExt::SubgroupSizeControl, "VK_EXT_subgroup_size_control", NeverPromoted},
+        {DeviceExt::Synchronization2, "VK_KHR_synchronization2", NeverPromoted},
         //
     }};
 
@@ -196,8 +203,10 @@ namespace dawn::native::vulkan {
             switch (ext) {
                 // Happy extensions don't need anybody else!
                 case DeviceExt::BindMemory2:
+                case DeviceExt::DescriptorUpdateTemplate:
                 case DeviceExt::GetMemoryRequirements2:
                 case DeviceExt::Maintenance1:
+                case DeviceExt::Maintenance2:
                 case DeviceExt::ImageFormatList:
                 case DeviceExt::StorageBufferStorageClass:
                     hasDependencies = true;
@@ -239,9 +248,16 @@ namespace dawn::native::vulkan {
 
                 case DeviceExt::DriverProperties:
                 case DeviceExt::ShaderFloat16Int8:
+                case DeviceExt::TimelineSemaphore:
                     hasDependencies = HasDep(DeviceExt::GetPhysicalDeviceProperties2);
                     break;
 
+                case DeviceExt::ImagelessFramebuffer:
+                    hasDependencies = HasDep(DeviceExt::GetPhysicalDeviceProperties2) &&
+                                      HasDep(DeviceExt::Maintenance2) &&
+                                      HasDep(DeviceExt::ImageFormatList);
+                    break;
+
                 case DeviceExt::ExternalMemory:
                     hasDependencies = HasDep(DeviceExt::ExternalMemoryCapabilities);
                     break;
@@ -276,6 +292,11 @@ namespace dawn::native::vulkan {
                     hasDependencies = icdVersion >= VulkanVersion_1_1;
                     break;
 
+                case DeviceExt::MemoryBudget:
+                case DeviceExt::Synchronization2:
+                    hasDependencies = HasDep(DeviceExt::GetPhysicalDeviceProperties2);
+                    break;
+
                 case DeviceExt::EnumCount:
                     UNREACHABLE();
             }
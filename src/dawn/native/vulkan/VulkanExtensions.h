@@ -74,6 +74,8 @@ namespace dawn::native::vulkan {
         // Promoted to 1.1
         BindMemory2,
         Maintenance1,
+        Maintenance2,
+        DescriptorUpdateTemplate,
         StorageBufferStorageClass,
         GetPhysicalDeviceProperties2,
         GetMemoryRequirements2,
@@ -88,6 +90,8 @@ namespace dawn::native::vulkan {
         DriverProperties,
         ImageFormatList,
         ShaderFloat16Int8,
+        ImagelessFramebuffer,
+        TimelineSemaphore,
 
         // External* extensions
         ExternalMemoryFD,
@@ -98,8 +102,10 @@ namespace dawn::native::vulkan {
 
         // Others
         ImageDrmFormatModifier,
+        MemoryBudget,
         Swapchain,
         SubgroupSizeControl,
+        Synchronization2,
 
         EnumCount,
     };
@@ -168,6 +168,14 @@ namespace dawn::native::vulkan {
         }                                                                               \
     } while (0)
 
+#define GET_DEVICE_PROC_VENDOR(name, vendor)                                                      \
+    do {                                                                                          \
+        name = reinterpret_cast<decltype(name)>(GetDeviceProcAddr(device, "vk" #name #vendor));   \
+        if (name == nullptr) {                                                                    \
+            return DAWN_INTERNAL_ERROR(std::string("Couldn't get proc vk") + #name #vendor);      \
+        }                                                                                         \
+    } while (0)
+
     MaybeError VulkanFunctions::LoadDeviceProcs(VkDevice device,
                                                 const VulkanDeviceInfo& deviceInfo) {
         GET_DEVICE_PROC(AllocateCommandBuffers);
@@ -300,6 +308,20 @@ namespace dawn::native::vulkan {
             GET_DEVICE_PROC(GetSemaphoreFdKHR);
         }
 
+        if (deviceInfo.HasExt(DeviceExt::TimelineSemaphore)) {
+            if (deviceInfo.properties.apiVersion >= VK_MAKE_VERSION(1, 2, 0)) {
+                GET_DEVICE_PROC(GetSemaphoreCounterValue);
+                GET_DEVICE_PROC(WaitSemaphores);
+            } else {
+                GET_DEVICE_PROC_VENDOR(GetSemaphoreCounterValue, KHR);
+                GET_DEVICE_PROC_VENDOR(WaitSemaphores, KHR);
+            }
+        }
+
+        if (deviceInfo.HasExt(DeviceExt::Synchronization2)) {
+            GET_DEVICE_PROC(CmdPipelineBarrier2KHR);
+        }
+
         if (deviceInfo.HasExt(DeviceExt::Swapchain)) {
             GET_DEVICE_PROC(CreateSwapchainKHR);
             GET_DEVICE_PROC(DestroySwapchainKHR);
@@ -308,6 +330,18 @@ namespace dawn::native::vulkan {
             GET_DEVICE_PROC(QueuePresentKHR);
         }
 
+        if (deviceInfo.HasExt(DeviceExt::DescriptorUpdateTemplate)) {
+            if (deviceInfo.properties.apiVersion >= VK_MAKE_VERSION(1, 1, 0)) {
+                GET_DEVICE_PROC(CreateDescriptorUpdateTemplate);
+                GET_DEVICE_PROC(DestroyDescriptorUpdateTemplate);
+                GET_DEVICE_PROC(UpdateDescriptorSetWithTemplate);
+            } else {
+                GET_DEVICE_PROC_VENDOR(CreateDescriptorUpdateTemplate, KHR);
+                GET_DEVICE_PROC_VENDOR(DestroyDescriptorUpdateTemplate, KHR);
+                GET_DEVICE_PROC_VENDOR(UpdateDescriptorSetWithTemplate, KHR);
+            }
+        }
+
         if (deviceInfo.HasExt(DeviceExt::GetMemoryRequirements2)) {
             GET_DEVICE_PROC(GetBufferMemoryRequirements2);
             GET_DEVICE_PROC(GetImageMemoryRequirements2);
@@ -275,11 +275,23 @@ namespace dawn::native::vulkan {
         PFN_vkImportSemaphoreFdKHR ImportSemaphoreFdKHR = nullptr;
         PFN_vkGetSemaphoreFdKHR GetSemaphoreFdKHR = nullptr;
 
+        // VK_KHR_descriptor_update_template
+        PFN_vkCreateDescriptorUpdateTemplateKHR CreateDescriptorUpdateTemplate = nullptr;
+        PFN_vkDestroyDescriptorUpdateTemplateKHR DestroyDescriptorUpdateTemplate = nullptr;
+        PFN_vkUpdateDescriptorSetWithTemplateKHR UpdateDescriptorSetWithTemplate = nullptr;
+
         // VK_KHR_get_memory_requirements2
         PFN_vkGetBufferMemoryRequirements2KHR GetBufferMemoryRequirements2 = nullptr;
         PFN_vkGetImageMemoryRequirements2KHR GetImageMemoryRequirements2 = nullptr;
         PFN_vkGetImageSparseMemoryRequirements2KHR GetImageSparseMemoryRequirements2 = nullptr;
 
+        // VK_KHR_timeline_semaphore
+        PFN_vkGetSemaphoreCounterValueKHR GetSemaphoreCounterValue = nullptr;
+        PFN_vkWaitSemaphoresKHR WaitSemaphores = nullptr;
+
+        // VK_KHR_synchronization2
+        PFN_vkCmdPipelineBarrier2KHR CmdPipelineBarrier2KHR = nullptr;
+
         // VK_KHR_swapchain
         PFN_vkCreateSwapchainKHR CreateSwapchainKHR = nullptr;
         PFN_vkDestroySwapchainKHR DestroySwapchainKHR = nullptr;
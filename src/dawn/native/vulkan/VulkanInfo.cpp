@@ -245,6 +245,21 @@ namespace dawn::native::vulkan {
                 VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_SIZE_CONTROL_PROPERTIES_EXT);
         }
 
+        if (info.extensions[DeviceExt::ImagelessFramebuffer]) {
+            featuresChain.Add(&info.imagelessFramebufferFeatures,
+                              VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_IMAGELESS_FRAMEBUFFER_FEATURES);
+        }
+
+        if (info.extensions[DeviceExt::TimelineSemaphore]) {
+            featuresChain.Add(&info.timelineSemaphoreFeatures,
+                              VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES);
+        }
+
+        if (info.extensions[DeviceExt::Synchronization2]) {
+            featuresChain.Add(&info.synchronization2Features,
+                              VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES_KHR);
+        }
+
         if (info.extensions[DeviceExt::DriverProperties]) {
             propertiesChain.Add(&info.driverProperties,
                                 VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DRIVER_PROPERTIES);
@@ -51,6 +51,9 @@ namespace dawn::native::vulkan {
         VkPhysicalDeviceShaderFloat16Int8FeaturesKHR shaderFloat16Int8Features;
         VkPhysicalDevice16BitStorageFeaturesKHR _16BitStorageFeatures;
         VkPhysicalDeviceSubgroupSizeControlFeaturesEXT subgroupSizeControlFeatures;
+        VkPhysicalDeviceImagelessFramebufferFeaturesKHR imagelessFramebufferFeatures;
+        VkPhysicalDeviceTimelineSemaphoreFeaturesKHR timelineSemaphoreFeatures;
+        VkPhysicalDeviceSynchronization2FeaturesKHR synchronization2Features;
 
         bool HasExt(DeviceExt ext) const;
         DeviceExtSet extensions;
@@ -0,0 +1,507 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/platform/FileCachingInterface.h"
+
+#include "dawn/common/Assert.h"
+#include "dawn/common/Platform.h"
+#include "dawn/common/SystemUtils.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#if defined(DAWN_PLATFORM_WINDOWS)
+#    include "dawn/common/windows_with_undefs.h"
+
+#    include <io.h>
+#elif defined(DAWN_PLATFORM_POSIX)
+#    include <dirent.h>
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#else
+#    error "Unsupported platform."
+#endif
+
+namespace dawn::platform {
+
+    namespace {
+
+        constexpr char kIndexFileName[] = "index";
+        constexpr char kIndexMagic[8] = {'D', 'A', 'W', 'N', 'F', 'C', 'I', '1'};
+        constexpr char kTemporarySuffix[] = ".tmp";
+
+        // 64-bit FNV-1a. Only used to name files, collisions are detected by comparing contents.
+        uint64_t HashBytes(const void* data, size_t size) {
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            uint64_t hash = 0xcbf29ce484222325ull;
+            for (size_t i = 0; i < size; ++i) {
+                hash ^= bytes[i];
+                hash *= 0x100000001b3ull;
+            }
+            return hash;
+        }
+
+        std::string ToHex(uint64_t value) {
+            char buffer[17];
+            snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(value));
+            return buffer;
+        }
+
+        std::string GetBlobName(const void* value, uint64_t size) {
+            return ToHex(HashBytes(value, size)) + "-" + ToHex(size);
+        }
+
+        // Blob names come from the index on disk and are used as paths, only accept the names
+        // produced by GetBlobName for a value of |size| bytes.
+        bool IsValidBlobName(const std::string& blobName, uint64_t size) {
+            constexpr size_t kHexLength = 16;
+            if (blobName.size() != 2 * kHexLength + 1 || blobName[kHexLength] != '-') {
+                return false;
+            }
+            for (size_t i = 0; i < kHexLength; ++i) {
+                char c = blobName[i];
+                if (!(c >= '0' && c <= '9') && !(c >= 'a' && c <= 'f')) {
+                    return false;
+                }
+            }
+            return blobName.compare(kHexLength + 1, kHexLength, ToHex(size)) == 0;
+        }
+
+        bool CreateDirectoryIfMissing(const std::string& path) {
+#if defined(DAWN_PLATFORM_WINDOWS)
+            return CreateDirectoryA(path.c_str(), nullptr) ||
+                   GetLastError() == ERROR_ALREADY_EXISTS;
+#else
+            return mkdir(path.c_str(), 0755) == 0 || errno == EEXIST;
+#endif
+        }
+
+        void RemoveFile(const std::string& path) {
+            std::remove(path.c_str());
+        }
+
+        std::vector<std::string> ListFiles(const std::string& directory) {
+            std::vector<std::string> files;
+#if defined(DAWN_PLATFORM_WINDOWS)
+            WIN32_FIND_DATAA findData;
+            HANDLE handle = FindFirstFileA((directory + "\\*").c_str(), &findData);
+            if (handle == INVALID_HANDLE_VALUE) {
+                return files;
+            }
+            do {
+                if ((findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == 0) {
+                    files.push_back(findData.cFileName);
+                }
+            } while (FindNextFileA(handle, &findData));
+            FindClose(handle);
+#else
+            DIR* dir = opendir(directory.c_str());
+            if (dir == nullptr) {
+                return files;
+            }
+            while (dirent* entry = readdir(dir)) {
+                if (entry->d_name[0] != '.') {
+                    files.push_back(entry->d_name);
+                }
+            }
+            closedir(dir);
+#endif
+            return files;
+        }
+
+        // Writes |data| to a temporary file, flushes it to the disk and renames it to |path| so
+        // that |path| either has its previous content or the complete new one.
+        bool WriteFileAtomically(const std::string& path, const void* data, size_t size) {
+            std::string temporaryPath = path + kTemporarySuffix;
+            FILE* file = fopen(temporaryPath.c_str(), "wb");
+            if (file == nullptr) {
+                return false;
+            }
+            bool success = fwrite(data, 1, size, file) == size && fflush(file) == 0;
+#if defined(DAWN_PLATFORM_WINDOWS)
+            success = success && _commit(_fileno(file)) == 0;
+#else
+            success = success && fsync(fileno(file)) == 0;
+#endif
+            success = fclose(file) == 0 && success;
+
+#if defined(DAWN_PLATFORM_WINDOWS)
+            success = success && MoveFileExA(temporaryPath.c_str(), path.c_str(),
+                                             MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+#else
+            success = success && rename(temporaryPath.c_str(), path.c_str()) == 0;
+#endif
+            if (!success) {
+                RemoveFile(temporaryPath);
+            }
+            return success;
+        }
+
+        // A read-only memory mapping of a whole file.
+        class MappedFile {
+          public:
+            static std::unique_ptr<MappedFile> Open(const std::string& path) {
+                std::unique_ptr<MappedFile> mapped(new MappedFile());
+#if defined(DAWN_PLATFORM_WINDOWS)
+                HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                          OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+                if (file == INVALID_HANDLE_VALUE) {
+                    return nullptr;
+                }
+                LARGE_INTEGER size;
+                if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+                    CloseHandle(file);
+                    return nullptr;
+                }
+                HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                CloseHandle(file);
+                if (mapping == nullptr) {
+                    return nullptr;
+                }
+                mapped->mData = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                CloseHandle(mapping);
+                if (mapped->mData == nullptr) {
+                    return nullptr;
+                }
+                mapped->mSize = static_cast<size_t>(size.QuadPart);
+#else
+                int fd = open(path.c_str(), O_RDONLY);
+                if (fd < 0) {
+                    return nullptr;
+                }
+                struct stat fileStat;
+                if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0) {
+                    close(fd);
+                    return nullptr;
+                }
+                void* data =
+                    mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE,
+                         fd, 0);
+                close(fd);
+                if (data == MAP_FAILED) {
+                    return nullptr;
+                }
+                mapped->mData = data;
+                mapped->mSize = static_cast<size_t>(fileStat.st_size);
+#endif
+                return mapped;
+            }
+
+            ~MappedFile() {
+                if (mData == nullptr) {
+                    return;
+                }
+#if defined(DAWN_PLATFORM_WINDOWS)
+                UnmapViewOfFile(mData);
+#else
+                munmap(mData, mSize);
+#endif
+            }
+
+            const uint8_t* GetData() const {
+                return static_cast<const uint8_t*>(mData);
+            }
+            size_t GetSize() const {
+                return mSize;
+            }
+
+          private:
+            MappedFile() = default;
+
+            void* mData = nullptr;
+            size_t mSize = 0;
+        };
+
+        // Helpers to (de)serialize the index.
+        void WriteU64(std::vector<uint8_t>* out, uint64_t value) {
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+            out->insert(out->end(), bytes, bytes + sizeof(value));
+        }
+
+        void WriteString(std::vector<uint8_t>* out, const std::string& value) {
+            WriteU64(out, value.size());
+            out->insert(out->end(), value.begin(), value.end());
+        }
+
+        class IndexReader {
+          public:
+            IndexReader(const uint8_t* data, size_t size) : mData(data), mRemaining(size) {
+            }
+
+            bool ReadBytes(void* out, size_t size) {
+                if (size > mRemaining) {
+                    return false;
+                }
+                memcpy(out, mData, size);
+                mData += size;
+                mRemaining -= size;
+                return true;
+            }
+
+            bool ReadU64(uint64_t* value) {
+                return ReadBytes(value, sizeof(*value));
+            }
+
+            bool ReadString(std::string* value) {
+                uint64_t size;
+                if (!ReadU64(&size) || size > mRemaining) {
+                    return false;
+                }
+                value->assign(reinterpret_cast<const char*>(mData), static_cast<size_t>(size));
+                mData += size;
+                mRemaining -= static_cast<size_t>(size);
+                return true;
+            }
+
+          private:
+            const uint8_t* mData;
+            size_t mRemaining;
+        };
+
+    }  // anonymous namespace
+
+    // static
+    std::unique_ptr<FileCachingInterface> FileCachingInterface::Create(
+        const std::string& directory,
+        uint64_t maxSizeInBytes,
+        const void* fingerprint,
+        size_t fingerprintSize) {
+        std::string isolatedDirectory =
+            directory + GetPathSeparator() + ToHex(HashBytes(fingerprint, fingerprintSize));
+        if (!CreateDirectoryIfMissing(directory) || !CreateDirectoryIfMissing(isolatedDirectory)) {
+            return nullptr;
+        }
+
+        std::unique_ptr<FileCachingInterface> cache(
+            new FileCachingInterface(std::move(isolatedDirectory), maxSizeInBytes));
+        cache->ReadIndex();
+        cache->RemoveUnreferencedFiles();
+        return cache;
+    }
+
+    FileCachingInterface::FileCachingInterface(std::string directory, uint64_t maxSizeInBytes)
+        : mDirectory(std::move(directory)), mMaxSizeInBytes(maxSizeInBytes) {
+    }
+
+    FileCachingInterface::~FileCachingInterface() {
+        // Persist the entries and their recency since the index was last written.
+        if (mIndexIsDirty) {
+            WriteIndex();
+        }
+    }
+
+    size_t FileCachingInterface::LoadData(const WGPUDevice device,
+                                          const void* key,
+                                          size_t keySize,
+                                          void* valueOut,
+                                          size_t valueSize) {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        auto iter = mEntriesByKey.find(std::string(static_cast<const char*>(key), keySize));
+        if (iter == mEntriesByKey.end()) {
+            return 0;
+        }
+        LRUList::iterator entry = iter->second;
+
+        // Check the file in the size query as well so that callers don't allocate for a value
+        // that can't be read.
+        std::unique_ptr<MappedFile> blob = MappedFile::Open(GetPath(entry->blobName));
+        if (blob == nullptr || blob->GetSize() != entry->size) {
+            // The file was removed or modified behind our back, forget about it.
+            RemoveEntry(entry);
+            mIndexIsDirty = true;
+            return 0;
+        }
+
+        // Only the query mode was used, the value is read on the second call.
+        if (valueOut == nullptr) {
+            ASSERT(valueSize == 0);
+            return blob->GetSize();
+        }
+
+        // Partial values are useless to the callers, only copy the whole value.
+        if (valueSize != blob->GetSize()) {
+            return 0;
+        }
+
+        memcpy(valueOut, blob->GetData(), valueSize);
+        Touch(entry);
+        return valueSize;
+    }
+
+    void FileCachingInterface::StoreData(const WGPUDevice device,
+                                         const void* key,
+                                         size_t keySize,
+                                         const void* value,
+                                         size_t valueSize) {
+        if (valueSize == 0 || valueSize > mMaxSizeInBytes) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        std::string keyString(static_cast<const char*>(key), keySize);
+        auto iter = mEntriesByKey.find(keyString);
+        if (iter != mEntriesByKey.end()) {
+            RemoveEntry(iter->second);
+        }
+
+        std::string blobName = GetBlobName(value, valueSize);
+        if (mBlobRefCounts.count(blobName) != 0) {
+            // Another key already stores a value with the same name, make sure it is the same
+            // content and not a hash collision.
+            std::unique_ptr<MappedFile> blob = MappedFile::Open(GetPath(blobName));
+            if (blob == nullptr || blob->GetSize() != valueSize ||
+                memcmp(blob->GetData(), value, valueSize) != 0) {
+                mIndexIsDirty = true;
+                return;
+            }
+        } else {
+            // Make room for the new value.
+            while (!mEntries.empty() && mTotalSize + valueSize > mMaxSizeInBytes) {
+                RemoveEntry(mEntries.begin());
+            }
+            if (!WriteFileAtomically(GetPath(blobName), value, valueSize)) {
+                mIndexIsDirty = true;
+                return;
+            }
+        }
+
+        AddEntry({std::move(keyString), std::move(blobName), valueSize});
+        mIndexIsDirty = true;
+    }
+
+    void FileCachingInterface::Flush() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mIndexIsDirty) {
+            WriteIndex();
+        }
+    }
+
+    uint64_t FileCachingInterface::GetTotalSizeForTesting() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mTotalSize;
+    }
+
+    const std::string& FileCachingInterface::GetDirectoryForTesting() const {
+        return mDirectory;
+    }
+
+    void FileCachingInterface::ReadIndex() {
+        std::unique_ptr<MappedFile> index = MappedFile::Open(GetPath(kIndexFileName));
+        if (index == nullptr) {
+            return;
+        }
+
+        IndexReader reader(index->GetData(), index->GetSize());
+        char magic[sizeof(kIndexMagic)];
+        uint64_t entryCount;
+        if (!reader.ReadBytes(magic, sizeof(magic)) ||
+            memcmp(magic, kIndexMagic, sizeof(magic)) != 0 || !reader.ReadU64(&entryCount)) {
+            return;
+        }
+
+        // Entries are stored from least to most recently used. A truncated or corrupted index
+        // keeps the entries that could be read.
+        for (uint64_t i = 0; i < entryCount; ++i) {
+            Entry entry;
+            if (!reader.ReadString(&entry.key) || !reader.ReadString(&entry.blobName) ||
+                !reader.ReadU64(&entry.size)) {
+                break;
+            }
+            if (mEntriesByKey.count(entry.key) != 0 ||
+                !IsValidBlobName(entry.blobName, entry.size)) {
+                mIndexIsDirty = true;
+                continue;
+            }
+            AddEntry(std::move(entry));
+        }
+
+        // The size limit might have been lowered since the index was written.
+        while (!mEntries.empty() && mTotalSize > mMaxSizeInBytes) {
+            RemoveEntry(mEntries.begin());
+            mIndexIsDirty = true;
+        }
+    }
+
+    void FileCachingInterface::WriteIndex() {
+        std::vector<uint8_t> data(kIndexMagic, kIndexMagic + sizeof(kIndexMagic));
+        WriteU64(&data, mEntries.size());
+        for (const Entry& entry : mEntries) {
+            WriteString(&data, entry.key);
+            WriteString(&data, entry.blobName);
+            WriteU64(&data, entry.size);
+        }
+
+        mIndexIsDirty = !WriteFileAtomically(GetPath(kIndexFileName), data.data(), data.size());
+    }
+
+    void FileCachingInterface::RemoveUnreferencedFiles() {
+        // Removes the leftovers of a crash: temporary files and values stored just before it,
+        // that didn't make it into the index.
+        for (const std::string& file : ListFiles(mDirectory)) {
+            if (file != kIndexFileName && mBlobRefCounts.count(file) == 0) {
+                RemoveFile(GetPath(file));
+            }
+        }
+    }
+
+    void FileCachingInterface::AddEntry(Entry entry) {
+        uint32_t& refCount = mBlobRefCounts[entry.blobName];
+        if (refCount == 0) {
+            mTotalSize += entry.size;
+        }
+        refCount++;
+
+        std::string key = entry.key;
+        mEntries.push_back(std::move(entry));
+        mEntriesByKey[std::move(key)] = std::prev(mEntries.end());
+    }
+
+    void FileCachingInterface::RemoveEntry(LRUList::iterator entry) {
+        auto refCount = mBlobRefCounts.find(entry->blobName);
+        ASSERT(refCount != mBlobRefCounts.end() && refCount->second > 0);
+        if (--refCount->second == 0) {
+            mBlobRefCounts.erase(refCount);
+            mTotalSize -= entry->size;
+            RemoveFile(GetPath(entry->blobName));
+        }
+
+        mEntriesByKey.erase(entry->key);
+        mEntries.erase(entry);
+    }
+
+    void FileCachingInterface::Touch(LRUList::iterator entry) {
+        mEntries.splice(mEntries.end(), mEntries, entry);
+        mIndexIsDirty = true;
+    }
+
+    std::string FileCachingInterface::GetPath(const std::string& fileName) const {
+        return mDirectory + GetPathSeparator() + fileName;
+    }
+
+    std::unique_ptr<CachingInterface> CreateFileCachingInterface(const char* directory,
+                                                                 uint64_t maxSizeInBytes,
+                                                                 const void* fingerprint,
+                                                                 size_t fingerprintSize) {
+        return FileCachingInterface::Create(directory, maxSizeInBytes, fingerprint,
+                                            fingerprintSize);
+    }
+
+}  // namespace dawn::platform
@@ -0,0 +1,104 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNPLATFORM_FILECACHINGINTERFACE_H_
+#define DAWNPLATFORM_FILECACHINGINTERFACE_H_
+
+#include "dawn/platform/DawnPlatform.h"
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace dawn::platform {
+
+    // A CachingInterface that persists its entries in a directory on disk. It is meant to be used
+    // by a single process at a time.
+    //
+    // Each fingerprint gets its own subdirectory which contains:
+    //  - One file per value, named after the hash and size of its content so that identical
+    //    values stored under different keys share the file.
+    //  - An "index" file mapping the keys to the value files, in least recently used order.
+    //
+    // Files are written to a temporary file and renamed in place so that a crash never leaves a
+    // truncated value or index behind. The index is only written by Flush() and on destruction,
+    // so that storing a value doesn't rewrite it; values stored since the last write of the index
+    // are lost if the process crashes. Values are read by memory-mapping their file and copying
+    // directly into the caller's buffer. When storing a value would make the total size of the
+    // values go over the size limit, the least recently used entries are evicted.
+    class FileCachingInterface final : public CachingInterface {
+      public:
+        // Returns nullptr if the cache directory can't be created.
+        static std::unique_ptr<FileCachingInterface> Create(const std::string& directory,
+                                                            uint64_t maxSizeInBytes,
+                                                            const void* fingerprint,
+                                                            size_t fingerprintSize);
+        ~FileCachingInterface() override;
+
+        size_t LoadData(const WGPUDevice device,
+                        const void* key,
+                        size_t keySize,
+                        void* valueOut,
+                        size_t valueSize) override;
+        void StoreData(const WGPUDevice device,
+                       const void* key,
+                       size_t keySize,
+                       const void* value,
+                       size_t valueSize) override;
+
+        // Writes the index if it changed since it was last written. Embedders can call it when
+        // idle to bound what a crash loses.
+        void Flush();
+
+        uint64_t GetTotalSizeForTesting();
+        // The subdirectory of the fingerprint, that contains the index and values.
+        const std::string& GetDirectoryForTesting() const;
+
+      private:
+        struct Entry {
+            std::string key;
+            std::string blobName;
+            uint64_t size;
+        };
+        using LRUList = std::list<Entry>;
+
+        FileCachingInterface(std::string directory, uint64_t maxSizeInBytes);
+
+        void ReadIndex();
+        void WriteIndex();
+        void RemoveUnreferencedFiles();
+
+        void AddEntry(Entry entry);
+        void RemoveEntry(LRUList::iterator entry);
+        void Touch(LRUList::iterator entry);
+
+        std::string GetPath(const std::string& fileName) const;
+
+        const std::string mDirectory;
+        const uint64_t mMaxSizeInBytes;
+
+        std::mutex mMutex;
+        // Entries ordered from least to most recently used.
+        LRUList mEntries;
+        std::unordered_map<std::string, LRUList::iterator> mEntriesByKey;
+        // The number of entries referencing each value file.
+        std::unordered_map<std::string, uint32_t> mBlobRefCounts;
+        uint64_t mTotalSize = 0;
+        bool mIndexIsDirty = false;
+    };
+
+}  // namespace dawn::platform
+
+#endif  // DAWNPLATFORM_FILECACHINGINTERFACE_H_
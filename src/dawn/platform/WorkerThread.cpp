@@ -14,14 +14,20 @@
 
 #include "dawn/platform/WorkerThread.h"
 
+#include <algorithm>
+#include <chrono>
 #include <condition_variable>
-#include <functional>
 #include <thread>
 
 #include "dawn/common/Assert.h"
 
 namespace {
 
+    // Set on the threads of an AsyncWorkerThreadPool. PostWorkerTask uses it to queue tasks posted
+    // from a worker on that worker, and waits on a worker help run the pool's tasks.
+    thread_local dawn::platform::AsyncWorkerThreadPool* tCurrentPool = nullptr;
+    thread_local uint32_t tCurrentWorkerIndex = 0;
+
     class AsyncWaitableEventImpl {
       public:
         AsyncWaitableEventImpl() : mIsComplete(false) {
@@ -32,6 +38,12 @@ namespace {
             mCondition.wait(lock, [this] { return mIsComplete; });
         }
 
+        template <typename Duration>
+        void WaitFor(Duration duration) {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCondition.wait_for(lock, duration, [this] { return mIsComplete; });
+        }
+
         bool IsComplete() {
             std::lock_guard<std::mutex> lock(mMutex);
             return mIsComplete;
@@ -58,7 +70,19 @@ namespace {
         }
 
         void Wait() override {
-            mWaitableEventImpl->Wait();
+            if (tCurrentPool == nullptr) {
+                mWaitableEventImpl->Wait();
+                return;
+            }
+
+            // Blocking a worker on a task that may be queued behind it could deadlock the pool, so
+            // run other tasks while waiting. The timeout covers the task being run by another
+            // worker while there is nothing left to help with.
+            while (!mWaitableEventImpl->IsComplete()) {
+                if (!tCurrentPool->TryRunOneTask()) {
+                    mWaitableEventImpl->WaitFor(std::chrono::milliseconds(1));
+                }
+            }
         }
 
         bool IsComplete() override {
@@ -77,21 +101,139 @@ namespace {
 
 namespace dawn::platform {
 
+    struct AsyncWorkerThreadPool::Task {
+        dawn::platform::PostWorkerTaskCallback callback = nullptr;
+        void* userdata = nullptr;
+        std::shared_ptr<AsyncWaitableEventImpl> waitableEventImpl;
+    };
+
+    struct AsyncWorkerThreadPool::Worker {
+        std::mutex mutex;
+        // Indexed by WorkerTaskPriority.
+        std::deque<Task> queues[2];
+    };
+
+    AsyncWorkerThreadPool::AsyncWorkerThreadPool(uint32_t threadCount)
+        : mThreadCount(threadCount != 0 ? threadCount
+                                        : std::max(1u, std::thread::hardware_concurrency())) {
+        mWorkers.reserve(mThreadCount);
+        for (uint32_t i = 0; i < mThreadCount; ++i) {
+            mWorkers.push_back(std::make_unique<Worker>());
+        }
+    }
+
+    AsyncWorkerThreadPool::~AsyncWorkerThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mSleepMutex);
+            mIsShuttingDown = true;
+        }
+        mWakeUpCondition.notify_all();
+
+        // The workers drain all the queued tasks before exiting so that nobody waits forever on
+        // the WaitableEvent of a task that was posted but never run.
+        for (std::thread& thread : mThreads) {
+            thread.join();
+        }
+    }
+
+    uint32_t AsyncWorkerThreadPool::GetThreadCount() const {
+        return mThreadCount;
+    }
+
     std::unique_ptr<dawn::platform::WaitableEvent> AsyncWorkerThreadPool::PostWorkerTask(
         dawn::platform::PostWorkerTaskCallback callback,
         void* userdata) {
-        std::unique_ptr<AsyncWaitableEvent> waitableEvent = std::make_unique<AsyncWaitableEvent>();
+        return PostWorkerTask(callback, userdata, WorkerTaskPriority::Normal);
+    }
 
-        std::function<void()> doTask =
-            [callback, userdata, waitableEventImpl = waitableEvent->GetWaitableEventImpl()]() {
-                callback(userdata);
-                waitableEventImpl->MarkAsComplete();
-            };
+    std::unique_ptr<dawn::platform::WaitableEvent> AsyncWorkerThreadPool::PostWorkerTask(
+        dawn::platform::PostWorkerTaskCallback callback,
+        void* userdata,
+        WorkerTaskPriority priority) {
+        EnsureThreadsStarted();
+
+        std::unique_ptr<AsyncWaitableEvent> waitableEvent = std::make_unique<AsyncWaitableEvent>();
 
-        std::thread thread(doTask);
-        thread.detach();
+        Task task;
+        task.callback = callback;
+        task.userdata = userdata;
+        task.waitableEventImpl = waitableEvent->GetWaitableEventImpl();
+
+        uint32_t workerIndex = tCurrentPool == this
+                                   ? tCurrentWorkerIndex
+                                   : mNextWorker.fetch_add(1, std::memory_order_relaxed) %
+                                         mThreadCount;
+        // Count the task before publishing it: a worker can pop it as soon as it is in the queue
+        // and the count must not go below zero when it is decremented.
+        {
+            std::lock_guard<std::mutex> lock(mSleepMutex);
+            mQueuedTaskCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        {
+            Worker* worker = mWorkers[workerIndex].get();
+            std::lock_guard<std::mutex> lock(worker->mutex);
+            worker->queues[static_cast<size_t>(priority)].push_back(std::move(task));
+        }
+        mWakeUpCondition.notify_one();
 
         return waitableEvent;
     }
 
+    void AsyncWorkerThreadPool::EnsureThreadsStarted() {
+        std::call_once(mThreadsStarted, [this]() {
+            mThreads.reserve(mThreadCount);
+            for (uint32_t i = 0; i < mThreadCount; ++i) {
+                mThreads.emplace_back(&AsyncWorkerThreadPool::WorkerLoop, this, i);
+            }
+        });
+    }
+
+    bool AsyncWorkerThreadPool::TryPopTask(uint32_t workerIndex, Task* task) {
+        // Look at the high priority tasks of every worker before any normal priority task, own
+        // queue first and then steal from the next workers in order.
+        for (size_t priority = 0; priority < 2; ++priority) {
+            for (uint32_t i = 0; i < mThreadCount; ++i) {
+                Worker* worker = mWorkers[(workerIndex + i) % mThreadCount].get();
+                std::lock_guard<std::mutex> lock(worker->mutex);
+                std::deque<Task>& queue = worker->queues[priority];
+                if (!queue.empty()) {
+                    *task = std::move(queue.front());
+                    queue.pop_front();
+                    mQueuedTaskCount.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    bool AsyncWorkerThreadPool::TryRunOneTask() {
+        Task task;
+        if (!TryPopTask(tCurrentPool == this ? tCurrentWorkerIndex : 0, &task)) {
+            return false;
+        }
+        task.callback(task.userdata);
+        task.waitableEventImpl->MarkAsComplete();
+        return true;
+    }
+
+    void AsyncWorkerThreadPool::WorkerLoop(uint32_t workerIndex) {
+        tCurrentPool = this;
+        tCurrentWorkerIndex = workerIndex;
+
+        while (true) {
+            if (TryRunOneTask()) {
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(mSleepMutex);
+            mWakeUpCondition.wait(lock, [this] {
+                return mIsShuttingDown || mQueuedTaskCount.load(std::memory_order_relaxed) > 0;
+            });
+            if (mIsShuttingDown && mQueuedTaskCount.load(std::memory_order_relaxed) == 0) {
+                return;
+            }
+        }
+    }
+
 }  // namespace dawn::platform
@@ -18,13 +18,71 @@
 #include "dawn/common/NonCopyable.h"
 #include "dawn/platform/DawnPlatform.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 namespace dawn::platform {
 
+    // A hint for the order in which queued tasks are picked up. High priority tasks are run
+    // before any queued Normal priority task, but running tasks are never preempted.
+    enum class WorkerTaskPriority {
+        High,
+        Normal,
+    };
+
+    // A persistent pool of worker threads. Each worker owns a queue of tasks; tasks posted from
+    // outside the pool are distributed round-robin over the workers, while tasks posted from
+    // inside a worker go to that worker's own queue. An idle worker steals from the other workers
+    // before going to sleep so that a burst of tasks posted to a single queue still spreads over
+    // all the threads. The threads are only started on the first posted task.
     class AsyncWorkerThreadPool : public dawn::platform::WorkerTaskPool, public NonCopyable {
       public:
+        // A |threadCount| of 0 creates one worker per hardware thread.
+        explicit AsyncWorkerThreadPool(uint32_t threadCount = 0);
+        ~AsyncWorkerThreadPool() override;
+
         std::unique_ptr<dawn::platform::WaitableEvent> PostWorkerTask(
             dawn::platform::PostWorkerTaskCallback callback,
             void* userdata) override;
+        std::unique_ptr<dawn::platform::WaitableEvent> PostWorkerTask(
+            dawn::platform::PostWorkerTaskCallback callback,
+            void* userdata,
+            WorkerTaskPriority priority);
+
+        // Runs one queued task on the calling thread if there is any. Returns false if all the
+        // queues were empty.
+        bool TryRunOneTask();
+
+        uint32_t GetThreadCount() const;
+
+      private:
+        struct Task;
+        struct Worker;
+
+        void EnsureThreadsStarted();
+        void WorkerLoop(uint32_t workerIndex);
+        bool TryPopTask(uint32_t workerIndex, Task* task);
+
+        const uint32_t mThreadCount;
+        std::vector<std::unique_ptr<Worker>> mWorkers;
+        std::vector<std::thread> mThreads;
+        std::once_flag mThreadsStarted;
+        std::atomic<uint32_t> mNextWorker = {0};
+
+        // Protects the sleep/wake-up of the workers. mQueuedTaskCount is only incremented with
+        // the lock held so that a worker can't miss a wake-up between checking the count and
+        // waiting on the condition. It is incremented before the task is pushed, so it can be
+        // briefly larger than the number of tasks in the queues but never smaller.
+        std::mutex mSleepMutex;
+        std::condition_variable mWakeUpCondition;
+        std::atomic<uint64_t> mQueuedTaskCount = {0};
+        bool mIsShuttingDown = false;
     };
 
 }  // namespace dawn::platform
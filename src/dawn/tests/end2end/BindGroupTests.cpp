@@ -1648,6 +1648,74 @@ TEST_P(BindGroupTests, CreateWithDestroyedResource) {
     }
 }
 
+// Test that bind groups are written correctly when many of them are created before the submit
+// using them, including some whose layout or resources are released in between. Backends like
+// Vulkan defer writing the bind groups until the next submit.
+TEST_P(BindGroupTests, ManyBindGroupsCreatedBeforeSubmit) {
+    wgpu::ComputePipelineDescriptor pipelineDesc;
+    pipelineDesc.compute.entryPoint = "main";
+    pipelineDesc.compute.module = utils::CreateShaderModule(device, R"(
+        struct Data {
+            value : u32;
+        };
+        @group(0) @binding(0) var<uniform> src : Data;
+        @group(0) @binding(1) var<storage, read_write> dst : Data;
+
+        @stage(compute) @workgroup_size(1) fn main() {
+            dst.value = src.value;
+        })");
+    wgpu::ComputePipeline pipeline = device.CreateComputePipeline(&pipelineDesc);
+
+    wgpu::BufferDescriptor dstDesc;
+    dstDesc.size = sizeof(uint32_t);
+    dstDesc.usage = wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc;
+
+    // Bind groups of a layout that is released before the submit.
+    {
+        wgpu::BindGroupLayout bgl = utils::MakeBindGroupLayout(
+            device, {{0, wgpu::ShaderStage::Compute, wgpu::BufferBindingType::Uniform},
+                     {1, wgpu::ShaderStage::Compute, wgpu::BufferBindingType::Storage}});
+        for (uint32_t i = 0; i < 10; ++i) {
+            wgpu::Buffer src =
+                utils::CreateBufferFromData(device, wgpu::BufferUsage::Uniform, {i});
+            utils::MakeBindGroup(device, bgl, {{0, src}, {1, device.CreateBuffer(&dstDesc)}});
+        }
+    }
+
+    // A bind group with a destroyed resource.
+    wgpu::Buffer destroyedDst = device.CreateBuffer(&dstDesc);
+    destroyedDst.Destroy();
+    utils::MakeBindGroup(
+        device, pipeline.GetBindGroupLayout(0),
+        {{0, utils::CreateBufferFromData(device, wgpu::BufferUsage::Uniform, {0u})},
+         {1, destroyedDst}});
+
+    std::vector<wgpu::Buffer> dsts;
+    std::vector<wgpu::BindGroup> bindGroups;
+    for (uint32_t i = 0; i < 10; ++i) {
+        wgpu::Buffer src =
+            utils::CreateBufferFromData(device, wgpu::BufferUsage::Uniform, {i + 42});
+        dsts.push_back(device.CreateBuffer(&dstDesc));
+        bindGroups.push_back(
+            utils::MakeBindGroup(device, pipeline.GetBindGroupLayout(0), {{0, src}, {1, dsts[i]}}));
+    }
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+    pass.SetPipeline(pipeline);
+    for (const wgpu::BindGroup& bindGroup : bindGroups) {
+        pass.SetBindGroup(0, bindGroup);
+        pass.Dispatch(1);
+    }
+    pass.End();
+    wgpu::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+
+    for (uint32_t i = 0; i < 10; ++i) {
+        EXPECT_BUFFER_U32_EQ(i + 42, dsts[i], 0);
+    }
+}
+
 DAWN_INSTANTIATE_TEST(BindGroupTests,
                       D3D12Backend(),
                       MetalBackend(),
@@ -533,6 +533,7 @@ DAWN_INSTANTIATE_TEST(BufferMappingTests,
                       D3D12Backend(),
                       MetalBackend(),
                       OpenGLBackend(),
+                      OpenGLBackend({"disable_persistently_mapped_uploads"}),
                       OpenGLESBackend(),
                       VulkanBackend());
 
@@ -788,6 +789,7 @@ DAWN_INSTANTIATE_TEST(BufferMappedAtCreationTests,
                       D3D12Backend({}, {"use_d3d12_resource_heap_tier2"}),
                       MetalBackend(),
                       OpenGLBackend(),
+                      OpenGLBackend({"disable_persistently_mapped_uploads"}),
                       OpenGLESBackend(),
                       VulkanBackend());
 
@@ -494,11 +494,12 @@ TEST_P(BufferZeroInitTest, WriteBufferToSubBuffer) {
         wgpu::Buffer buffer = CreateBuffer(kBufferSize, kBufferUsage);
 
         constexpr uint32_t kCopyOffset = 0u;
-        EXPECT_LAZY_CLEAR(1u,
+        EXPECT_LAZY_CLEAR(0u,
                           queue.WriteBuffer(buffer, kCopyOffset, &kCopyValue, sizeof(kCopyValue)));
 
+        // Only the range that wasn't written is cleared, when it is read.
         EXPECT_LAZY_CLEAR(0u, EXPECT_BUFFER_U32_EQ(kCopyValue, buffer, kCopyOffset));
-        EXPECT_LAZY_CLEAR(0u, EXPECT_BUFFER_U32_EQ(0, buffer, kBufferSize - sizeof(kCopyValue)));
+        EXPECT_LAZY_CLEAR(1u, EXPECT_BUFFER_U32_EQ(0, buffer, kBufferSize - sizeof(kCopyValue)));
     }
 
     // offset > 0
@@ -506,10 +507,10 @@ TEST_P(BufferZeroInitTest, WriteBufferToSubBuffer) {
         wgpu::Buffer buffer = CreateBuffer(kBufferSize, kBufferUsage);
 
         constexpr uint32_t kCopyOffset = 4u;
-        EXPECT_LAZY_CLEAR(1u,
+        EXPECT_LAZY_CLEAR(0u,
                           queue.WriteBuffer(buffer, kCopyOffset, &kCopyValue, sizeof(kCopyValue)));
 
-        EXPECT_LAZY_CLEAR(0u, EXPECT_BUFFER_U32_EQ(0, buffer, 0));
+        EXPECT_LAZY_CLEAR(1u, EXPECT_BUFFER_U32_EQ(0, buffer, 0));
         EXPECT_LAZY_CLEAR(0u, EXPECT_BUFFER_U32_EQ(kCopyValue, buffer, kCopyOffset));
     }
 }
@@ -545,7 +546,8 @@ TEST_P(BufferZeroInitTest, CopyBufferToBufferSource) {
                                                          kBufferSize / sizeof(uint32_t)));
     }
 
-    // Partial copy from the source buffer
+    // Partial copy from the source buffer only clears the range that is copied, the rest of the
+    // buffer is cleared when it is read.
     // srcOffset == 0
     {
         constexpr uint64_t kSrcOffset = 0;
@@ -558,7 +560,7 @@ TEST_P(BufferZeroInitTest, CopyBufferToBufferSource) {
 
         EXPECT_LAZY_CLEAR(1u, queue.Submit(1, &commandBuffer));
 
-        EXPECT_LAZY_CLEAR(0u, EXPECT_BUFFER_U32_RANGE_EQ(kExpectedData.data(), srcBuffer, 0,
+        EXPECT_LAZY_CLEAR(1u, EXPECT_BUFFER_U32_RANGE_EQ(kExpectedData.data(), srcBuffer, 0,
                                                          kBufferSize / sizeof(uint32_t)));
     }
 
@@ -574,7 +576,7 @@ TEST_P(BufferZeroInitTest, CopyBufferToBufferSource) {
 
         EXPECT_LAZY_CLEAR(1u, queue.Submit(1, &commandBuffer));
 
-        EXPECT_LAZY_CLEAR(0u, EXPECT_BUFFER_U32_RANGE_EQ(kExpectedData.data(), srcBuffer, 0,
+        EXPECT_LAZY_CLEAR(1u, EXPECT_BUFFER_U32_RANGE_EQ(kExpectedData.data(), srcBuffer, 0,
                                                          kBufferSize / sizeof(uint32_t)));
     }
 
@@ -590,7 +592,7 @@ TEST_P(BufferZeroInitTest, CopyBufferToBufferSource) {
 
         EXPECT_LAZY_CLEAR(1u, queue.Submit(1, &commandBuffer));
 
-        EXPECT_LAZY_CLEAR(0u, EXPECT_BUFFER_U32_RANGE_EQ(kExpectedData.data(), srcBuffer, 0,
+        EXPECT_LAZY_CLEAR(1u, EXPECT_BUFFER_U32_RANGE_EQ(kExpectedData.data(), srcBuffer, 0,
                                                          kBufferSize / sizeof(uint32_t)));
     }
 }
@@ -624,7 +626,7 @@ TEST_P(BufferZeroInitTest, CopyBufferToBufferDestination) {
                                            dstBuffer, 0, kBufferSize / sizeof(uint32_t)));
     }
 
-    // Partial copy from the source buffer needs lazy initialization.
+    // Partial copy from the source buffer doesn't clear the rest of the buffer until it is read.
     // offset == 0
     {
         constexpr uint32_t kDstOffset = 0;
@@ -635,7 +637,7 @@ TEST_P(BufferZeroInitTest, CopyBufferToBufferDestination) {
         encoder.CopyBufferToBuffer(srcBuffer, 0, dstBuffer, kDstOffset, kCopySize);
         wgpu::CommandBuffer commandBuffer = encoder.Finish();
 
-        EXPECT_LAZY_CLEAR(1u, queue.Submit(1, &commandBuffer));
+        EXPECT_LAZY_CLEAR(0u, queue.Submit(1, &commandBuffer));
 
         std::array<uint8_t, kBufferSize> expectedData;
         expectedData.fill(0);
@@ -644,7 +646,7 @@ TEST_P(BufferZeroInitTest, CopyBufferToBufferDestination) {
         }
 
         EXPECT_LAZY_CLEAR(
-            0u, EXPECT_BUFFER_U32_RANGE_EQ(reinterpret_cast<uint32_t*>(expectedData.data()),
+            1u, EXPECT_BUFFER_U32_RANGE_EQ(reinterpret_cast<uint32_t*>(expectedData.data()),
                                            dstBuffer, 0, kBufferSize / sizeof(uint32_t)));
     }
 
@@ -658,7 +660,7 @@ TEST_P(BufferZeroInitTest, CopyBufferToBufferDestination) {
         encoder.CopyBufferToBuffer(srcBuffer, 0, dstBuffer, kDstOffset, kCopySize);
         wgpu::CommandBuffer commandBuffer = encoder.Finish();
 
-        EXPECT_LAZY_CLEAR(1u, queue.Submit(1, &commandBuffer));
+        EXPECT_LAZY_CLEAR(0u, queue.Submit(1, &commandBuffer));
 
         std::array<uint8_t, kBufferSize> expectedData;
         expectedData.fill(0);
@@ -667,7 +669,7 @@ TEST_P(BufferZeroInitTest, CopyBufferToBufferDestination) {
         }
 
         EXPECT_LAZY_CLEAR(
-            0u, EXPECT_BUFFER_U32_RANGE_EQ(reinterpret_cast<uint32_t*>(expectedData.data()),
+            1u, EXPECT_BUFFER_U32_RANGE_EQ(reinterpret_cast<uint32_t*>(expectedData.data()),
                                            dstBuffer, 0, kBufferSize / sizeof(uint32_t)));
     }
 
@@ -681,7 +683,7 @@ TEST_P(BufferZeroInitTest, CopyBufferToBufferDestination) {
         encoder.CopyBufferToBuffer(srcBuffer, 0, dstBuffer, kDstOffset, kCopySize);
         wgpu::CommandBuffer commandBuffer = encoder.Finish();
 
-        EXPECT_LAZY_CLEAR(1u, queue.Submit(1, &commandBuffer));
+        EXPECT_LAZY_CLEAR(0u, queue.Submit(1, &commandBuffer));
 
         std::array<uint8_t, kBufferSize> expectedData;
         expectedData.fill(0);
@@ -690,7 +692,7 @@ TEST_P(BufferZeroInitTest, CopyBufferToBufferDestination) {
         }
 
         EXPECT_LAZY_CLEAR(
-            0u, EXPECT_BUFFER_U32_RANGE_EQ(reinterpret_cast<uint32_t*>(expectedData.data()),
+            1u, EXPECT_BUFFER_U32_RANGE_EQ(reinterpret_cast<uint32_t*>(expectedData.data()),
                                            dstBuffer, 0, kBufferSize / sizeof(uint32_t)));
     }
 }
@@ -731,7 +733,8 @@ TEST_P(BufferZeroInitTest, MapAsync_Read) {
         }
         buffer.Unmap();
 
-        EXPECT_LAZY_CLEAR(0u, MapAsyncAndWait(buffer, kMapMode, 0, kBufferSize));
+        // Only the mapped range was cleared, the rest of the buffer is cleared now.
+        EXPECT_LAZY_CLEAR(1u, MapAsyncAndWait(buffer, kMapMode, 0, kBufferSize));
         mappedDataUint = static_cast<const uint32_t*>(buffer.GetConstMappedRange());
         for (uint32_t i = 0; i < kBufferSize / sizeof(uint32_t); ++i) {
             EXPECT_EQ(0u, mappedDataUint[i]);
@@ -771,12 +774,35 @@ TEST_P(BufferZeroInitTest, MapAsync_Write) {
         EXPECT_LAZY_CLEAR(1u, MapAsyncAndWait(buffer, kMapMode, kOffset, kSize));
         buffer.Unmap();
 
+        // Only the mapped range was cleared, the rest of the buffer is cleared when it is read.
         EXPECT_LAZY_CLEAR(
-            0u, EXPECT_BUFFER_U32_RANGE_EQ(reinterpret_cast<const uint32_t*>(kExpectedData.data()),
+            1u, EXPECT_BUFFER_U32_RANGE_EQ(reinterpret_cast<const uint32_t*>(kExpectedData.data()),
                                            buffer, 0, kExpectedData.size()));
     }
 }
 
+// Test that the data written to a buffer mapped for writing isn't overwritten by its lazy clear
+// when the buffer is then used in a copy.
+TEST_P(BufferZeroInitTest, MapAsync_WriteThenCopy) {
+    constexpr uint32_t kBufferSize = 16u;
+    constexpr std::array<uint32_t, kBufferSize / sizeof(uint32_t)> kExpectedData = {{1, 2, 3, 4}};
+
+    wgpu::Buffer buffer =
+        CreateBuffer(kBufferSize, wgpu::BufferUsage::MapWrite | wgpu::BufferUsage::CopySrc);
+    EXPECT_LAZY_CLEAR(1u, MapAsyncAndWait(buffer, wgpu::MapMode::Write, 0, kBufferSize));
+    memcpy(buffer.GetMappedRange(), kExpectedData.data(), kBufferSize);
+    buffer.Unmap();
+
+    wgpu::Buffer destination =
+        CreateBuffer(kBufferSize, wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::CopySrc);
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    encoder.CopyBufferToBuffer(buffer, 0, destination, 0, kBufferSize);
+    wgpu::CommandBuffer commandBuffer = encoder.Finish();
+    EXPECT_LAZY_CLEAR(0u, queue.Submit(1, &commandBuffer));
+
+    EXPECT_BUFFER_U32_RANGE_EQ(kExpectedData.data(), destination, 0, kExpectedData.size());
+}
+
 // Test that the code path of creating a buffer with BufferDescriptor.mappedAtCreation == true
 // clears the buffer correctly at the creation of the buffer.
 TEST_P(BufferZeroInitTest, MappedAtCreation) {
@@ -1349,7 +1375,7 @@ TEST_P(BufferZeroInitTest, ResolveQuerySet) {
         EXPECT_LAZY_CLEAR(0u, queue.Submit(1, &commands));
     }
 
-    // Resolve data to partial of the buffer needs lazy initialization.
+    // Resolve data to partial of the buffer doesn't clear the rest of the buffer until it is read.
     // destinationOffset == 0 and destinationOffset + 8 * queryCount < kBufferSize
     {
         constexpr uint32_t kQueryCount = 1u;
@@ -1361,7 +1387,7 @@ TEST_P(BufferZeroInitTest, ResolveQuerySet) {
         encoder.ResolveQuerySet(querySet, 0, kQueryCount, destination, kDestinationOffset);
         wgpu::CommandBuffer commands = encoder.Finish();
 
-        EXPECT_LAZY_CLEAR(1u, queue.Submit(1, &commands));
+        EXPECT_LAZY_CLEAR(0u, queue.Submit(1, &commands));
     }
 
     // destinationOffset > 0 and destinationOffset + 8 * queryCount <= kBufferSize
@@ -1375,7 +1401,7 @@ TEST_P(BufferZeroInitTest, ResolveQuerySet) {
         encoder.ResolveQuerySet(querySet, 0, kQueryCount, destination, kDestinationOffset);
         wgpu::CommandBuffer commands = encoder.Finish();
 
-        EXPECT_LAZY_CLEAR(1u, queue.Submit(1, &commands));
+        EXPECT_LAZY_CLEAR(0u, queue.Submit(1, &commands));
     }
 }
 
@@ -1384,4 +1410,6 @@ DAWN_INSTANTIATE_TEST(BufferZeroInitTest,
                       MetalBackend({"nonzero_clear_resources_on_creation_for_testing"}),
                       OpenGLBackend({"nonzero_clear_resources_on_creation_for_testing"}),
                       OpenGLESBackend({"nonzero_clear_resources_on_creation_for_testing"}),
-                      VulkanBackend({"nonzero_clear_resources_on_creation_for_testing"}));
+                      VulkanBackend({"nonzero_clear_resources_on_creation_for_testing"}),
+                      VulkanBackend({"nonzero_clear_resources_on_creation_for_testing",
+                                     "vulkan_use_dedicated_transfer_queue"}));
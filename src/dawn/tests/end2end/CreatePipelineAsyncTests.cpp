@@ -14,6 +14,8 @@
 
 #include "dawn/tests/DawnTest.h"
 
+#include "dawn/native/DawnNative.h"
+
 #include "dawn/utils/ComboRenderPipelineDescriptor.h"
 #include "dawn/utils/WGPUHelpers.h"
 
@@ -621,6 +623,89 @@ TEST_P(CreatePipelineAsyncTest, CreateSameRenderPipelineTwiceAtSameTime) {
     }
 }
 
+// Verify that creating a compute pipeline while the same pipeline is being created asynchronously
+// compiles it only once. This doesn't depend on whether the asynchronous compilation already
+// finished since it is tracked until its pipeline is in the device's cache.
+TEST_P(CreatePipelineAsyncTest, CreateSameComputePipelineAsyncAndSyncCompilesOnce) {
+    // The compilation counter is only available in dawn_native.
+    DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+
+    wgpu::ComputePipelineDescriptor csDesc;
+    csDesc.compute.module = utils::CreateShaderModule(device, R"(
+        @stage(compute) @workgroup_size(1) fn main() {
+        })");
+    csDesc.compute.entryPoint = "main";
+
+    auto callback = [](WGPUCreatePipelineAsyncStatus status, WGPUComputePipeline returnPipeline,
+                       const char* message, void* userdata) {
+        EXPECT_EQ(WGPUCreatePipelineAsyncStatus::WGPUCreatePipelineAsyncStatus_Success, status);
+
+        CreatePipelineAsyncTask* task = static_cast<CreatePipelineAsyncTask*>(userdata);
+        task->computePipeline = wgpu::ComputePipeline::Acquire(returnPipeline);
+        task->isCompleted = true;
+        task->message = message;
+    };
+
+    size_t compilationCount = dawn::native::GetPipelineCompilationCountForTesting(device.Get());
+
+    device.CreateComputePipelineAsync(&csDesc, callback, &task);
+    wgpu::ComputePipeline pipeline = device.CreateComputePipeline(&csDesc);
+
+    while (!task.isCompleted) {
+        WaitABit();
+    }
+    ASSERT_NE(nullptr, task.computePipeline.Get());
+    EXPECT_EQ(task.computePipeline.Get(), pipeline.Get());
+
+    EXPECT_EQ(compilationCount + 1,
+              dawn::native::GetPipelineCompilationCountForTesting(device.Get()));
+}
+
+// Verify that creating the same render pipeline twice at the same time compiles it only once. The
+// second task reuses the compilation of the first one, whether it already finished or not, since
+// no Tick adds the first pipeline to the device's cache in between.
+TEST_P(CreatePipelineAsyncTest, CreateSameRenderPipelineTwiceAtSameTimeCompilesOnce) {
+    // The compilation counter is only available in dawn_native.
+    DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+
+    utils::ComboRenderPipelineDescriptor renderPipelineDescriptor;
+    renderPipelineDescriptor.vertex.module = utils::CreateShaderModule(device, R"(
+        @stage(vertex) fn main() -> @builtin(position) vec4<f32> {
+            return vec4<f32>(0.0, 0.0, 0.0, 1.0);
+        })");
+    renderPipelineDescriptor.cFragment.module = utils::CreateShaderModule(device, R"(
+        @stage(fragment) fn main() -> @location(0) vec4<f32> {
+            return vec4<f32>(0.0, 1.0, 0.0, 1.0);
+        })");
+    renderPipelineDescriptor.cTargets[0].format = wgpu::TextureFormat::RGBA8Unorm;
+    renderPipelineDescriptor.primitive.topology = wgpu::PrimitiveTopology::PointList;
+
+    auto callback = [](WGPUCreatePipelineAsyncStatus status, WGPURenderPipeline returnPipeline,
+                       const char* message, void* userdata) {
+        EXPECT_EQ(WGPUCreatePipelineAsyncStatus::WGPUCreatePipelineAsyncStatus_Success, status);
+
+        CreatePipelineAsyncTask* task = static_cast<CreatePipelineAsyncTask*>(userdata);
+        task->renderPipeline = wgpu::RenderPipeline::Acquire(returnPipeline);
+        task->isCompleted = true;
+        task->message = message;
+    };
+
+    size_t compilationCount = dawn::native::GetPipelineCompilationCountForTesting(device.Get());
+
+    CreatePipelineAsyncTask anotherTask;
+    device.CreateRenderPipelineAsync(&renderPipelineDescriptor, callback, &task);
+    device.CreateRenderPipelineAsync(&renderPipelineDescriptor, callback, &anotherTask);
+
+    while (!task.isCompleted || !anotherTask.isCompleted) {
+        WaitABit();
+    }
+    ASSERT_NE(nullptr, task.renderPipeline.Get());
+    EXPECT_EQ(task.renderPipeline.Get(), anotherTask.renderPipeline.Get());
+
+    EXPECT_EQ(compilationCount + 1,
+              dawn::native::GetPipelineCompilationCountForTesting(device.Get()));
+}
+
 // Verify calling CreateRenderPipelineAsync() with valid VertexBufferLayouts works on all backends.
 TEST_P(CreatePipelineAsyncTest, CreateRenderPipelineAsyncWithVertexBufferLayouts) {
     wgpu::TextureDescriptor textureDescriptor;
@@ -14,86 +14,17 @@
 
 #include "dawn/tests/DawnTest.h"
 
+#include "dawn/tests/end2end/FakePersistentCache.h"
 #include "dawn/utils/ComboRenderPipelineDescriptor.h"
 #include "dawn/utils/WGPUHelpers.h"
 
-#define EXPECT_CACHE_HIT(N, statement)              \
-    do {                                            \
-        size_t before = mPersistentCache.mHitCount; \
-        statement;                                  \
-        FlushWire();                                \
-        size_t after = mPersistentCache.mHitCount;  \
-        EXPECT_EQ(N, after - before);               \
-    } while (0)
-
-// FakePersistentCache implements a in-memory persistent cache.
-class FakePersistentCache : public dawn::platform::CachingInterface {
-  public:
-    // PersistentCache API
-    void StoreData(const WGPUDevice device,
-                   const void* key,
-                   size_t keySize,
-                   const void* value,
-                   size_t valueSize) override {
-        if (mIsDisabled)
-            return;
-        const std::string keyStr(reinterpret_cast<const char*>(key), keySize);
-
-        const uint8_t* value_start = reinterpret_cast<const uint8_t*>(value);
-        std::vector<uint8_t> entry_value(value_start, value_start + valueSize);
-
-        EXPECT_TRUE(mCache.insert({keyStr, std::move(entry_value)}).second);
-    }
-
-    size_t LoadData(const WGPUDevice device,
-                    const void* key,
-                    size_t keySize,
-                    void* value,
-                    size_t valueSize) override {
-        const std::string keyStr(reinterpret_cast<const char*>(key), keySize);
-        auto entry = mCache.find(keyStr);
-        if (entry == mCache.end()) {
-            return 0;
-        }
-        if (valueSize >= entry->second.size()) {
-            memcpy(value, entry->second.data(), entry->second.size());
-        }
-        mHitCount++;
-        return entry->second.size();
-    }
-
-    using Blob = std::vector<uint8_t>;
-    using FakeCache = std::unordered_map<std::string, Blob>;
-
-    FakeCache mCache;
-
-    size_t mHitCount = 0;
-    bool mIsDisabled = false;
-};
-
-// Test platform that only supports caching.
-class DawnTestPlatform : public dawn::platform::Platform {
-  public:
-    DawnTestPlatform(dawn::platform::CachingInterface* cachingInterface)
-        : mCachingInterface(cachingInterface) {
-    }
-    ~DawnTestPlatform() override = default;
-
-    dawn::platform::CachingInterface* GetCachingInterface(const void* fingerprint,
-                                                          size_t fingerprintSize) override {
-        return mCachingInterface;
-    }
-
-    dawn::platform::CachingInterface* mCachingInterface = nullptr;
-};
-
 class D3D12CachingTests : public DawnTest {
   protected:
     std::unique_ptr<dawn::platform::Platform> CreateTestPlatform() override {
         return std::make_unique<DawnTestPlatform>(&mPersistentCache);
     }
 
-    FakePersistentCache mPersistentCache;
+    FakePersistentCache mPersistentCache{dawn::native::PersistentKeyType::Shader};
 };
 
 // Test that duplicate WGSL still re-compiles HLSL even when the cache is not enabled.
@@ -612,6 +612,66 @@ TEST_P(DrawIndexedIndirectTest, ValidateWithBundlesInDifferentPasses) {
     EXPECT_PIXEL_RGBA8_EQ(notFilled, renderPass.color, 3, 1);
 }
 
+// Test executing a bundle with redundant state-setting commands around its indirect draws. The
+// validation patches the draws of the bundle each time it is executed, so this checks that the
+// elimination of the redundant commands doesn't move the draws.
+TEST_P(DrawIndexedIndirectTest, ValidateBundleWithRedundantState) {
+    // TODO(crbug.com/dawn/789): Test is failing under SwANGLE on Windows only.
+    DAWN_SUPPRESS_TEST_IF(IsANGLE() && IsWindows());
+
+    // TODO(crbug.com/dawn/1292): Some Intel OpenGL drivers don't seem to like
+    // the offsets that Tint/GLSL produces.
+    DAWN_SUPPRESS_TEST_IF(IsIntel() && IsOpenGL() && IsLinux());
+
+    // It doesn't make sense to test invalid inputs when validation is disabled.
+    DAWN_SUPPRESS_TEST_IF(HasToggleEnabled("skip_validation"));
+
+    RGBA8 filled(0, 255, 0, 255);
+    RGBA8 notFilled(0, 0, 0, 0);
+
+    wgpu::Buffer indirectBuffer = CreateIndirectBuffer({3, 1, 0, 0, 0, 10, 1, 0, 0, 0});
+    wgpu::Buffer indexBuffer = CreateIndexBuffer({0, 1, 2, 0, 3, 1});
+
+    wgpu::RenderBundle bundle;
+    {
+        utils::ComboRenderBundleEncoderDescriptor desc = {};
+        desc.colorFormatsCount = 1;
+        desc.cColorFormats[0] = wgpu::TextureFormat::RGBA8Unorm;
+        wgpu::RenderBundleEncoder bundleEncoder = device.CreateRenderBundleEncoder(&desc);
+        for (uint32_t i = 0; i < 2; ++i) {
+            bundleEncoder.SetPipeline(pipeline);
+            bundleEncoder.SetVertexBuffer(0, vertexBuffer);
+            bundleEncoder.SetIndexBuffer(indexBuffer, wgpu::IndexFormat::Uint32, 0);
+            bundleEncoder.DrawIndexedIndirect(indirectBuffer, 0);
+        }
+        bundleEncoder.SetPipeline(pipeline);
+        bundleEncoder.SetIndexBuffer(indexBuffer, wgpu::IndexFormat::Uint32, 0);
+        // Draws nothing since its index count is out of bounds.
+        bundleEncoder.DrawIndexedIndirect(indirectBuffer, 20);
+        bundle = bundleEncoder.Finish();
+    }
+
+    // Execute the bundle in several passes and command buffers so that its draws are patched
+    // several times.
+    for (uint32_t i = 0; i < 2; ++i) {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        renderPass.renderPassInfo.cColorAttachments[0].loadOp = wgpu::LoadOp::Clear;
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass.renderPassInfo);
+        pass.ExecuteBundles(1, &bundle);
+        pass.End();
+        renderPass.renderPassInfo.cColorAttachments[0].loadOp = wgpu::LoadOp::Load;
+        pass = encoder.BeginRenderPass(&renderPass.renderPassInfo);
+        pass.ExecuteBundles(1, &bundle);
+        pass.End();
+
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+
+        EXPECT_PIXEL_RGBA8_EQ(filled, renderPass.color, 1, 3);
+        EXPECT_PIXEL_RGBA8_EQ(notFilled, renderPass.color, 3, 1);
+    }
+}
+
 TEST_P(DrawIndexedIndirectTest, ValidateReusedBundleWithChangingParams) {
     // TODO(crbug.com/dawn/789): Test is failing under SwANGLE on Windows.
     DAWN_SUPPRESS_TEST_IF(IsANGLE() && IsWindows());
@@ -0,0 +1,76 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/tests/end2end/FakePersistentCache.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+FakePersistentCache::FakePersistentCache(dawn::native::PersistentKeyType keyType)
+    : mKeyPrefix(std::to_string(static_cast<uint32_t>(keyType)) + "\n") {
+}
+
+FakePersistentCache::~FakePersistentCache() = default;
+
+void FakePersistentCache::StoreData(const WGPUDevice device,
+                                    const void* key,
+                                    size_t keySize,
+                                    const void* value,
+                                    size_t valueSize) {
+    if (mIsDisabled) {
+        return;
+    }
+    const std::string keyStr(reinterpret_cast<const char*>(key), keySize);
+    if (keyStr.compare(0, mKeyPrefix.size(), mKeyPrefix) != 0) {
+        return;
+    }
+
+    const uint8_t* value_start = reinterpret_cast<const uint8_t*>(value);
+    std::vector<uint8_t> entry_value(value_start, value_start + valueSize);
+
+    if (mCanReplaceEntries) {
+        mCache[keyStr] = std::move(entry_value);
+    } else {
+        EXPECT_TRUE(mCache.insert({keyStr, std::move(entry_value)}).second);
+    }
+}
+
+size_t FakePersistentCache::LoadData(const WGPUDevice device,
+                                     const void* key,
+                                     size_t keySize,
+                                     void* value,
+                                     size_t valueSize) {
+    const std::string keyStr(reinterpret_cast<const char*>(key), keySize);
+    auto entry = mCache.find(keyStr);
+    if (entry == mCache.end()) {
+        return 0;
+    }
+    if (valueSize >= entry->second.size()) {
+        memcpy(value, entry->second.data(), entry->second.size());
+    }
+    mHitCount++;
+    return entry->second.size();
+}
+
+DawnTestPlatform::DawnTestPlatform(dawn::platform::CachingInterface* cachingInterface)
+    : mCachingInterface(cachingInterface) {
+}
+
+DawnTestPlatform::~DawnTestPlatform() = default;
+
+dawn::platform::CachingInterface* DawnTestPlatform::GetCachingInterface(const void* fingerprint,
+                                                                        size_t fingerprintSize) {
+    return mCachingInterface;
+}
@@ -0,0 +1,86 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TESTS_FAKEPERSISTENTCACHE_H_
+#define TESTS_FAKEPERSISTENTCACHE_H_
+
+#include "dawn/native/PersistentCache.h"
+#include "dawn/platform/DawnPlatform.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Expects |statement| to load N entries from the cache. Used in test fixtures that have their
+// FakePersistentCache in mPersistentCache.
+#define EXPECT_CACHE_HIT(N, statement)              \
+    do {                                            \
+        size_t before = mPersistentCache.mHitCount; \
+        statement;                                  \
+        FlushWire();                                \
+        size_t after = mPersistentCache.mHitCount;  \
+        EXPECT_EQ(N, after - before);               \
+    } while (0)
+
+// FakePersistentCache implements an in-memory persistent cache. It only stores the entries of a
+// single kind of data, so that tests can count them and their loads while ignoring the other kinds
+// of entries Dawn stores.
+class FakePersistentCache : public dawn::platform::CachingInterface {
+  public:
+    explicit FakePersistentCache(dawn::native::PersistentKeyType keyType);
+    ~FakePersistentCache() override;
+
+    // PersistentCache API
+    void StoreData(const WGPUDevice device,
+                   const void* key,
+                   size_t keySize,
+                   const void* value,
+                   size_t valueSize) override;
+    size_t LoadData(const WGPUDevice device,
+                    const void* key,
+                    size_t keySize,
+                    void* value,
+                    size_t valueSize) override;
+
+    using Blob = std::vector<uint8_t>;
+    using FakeCache = std::unordered_map<std::string, Blob>;
+
+    FakeCache mCache;
+
+    // The number of calls to LoadData that found their key.
+    size_t mHitCount = 0;
+    bool mIsDisabled = false;
+    // Whether storing a key that is already in the cache replaces its value. Otherwise it is a
+    // test failure.
+    bool mCanReplaceEntries = false;
+
+  private:
+    // Keys start with their PersistentKeyType printed as text, like PersistentCache keys are
+    // built.
+    const std::string mKeyPrefix;
+};
+
+// Test platform that only supports caching.
+class DawnTestPlatform : public dawn::platform::Platform {
+  public:
+    explicit DawnTestPlatform(dawn::platform::CachingInterface* cachingInterface);
+    ~DawnTestPlatform() override;
+
+    dawn::platform::CachingInterface* GetCachingInterface(const void* fingerprint,
+                                                          size_t fingerprintSize) override;
+
+    dawn::platform::CachingInterface* mCachingInterface = nullptr;
+};
+
+#endif  // TESTS_FAKEPERSISTENTCACHE_H_
@@ -0,0 +1,180 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/tests/DawnTest.h"
+
+#include "dawn/utils/ComboRenderBundleEncoderDescriptor.h"
+#include "dawn/utils/ComboRenderPipelineDescriptor.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+#include <vector>
+
+constexpr uint32_t kRTSize = 4;
+
+// Tests submitting several command buffers with render passes at once, which the backends may
+// record in parallel.
+class MultipleCommandBufferSubmitTests : public DawnTest {
+  protected:
+    void SetUp() override {
+        DawnTest::SetUp();
+
+        // Draw a fullscreen triangle with the color of the uniform buffer.
+        utils::ComboRenderPipelineDescriptor descriptor;
+        descriptor.vertex.module = utils::CreateShaderModule(device, R"(
+            @stage(vertex) fn main(@builtin(vertex_index) VertexIndex : u32)
+                                -> @builtin(position) vec4<f32> {
+                var pos = array<vec2<f32>, 3>(
+                    vec2<f32>(-1.0, -1.0),
+                    vec2<f32>( 3.0, -1.0),
+                    vec2<f32>(-1.0,  3.0));
+                return vec4<f32>(pos[VertexIndex], 0.0, 1.0);
+            })");
+        descriptor.cFragment.module = utils::CreateShaderModule(device, R"(
+            struct Ubo {
+                color : vec4<f32>;
+            };
+            @group(0) @binding(0) var<uniform> ubo : Ubo;
+
+            @stage(fragment) fn main() -> @location(0) vec4<f32> {
+                return ubo.color;
+            })");
+        descriptor.cTargets[0].format = wgpu::TextureFormat::RGBA8Unorm;
+        pipeline = device.CreateRenderPipeline(&descriptor);
+    }
+
+    wgpu::Texture CreateRenderTarget() {
+        wgpu::TextureDescriptor descriptor;
+        descriptor.size = {kRTSize, kRTSize};
+        descriptor.format = wgpu::TextureFormat::RGBA8Unorm;
+        descriptor.usage = wgpu::TextureUsage::RenderAttachment | wgpu::TextureUsage::CopySrc |
+                           wgpu::TextureUsage::CopyDst;
+        return device.CreateTexture(&descriptor);
+    }
+
+    wgpu::BindGroup CreateColorBindGroup(const RGBA8& color) {
+        float data[] = {color.r / 255.f, color.g / 255.f, color.b / 255.f, color.a / 255.f};
+        wgpu::Buffer buffer = utils::CreateBufferFromData(device, data, sizeof(data),
+                                                          wgpu::BufferUsage::Uniform);
+        return utils::MakeBindGroup(device, pipeline.GetBindGroupLayout(0), {{0, buffer}});
+    }
+
+    // Encodes a render pass drawing |color| in |renderTarget|, or only in the scissor rect of
+    // the left half of it if |leftHalfOnly| is true.
+    void EncodeDraw(const wgpu::CommandEncoder& encoder,
+                    const wgpu::Texture& renderTarget,
+                    const RGBA8& color,
+                    bool leftHalfOnly = false) {
+        utils::ComboRenderPassDescriptor renderPassDesc({renderTarget.CreateView()});
+        renderPassDesc.cColorAttachments[0].loadOp =
+            leftHalfOnly ? wgpu::LoadOp::Load : wgpu::LoadOp::Clear;
+
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPassDesc);
+        pass.SetPipeline(pipeline);
+        pass.SetBindGroup(0, CreateColorBindGroup(color));
+        if (leftHalfOnly) {
+            pass.SetScissorRect(0, 0, kRTSize / 2, kRTSize);
+        }
+        pass.Draw(3);
+        pass.End();
+    }
+
+    wgpu::RenderPipeline pipeline;
+};
+
+// Test command buffers rendering to different render targets.
+TEST_P(MultipleCommandBufferSubmitTests, IndependentRenderPasses) {
+    constexpr uint32_t kCommandBufferCount = 8;
+    const RGBA8 kColors[] = {RGBA8::kRed, RGBA8::kGreen, RGBA8::kBlue, RGBA8::kYellow};
+
+    std::vector<wgpu::Texture> renderTargets;
+    std::vector<wgpu::CommandBuffer> commands;
+    for (uint32_t i = 0; i < kCommandBufferCount; ++i) {
+        renderTargets.push_back(CreateRenderTarget());
+
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        EncodeDraw(encoder, renderTargets[i], kColors[i % 4]);
+        commands.push_back(encoder.Finish());
+    }
+    queue.Submit(commands.size(), commands.data());
+
+    for (uint32_t i = 0; i < kCommandBufferCount; ++i) {
+        EXPECT_PIXEL_RGBA8_EQ(kColors[i % 4], renderTargets[i], 0, 0);
+        EXPECT_PIXEL_RGBA8_EQ(kColors[i % 4], renderTargets[i], kRTSize - 1, kRTSize - 1);
+    }
+}
+
+// Test that the render passes of the command buffers are executed in submission order.
+TEST_P(MultipleCommandBufferSubmitTests, RenderPassesInSubmissionOrder) {
+    wgpu::Texture renderTarget = CreateRenderTarget();
+
+    wgpu::CommandEncoder encoder0 = device.CreateCommandEncoder();
+    EncodeDraw(encoder0, renderTarget, RGBA8::kGreen);
+    wgpu::CommandEncoder encoder1 = device.CreateCommandEncoder();
+    EncodeDraw(encoder1, renderTarget, RGBA8::kBlue, true);
+    wgpu::CommandBuffer commands[] = {encoder0.Finish(), encoder1.Finish()};
+    queue.Submit(2, commands);
+
+    EXPECT_PIXEL_RGBA8_EQ(RGBA8::kBlue, renderTarget, 0, 0);
+    EXPECT_PIXEL_RGBA8_EQ(RGBA8::kGreen, renderTarget, kRTSize - 1, 0);
+}
+
+// Test command buffers mixing render passes with and without render bundles, and copies.
+TEST_P(MultipleCommandBufferSubmitTests, RenderPassesWithBundlesAndCopies) {
+    wgpu::Texture renderTarget0 = CreateRenderTarget();
+    wgpu::Texture renderTarget1 = CreateRenderTarget();
+    wgpu::Texture copyDestination = CreateRenderTarget();
+
+    utils::ComboRenderBundleEncoderDescriptor bundleDesc = {};
+    bundleDesc.colorFormatsCount = 1;
+    bundleDesc.cColorFormats[0] = wgpu::TextureFormat::RGBA8Unorm;
+    wgpu::RenderBundleEncoder bundleEncoder = device.CreateRenderBundleEncoder(&bundleDesc);
+    bundleEncoder.SetPipeline(pipeline);
+    bundleEncoder.SetBindGroup(0, CreateColorBindGroup(RGBA8::kRed));
+    bundleEncoder.Draw(3);
+    wgpu::RenderBundle bundle = bundleEncoder.Finish();
+
+    // The first command buffer draws in a render pass and then executes the bundle in another.
+    wgpu::CommandEncoder encoder0 = device.CreateCommandEncoder();
+    EncodeDraw(encoder0, renderTarget0, RGBA8::kGreen);
+    {
+        utils::ComboRenderPassDescriptor renderPassDesc({renderTarget1.CreateView()});
+        wgpu::RenderPassEncoder pass = encoder0.BeginRenderPass(&renderPassDesc);
+        pass.ExecuteBundles(1, &bundle);
+        pass.End();
+    }
+
+    // The second command buffer copies the result of the first one and draws over it.
+    wgpu::CommandEncoder encoder1 = device.CreateCommandEncoder();
+    wgpu::ImageCopyTexture src = utils::CreateImageCopyTexture(renderTarget0, 0, {0, 0, 0});
+    wgpu::ImageCopyTexture dst = utils::CreateImageCopyTexture(copyDestination, 0, {0, 0, 0});
+    wgpu::Extent3D copySize = {kRTSize, kRTSize};
+    encoder1.CopyTextureToTexture(&src, &dst, &copySize);
+    EncodeDraw(encoder1, renderTarget0, RGBA8::kBlue, true);
+
+    wgpu::CommandBuffer commands[] = {encoder0.Finish(), encoder1.Finish()};
+    queue.Submit(2, commands);
+
+    EXPECT_PIXEL_RGBA8_EQ(RGBA8::kBlue, renderTarget0, 0, 0);
+    EXPECT_PIXEL_RGBA8_EQ(RGBA8::kGreen, renderTarget0, kRTSize - 1, 0);
+    EXPECT_PIXEL_RGBA8_EQ(RGBA8::kRed, renderTarget1, 0, 0);
+    EXPECT_PIXEL_RGBA8_EQ(RGBA8::kGreen, copyDestination, 0, 0);
+}
+
+DAWN_INSTANTIATE_TEST(MultipleCommandBufferSubmitTests,
+                      D3D12Backend(),
+                      MetalBackend(),
+                      OpenGLBackend(),
+                      OpenGLESBackend(),
+                      VulkanBackend(),
+                      VulkanBackend({"vulkan_record_command_buffers_in_parallel"}));
@@ -0,0 +1,135 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/tests/DawnTest.h"
+
+#include "dawn/tests/end2end/FakePersistentCache.h"
+#include "dawn/utils/ComboRenderPipelineDescriptor.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace {
+
+    constexpr char kRenderShader[] = R"(
+        struct Uniforms {
+            color : vec4<f32>;
+        };
+        @group(0) @binding(0) var<uniform> uniforms : Uniforms;
+
+        @stage(vertex) fn vertex_main(@builtin(vertex_index) VertexIndex : u32)
+                                   -> @builtin(position) vec4<f32> {
+            var pos = array<vec2<f32>, 3>(
+                vec2<f32>(-1.0, -1.0),
+                vec2<f32>( 3.0, -1.0),
+                vec2<f32>(-1.0,  3.0));
+            return vec4<f32>(pos[VertexIndex], 0.0, 1.0);
+        }
+
+        @stage(fragment) fn fragment_main() -> @location(0) vec4<f32> {
+            return uniforms.color;
+        }
+    )";
+
+    constexpr uint32_t kRTSize = 4;
+
+}  // anonymous namespace
+
+class OpenGLCachingTests : public DawnTest {
+  protected:
+    std::unique_ptr<dawn::platform::Platform> CreateTestPlatform() override {
+        return std::make_unique<DawnTestPlatform>(&mPersistentCache);
+    }
+
+    void SetUp() override {
+        DawnTest::SetUp();
+        DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+
+        // A recompiled program replaces the binary that the driver rejected.
+        mPersistentCache.mCanReplaceEntries = true;
+    }
+
+    wgpu::RenderPipeline CreateRenderPipeline() {
+        wgpu::ShaderModule module = utils::CreateShaderModule(device, kRenderShader);
+
+        utils::ComboRenderPipelineDescriptor desc;
+        desc.vertex.module = module;
+        desc.vertex.entryPoint = "vertex_main";
+        desc.cFragment.module = module;
+        desc.cFragment.entryPoint = "fragment_main";
+        desc.cTargets[0].format = wgpu::TextureFormat::RGBA8Unorm;
+        return device.CreateRenderPipeline(&desc);
+    }
+
+    // Draws with |pipeline| and checks that it produced the color of the uniform buffer, which
+    // needs the bindings of the program to be set up even when it was loaded from a binary.
+    void CheckPipelineRenders(const wgpu::RenderPipeline& pipeline) {
+        utils::BasicRenderPass renderPass = utils::CreateBasicRenderPass(device, kRTSize, kRTSize);
+
+        constexpr float kColor[] = {0.0f, 1.0f, 0.0f, 1.0f};
+        wgpu::Buffer uniformBuffer = utils::CreateBufferFromData(
+            device, kColor, sizeof(kColor), wgpu::BufferUsage::Uniform);
+        wgpu::BindGroup bindGroup =
+            utils::MakeBindGroup(device, pipeline.GetBindGroupLayout(0), {{0, uniformBuffer}});
+
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass.renderPassInfo);
+        pass.SetPipeline(pipeline);
+        pass.SetBindGroup(0, bindGroup);
+        pass.Draw(3);
+        pass.End();
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+
+        EXPECT_PIXEL_RGBA8_EQ(RGBA8::kGreen, renderPass.color, 0, 0);
+        EXPECT_PIXEL_RGBA8_EQ(RGBA8::kGreen, renderPass.color, kRTSize - 1, kRTSize - 1);
+    }
+
+    // Overwrites the binaries while keeping their format, which is the GLenum at the start of the
+    // blob, like what the driver would find after it was updated.
+    void CorruptProgramBinaries() {
+        for (auto& [key, blob] : mPersistentCache.mCache) {
+            for (size_t i = sizeof(uint32_t); i < blob.size(); ++i) {
+                blob[i] = ~blob[i];
+            }
+        }
+    }
+
+    FakePersistentCache mPersistentCache{dawn::native::PersistentKeyType::ProgramBinary};
+};
+
+// Test that the linked program is stored in the cache and that a new pipeline with the same
+// shaders is created from it.
+TEST_P(OpenGLCachingTests, ReuseProgramBinary) {
+    CheckPipelineRenders(CreateRenderPipeline());
+    // Program binaries are optional, so there is nothing more to test without them.
+    DAWN_TEST_UNSUPPORTED_IF(mPersistentCache.mCache.size() == 0);
+    EXPECT_EQ(mPersistentCache.mCache.size(), 1u);
+
+    EXPECT_CACHE_HIT(2u, CheckPipelineRenders(CreateRenderPipeline()));
+    EXPECT_EQ(mPersistentCache.mCache.size(), 1u);
+}
+
+// Test that a program binary rejected by the driver falls back to compiling the shaders again.
+TEST_P(OpenGLCachingTests, InvalidProgramBinaryIsRecompiled) {
+    CheckPipelineRenders(CreateRenderPipeline());
+    DAWN_TEST_UNSUPPORTED_IF(mPersistentCache.mCache.size() == 0);
+
+    CorruptProgramBinaries();
+    EXPECT_CACHE_HIT(2u, CheckPipelineRenders(CreateRenderPipeline()));
+
+    // The binary of the recompiled program replaces the invalid one.
+    EXPECT_CACHE_HIT(2u, CheckPipelineRenders(CreateRenderPipeline()));
+    EXPECT_EQ(mPersistentCache.mCache.size(), 1u);
+}
+
+DAWN_INSTANTIATE_TEST(OpenGLCachingTests, OpenGLBackend(), OpenGLESBackend());
@@ -34,7 +34,8 @@ DAWN_INSTANTIATE_TEST(QueueTests,
                       NullBackend(),
                       OpenGLBackend(),
                       OpenGLESBackend(),
-                      VulkanBackend());
+                      VulkanBackend(),
+                      VulkanBackend({"vulkan_use_dedicated_transfer_queue"}));
 
 class QueueWriteBufferTests : public DawnTest {};
 
@@ -189,8 +190,10 @@ DAWN_INSTANTIATE_TEST(QueueWriteBufferTests,
                       D3D12Backend(),
                       MetalBackend(),
                       OpenGLBackend(),
+                      OpenGLBackend({"disable_persistently_mapped_uploads"}),
                       OpenGLESBackend(),
-                      VulkanBackend());
+                      VulkanBackend(),
+                      VulkanBackend({"vulkan_use_dedicated_transfer_queue"}));
 
 // For MinimumDataSpec bytesPerRow and rowsPerImage, compute a default from the copy extent.
 constexpr uint32_t kStrideComputeDefault = 0xFFFF'FFFEul;
@@ -708,4 +711,5 @@ DAWN_INSTANTIATE_TEST(QueueWriteTextureTests,
                       MetalBackend(),
                       OpenGLBackend(),
                       OpenGLESBackend(),
-                      VulkanBackend());
+                      VulkanBackend(),
+                      VulkanBackend({"vulkan_use_dedicated_transfer_queue"}));
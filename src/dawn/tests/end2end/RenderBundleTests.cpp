@@ -193,6 +193,83 @@ TEST_P(RenderBundleTest, BundleAndRenderPassCommands) {
     EXPECT_PIXEL_RGBA8_EQ(kColors[1], renderPass.color, 3, 1);
 }
 
+// Test executing the same bundle in several render passes and submits.
+TEST_P(RenderBundleTest, BundleExecutedInSeveralRenderPasses) {
+    utils::ComboRenderBundleEncoderDescriptor desc = {};
+    desc.colorFormatsCount = 1;
+    desc.cColorFormats[0] = renderPass.colorFormat;
+
+    wgpu::RenderBundle renderBundles[2];
+    for (uint32_t i = 0; i < 2; ++i) {
+        wgpu::RenderBundleEncoder renderBundleEncoder = device.CreateRenderBundleEncoder(&desc);
+
+        renderBundleEncoder.SetPipeline(pipeline);
+        renderBundleEncoder.SetVertexBuffer(0, vertexBuffer);
+        renderBundleEncoder.SetBindGroup(0, bindGroups[i]);
+        renderBundleEncoder.Draw(6);
+
+        renderBundles[i] = renderBundleEncoder.Finish();
+    }
+
+    // Alternate between the bundles so that each one is executed again after the other.
+    for (uint32_t i = 0; i < 4; ++i) {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        for (uint32_t j = 0; j < 2; ++j) {
+            wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass.renderPassInfo);
+            pass.ExecuteBundles(1, &renderBundles[(i + j) % 2]);
+            pass.End();
+        }
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+
+        EXPECT_PIXEL_RGBA8_EQ(kColors[(i + 1) % 2], renderPass.color, 1, 3);
+        EXPECT_PIXEL_RGBA8_EQ(kColors[(i + 1) % 2], renderPass.color, 3, 1);
+    }
+}
+
+// Test that bundles use the dynamic state of the render pass executing them.
+TEST_P(RenderBundleTest, BundleUsesRenderPassDynamicState) {
+    utils::ComboRenderBundleEncoderDescriptor desc = {};
+    desc.colorFormatsCount = 1;
+    desc.cColorFormats[0] = renderPass.colorFormat;
+
+    wgpu::RenderBundleEncoder renderBundleEncoder = device.CreateRenderBundleEncoder(&desc);
+
+    renderBundleEncoder.SetPipeline(pipeline);
+    renderBundleEncoder.SetVertexBuffer(0, vertexBuffer);
+    renderBundleEncoder.SetBindGroup(0, bindGroups[0]);
+    renderBundleEncoder.Draw(6);
+
+    wgpu::RenderBundle renderBundle = renderBundleEncoder.Finish();
+
+    // Draw with the viewport covering the left half, then the top half of the render target.
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    {
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass.renderPassInfo);
+        pass.SetViewport(0, 0, kRTSize / 2, kRTSize, 0, 1);
+        pass.ExecuteBundles(1, &renderBundle);
+        pass.End();
+    }
+    wgpu::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+
+    EXPECT_PIXEL_RGBA8_EQ(kColors[0], renderPass.color, 1, 3);
+    EXPECT_PIXEL_RGBA8_EQ(RGBA8::kZero, renderPass.color, 3, 1);
+
+    encoder = device.CreateCommandEncoder();
+    {
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass.renderPassInfo);
+        pass.SetViewport(0, 0, kRTSize, kRTSize / 2, 0, 1);
+        pass.ExecuteBundles(1, &renderBundle);
+        pass.End();
+    }
+    commands = encoder.Finish();
+    queue.Submit(1, &commands);
+
+    EXPECT_PIXEL_RGBA8_EQ(RGBA8::kZero, renderPass.color, 1, 3);
+    EXPECT_PIXEL_RGBA8_EQ(kColors[0], renderPass.color, 3, 1);
+}
+
 DAWN_INSTANTIATE_TEST(RenderBundleTest,
                       D3D12Backend(),
                       MetalBackend(),
@@ -0,0 +1,130 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/tests/DawnTest.h"
+
+#include "dawn/tests/end2end/FakePersistentCache.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace {
+
+    constexpr char kComputeShader[] = R"(
+        struct Data {
+            data : u32;
+        };
+        @binding(0) @group(0) var<storage, read_write> data : Data;
+
+        @stage(compute) @workgroup_size(1) fn main() {
+            data.data = 42u;
+        }
+    )";
+
+}  // anonymous namespace
+
+class ShaderModuleCachingTests : public DawnTest {
+  protected:
+    std::unique_ptr<dawn::platform::Platform> CreateTestPlatform() override {
+        return std::make_unique<DawnTestPlatform>(&mPersistentCache);
+    }
+
+    // Creates the module and releases the previous one so that it isn't found in the device's
+    // in-memory cache of shader modules.
+    wgpu::ShaderModule RecreateModule(const char* source) {
+        wgpu::ShaderModule module = utils::CreateShaderModule(device, source);
+        FlushWire();
+        return module;
+    }
+
+    FakePersistentCache mPersistentCache{dawn::native::PersistentKeyType::ShaderReflection};
+};
+
+// Test that the reflection of a shader module is stored and used for the next module with the same
+// source, and that the module can still be used in a pipeline.
+TEST_P(ShaderModuleCachingTests, ReuseReflectionAcrossShaderModules) {
+    EXPECT_CACHE_HIT(0u, RecreateModule(kComputeShader));
+    EXPECT_EQ(mPersistentCache.mCache.size(), 1u);
+
+    // Loading the reflection calls LoadData twice (once to peek, again to get).
+    wgpu::ShaderModule module;
+    EXPECT_CACHE_HIT(2u, module = RecreateModule(kComputeShader));
+    EXPECT_EQ(mPersistentCache.mCache.size(), 1u);
+
+    // The pipeline is created from the cached reflection and the source parsed lazily.
+    wgpu::ComputePipelineDescriptor desc;
+    desc.compute.module = module;
+    desc.compute.entryPoint = "main";
+    wgpu::ComputePipeline pipeline = device.CreateComputePipeline(&desc);
+
+    wgpu::BufferDescriptor bufferDesc;
+    bufferDesc.size = sizeof(uint32_t);
+    bufferDesc.usage = wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc;
+    wgpu::Buffer buffer = device.CreateBuffer(&bufferDesc);
+
+    wgpu::BindGroup bindGroup =
+        utils::MakeBindGroup(device, pipeline.GetBindGroupLayout(0), {{0, buffer}});
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+    pass.SetPipeline(pipeline);
+    pass.SetBindGroup(0, bindGroup);
+    pass.Dispatch(1);
+    pass.End();
+    wgpu::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+
+    EXPECT_BUFFER_U32_EQ(42u, buffer, 0);
+}
+
+// Test that modules created from the cached reflection still validate their usage.
+TEST_P(ShaderModuleCachingTests, CachedReflectionIsValidated) {
+    DAWN_TEST_UNSUPPORTED_IF(HasToggleEnabled("skip_validation"));
+
+    RecreateModule(kComputeShader);
+    wgpu::ShaderModule module;
+    EXPECT_CACHE_HIT(2u, module = RecreateModule(kComputeShader));
+
+    wgpu::ComputePipelineDescriptor desc;
+    desc.compute.module = module;
+    desc.compute.entryPoint = "missing";
+    ASSERT_DEVICE_ERROR(device.CreateComputePipeline(&desc));
+
+    // The bind group layout doesn't match the storage buffer used by the shader.
+    desc.layout = utils::MakePipelineLayout(
+        device, {utils::MakeBindGroupLayout(
+                    device, {{0, wgpu::ShaderStage::Compute, wgpu::BufferBindingType::Uniform}})});
+    desc.compute.entryPoint = "main";
+    ASSERT_DEVICE_ERROR(device.CreateComputePipeline(&desc));
+}
+
+// Test that modules with a different source don't use the cached reflection.
+TEST_P(ShaderModuleCachingTests, DifferentSourcesAreCachedSeparately) {
+    EXPECT_CACHE_HIT(0u, RecreateModule(kComputeShader));
+
+    constexpr char kOtherShader[] = R"(
+        @stage(compute) @workgroup_size(2) fn main() {
+        }
+    )";
+    EXPECT_CACHE_HIT(0u, RecreateModule(kOtherShader));
+    EXPECT_EQ(mPersistentCache.mCache.size(), 2u);
+
+    EXPECT_CACHE_HIT(2u, RecreateModule(kOtherShader));
+    EXPECT_EQ(mPersistentCache.mCache.size(), 2u);
+}
+
+DAWN_INSTANTIATE_TEST(ShaderModuleCachingTests,
+                      D3D12Backend(),
+                      MetalBackend(),
+                      OpenGLBackend(),
+                      OpenGLESBackend(),
+                      VulkanBackend());
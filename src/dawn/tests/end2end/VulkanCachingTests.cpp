@@ -0,0 +1,110 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/tests/DawnTest.h"
+
+#include "dawn/tests/end2end/FakePersistentCache.h"
+#include "dawn/utils/ComboRenderPipelineDescriptor.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace {
+
+    constexpr char kRenderShader[] = R"(
+        @stage(vertex) fn vertex_main() -> @builtin(position) vec4<f32> {
+            return vec4<f32>(0.0, 0.0, 0.0, 1.0);
+        }
+
+        @stage(fragment) fn fragment_main() -> @location(0) vec4<f32> {
+          return vec4<f32>(1.0, 0.0, 0.0, 1.0);
+        }
+    )";
+
+}  // anonymous namespace
+
+class VulkanCachingTests : public DawnTest {
+  protected:
+    std::unique_ptr<dawn::platform::Platform> CreateTestPlatform() override {
+        return std::make_unique<DawnTestPlatform>(&mPersistentCache);
+    }
+
+    void CreateRenderPipeline() {
+        // The shader module is created for each pipeline so that the SPIR-V isn't found in the
+        // in-memory cache of the previous shader module.
+        wgpu::ShaderModule module = utils::CreateShaderModule(device, kRenderShader);
+
+        utils::ComboRenderPipelineDescriptor desc;
+        desc.vertex.module = module;
+        desc.vertex.entryPoint = "vertex_main";
+        desc.cFragment.module = module;
+        desc.cFragment.entryPoint = "fragment_main";
+        device.CreateRenderPipeline(&desc);
+    }
+
+    FakePersistentCache mPersistentCache{dawn::native::PersistentKeyType::Shader};
+};
+
+// Test that the SPIR-V generated for each entry point is cached and loaded again when a new
+// shader module with the same source is used.
+TEST_P(VulkanCachingTests, ReuseSpirvAcrossShaderModules) {
+    // Store the SPIR-V of both stages into the cache.
+    EXPECT_CACHE_HIT(0u, CreateRenderPipeline());
+    EXPECT_EQ(mPersistentCache.mCache.size(), 2u);
+
+    // Load the SPIR-V from the cache. Each load calls LoadData twice (once to peek, again to
+    // get), so check 2 x kNumOfShaders hits.
+    EXPECT_CACHE_HIT(4u, CreateRenderPipeline());
+    EXPECT_EQ(mPersistentCache.mCache.size(), 2u);
+}
+
+// Test that the same entry point used with layouts that remap the bindings differently is cached
+// separately.
+TEST_P(VulkanCachingTests, DifferentLayoutsAreCachedSeparately) {
+    constexpr char kComputeShader[] = R"(
+        struct Data {
+            data : u32;
+        };
+        @binding(1) @group(0) var<storage, read_write> data : Data;
+
+        @stage(compute) @workgroup_size(1) fn main() {
+            data.data = 1u;
+        }
+    )";
+
+    // BindingNumber 1 is BindingIndex 0 in the first layout and BindingIndex 1 in the second.
+    wgpu::BindGroupLayout bgl1 = utils::MakeBindGroupLayout(
+        device, {{1, wgpu::ShaderStage::Compute, wgpu::BufferBindingType::Storage}});
+    wgpu::BindGroupLayout bgl2 = utils::MakeBindGroupLayout(
+        device, {{0, wgpu::ShaderStage::Compute, wgpu::BufferBindingType::Storage},
+                 {1, wgpu::ShaderStage::Compute, wgpu::BufferBindingType::Storage}});
+
+    for (const wgpu::BindGroupLayout& bgl : {bgl1, bgl2}) {
+        wgpu::ComputePipelineDescriptor desc;
+        desc.layout = utils::MakePipelineLayout(device, {bgl});
+        desc.compute.module = utils::CreateShaderModule(device, kComputeShader);
+        desc.compute.entryPoint = "main";
+        EXPECT_CACHE_HIT(0u, device.CreateComputePipeline(&desc));
+    }
+    EXPECT_EQ(mPersistentCache.mCache.size(), 2u);
+
+    for (const wgpu::BindGroupLayout& bgl : {bgl1, bgl2}) {
+        wgpu::ComputePipelineDescriptor desc;
+        desc.layout = utils::MakePipelineLayout(device, {bgl});
+        desc.compute.module = utils::CreateShaderModule(device, kComputeShader);
+        desc.compute.entryPoint = "main";
+        EXPECT_CACHE_HIT(2u, device.CreateComputePipeline(&desc));
+    }
+    EXPECT_EQ(mPersistentCache.mCache.size(), 2u);
+}
+
+DAWN_INSTANTIATE_TEST(VulkanCachingTests, VulkanBackend());
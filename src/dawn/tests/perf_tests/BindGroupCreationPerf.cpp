@@ -0,0 +1,113 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+
+#include "dawn/utils/WGPUHelpers.h"
+
+#include <vector>
+
+namespace {
+
+    constexpr unsigned int kNumIterations = 50;
+    constexpr uint32_t kBindGroupsPerStep = 1000;
+
+    struct BindGroupCreationParams : AdapterTestParam {
+        BindGroupCreationParams(const AdapterTestParam& param, uint32_t bindingsPerGroup)
+            : AdapterTestParam(param), bindingsPerGroup(bindingsPerGroup) {
+        }
+        uint32_t bindingsPerGroup;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const BindGroupCreationParams& param) {
+        ostream << static_cast<const AdapterTestParam&>(param);
+        ostream << "_bindings_" << param.bindingsPerGroup;
+        return ostream;
+    }
+
+}  // anonymous namespace
+
+// Test the CPU cost of creating many bind groups and submitting once, like applications that
+// create bind groups for each draw of a frame. Each step ends with a submit so that the cost of
+// writing the descriptors, which some backends defer until then, is included.
+class BindGroupCreationPerf : public DawnPerfTestWithParams<BindGroupCreationParams> {
+  public:
+    BindGroupCreationPerf() : DawnPerfTestWithParams(kNumIterations, 1) {
+    }
+    ~BindGroupCreationPerf() override = default;
+
+    void SetUp() override;
+
+  private:
+    void Step() override;
+
+    wgpu::BindGroupLayout mLayout;
+    std::vector<wgpu::BindGroupEntry> mEntries;
+    std::vector<wgpu::BindGroup> mBindGroups;
+};
+
+void BindGroupCreationPerf::SetUp() {
+    // Skip the check for CPU adapters done in DawnPerfTestWithParams::SetUp: the driver cost of
+    // writing descriptors is the most visible on software implementations like SwiftShader and
+    // lavapipe.
+    DawnTestWithParams<BindGroupCreationParams>::SetUp();
+
+    std::vector<wgpu::BindGroupLayoutEntry> layoutEntries(GetParam().bindingsPerGroup);
+    mEntries.resize(GetParam().bindingsPerGroup);
+    for (uint32_t i = 0; i < GetParam().bindingsPerGroup; ++i) {
+        layoutEntries[i].binding = i;
+        layoutEntries[i].visibility = wgpu::ShaderStage::Fragment;
+        layoutEntries[i].buffer.type = wgpu::BufferBindingType::Uniform;
+
+        wgpu::BufferDescriptor bufferDesc;
+        bufferDesc.size = 256;
+        bufferDesc.usage = wgpu::BufferUsage::Uniform;
+
+        mEntries[i].binding = i;
+        mEntries[i].buffer = device.CreateBuffer(&bufferDesc);
+        mEntries[i].size = 256;
+    }
+
+    wgpu::BindGroupLayoutDescriptor layoutDesc;
+    layoutDesc.entryCount = layoutEntries.size();
+    layoutDesc.entries = layoutEntries.data();
+    mLayout = device.CreateBindGroupLayout(&layoutDesc);
+
+    mBindGroups.resize(kBindGroupsPerStep);
+}
+
+void BindGroupCreationPerf::Step() {
+    wgpu::BindGroupDescriptor desc;
+    desc.layout = mLayout;
+    desc.entryCount = mEntries.size();
+    desc.entries = mEntries.data();
+
+    for (uint32_t i = 0; i < kBindGroupsPerStep; ++i) {
+        mBindGroups[i] = device.CreateBindGroup(&desc);
+    }
+
+    wgpu::CommandBuffer commands = device.CreateCommandEncoder().Finish();
+    queue.Submit(1, &commands);
+
+    // Release the bind groups so that their descriptor sets can be reused by later steps.
+    for (wgpu::BindGroup& bindGroup : mBindGroups) {
+        bindGroup = nullptr;
+    }
+}
+
+TEST_P(BindGroupCreationPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST_P(BindGroupCreationPerf, {VulkanBackend()}, {1, 4, 8});
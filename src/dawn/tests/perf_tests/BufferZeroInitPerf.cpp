@@ -0,0 +1,86 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+
+#include "dawn/utils/WGPUHelpers.h"
+
+#include <vector>
+
+namespace {
+
+    constexpr unsigned int kNumIterations = 16;
+
+    constexpr uint64_t kBufferSize = 256 * 1024 * 1024;
+    constexpr uint64_t kWriteSize = 1 * 1024 * 1024;
+
+}  // namespace
+
+// Test streaming data into the start of new large buffers with Queue::WriteBuffer, then copying
+// the written data out of them. Only the written ranges of the buffers are used, so none of the
+// buffers needs to be lazily cleared.
+class BufferZeroInitPerf : public DawnPerfTestWithParams<AdapterTestParam> {
+  public:
+    BufferZeroInitPerf() : DawnPerfTestWithParams(kNumIterations, 1), mData(kWriteSize) {
+    }
+    ~BufferZeroInitPerf() override = default;
+
+    void SetUp() override;
+
+  private:
+    void Step() override;
+
+    wgpu::Buffer mCopyDestination;
+    std::vector<uint8_t> mData;
+};
+
+void BufferZeroInitPerf::SetUp() {
+    DawnPerfTestWithParams<AdapterTestParam>::SetUp();
+
+    wgpu::BufferDescriptor desc;
+    desc.size = kWriteSize * kNumIterations;
+    desc.usage = wgpu::BufferUsage::CopyDst;
+    mCopyDestination = device.CreateBuffer(&desc);
+
+    for (size_t i = 0; i < mData.size(); ++i) {
+        mData[i] = static_cast<uint8_t>(i % 251);
+    }
+}
+
+void BufferZeroInitPerf::Step() {
+    wgpu::BufferDescriptor desc;
+    desc.size = kBufferSize;
+    desc.usage = wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::CopyDst;
+    wgpu::Buffer buffer = device.CreateBuffer(&desc);
+
+    for (unsigned int i = 0; i < kNumIterations; ++i) {
+        queue.WriteBuffer(buffer, i * kWriteSize, mData.data(), mData.size());
+    }
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    encoder.CopyBufferToBuffer(buffer, 0, mCopyDestination, 0, kWriteSize * kNumIterations);
+    wgpu::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+}
+
+TEST_P(BufferZeroInitPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST(BufferZeroInitPerf,
+                      D3D12Backend(),
+                      MetalBackend(),
+                      OpenGLBackend(),
+                      VulkanBackend(),
+                      VulkanBackend({}, {"lazy_clear_resource_on_first_use"}));
@@ -0,0 +1,93 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+
+#include <vector>
+
+namespace {
+
+    constexpr unsigned int kNumIterations = 50;
+    constexpr uint32_t kCommandBuffersPerStep = 500;
+
+    struct CommandEncodingParams : AdapterTestParam {
+        CommandEncodingParams(const AdapterTestParam& param, uint32_t commandsPerEncoder)
+            : AdapterTestParam(param), commandsPerEncoder(commandsPerEncoder) {
+        }
+        uint32_t commandsPerEncoder;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const CommandEncodingParams& param) {
+        ostream << static_cast<const AdapterTestParam&>(param);
+        ostream << "_commands_" << param.commandsPerEncoder;
+        return ostream;
+    }
+
+}  // anonymous namespace
+
+// Test the CPU cost of encoding and submitting many small command buffers, like applications
+// that record one command buffer per object or per upload. Most of it is spent allocating and
+// freeing the blocks that hold the commands, so the Null backend is used to leave the driver out.
+class CommandEncodingPerf : public DawnPerfTestWithParams<CommandEncodingParams> {
+  public:
+    CommandEncodingPerf() : DawnPerfTestWithParams(kNumIterations, 1) {
+    }
+    ~CommandEncodingPerf() override = default;
+
+    void SetUp() override;
+
+  private:
+    void Step() override;
+
+    wgpu::Buffer mSrc;
+    wgpu::Buffer mDst;
+    std::vector<wgpu::CommandBuffer> mCommandBuffers;
+};
+
+void CommandEncodingPerf::SetUp() {
+    // Skip the check for CPU adapters done in DawnPerfTestWithParams::SetUp since the Null
+    // backend reports itself as one.
+    DawnTestWithParams<CommandEncodingParams>::SetUp();
+
+    wgpu::BufferDescriptor desc;
+    desc.size = 4;
+    desc.usage = wgpu::BufferUsage::CopySrc;
+    mSrc = device.CreateBuffer(&desc);
+    desc.usage = wgpu::BufferUsage::CopyDst;
+    mDst = device.CreateBuffer(&desc);
+
+    mCommandBuffers.resize(kCommandBuffersPerStep);
+}
+
+void CommandEncodingPerf::Step() {
+    for (uint32_t i = 0; i < kCommandBuffersPerStep; ++i) {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        for (uint32_t j = 0; j < GetParam().commandsPerEncoder; ++j) {
+            encoder.CopyBufferToBuffer(mSrc, 0, mDst, 0, 4);
+        }
+        mCommandBuffers[i] = encoder.Finish();
+    }
+    queue.Submit(kCommandBuffersPerStep, mCommandBuffers.data());
+
+    // Release the command buffers so that their blocks can be reused by the next step.
+    for (wgpu::CommandBuffer& commandBuffer : mCommandBuffers) {
+        commandBuffer = nullptr;
+    }
+}
+
+TEST_P(CommandEncodingPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST_P(CommandEncodingPerf, {NullBackend()}, {1, 64});
@@ -0,0 +1,192 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+
+#include "dawn/common/ConcurrentCache.h"
+
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+    constexpr unsigned int kNumIterations = 20;
+    constexpr size_t kObjectCount = 1024;
+    constexpr size_t kOperationsPerThread = 20000;
+
+    enum class CacheType {
+        SingleMutex,
+        Sharded,
+    };
+
+    struct ConcurrentCacheParams : AdapterTestParam {
+        ConcurrentCacheParams(const AdapterTestParam& param,
+                              CacheType cacheType,
+                              uint32_t threadCount)
+            : AdapterTestParam(param), cacheType(cacheType), threadCount(threadCount) {
+        }
+        CacheType cacheType;
+        uint32_t threadCount;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const ConcurrentCacheParams& param) {
+        ostream << static_cast<const AdapterTestParam&>(param);
+
+        switch (param.cacheType) {
+            case CacheType::SingleMutex:
+                ostream << "_SingleMutex";
+                break;
+            case CacheType::Sharded:
+                ostream << "_Sharded";
+                break;
+        }
+        ostream << "_threads_" << param.threadCount;
+
+        return ostream;
+    }
+
+    class CachedObject {
+      public:
+        explicit CachedObject(size_t value) : mValue(value) {
+        }
+
+        struct EqualityFunc {
+            bool operator()(const CachedObject* a, const CachedObject* b) const {
+                return a->mValue == b->mValue;
+            }
+        };
+
+        struct HashFunc {
+            size_t operator()(const CachedObject* obj) const {
+                return std::hash<size_t>()(obj->mValue);
+            }
+        };
+
+      private:
+        size_t mValue;
+    };
+
+    // The previous implementation of ConcurrentCache, kept as the baseline: a single mutex
+    // serializes all the operations.
+    template <typename T>
+    class SingleMutexCache {
+      public:
+        T* Find(T* object) {
+            std::lock_guard<std::mutex> lock(mMutex);
+            auto iter = mCache.find(object);
+            if (iter == mCache.end()) {
+                return nullptr;
+            }
+            return *iter;
+        }
+
+        std::pair<T*, bool> Insert(T* object) {
+            std::lock_guard<std::mutex> lock(mMutex);
+            auto [value, inserted] = mCache.insert(object);
+            return {*value, inserted};
+        }
+
+        size_t Erase(T* object) {
+            std::lock_guard<std::mutex> lock(mMutex);
+            return mCache.erase(object);
+        }
+
+      private:
+        std::mutex mMutex;
+        std::unordered_set<T*, typename T::HashFunc, typename T::EqualityFunc> mCache;
+    };
+
+}  // anonymous namespace
+
+// Test the cost of looking up objects in a cache from several threads at once, like when
+// pipelines are created concurrently and each of them deduplicates its layouts and shader modules.
+// Most lookups hit, and one operation out of sixteen replaces an object.
+class ConcurrentCachePerf : public DawnPerfTestWithParams<ConcurrentCacheParams> {
+  public:
+    ConcurrentCachePerf() : DawnPerfTestWithParams(kNumIterations, 1) {
+    }
+    ~ConcurrentCachePerf() override = default;
+
+    void SetUp() override;
+
+  private:
+    void Step() override;
+
+    template <typename Cache>
+    void RunThreads(Cache* cache);
+
+    std::vector<std::unique_ptr<CachedObject>> mObjects;
+    SingleMutexCache<CachedObject> mSingleMutexCache;
+    ConcurrentCache<CachedObject> mShardedCache;
+};
+
+void ConcurrentCachePerf::SetUp() {
+    // Skip the check for CPU adapters done in DawnPerfTestWithParams::SetUp since the Null
+    // backend reports itself as one. No GPU work is done by this test.
+    DawnTestWithParams<ConcurrentCacheParams>::SetUp();
+
+    for (size_t i = 0; i < kObjectCount; ++i) {
+        mObjects.push_back(std::make_unique<CachedObject>(i));
+        mSingleMutexCache.Insert(mObjects.back().get());
+        mShardedCache.Insert(mObjects.back().get());
+    }
+}
+
+template <typename Cache>
+void ConcurrentCachePerf::RunThreads(Cache* cache) {
+    std::vector<std::thread> threads;
+    for (uint32_t thread = 0; thread < GetParam().threadCount; ++thread) {
+        threads.emplace_back([this, cache, thread] {
+            // Each thread looks up the objects in a different order.
+            size_t index = thread * 7919;
+            for (size_t i = 0; i < kOperationsPerThread; ++i) {
+                index = (index + 31) % kObjectCount;
+                CachedObject* object = mObjects[index].get();
+                CachedObject blueprint(index);
+                if (i % 16 == 0) {
+                    cache->Erase(object);
+                    cache->Insert(object);
+                } else {
+                    cache->Find(&blueprint);
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+void ConcurrentCachePerf::Step() {
+    switch (GetParam().cacheType) {
+        case CacheType::SingleMutex:
+            RunThreads(&mSingleMutexCache);
+            break;
+        case CacheType::Sharded:
+            RunThreads(&mShardedCache);
+            break;
+    }
+}
+
+TEST_P(ConcurrentCachePerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST_P(ConcurrentCachePerf,
+                        {NullBackend()},
+                        {CacheType::SingleMutex, CacheType::Sharded},
+                        {1, 4, 8});
@@ -0,0 +1,151 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+
+#include "dawn/tests/end2end/FakePersistentCache.h"
+#include "dawn/utils/ComboRenderPipelineDescriptor.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+    constexpr unsigned int kPipelineCount = 20;
+
+    enum class CacheState {
+        Cold,
+        Warm,
+    };
+
+    struct PipelineCacheParams : AdapterTestParam {
+        PipelineCacheParams(const AdapterTestParam& param, CacheState cacheState)
+            : AdapterTestParam(param), cacheState(cacheState) {
+        }
+        CacheState cacheState;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const PipelineCacheParams& param) {
+        ostream << static_cast<const AdapterTestParam&>(param);
+
+        switch (param.cacheState) {
+            case CacheState::Cold:
+                ostream << "_Cold";
+                break;
+            case CacheState::Warm:
+                ostream << "_Warm";
+                break;
+        }
+
+        return ostream;
+    }
+
+}  // anonymous namespace
+
+// Test the cost of creating a new device and compiling a set of render pipelines on it, like an
+// application does at startup, either with an empty cache or with the pipeline cache written by a
+// previous device.
+class PipelineCachePerf : public DawnPerfTestWithParams<PipelineCacheParams> {
+  public:
+    PipelineCachePerf() : DawnPerfTestWithParams(kPipelineCount, 1) {
+    }
+    ~PipelineCachePerf() override = default;
+
+    void SetUp() override;
+
+  protected:
+    std::unique_ptr<dawn::platform::Platform> CreateTestPlatform() override {
+        return std::make_unique<DawnTestPlatform>(&mPersistentCache);
+    }
+
+  private:
+    void Step() override;
+
+    void CreatePipelines(const wgpu::Device& testDevice);
+
+    // Only the VkPipelineCache is stored so that the measured savings come from the driver's
+    // cache rather than from skipping the shader translation.
+    FakePersistentCache mPersistentCache{dawn::native::PersistentKeyType::PipelineCache};
+    std::vector<std::string> mFragmentShaders;
+};
+
+void PipelineCachePerf::SetUp() {
+    DawnPerfTestWithParams<PipelineCacheParams>::SetUp();
+    DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+
+    // Each device stores the pipeline cache again when it is destroyed.
+    mPersistentCache.mCanReplaceEntries = true;
+
+    // Make each pipeline different so that none of them is deduplicated by the driver.
+    for (unsigned int i = 0; i < kPipelineCount; ++i) {
+        std::ostringstream fragmentShader;
+        fragmentShader << R"(
+            @stage(fragment) fn main(@builtin(position) position : vec4<f32>)
+                -> @location(0) vec4<f32> {
+                var color = vec4<f32>(0.0, 0.0, 0.0, 1.0);
+                for (var j = 0; j < )"
+                       << (i + 1) << R"(; j = j + 1) {
+                    color.r = color.r + sin(position.x * f32(j));
+                    color.g = color.g + cos(position.y * f32(j));
+                }
+                return color;
+            })";
+        mFragmentShaders.push_back(fragmentShader.str());
+    }
+
+    if (GetParam().cacheState == CacheState::Warm) {
+        // Populate the cache from a device that is then destroyed.
+        wgpu::Device warmUpDevice = wgpu::Device::Acquire(GetAdapter().CreateDevice());
+        CreatePipelines(warmUpDevice);
+    }
+}
+
+void PipelineCachePerf::CreatePipelines(const wgpu::Device& testDevice) {
+    wgpu::ShaderModule vsModule = utils::CreateShaderModule(testDevice, R"(
+        @stage(vertex) fn main(@builtin(vertex_index) vertexIndex : u32)
+            -> @builtin(position) vec4<f32> {
+            var pos = array<vec2<f32>, 3>(
+                vec2<f32>(-1.0, -1.0), vec2<f32>(3.0, -1.0), vec2<f32>(-1.0, 3.0));
+            return vec4<f32>(pos[vertexIndex], 0.0, 1.0);
+        })");
+
+    for (const std::string& fragmentShader : mFragmentShaders) {
+        utils::ComboRenderPipelineDescriptor descriptor;
+        descriptor.vertex.module = vsModule;
+        descriptor.cFragment.module =
+            utils::CreateShaderModule(testDevice, fragmentShader.c_str());
+        testDevice.CreateRenderPipeline(&descriptor);
+    }
+}
+
+void PipelineCachePerf::Step() {
+    if (GetParam().cacheState == CacheState::Cold) {
+        mPersistentCache.mCache.clear();
+    }
+
+    // The pipeline cache is loaded when the device is created and stored when it is destroyed,
+    // so each step uses a new device.
+    wgpu::Device testDevice = wgpu::Device::Acquire(GetAdapter().CreateDevice());
+    CreatePipelines(testDevice);
+}
+
+TEST_P(PipelineCachePerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST_P(PipelineCachePerf,
+                        {VulkanBackend()},
+                        {CacheState::Cold, CacheState::Warm});
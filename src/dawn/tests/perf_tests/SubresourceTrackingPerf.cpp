@@ -17,6 +17,8 @@
 #include "dawn/utils/ComboRenderPipelineDescriptor.h"
 #include "dawn/utils/WGPUHelpers.h"
 
+#include <vector>
+
 struct SubresourceTrackingParams : AdapterTestParam {
     SubresourceTrackingParams(const AdapterTestParam& param,
                               uint32_t arrayLayerCountIn,
@@ -149,3 +151,108 @@ DAWN_INSTANTIATE_TEST_P(SubresourceTrackingPerf,
                         {D3D12Backend(), MetalBackend(), OpenGLBackend(), VulkanBackend()},
                         {1, 4, 16, 256},
                         {2, 3, 8});
+
+struct BindGroupTrackingParams : AdapterTestParam {
+    BindGroupTrackingParams(const AdapterTestParam& param, uint32_t bindGroupCountIn)
+        : AdapterTestParam(param), bindGroupCount(bindGroupCountIn) {
+    }
+    uint32_t bindGroupCount;
+};
+
+std::ostream& operator<<(std::ostream& ostream, const BindGroupTrackingParams& param) {
+    ostream << static_cast<const AdapterTestParam&>(param);
+    ostream << "_bindGroups_" << param.bindGroupCount;
+    return ostream;
+}
+
+// Test the performance of the resource usage tracking of a render pass that sets many bind groups,
+// each with its own uniform buffers and texture. Each SetBindGroup adds the usage of all these
+// resources to the pass' synchronization scope.
+class BindGroupUsageTrackingPerf : public DawnPerfTestWithParams<BindGroupTrackingParams> {
+  public:
+    static constexpr unsigned int kNumIterations = 50;
+
+    BindGroupUsageTrackingPerf() : DawnPerfTestWithParams(kNumIterations, 1) {
+    }
+    ~BindGroupUsageTrackingPerf() override = default;
+
+    void SetUp() override {
+        DawnPerfTestWithParams<BindGroupTrackingParams>::SetUp();
+
+        utils::ComboRenderPipelineDescriptor pipelineDesc;
+        pipelineDesc.vertex.module = utils::CreateShaderModule(device, R"(
+            @stage(vertex) fn main() -> @builtin(position) vec4<f32> {
+                return vec4<f32>(1.0, 0.0, 0.0, 1.0);
+            }
+        )");
+        pipelineDesc.cFragment.module = utils::CreateShaderModule(device, R"(
+            struct Uniforms {
+                value : vec4<f32>;
+            };
+            @group(0) @binding(0) var<uniform> u0 : Uniforms;
+            @group(0) @binding(1) var<uniform> u1 : Uniforms;
+            @group(0) @binding(2) var<uniform> u2 : Uniforms;
+            @group(0) @binding(3) var<uniform> u3 : Uniforms;
+            @group(0) @binding(4) var t : texture_2d<f32>;
+            @stage(fragment) fn main() -> @location(0) vec4<f32> {
+                let size : vec2<i32> = textureDimensions(t);
+                return u0.value + u1.value + u2.value + u3.value + vec4<f32>(f32(size.x));
+            }
+        )");
+        mPipeline = device.CreateRenderPipeline(&pipelineDesc);
+
+        wgpu::BufferDescriptor bufferDesc;
+        bufferDesc.size = 4 * sizeof(float);
+        bufferDesc.usage = wgpu::BufferUsage::Uniform;
+
+        wgpu::TextureDescriptor textureDesc;
+        textureDesc.size = {1, 1, 1};
+        textureDesc.usage = wgpu::TextureUsage::TextureBinding;
+        textureDesc.format = wgpu::TextureFormat::RGBA8Unorm;
+
+        for (uint32_t i = 0; i < GetParam().bindGroupCount; ++i) {
+            mBindGroups.push_back(utils::MakeBindGroup(
+                device, mPipeline.GetBindGroupLayout(0),
+                {{0, device.CreateBuffer(&bufferDesc)},
+                 {1, device.CreateBuffer(&bufferDesc)},
+                 {2, device.CreateBuffer(&bufferDesc)},
+                 {3, device.CreateBuffer(&bufferDesc)},
+                 {4, device.CreateTexture(&textureDesc).CreateView()}}));
+        }
+
+        wgpu::TextureDescriptor renderTargetDesc;
+        renderTargetDesc.size = {16, 16, 1};
+        renderTargetDesc.usage = wgpu::TextureUsage::RenderAttachment;
+        renderTargetDesc.format = wgpu::TextureFormat::RGBA8Unorm;
+        mRenderTarget = device.CreateTexture(&renderTargetDesc);
+    }
+
+  private:
+    void Step() override {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+
+        utils::ComboRenderPassDescriptor renderPass({mRenderTarget.CreateView()});
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+        pass.SetPipeline(mPipeline);
+        for (const wgpu::BindGroup& bindGroup : mBindGroups) {
+            pass.SetBindGroup(0, bindGroup);
+            pass.Draw(3);
+        }
+        pass.End();
+
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+    }
+
+    wgpu::RenderPipeline mPipeline;
+    std::vector<wgpu::BindGroup> mBindGroups;
+    wgpu::Texture mRenderTarget;
+};
+
+TEST_P(BindGroupUsageTrackingPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST_P(BindGroupUsageTrackingPerf,
+                        {D3D12Backend(), MetalBackend(), OpenGLBackend(), VulkanBackend()},
+                        {1, 16, 256});
@@ -0,0 +1,139 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+
+#include "dawn/utils/ComboRenderPipelineDescriptor.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+#include <array>
+#include <vector>
+
+namespace {
+
+    constexpr unsigned int kNumIterations = 10;
+
+    constexpr uint32_t kRenderTargetSize = 1024;
+    constexpr uint32_t kRenderPassCount = 4;
+
+    constexpr uint32_t kUploadTextureSize = 2048;
+    constexpr uint32_t kBytesPerTexel = 4;
+    // Uploads go to a ring of textures that aren't used by the rendering, like the streaming of
+    // textures used by the next frames.
+    constexpr size_t kUploadTextureCount = 3;
+
+}  // namespace
+
+// Test rendering while uploading large textures with Queue::WriteTexture. When the uploads are done
+// on a dedicated transfer queue, they can execute while the GPU renders.
+class TextureUploadOverlapPerf : public DawnPerfTestWithParams<AdapterTestParam> {
+  public:
+    TextureUploadOverlapPerf()
+        : DawnPerfTestWithParams(kNumIterations, 1),
+          mData(kUploadTextureSize * kUploadTextureSize * kBytesPerTexel) {
+    }
+    ~TextureUploadOverlapPerf() override = default;
+
+    void SetUp() override;
+
+  private:
+    void Step() override;
+
+    wgpu::RenderPipeline mPipeline;
+    wgpu::TextureView mRenderTargetView;
+    std::array<wgpu::Texture, kUploadTextureCount> mUploadTextures;
+    size_t mNextUploadTexture = 0;
+    std::vector<uint8_t> mData;
+};
+
+void TextureUploadOverlapPerf::SetUp() {
+    DawnPerfTestWithParams<AdapterTestParam>::SetUp();
+
+    wgpu::TextureDescriptor renderTargetDesc;
+    renderTargetDesc.size = {kRenderTargetSize, kRenderTargetSize};
+    renderTargetDesc.format = wgpu::TextureFormat::RGBA8Unorm;
+    renderTargetDesc.usage = wgpu::TextureUsage::RenderAttachment;
+    mRenderTargetView = device.CreateTexture(&renderTargetDesc).CreateView();
+
+    wgpu::TextureDescriptor uploadDesc;
+    uploadDesc.size = {kUploadTextureSize, kUploadTextureSize};
+    uploadDesc.format = wgpu::TextureFormat::RGBA8Unorm;
+    uploadDesc.usage = wgpu::TextureUsage::CopyDst | wgpu::TextureUsage::TextureBinding;
+    for (wgpu::Texture& texture : mUploadTextures) {
+        texture = device.CreateTexture(&uploadDesc);
+    }
+
+    for (size_t i = 0; i < mData.size(); ++i) {
+        mData[i] = static_cast<uint8_t>(i % 251);
+    }
+
+    // Draw a fullscreen triangle with a fragment shader that is expensive enough for the
+    // rendering to take about as long as the uploads.
+    utils::ComboRenderPipelineDescriptor pipelineDesc;
+    pipelineDesc.vertex.module = utils::CreateShaderModule(device, R"(
+        @stage(vertex) fn main(@builtin(vertex_index) VertexIndex : u32)
+                            -> @builtin(position) vec4<f32> {
+            var pos = array<vec2<f32>, 3>(
+                vec2<f32>(-1.0, -1.0),
+                vec2<f32>( 3.0, -1.0),
+                vec2<f32>(-1.0,  3.0));
+            return vec4<f32>(pos[VertexIndex], 0.0, 1.0);
+        }
+    )");
+    pipelineDesc.cFragment.module = utils::CreateShaderModule(device, R"(
+        @stage(fragment) fn main(@builtin(position) position : vec4<f32>)
+                              -> @location(0) vec4<f32> {
+            var value = position.xy;
+            for (var i : i32 = 0; i < 256; i = i + 1) {
+                value = fract(sin(value * 12.9898 + vec2<f32>(78.233, 37.719)) * 43758.5453);
+            }
+            return vec4<f32>(value, 0.0, 1.0);
+        }
+    )");
+    pipelineDesc.cTargets[0].format = wgpu::TextureFormat::RGBA8Unorm;
+    mPipeline = device.CreateRenderPipeline(&pipelineDesc);
+}
+
+void TextureUploadOverlapPerf::Step() {
+    wgpu::ImageCopyTexture destination =
+        utils::CreateImageCopyTexture(mUploadTextures[mNextUploadTexture], 0, {0, 0, 0});
+    mNextUploadTexture = (mNextUploadTexture + 1) % kUploadTextureCount;
+
+    wgpu::TextureDataLayout dataLayout =
+        utils::CreateTextureDataLayout(0, kUploadTextureSize * kBytesPerTexel);
+    wgpu::Extent3D copySize = {kUploadTextureSize, kUploadTextureSize};
+    queue.WriteTexture(&destination, mData.data(), mData.size(), &dataLayout, &copySize);
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    for (uint32_t i = 0; i < kRenderPassCount; ++i) {
+        utils::ComboRenderPassDescriptor renderPass({mRenderTargetView});
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+        pass.SetPipeline(mPipeline);
+        pass.Draw(3);
+        pass.End();
+    }
+    wgpu::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+}
+
+TEST_P(TextureUploadOverlapPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST(TextureUploadOverlapPerf,
+                      D3D12Backend(),
+                      MetalBackend(),
+                      OpenGLBackend(),
+                      VulkanBackend(),
+                      VulkanBackend({"vulkan_use_dedicated_transfer_queue"}));
@@ -0,0 +1,148 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+
+#include "dawn/platform/WorkerThread.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+    constexpr unsigned int kTaskCount = 1000;
+
+    enum class PoolType {
+        ThreadPerTask,
+        WorkStealing,
+    };
+
+    struct WorkerThreadPoolParams : AdapterTestParam {
+        WorkerThreadPoolParams(const AdapterTestParam& param, PoolType poolType)
+            : AdapterTestParam(param), poolType(poolType) {
+        }
+        PoolType poolType;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const WorkerThreadPoolParams& param) {
+        ostream << static_cast<const AdapterTestParam&>(param);
+
+        switch (param.poolType) {
+            case PoolType::ThreadPerTask:
+                ostream << "_ThreadPerTask";
+                break;
+            case PoolType::WorkStealing:
+                ostream << "_WorkStealing";
+                break;
+        }
+
+        return ostream;
+    }
+
+    // The previous implementation of AsyncWorkerThreadPool, kept as the baseline: every task gets
+    // its own detached thread.
+    class ThreadPerTaskPool : public dawn::platform::WorkerTaskPool {
+      public:
+        std::unique_ptr<dawn::platform::WaitableEvent> PostWorkerTask(
+            dawn::platform::PostWorkerTaskCallback callback,
+            void* userdata) override {
+            auto event = std::make_unique<Event>();
+            std::thread([callback, userdata, state = event->state]() {
+                callback(userdata);
+                {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    state->isComplete = true;
+                }
+                state->condition.notify_all();
+            }).detach();
+            return event;
+        }
+
+      private:
+        struct EventState {
+            std::mutex mutex;
+            std::condition_variable condition;
+            bool isComplete = false;
+        };
+
+        class Event : public dawn::platform::WaitableEvent {
+          public:
+            void Wait() override {
+                std::unique_lock<std::mutex> lock(state->mutex);
+                state->condition.wait(lock, [this] { return state->isComplete; });
+            }
+            bool IsComplete() override {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                return state->isComplete;
+            }
+
+            std::shared_ptr<EventState> state = std::make_shared<EventState>();
+        };
+    };
+
+    // A small amount of work so that the cost of dispatching the task dominates, like the
+    // trivially short tasks of a warm pipeline cache.
+    void SmallTask(void* userdata) {
+        std::atomic<uint64_t>* counter = static_cast<std::atomic<uint64_t>*>(userdata);
+        counter->fetch_add(1, std::memory_order_relaxed);
+    }
+
+}  // anonymous namespace
+
+// Test the cost of posting a burst of tasks to the worker task pool and waiting for all of them,
+// like a warm-up burst of CreateRenderPipelineAsync calls does.
+class WorkerThreadPoolPerf : public DawnPerfTestWithParams<WorkerThreadPoolParams> {
+  public:
+    WorkerThreadPoolPerf() : DawnPerfTestWithParams(kTaskCount, 1) {
+    }
+    ~WorkerThreadPoolPerf() override = default;
+
+    void SetUp() override {
+        DawnPerfTestWithParams<WorkerThreadPoolParams>::SetUp();
+
+        switch (GetParam().poolType) {
+            case PoolType::ThreadPerTask:
+                mPool = std::make_unique<ThreadPerTaskPool>();
+                break;
+            case PoolType::WorkStealing:
+                mPool = std::make_unique<dawn::platform::AsyncWorkerThreadPool>();
+                break;
+        }
+    }
+
+  private:
+    void Step() override {
+        std::vector<std::unique_ptr<dawn::platform::WaitableEvent>> events;
+        events.reserve(kTaskCount);
+        for (unsigned int i = 0; i < kTaskCount; ++i) {
+            events.push_back(mPool->PostWorkerTask(SmallTask, &mCounter));
+        }
+        for (std::unique_ptr<dawn::platform::WaitableEvent>& event : events) {
+            event->Wait();
+        }
+    }
+
+    std::unique_ptr<dawn::platform::WorkerTaskPool> mPool;
+    std::atomic<uint64_t> mCounter = {0};
+};
+
+TEST_P(WorkerThreadPoolPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST_P(WorkerThreadPoolPerf,
+                        {D3D12Backend(), MetalBackend(), OpenGLBackend(), VulkanBackend()},
+                        {PoolType::ThreadPerTask, PoolType::WorkStealing});
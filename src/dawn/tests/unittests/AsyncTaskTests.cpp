@@ -19,6 +19,8 @@
 
 #include <memory>
 #include <mutex>
+#include <utility>
+#include <vector>
 
 #include "dawn/common/NonCopyable.h"
 #include "dawn/native/AsyncTask.h"
@@ -58,6 +60,29 @@ namespace {
         resultQueue->AddResult(std::move(result));
     }
 
+    // A WorkerTaskPool that only runs the posted tasks when asked to, so that tests can control
+    // which tasks are still pending.
+    class ManualWorkerTaskPool : public dawn::platform::WorkerTaskPool {
+      public:
+        std::unique_ptr<dawn::platform::WaitableEvent> PostWorkerTask(
+            dawn::platform::PostWorkerTaskCallback callback,
+            void* userdata) override {
+            mTasks.push_back({callback, userdata});
+            return nullptr;
+        }
+
+        void RunAllTasks() {
+            std::vector<std::pair<dawn::platform::PostWorkerTaskCallback, void*>> tasks;
+            tasks.swap(mTasks);
+            for (auto& [callback, userdata] : tasks) {
+                callback(userdata);
+            }
+        }
+
+      private:
+        std::vector<std::pair<dawn::platform::PostWorkerTaskCallback, void*>> mTasks;
+    };
+
 }  // anonymous namespace
 
 class AsyncTaskTest : public testing::Test {};
@@ -87,3 +112,75 @@ TEST_F(AsyncTaskTest, Basic) {
     }
     ASSERT_TRUE(idset.empty());
 }
+
+// Test that a cancelled task doesn't run, calls its cancel callback and is no longer pending.
+TEST_F(AsyncTaskTest, Cancel) {
+    ManualWorkerTaskPool pool;
+    dawn::native::AsyncTaskManager taskManager(&pool);
+
+    bool ran = false;
+    bool cancelled = false;
+    Ref<dawn::native::AsyncTaskManager::WaitableTask> task =
+        taskManager.PostTask([&ran] { ran = true; }, [&cancelled] { cancelled = true; });
+    ASSERT_TRUE(taskManager.HasPendingTasks());
+
+    EXPECT_TRUE(taskManager.Cancel(task.Get()));
+    EXPECT_TRUE(cancelled);
+    EXPECT_FALSE(taskManager.HasPendingTasks());
+
+    // The worker skips the cancelled task, and it can't be cancelled or run a second time.
+    pool.RunAllTasks();
+    EXPECT_FALSE(ran);
+    EXPECT_FALSE(taskManager.Cancel(task.Get()));
+    EXPECT_FALSE(taskManager.RunNow(task.Get()));
+    EXPECT_FALSE(ran);
+}
+
+// Test that RunNow runs a pending task on the calling thread exactly once.
+TEST_F(AsyncTaskTest, RunNow) {
+    ManualWorkerTaskPool pool;
+    dawn::native::AsyncTaskManager taskManager(&pool);
+
+    uint32_t runCount = 0;
+    bool cancelled = false;
+    Ref<dawn::native::AsyncTaskManager::WaitableTask> task =
+        taskManager.PostTask([&runCount] { runCount++; }, [&cancelled] { cancelled = true; });
+
+    EXPECT_TRUE(taskManager.RunNow(task.Get()));
+    EXPECT_EQ(1u, runCount);
+    EXPECT_FALSE(taskManager.HasPendingTasks());
+
+    // The worker skips the stolen task, and it can no longer be cancelled.
+    pool.RunAllTasks();
+    EXPECT_EQ(1u, runCount);
+    EXPECT_FALSE(taskManager.Cancel(task.Get()));
+    EXPECT_FALSE(cancelled);
+
+    // Running it again only waits for the completed task.
+    EXPECT_TRUE(taskManager.RunNow(task.Get()));
+    EXPECT_EQ(1u, runCount);
+}
+
+// Test that CancelAllPendingTasks cancels the tasks that didn't start yet.
+TEST_F(AsyncTaskTest, CancelAllPendingTasks) {
+    ManualWorkerTaskPool pool;
+    dawn::native::AsyncTaskManager taskManager(&pool);
+
+    constexpr uint32_t kTaskCount = 4u;
+    uint32_t runCount = 0;
+    uint32_t cancelCount = 0;
+    std::vector<Ref<dawn::native::AsyncTaskManager::WaitableTask>> tasks;
+    for (uint32_t i = 0; i < kTaskCount; ++i) {
+        tasks.push_back(
+            taskManager.PostTask([&runCount] { runCount++; }, [&cancelCount] { cancelCount++; }));
+    }
+    taskManager.RunNow(tasks[0].Get());
+
+    taskManager.CancelAllPendingTasks();
+    EXPECT_FALSE(taskManager.HasPendingTasks());
+    EXPECT_EQ(1u, runCount);
+    EXPECT_EQ(kTaskCount - 1, cancelCount);
+
+    pool.RunAllTasks();
+    EXPECT_EQ(1u, runCount);
+}
@@ -325,3 +325,34 @@ TEST(BuddyAllocatorTests, VariousSizeSameAlignment) {
 
     ASSERT_EQ(allocator.ComputeTotalNumOfFreeBlocksForTesting(), 0u);
 }
+
+// Verify that the free blocks rejected by the filter are skipped.
+TEST(BuddyAllocatorTests, FilteredAllocation) {
+    //  After four 8 byte allocations then freeing Ab and Ad.
+    //
+    //  Level          --------------------------------
+    //      0       32 |               S              |
+    //                 --------------------------------
+    //      1       16 |       S       |       S      |       S - split
+    //                 --------------------------------       F - free
+    //      2       8  |   Aa  |   F   |  Ac   |  F   |       A - allocated
+    //                 --------------------------------
+    //
+    BuddyAllocator allocator(32);
+
+    ASSERT_EQ(allocator.Allocate(8), 0u);
+    ASSERT_EQ(allocator.Allocate(8), 8u);
+    ASSERT_EQ(allocator.Allocate(8), 16u);
+    ASSERT_EQ(allocator.Allocate(8), 24u);
+    allocator.Deallocate(8);
+    allocator.Deallocate(24);
+    ASSERT_EQ(allocator.ComputeTotalNumOfFreeBlocksForTesting(), 2u);
+
+    // The last freed block is the head of the free list, skip it to allocate the other one.
+    auto isBlockUsable = [](uint64_t offset, uint64_t size) { return offset < 16; };
+    ASSERT_EQ(allocator.Allocate(8, 1, isBlockUsable), 8u);
+
+    // Check that there is no usable block left.
+    ASSERT_EQ(allocator.Allocate(8, 1, isBlockUsable), BuddyAllocator::kInvalidOffset);
+    ASSERT_EQ(allocator.Allocate(8), 24u);
+}
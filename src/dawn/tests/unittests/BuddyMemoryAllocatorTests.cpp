@@ -18,6 +18,7 @@
 #include "dawn/native/PooledResourceMemoryAllocator.h"
 #include "dawn/native/ResourceHeapAllocator.h"
 
+#include <functional>
 #include <set>
 #include <vector>
 
@@ -54,6 +55,18 @@ class DummyBuddyResourceAllocator {
         mAllocator.Deallocate(allocation);
     }
 
+    ResourceMemoryAllocation AllocateInExistingHeaps(
+        uint64_t allocationSize,
+        uint64_t alignment = 1,
+        const std::function<bool(const ResourceHeapBase*)>& isHeapUsable =
+            [](const ResourceHeapBase*) { return true; }) {
+        return mAllocator.AllocateInExistingHeaps(allocationSize, alignment, isHeapUsable);
+    }
+
+    std::vector<BuddyMemoryAllocator::HeapUsage> GetHeapUsages() const {
+        return mAllocator.GetHeapUsages();
+    }
+
     uint64_t ComputeTotalNumOfHeapsForTesting() const {
         return mAllocator.ComputeTotalNumOfHeapsForTesting();
     }
@@ -458,3 +471,86 @@ TEST(BuddyMemoryAllocatorTests, DestroyHeaps) {
     poolAllocator.DestroyPool();
     ASSERT_EQ(poolAllocator.GetPoolSizeForTesting(), 0u);
 }
+
+// Verify that allocating in the existing heaps never creates a heap.
+TEST(BuddyMemoryAllocatorTests, AllocateInExistingHeaps) {
+    constexpr uint64_t heapSize = 128;
+    constexpr uint64_t maxBlockSize = 512;
+    DummyBuddyResourceAllocator allocator(maxBlockSize, heapSize);
+
+    // There is no heap to allocate in yet.
+    ResourceMemoryAllocation invalidAllocation = allocator.AllocateInExistingHeaps(64);
+    ASSERT_EQ(invalidAllocation.GetInfo().mMethod, AllocationMethod::kInvalid);
+    ASSERT_EQ(allocator.ComputeTotalNumOfHeapsForTesting(), 0u);
+
+    ResourceMemoryAllocation allocation1 = allocator.Allocate(64);
+    ASSERT_EQ(allocation1.GetInfo().mMethod, AllocationMethod::kSubAllocated);
+
+    // The second half of the heap of allocation1 is used.
+    ResourceMemoryAllocation allocation2 = allocator.AllocateInExistingHeaps(64);
+    ASSERT_EQ(allocation2.GetInfo().mMethod, AllocationMethod::kSubAllocated);
+    ASSERT_EQ(allocation2.GetInfo().mBlockOffset, 64u);
+    ASSERT_EQ(allocation2.GetResourceHeap(), allocation1.GetResourceHeap());
+
+    // The heap is full.
+    invalidAllocation = allocator.AllocateInExistingHeaps(64);
+    ASSERT_EQ(invalidAllocation.GetInfo().mMethod, AllocationMethod::kInvalid);
+    ASSERT_EQ(allocator.ComputeTotalNumOfHeapsForTesting(), 1u);
+
+    allocator.Deallocate(allocation1);
+    allocator.Deallocate(allocation2);
+    ASSERT_EQ(allocator.ComputeTotalNumOfHeapsForTesting(), 0u);
+}
+
+// Verify that the heaps rejected by the filter are skipped.
+TEST(BuddyMemoryAllocatorTests, AllocateInExistingHeapsFiltered) {
+    constexpr uint64_t heapSize = 128;
+    constexpr uint64_t maxBlockSize = 512;
+    DummyBuddyResourceAllocator allocator(maxBlockSize, heapSize);
+
+    // Allocate A1 in H0 and A2 in H1.
+    ResourceMemoryAllocation allocation1 = allocator.Allocate(64);
+    ResourceMemoryAllocation allocation2 = allocator.Allocate(128);
+    ASSERT_EQ(allocator.ComputeTotalNumOfHeapsForTesting(), 2u);
+    allocator.Deallocate(allocation2);
+
+    // Only H0 has free space, and it is rejected.
+    ResourceHeapBase* excludedHeap = allocation1.GetResourceHeap();
+    ResourceMemoryAllocation invalidAllocation = allocator.AllocateInExistingHeaps(
+        64, 1, [&](const ResourceHeapBase* heap) { return heap != excludedHeap; });
+    ASSERT_EQ(invalidAllocation.GetInfo().mMethod, AllocationMethod::kInvalid);
+
+    allocator.Deallocate(allocation1);
+}
+
+// Verify the usage reported for each heap.
+TEST(BuddyMemoryAllocatorTests, HeapUsages) {
+    constexpr uint64_t heapSize = 128;
+    constexpr uint64_t maxBlockSize = 512;
+    DummyBuddyResourceAllocator allocator(maxBlockSize, heapSize);
+
+    ASSERT_TRUE(allocator.GetHeapUsages().empty());
+
+    // The sizes are the sizes of the buddy blocks, rounded up to a power of two.
+    ResourceMemoryAllocation allocation1 = allocator.Allocate(24);
+    ResourceMemoryAllocation allocation2 = allocator.Allocate(64);
+    ResourceMemoryAllocation allocation3 = allocator.Allocate(128);
+
+    std::vector<BuddyMemoryAllocator::HeapUsage> usages = allocator.GetHeapUsages();
+    ASSERT_EQ(usages.size(), 2u);
+    ASSERT_EQ(usages[0].heap, allocation1.GetResourceHeap());
+    ASSERT_EQ(usages[0].subAllocationCount, 2u);
+    ASSERT_EQ(usages[0].usedSize, 32u + 64u);
+    ASSERT_EQ(usages[1].heap, allocation3.GetResourceHeap());
+    ASSERT_EQ(usages[1].subAllocationCount, 1u);
+    ASSERT_EQ(usages[1].usedSize, 128u);
+
+    allocator.Deallocate(allocation2);
+    usages = allocator.GetHeapUsages();
+    ASSERT_EQ(usages[0].subAllocationCount, 1u);
+    ASSERT_EQ(usages[0].usedSize, 32u);
+
+    allocator.Deallocate(allocation1);
+    allocator.Deallocate(allocation3);
+    ASSERT_TRUE(allocator.GetHeapUsages().empty());
+}
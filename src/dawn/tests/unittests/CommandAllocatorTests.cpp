@@ -501,3 +501,86 @@ TEST(CommandAllocator, AcquireCommandBlocks) {
     ASSERT_FALSE(iterator.NextCommandId(&type));
     iterator.MakeEmptyAsDataWasDestroyed();
 }
+
+// Test that the blocks of an allocator using a CommandBlockPool are returned to the pool and
+// reused by the next allocator.
+TEST(CommandAllocator, BlockPoolReusesBlocks) {
+    Ref<CommandBlockPool> pool = AcquireRef(new CommandBlockPool());
+
+    const void* firstCommand = nullptr;
+    {
+        CommandAllocator allocator(pool.Get());
+        CommandDraw* draw = allocator.Allocate<CommandDraw>(CommandType::Draw);
+        draw->first = 42;
+        draw->count = 16;
+        firstCommand = draw;
+
+        CommandIterator iterator(std::move(allocator));
+        CommandType type;
+        ASSERT_TRUE(iterator.NextCommandId(&type));
+        ASSERT_EQ(type, CommandType::Draw);
+        ASSERT_EQ(iterator.NextCommand<CommandDraw>()->first, 42u);
+        iterator.MakeEmptyAsDataWasDestroyed();
+    }
+    EXPECT_EQ(pool->GetCachedSizeForTesting(), CommandBlockPool::kMinBlockSize);
+
+    // The moved-from allocator keeps using the pool.
+    CommandAllocator allocator(pool.Get());
+    CommandAllocator movedTo(std::move(allocator));
+    CommandDraw* draw = allocator.Allocate<CommandDraw>(CommandType::Draw);
+    EXPECT_EQ(draw, firstCommand);
+    EXPECT_EQ(pool->GetCachedSizeForTesting(), 0u);
+
+    // Blocks too big for the pool are freed directly.
+    allocator.Allocate<CommandBig>(CommandType::Big);
+    allocator.Reset();
+    EXPECT_EQ(pool->GetCachedSizeForTesting(), CommandBlockPool::kMinBlockSize);
+}
+
+// Test that the blocks of the pool are rounded up to the size classes.
+TEST(CommandAllocator, BlockPoolSizeClasses) {
+    Ref<CommandBlockPool> pool = AcquireRef(new CommandBlockPool());
+
+    BlockDef small = pool->Allocate(1);
+    EXPECT_EQ(small.size, CommandBlockPool::kMinBlockSize);
+    BlockDef medium = pool->Allocate(CommandBlockPool::kMinBlockSize + 1);
+    EXPECT_EQ(medium.size, 2 * CommandBlockPool::kMinBlockSize);
+    BlockDef large = pool->Allocate(CommandBlockPool::kMaxBlockSize);
+    EXPECT_EQ(large.size, CommandBlockPool::kMaxBlockSize);
+
+    pool->Deallocate(small);
+    pool->Deallocate(medium);
+    pool->Deallocate(large);
+    EXPECT_EQ(pool->GetCachedSizeForTesting(),
+              3 * CommandBlockPool::kMinBlockSize + CommandBlockPool::kMaxBlockSize);
+
+    // Blocks are only reused for requests of the same size class.
+    BlockDef reused = pool->Allocate(CommandBlockPool::kMinBlockSize * 2);
+    EXPECT_EQ(reused.block, medium.block);
+    pool->Deallocate(reused);
+}
+
+// Test that Trim() keeps the blocks needed to reach the high-water mark since the previous trim.
+TEST(CommandAllocator, BlockPoolTrimToHighWaterMark) {
+    Ref<CommandBlockPool> pool = AcquireRef(new CommandBlockPool());
+    constexpr size_t kBlockSize = CommandBlockPool::kMinBlockSize;
+
+    BlockDef a = pool->Allocate(kBlockSize);
+    BlockDef b = pool->Allocate(kBlockSize);
+    pool->Deallocate(a);
+    pool->Deallocate(b);
+
+    // Two blocks were in use at the same time so both are kept.
+    pool->Trim();
+    EXPECT_EQ(pool->GetCachedSizeForTesting(), 2 * kBlockSize);
+
+    // Only one block was in use since the previous trim.
+    a = pool->Allocate(kBlockSize);
+    pool->Deallocate(a);
+    pool->Trim();
+    EXPECT_EQ(pool->GetCachedSizeForTesting(), kBlockSize);
+
+    // Nothing was used since the previous trim.
+    pool->Trim();
+    EXPECT_EQ(pool->GetCachedSizeForTesting(), 0u);
+}
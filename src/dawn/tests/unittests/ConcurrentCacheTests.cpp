@@ -19,6 +19,10 @@
 #include "dawn/platform/DawnPlatform.h"
 #include "dawn/utils/SystemUtils.h"
 
+#include <atomic>
+#include <memory>
+#include <vector>
+
 namespace {
     class SimpleCachedObject {
       public:
@@ -112,3 +116,44 @@ TEST_F(ConcurrentCacheTest, EraseAfterInsertion) {
     ASSERT_TRUE(insertOutput.second);
     ASSERT_EQ(1u, erasedObjectCount);
 }
+
+// Test that concurrent insertions, lookups and erasures of objects spread over the whole cache
+// each see a consistent state.
+TEST_F(ConcurrentCacheTest, ConcurrentOperationsOnManyObjects) {
+    constexpr size_t kTaskCount = 8;
+    constexpr size_t kObjectsPerTask = 256;
+
+    std::vector<std::unique_ptr<SimpleCachedObject>> objects;
+    for (size_t i = 0; i < kTaskCount * kObjectsPerTask; ++i) {
+        objects.push_back(std::make_unique<SimpleCachedObject>(i));
+    }
+
+    std::atomic<size_t> failureCount = {0};
+    ConcurrentCache<SimpleCachedObject>* cachePtr = &mCache;
+    for (size_t task = 0; task < kTaskCount; ++task) {
+        mTaskManager.PostTask([&objects, &failureCount, cachePtr, task] {
+            for (size_t i = task * kObjectsPerTask; i < (task + 1) * kObjectsPerTask; ++i) {
+                SimpleCachedObject* object = objects[i].get();
+                SimpleCachedObject blueprint(object->GetValue());
+                bool succeeded = cachePtr->Find(&blueprint) == nullptr &&
+                                 cachePtr->Insert(object).second &&
+                                 cachePtr->Find(&blueprint) == object;
+                // Keep every other object in the cache.
+                if (i % 2 == 0) {
+                    succeeded = succeeded && cachePtr->Erase(object) == 1 &&
+                                cachePtr->Find(&blueprint) == nullptr;
+                }
+                if (!succeeded) {
+                    failureCount++;
+                }
+            }
+        });
+    }
+    mTaskManager.WaitAllPendingTasks();
+
+    EXPECT_EQ(failureCount.load(), 0u);
+    for (size_t i = 0; i < objects.size(); ++i) {
+        SimpleCachedObject blueprint(i);
+        EXPECT_EQ(mCache.Find(&blueprint), i % 2 == 0 ? nullptr : objects[i].get());
+    }
+}
@@ -0,0 +1,283 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// FileCachingInterfaceTests:
+//     Tests for dawn::platform::FileCachingInterface.
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dawn/platform/FileCachingInterface.h"
+
+namespace {
+
+    using dawn::platform::FileCachingInterface;
+
+    constexpr uint64_t kMaxSize = 1024;
+    constexpr char kFingerprint[] = "fingerprint";
+
+    class FileCachingInterfaceTests : public testing::Test {
+      protected:
+        void SetUp() override {
+            mDirectory = testing::TempDir() + "dawn_file_caching_interface_" +
+                         testing::UnitTest::GetInstance()->current_test_info()->name();
+
+            // Opening the caches with a size limit of 0 evicts the entries of previous runs.
+            for (const char* fingerprint : {kFingerprint, "other"}) {
+                ASSERT_NE(nullptr, FileCachingInterface::Create(mDirectory, 0, fingerprint,
+                                                                strlen(fingerprint)));
+            }
+        }
+
+        std::unique_ptr<FileCachingInterface> Open(uint64_t maxSize = kMaxSize,
+                                                   const char* fingerprint = kFingerprint) {
+            return FileCachingInterface::Create(mDirectory, maxSize, fingerprint,
+                                                strlen(fingerprint));
+        }
+
+        static void Store(FileCachingInterface* cache,
+                          const std::string& key,
+                          const std::string& value) {
+            cache->StoreData(nullptr, key.data(), key.size(), value.data(), value.size());
+        }
+
+        // Loads the value the same way PersistentCache does: query the size, then copy.
+        static std::string Load(FileCachingInterface* cache, const std::string& key) {
+            size_t size = cache->LoadData(nullptr, key.data(), key.size(), nullptr, 0);
+            std::string value(size, '\0');
+            if (size != 0) {
+                EXPECT_EQ(size, cache->LoadData(nullptr, key.data(), key.size(), &value[0], size));
+            }
+            return value;
+        }
+
+        // Replaces the index of |cache|'s directory by one with a single entry, the way a
+        // corrupted or malicious index could.
+        static void WriteIndex(FileCachingInterface* cache,
+                               const std::string& key,
+                               const std::string& blobName,
+                               uint64_t size) {
+            std::vector<char> data = {'D', 'A', 'W', 'N', 'F', 'C', 'I', '1'};
+            auto writeU64 = [&](uint64_t value) {
+                const char* bytes = reinterpret_cast<const char*>(&value);
+                data.insert(data.end(), bytes, bytes + sizeof(value));
+            };
+            writeU64(1);
+            writeU64(key.size());
+            data.insert(data.end(), key.begin(), key.end());
+            writeU64(blobName.size());
+            data.insert(data.end(), blobName.begin(), blobName.end());
+            writeU64(size);
+            WriteFile(cache->GetDirectoryForTesting() + "/index", data.data(), data.size());
+        }
+
+        static void WriteFile(const std::string& path, const void* data, size_t size) {
+            FILE* file = fopen(path.c_str(), "wb");
+            ASSERT_NE(nullptr, file);
+            EXPECT_EQ(size, fwrite(data, 1, size, file));
+            fclose(file);
+        }
+
+        static std::string ReadFile(const std::string& path) {
+            std::string content;
+            FILE* file = fopen(path.c_str(), "rb");
+            if (file == nullptr) {
+                return content;
+            }
+            char buffer[256];
+            size_t readSize;
+            while ((readSize = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+                content.append(buffer, readSize);
+            }
+            fclose(file);
+            return content;
+        }
+
+        static bool FileExists(const std::string& path) {
+            FILE* file = fopen(path.c_str(), "rb");
+            if (file == nullptr) {
+                return false;
+            }
+            fclose(file);
+            return true;
+        }
+
+        std::string mDirectory;
+    };
+
+}  // anonymous namespace
+
+// Test storing and loading values.
+TEST_F(FileCachingInterfaceTests, StoreAndLoad) {
+    std::unique_ptr<FileCachingInterface> cache = Open();
+    ASSERT_NE(nullptr, cache);
+
+    EXPECT_EQ("", Load(cache.get(), "a"));
+    Store(cache.get(), "a", "value a");
+    Store(cache.get(), "b", "value b");
+    EXPECT_EQ("value a", Load(cache.get(), "a"));
+    EXPECT_EQ("value b", Load(cache.get(), "b"));
+
+    // Storing a key again replaces its value.
+    Store(cache.get(), "a", "new value a");
+    EXPECT_EQ("new value a", Load(cache.get(), "a"));
+    EXPECT_EQ(std::string("new value a").size() + std::string("value b").size(),
+              cache->GetTotalSizeForTesting());
+}
+
+// Test that the values are still there when the cache is opened again.
+TEST_F(FileCachingInterfaceTests, PersistsAcrossInstances) {
+    {
+        std::unique_ptr<FileCachingInterface> cache = Open();
+        Store(cache.get(), "a", "value a");
+    }
+
+    std::unique_ptr<FileCachingInterface> cache = Open();
+    EXPECT_EQ("value a", Load(cache.get(), "a"));
+}
+
+// Test that storing values doesn't write the index, and that Flush does.
+TEST_F(FileCachingInterfaceTests, FlushWritesTheIndex) {
+    std::unique_ptr<FileCachingInterface> cache = Open();
+    const std::string indexPath = cache->GetDirectoryForTesting() + "/index";
+    const std::string emptyIndex = ReadFile(indexPath);
+
+    Store(cache.get(), "a", "value a");
+    Store(cache.get(), "b", "value b");
+    EXPECT_EQ(emptyIndex, ReadFile(indexPath));
+
+    cache->Flush();
+    EXPECT_NE(emptyIndex, ReadFile(indexPath));
+    cache = nullptr;
+
+    cache = Open();
+    EXPECT_EQ("value a", Load(cache.get(), "a"));
+    EXPECT_EQ("value b", Load(cache.get(), "b"));
+}
+
+// Test that values stored with a different fingerprint aren't visible.
+TEST_F(FileCachingInterfaceTests, FingerprintIsolation) {
+    {
+        std::unique_ptr<FileCachingInterface> cache = Open();
+        Store(cache.get(), "a", "value a");
+    }
+
+    std::unique_ptr<FileCachingInterface> otherCache = Open(kMaxSize, "other");
+    EXPECT_EQ("", Load(otherCache.get(), "a"));
+    Store(otherCache.get(), "a", "other value a");
+
+    std::unique_ptr<FileCachingInterface> cache = Open();
+    EXPECT_EQ("value a", Load(cache.get(), "a"));
+}
+
+// Test that identical values stored under different keys are only counted once.
+TEST_F(FileCachingInterfaceTests, SharedValues) {
+    std::unique_ptr<FileCachingInterface> cache = Open();
+    Store(cache.get(), "a", "same value");
+    Store(cache.get(), "b", "same value");
+    EXPECT_EQ(std::string("same value").size(), cache->GetTotalSizeForTesting());
+
+    // Replacing one of the keys keeps the shared value alive for the other.
+    Store(cache.get(), "a", "different value");
+    EXPECT_EQ("same value", Load(cache.get(), "b"));
+}
+
+// Test that the least recently used entries are evicted to stay under the size limit, and that
+// loading an entry counts as a use.
+TEST_F(FileCachingInterfaceTests, LRUEviction) {
+    std::unique_ptr<FileCachingInterface> cache = Open(30);
+    Store(cache.get(), "a", std::string(10, 'a'));
+    Store(cache.get(), "b", std::string(10, 'b'));
+    Store(cache.get(), "c", std::string(10, 'c'));
+    EXPECT_EQ(30u, cache->GetTotalSizeForTesting());
+
+    // Make "a" the most recently used so that "b" gets evicted instead.
+    EXPECT_EQ(std::string(10, 'a'), Load(cache.get(), "a"));
+    Store(cache.get(), "d", std::string(10, 'd'));
+    EXPECT_EQ(30u, cache->GetTotalSizeForTesting());
+    EXPECT_EQ("", Load(cache.get(), "b"));
+    EXPECT_EQ(std::string(10, 'a'), Load(cache.get(), "a"));
+    EXPECT_EQ(std::string(10, 'c'), Load(cache.get(), "c"));
+    EXPECT_EQ(std::string(10, 'd'), Load(cache.get(), "d"));
+
+    // Values bigger than the limit are not stored and don't evict anything.
+    Store(cache.get(), "e", std::string(31, 'e'));
+    EXPECT_EQ("", Load(cache.get(), "e"));
+    EXPECT_EQ(30u, cache->GetTotalSizeForTesting());
+}
+
+// Test that the recency order is persisted and that a lower size limit evicts entries on open.
+TEST_F(FileCachingInterfaceTests, LRUOrderPersists) {
+    {
+        std::unique_ptr<FileCachingInterface> cache = Open();
+        Store(cache.get(), "a", std::string(10, 'a'));
+        Store(cache.get(), "b", std::string(10, 'b'));
+        Load(cache.get(), "a");
+    }
+
+    std::unique_ptr<FileCachingInterface> cache = Open(10);
+    EXPECT_EQ(10u, cache->GetTotalSizeForTesting());
+    EXPECT_EQ("", Load(cache.get(), "b"));
+    EXPECT_EQ(std::string(10, 'a'), Load(cache.get(), "a"));
+}
+
+// Test that values are only copied when the whole value fits exactly in the output.
+TEST_F(FileCachingInterfaceTests, LoadRequiresExactSize) {
+    std::unique_ptr<FileCachingInterface> cache = Open();
+    Store(cache.get(), "a", "value a");
+
+    std::string value(16, '\0');
+    EXPECT_EQ(0u, cache->LoadData(nullptr, "a", 1, &value[0], 3));
+    EXPECT_EQ(0u, cache->LoadData(nullptr, "a", 1, &value[0], value.size()));
+    EXPECT_EQ(7u, cache->LoadData(nullptr, "a", 1, &value[0], 7));
+    EXPECT_EQ("value a", value.substr(0, 7));
+}
+
+// Test that the size query forgets entries whose value file is missing.
+TEST_F(FileCachingInterfaceTests, SizeQueryChecksTheValue) {
+    {
+        std::unique_ptr<FileCachingInterface> cache = Open();
+        WriteIndex(cache.get(), "a", "0123456789abcdef-0000000000000007", 7);
+    }
+
+    std::unique_ptr<FileCachingInterface> cache = Open();
+    EXPECT_EQ(7u, cache->GetTotalSizeForTesting());
+    EXPECT_EQ(0u, cache->LoadData(nullptr, "a", 1, nullptr, 0));
+    EXPECT_EQ(0u, cache->GetTotalSizeForTesting());
+}
+
+// Test that index entries with value file names that the cache didn't produce are dropped
+// instead of being used as paths.
+TEST_F(FileCachingInterfaceTests, InvalidBlobNamesAreIgnored) {
+    const std::string victimPath = mDirectory + "/victim";
+    {
+        std::unique_ptr<FileCachingInterface> cache = Open();
+        WriteFile(victimPath, "victim!", 7);
+        WriteIndex(cache.get(), "a", "../victim", 7);
+    }
+
+    // A size limit of 0 would evict, and remove the file of, every entry read from the index.
+    ASSERT_NE(nullptr, Open(0));
+    EXPECT_TRUE(FileExists(victimPath));
+
+    std::unique_ptr<FileCachingInterface> cache = Open();
+    EXPECT_EQ(0u, cache->GetTotalSizeForTesting());
+    EXPECT_EQ("", Load(cache.get(), "a"));
+    std::remove(victimPath.c_str());
+}
@@ -0,0 +1,123 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "dawn/native/IntervalSet.h"
+
+#include <vector>
+
+using namespace dawn::native;
+
+namespace {
+
+    void ExpectGaps(const IntervalSet& set,
+                    uint64_t offset,
+                    uint64_t size,
+                    const std::vector<IntervalSet::Interval>& expected) {
+        std::vector<IntervalSet::Interval> gaps = set.GetGaps(offset, size);
+        ASSERT_EQ(gaps.size(), expected.size());
+        for (size_t i = 0; i < gaps.size(); ++i) {
+            EXPECT_EQ(gaps[i].offset, expected[i].offset);
+            EXPECT_EQ(gaps[i].size, expected[i].size);
+        }
+    }
+
+}  // anonymous namespace
+
+// Test the queries on an empty set.
+TEST(IntervalSetTests, Empty) {
+    IntervalSet set;
+    EXPECT_TRUE(set.IsEmpty());
+    EXPECT_FALSE(set.Contains(0, 4));
+    EXPECT_FALSE(set.Intersects(0, 4));
+    EXPECT_TRUE(set.Contains(0, 0));
+    ExpectGaps(set, 8, 16, {{8, 16}});
+
+    // Adding an empty interval does nothing.
+    set.Add(4, 0);
+    EXPECT_TRUE(set.IsEmpty());
+}
+
+// Test the queries on a set with a single interval.
+TEST(IntervalSetTests, SingleInterval) {
+    IntervalSet set;
+    set.Add(16, 16);
+    EXPECT_FALSE(set.IsEmpty());
+    EXPECT_EQ(set.GetIntervalCountForTesting(), 1u);
+
+    EXPECT_TRUE(set.Contains(16, 16));
+    EXPECT_TRUE(set.Contains(20, 4));
+    EXPECT_FALSE(set.Contains(12, 8));
+    EXPECT_FALSE(set.Contains(28, 8));
+    EXPECT_FALSE(set.Contains(0, 16));
+
+    EXPECT_TRUE(set.Intersects(12, 8));
+    EXPECT_TRUE(set.Intersects(28, 8));
+    EXPECT_TRUE(set.Intersects(0, 64));
+    EXPECT_FALSE(set.Intersects(0, 16));
+    EXPECT_FALSE(set.Intersects(32, 16));
+
+    ExpectGaps(set, 0, 64, {{0, 16}, {32, 32}});
+    ExpectGaps(set, 16, 16, {});
+    ExpectGaps(set, 20, 20, {{32, 8}});
+    ExpectGaps(set, 8, 12, {{8, 8}});
+}
+
+// Test that overlapping and adjacent intervals are coalesced.
+TEST(IntervalSetTests, Coalescing) {
+    IntervalSet set;
+
+    // Consecutive intervals, like sequential writes, are merged.
+    for (uint64_t offset = 0; offset < 64; offset += 8) {
+        set.Add(offset, 8);
+        EXPECT_EQ(set.GetIntervalCountForTesting(), 1u);
+    }
+    EXPECT_TRUE(set.Contains(0, 64));
+
+    // A disjoint interval stays separate.
+    set.Add(128, 8);
+    EXPECT_EQ(set.GetIntervalCountForTesting(), 2u);
+    ExpectGaps(set, 0, 160, {{64, 64}, {136, 24}});
+
+    // An interval overlapping the end of one interval and touching the next merges the three.
+    set.Add(60, 68);
+    EXPECT_EQ(set.GetIntervalCountForTesting(), 1u);
+    EXPECT_TRUE(set.Contains(0, 136));
+    ExpectGaps(set, 0, 160, {{136, 24}});
+
+    // An interval inside an existing one doesn't change the set.
+    set.Add(16, 16);
+    EXPECT_EQ(set.GetIntervalCountForTesting(), 1u);
+    EXPECT_TRUE(set.Contains(0, 136));
+}
+
+// Test that an interval covering several intervals replaces them.
+TEST(IntervalSetTests, CoveringInterval) {
+    IntervalSet set;
+    set.Add(8, 4);
+    set.Add(16, 4);
+    set.Add(32, 4);
+    EXPECT_EQ(set.GetIntervalCountForTesting(), 3u);
+    ExpectGaps(set, 0, 40, {{0, 8}, {12, 4}, {20, 12}, {36, 4}});
+
+    set.Add(4, 40);
+    EXPECT_EQ(set.GetIntervalCountForTesting(), 1u);
+    EXPECT_TRUE(set.Contains(4, 40));
+    EXPECT_FALSE(set.Contains(0, 8));
+    ExpectGaps(set, 0, 48, {{0, 4}, {44, 4}});
+
+    set.Clear();
+    EXPECT_TRUE(set.IsEmpty());
+}
@@ -0,0 +1,326 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "dawn/native/CommandAllocator.h"
+#include "dawn/native/Commands.h"
+#include "dawn/native/QuerySet.h"
+#include "dawn/native/RedundantStateElimination.h"
+#include "dawn/tests/unittests/native/mocks/BindGroupMock.h"
+#include "dawn/tests/unittests/native/mocks/BufferMock.h"
+#include "dawn/tests/unittests/native/mocks/DeviceMock.h"
+#include "dawn/tests/unittests/native/mocks/RenderPipelineMock.h"
+
+#include <cstring>
+#include <vector>
+
+using namespace dawn::native;
+
+namespace {
+
+    class RedundantStateEliminationTest : public testing::Test {
+      protected:
+        void TearDown() override {
+            FreeCommands(&mCommands);
+        }
+
+        Ref<RenderPipelineBase> CreateRenderPipeline() {
+            return AcquireRef(new RenderPipelineMock(&mDevice));
+        }
+
+        Ref<BindGroupBase> CreateBindGroup() {
+            return AcquireRef(new BindGroupMock(&mDevice));
+        }
+
+        Ref<BufferBase> CreateBuffer() {
+            return AcquireRef(new BufferMock(&mDevice, BufferBase::BufferState::Unmapped));
+        }
+
+        void SetRenderPipeline(RenderPipelineBase* pipeline) {
+            SetRenderPipelineCmd* cmd =
+                mAllocator.Allocate<SetRenderPipelineCmd>(Command::SetRenderPipeline);
+            cmd->pipeline = pipeline;
+        }
+
+        void SetBindGroup(uint32_t index,
+                          BindGroupBase* group,
+                          const std::vector<uint32_t>& dynamicOffsets = {}) {
+            SetBindGroupCmd* cmd = mAllocator.Allocate<SetBindGroupCmd>(Command::SetBindGroup);
+            cmd->index = BindGroupIndex(index);
+            cmd->group = group;
+            cmd->dynamicOffsetCount = static_cast<uint32_t>(dynamicOffsets.size());
+            if (!dynamicOffsets.empty()) {
+                memcpy(mAllocator.AllocateData<uint32_t>(dynamicOffsets.size()),
+                       dynamicOffsets.data(), dynamicOffsets.size() * sizeof(uint32_t));
+            }
+        }
+
+        void SetVertexBuffer(uint32_t slot, BufferBase* buffer, uint64_t offset) {
+            SetVertexBufferCmd* cmd =
+                mAllocator.Allocate<SetVertexBufferCmd>(Command::SetVertexBuffer);
+            cmd->slot = VertexBufferSlot(static_cast<uint8_t>(slot));
+            cmd->buffer = buffer;
+            cmd->offset = offset;
+            cmd->size = 16;
+        }
+
+        void SetIndexBuffer(BufferBase* buffer, wgpu::IndexFormat format, uint64_t offset) {
+            SetIndexBufferCmd* cmd =
+                mAllocator.Allocate<SetIndexBufferCmd>(Command::SetIndexBuffer);
+            cmd->buffer = buffer;
+            cmd->format = format;
+            cmd->offset = offset;
+            cmd->size = 16;
+        }
+
+        void SetViewport(float x, float width) {
+            SetViewportCmd* cmd = mAllocator.Allocate<SetViewportCmd>(Command::SetViewport);
+            *cmd = {x, 0, width, 1, 0, 1};
+        }
+
+        void SetScissorRect(uint32_t x, uint32_t width) {
+            SetScissorRectCmd* cmd =
+                mAllocator.Allocate<SetScissorRectCmd>(Command::SetScissorRect);
+            *cmd = {x, 0, width, 1};
+        }
+
+        void SetStencilReference(uint32_t reference) {
+            SetStencilReferenceCmd* cmd =
+                mAllocator.Allocate<SetStencilReferenceCmd>(Command::SetStencilReference);
+            cmd->reference = reference;
+        }
+
+        void Draw() {
+            DrawCmd* cmd = mAllocator.Allocate<DrawCmd>(Command::Draw);
+            *cmd = {3, 1, 0, 0};
+        }
+
+        void PushDebugGroup(const char* label) {
+            PushDebugGroupCmd* cmd =
+                mAllocator.Allocate<PushDebugGroupCmd>(Command::PushDebugGroup);
+            cmd->length = strlen(label);
+            memcpy(mAllocator.AllocateData<char>(cmd->length + 1), label, cmd->length + 1);
+        }
+
+        void BeginRenderPass() {
+            mAllocator.Allocate<BeginRenderPassCmd>(Command::BeginRenderPass);
+        }
+
+        void EndRenderPass() {
+            mAllocator.Allocate<EndRenderPassCmd>(Command::EndRenderPass);
+        }
+
+        // Runs the elimination on the commands recorded so far.
+        size_t Eliminate() {
+            mCommands = CommandIterator(std::move(mAllocator));
+            return EliminateRedundantStateCommands(&mCommands, nullptr);
+        }
+
+        std::vector<Command> GetCommandTypes() {
+            std::vector<Command> types;
+            Command type;
+            while (mCommands.NextCommandId(&type)) {
+                types.push_back(type);
+                SkipCommand(&mCommands, type);
+            }
+            return types;
+        }
+
+        // Declared first so that it outlives the objects referenced by the commands.
+        DeviceMock mDevice;
+        CommandAllocator mAllocator;
+        CommandIterator mCommands;
+    };
+
+}  // anonymous namespace
+
+// Test that setting dynamic state to its current value is removed.
+TEST_F(RedundantStateEliminationTest, RemovesRepeatedDynamicState) {
+    BeginRenderPass();
+    SetViewport(0, 4);
+    SetScissorRect(1, 2);
+    SetStencilReference(1);
+    Draw();
+    SetViewport(0, 4);
+    SetScissorRect(1, 2);
+    SetStencilReference(1);
+    Draw();
+    EndRenderPass();
+
+    EXPECT_EQ(Eliminate(), 3u);
+    EXPECT_EQ(GetCommandTypes(),
+              (std::vector<Command>{Command::BeginRenderPass, Command::SetViewport,
+                                    Command::SetScissorRect, Command::SetStencilReference,
+                                    Command::Draw, Command::Draw, Command::EndRenderPass}));
+}
+
+// Test that only the commands that set the same value as the current one are removed.
+TEST_F(RedundantStateEliminationTest, KeepsStateChanges) {
+    BeginRenderPass();
+    SetViewport(0, 4);
+    SetViewport(0, 2);
+    SetViewport(0, 4);
+    SetScissorRect(0, 4);
+    SetScissorRect(0, 4);
+    EndRenderPass();
+
+    EXPECT_EQ(Eliminate(), 1u);
+    EXPECT_EQ(GetCommandTypes(),
+              (std::vector<Command>{Command::BeginRenderPass, Command::SetViewport,
+                                    Command::SetViewport, Command::SetViewport,
+                                    Command::SetScissorRect, Command::EndRenderPass}));
+
+    // The values are moved to the new commands.
+    Command type;
+    ASSERT_TRUE(mCommands.NextCommandId(&type));
+    mCommands.NextCommand<BeginRenderPassCmd>();
+    ASSERT_TRUE(mCommands.NextCommandId(&type));
+    EXPECT_EQ(mCommands.NextCommand<SetViewportCmd>()->width, 4.0f);
+    ASSERT_TRUE(mCommands.NextCommandId(&type));
+    EXPECT_EQ(mCommands.NextCommand<SetViewportCmd>()->width, 2.0f);
+    mCommands.Reset();
+}
+
+// Test that the state isn't carried over from a pass to the next one.
+TEST_F(RedundantStateEliminationTest, StateIsResetBetweenPasses) {
+    BeginRenderPass();
+    SetViewport(0, 4);
+    SetStencilReference(3);
+    EndRenderPass();
+    BeginRenderPass();
+    SetViewport(0, 4);
+    SetStencilReference(3);
+    EndRenderPass();
+
+    EXPECT_EQ(Eliminate(), 0u);
+    EXPECT_EQ(GetCommandTypes().size(), 8u);
+}
+
+// Test that the data following the commands that are kept is preserved when the commands are
+// rewritten.
+TEST_F(RedundantStateEliminationTest, PreservesCommandData) {
+    BeginRenderPass();
+    PushDebugGroup("first");
+    SetViewport(0, 4);
+    SetViewport(0, 4);
+    PushDebugGroup("second");
+    EndRenderPass();
+
+    EXPECT_EQ(Eliminate(), 1u);
+
+    Command type;
+    ASSERT_TRUE(mCommands.NextCommandId(&type));
+    ASSERT_EQ(type, Command::BeginRenderPass);
+    mCommands.NextCommand<BeginRenderPassCmd>();
+
+    ASSERT_TRUE(mCommands.NextCommandId(&type));
+    ASSERT_EQ(type, Command::PushDebugGroup);
+    PushDebugGroupCmd* cmd = mCommands.NextCommand<PushDebugGroupCmd>();
+    EXPECT_STREQ(mCommands.NextData<char>(cmd->length + 1), "first");
+
+    ASSERT_TRUE(mCommands.NextCommandId(&type));
+    ASSERT_EQ(type, Command::SetViewport);
+    mCommands.NextCommand<SetViewportCmd>();
+
+    ASSERT_TRUE(mCommands.NextCommandId(&type));
+    ASSERT_EQ(type, Command::PushDebugGroup);
+    cmd = mCommands.NextCommand<PushDebugGroupCmd>();
+    EXPECT_STREQ(mCommands.NextData<char>(cmd->length + 1), "second");
+
+    mCommands.Reset();
+}
+
+// Test that setting the current pipeline again is removed, but not switching back to a pipeline
+// that was used before.
+TEST_F(RedundantStateEliminationTest, RemovesRepeatedPipeline) {
+    Ref<RenderPipelineBase> pipeline1 = CreateRenderPipeline();
+    Ref<RenderPipelineBase> pipeline2 = CreateRenderPipeline();
+
+    BeginRenderPass();
+    SetRenderPipeline(pipeline1.Get());
+    Draw();
+    SetRenderPipeline(pipeline1.Get());
+    Draw();
+    SetRenderPipeline(pipeline2.Get());
+    SetRenderPipeline(pipeline1.Get());
+    Draw();
+    EndRenderPass();
+
+    EXPECT_EQ(Eliminate(), 1u);
+    EXPECT_EQ(GetCommandTypes(),
+              (std::vector<Command>{Command::BeginRenderPass, Command::SetRenderPipeline,
+                                    Command::Draw, Command::Draw, Command::SetRenderPipeline,
+                                    Command::SetRenderPipeline, Command::Draw,
+                                    Command::EndRenderPass}));
+}
+
+// Test that a bind group is only redundant if it is set at the same index with the same dynamic
+// offsets, and that the offsets of the bind groups that are kept are preserved.
+TEST_F(RedundantStateEliminationTest, BindGroupDynamicOffsets) {
+    Ref<BindGroupBase> group = CreateBindGroup();
+
+    BeginRenderPass();
+    SetBindGroup(0, group.Get(), {256});
+    SetBindGroup(0, group.Get(), {256});
+    SetBindGroup(0, group.Get(), {512});
+    SetBindGroup(1, group.Get(), {512});
+    SetBindGroup(1, group.Get(), {512, 0});
+    EndRenderPass();
+
+    EXPECT_EQ(Eliminate(), 1u);
+
+    Command type;
+    ASSERT_TRUE(mCommands.NextCommandId(&type));
+    ASSERT_EQ(type, Command::BeginRenderPass);
+    mCommands.NextCommand<BeginRenderPassCmd>();
+
+    std::vector<std::vector<uint32_t>> expectedOffsets = {{256}, {512}, {512}, {512, 0}};
+    for (const std::vector<uint32_t>& expected : expectedOffsets) {
+        ASSERT_TRUE(mCommands.NextCommandId(&type));
+        ASSERT_EQ(type, Command::SetBindGroup);
+        SetBindGroupCmd* cmd = mCommands.NextCommand<SetBindGroupCmd>();
+        ASSERT_EQ(cmd->dynamicOffsetCount, expected.size());
+        uint32_t* offsets = mCommands.NextData<uint32_t>(cmd->dynamicOffsetCount);
+        EXPECT_EQ(std::vector<uint32_t>(offsets, offsets + cmd->dynamicOffsetCount), expected);
+    }
+
+    ASSERT_TRUE(mCommands.NextCommandId(&type));
+    EXPECT_EQ(type, Command::EndRenderPass);
+    mCommands.Reset();
+}
+
+// Test that vertex and index buffers are only redundant if they are set with the same
+// parameters, at the same slot for vertex buffers.
+TEST_F(RedundantStateEliminationTest, RemovesRepeatedVertexAndIndexBuffers) {
+    Ref<BufferBase> buffer = CreateBuffer();
+
+    BeginRenderPass();
+    SetVertexBuffer(0, buffer.Get(), 0);
+    SetVertexBuffer(0, buffer.Get(), 0);
+    SetVertexBuffer(1, buffer.Get(), 0);
+    SetVertexBuffer(0, buffer.Get(), 16);
+    SetIndexBuffer(buffer.Get(), wgpu::IndexFormat::Uint16, 0);
+    SetIndexBuffer(buffer.Get(), wgpu::IndexFormat::Uint16, 0);
+    SetIndexBuffer(buffer.Get(), wgpu::IndexFormat::Uint32, 0);
+    SetIndexBuffer(buffer.Get(), wgpu::IndexFormat::Uint32, 16);
+    EndRenderPass();
+
+    EXPECT_EQ(Eliminate(), 2u);
+    EXPECT_EQ(GetCommandTypes(),
+              (std::vector<Command>{Command::BeginRenderPass, Command::SetVertexBuffer,
+                                    Command::SetVertexBuffer, Command::SetVertexBuffer,
+                                    Command::SetIndexBuffer, Command::SetIndexBuffer,
+                                    Command::SetIndexBuffer, Command::EndRenderPass}));
+}
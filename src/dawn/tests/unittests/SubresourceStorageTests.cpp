@@ -667,6 +667,51 @@ TEST(SubresourceStorageTest, AspectDecompressionUpdatesLayer0) {
     EXPECT_EQ(3, s.Get(Aspect::Color, 0, 1));
 }
 
+// Test that AllOf calls the predicate once per compressed aspect and checks the data of all the
+// subresources of the range otherwise.
+TEST(SubresourceStorageTest, AllOf) {
+    const uint32_t kLayers = 4;
+    const uint32_t kLevels = 3;
+    SubresourceStorage<int> s(Aspect::Depth | Aspect::Stencil, kLayers, kLevels, 1);
+
+    const SubresourceRange fullRange =
+        SubresourceRange::MakeFull(Aspect::Depth | Aspect::Stencil, kLayers, kLevels);
+
+    // Compressed aspects are checked with a single call each.
+    uint32_t callCount = 0;
+    auto IsOne = [&](int data) {
+        callCount++;
+        return data == 1;
+    };
+    EXPECT_TRUE(s.AllOf(fullRange, IsOne));
+    EXPECT_EQ(callCount, 2u);
+
+    // Change a single subresource of the stencil.
+    s.Update(SubresourceRange::MakeSingle(Aspect::Stencil, 2, 1),
+             [](const SubresourceRange&, int* data) { *data = 0; });
+    EXPECT_FALSE(s.AllOf(fullRange, IsOne));
+    EXPECT_FALSE(s.AllOf(SubresourceRange::MakeSingle(Aspect::Stencil, 2, 1), IsOne));
+    EXPECT_TRUE(s.AllOf(SubresourceRange::MakeFull(Aspect::Depth, kLayers, kLevels), IsOne));
+
+    // Ranges skipping the subresource only see ones, and compressed layers are checked once.
+    callCount = 0;
+    EXPECT_TRUE(s.AllOf({Aspect::Stencil, {0, 2}, {0, kLevels}}, IsOne));
+    EXPECT_EQ(callCount, 2u);
+    EXPECT_TRUE(s.AllOf({Aspect::Stencil, {2, 1}, {0, 1}}, IsOne));
+    EXPECT_TRUE(s.AllOf({Aspect::Stencil, {2, 2}, {2, 1}}, IsOne));
+    EXPECT_FALSE(s.AllOf({Aspect::Stencil, {1, 2}, {1, 2}}, IsOne));
+}
+
+// Test that a storage without aspects can be created and has no subresources to iterate on.
+TEST(SubresourceStorageTest, NoAspects) {
+    SubresourceStorage<int> s(Aspect::None, 0, 0, 1);
+    EXPECT_EQ(s.GetAspectsForTesting(), Aspect::None);
+
+    uint32_t callCount = 0;
+    s.Iterate([&](const SubresourceRange&, const int&) { callCount++; });
+    EXPECT_EQ(callCount, 0u);
+}
+
 // Bugs found while testing:
 //  - mLayersCompressed not initialized to true.
 //  - DecompressLayer setting Compressed to true instead of false.
@@ -0,0 +1,107 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// WorkerThreadTests:
+//     Tests for dawn::platform::AsyncWorkerThreadPool.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "dawn/platform/WorkerThread.h"
+
+namespace {
+
+    using dawn::platform::AsyncWorkerThreadPool;
+    using dawn::platform::WaitableEvent;
+    using dawn::platform::WorkerTaskPriority;
+
+    struct CountingTask {
+        std::atomic<uint32_t>* counter;
+    };
+
+    void IncrementCounter(void* userdata) {
+        static_cast<CountingTask*>(userdata)->counter->fetch_add(1);
+    }
+
+    struct NestedTask {
+        AsyncWorkerThreadPool* pool;
+        CountingTask leaf;
+    };
+
+    // Posts a task from inside a worker and waits on it, which requires the waiting worker to
+    // help run the queued tasks when there are fewer workers than nested tasks.
+    void PostAndWaitNestedTask(void* userdata) {
+        NestedTask* task = static_cast<NestedTask*>(userdata);
+        task->pool->PostWorkerTask(IncrementCounter, &task->leaf)->Wait();
+    }
+
+}  // anonymous namespace
+
+// Test that a burst of many more tasks than threads all get run.
+TEST(WorkerThreadTests, ManyTasks) {
+    AsyncWorkerThreadPool pool(4);
+    ASSERT_EQ(4u, pool.GetThreadCount());
+
+    constexpr uint32_t kTaskCount = 1000;
+    std::atomic<uint32_t> counter = {0};
+    CountingTask task = {&counter};
+
+    std::vector<std::unique_ptr<WaitableEvent>> events;
+    for (uint32_t i = 0; i < kTaskCount; ++i) {
+        WorkerTaskPriority priority =
+            i % 2 == 0 ? WorkerTaskPriority::Normal : WorkerTaskPriority::High;
+        events.push_back(pool.PostWorkerTask(IncrementCounter, &task, priority));
+    }
+    for (std::unique_ptr<WaitableEvent>& event : events) {
+        event->Wait();
+        EXPECT_TRUE(event->IsComplete());
+    }
+    EXPECT_EQ(kTaskCount, counter.load());
+}
+
+// Test that waiting on a task from a worker doesn't deadlock the pool.
+TEST(WorkerThreadTests, NestedWait) {
+    AsyncWorkerThreadPool pool(2);
+
+    constexpr uint32_t kTaskCount = 16;
+    std::atomic<uint32_t> counter = {0};
+    std::vector<NestedTask> tasks(kTaskCount, NestedTask{&pool, {&counter}});
+
+    std::vector<std::unique_ptr<WaitableEvent>> events;
+    for (NestedTask& task : tasks) {
+        events.push_back(pool.PostWorkerTask(PostAndWaitNestedTask, &task));
+    }
+    for (std::unique_ptr<WaitableEvent>& event : events) {
+        event->Wait();
+    }
+    EXPECT_EQ(kTaskCount, counter.load());
+}
+
+// Test that destroying the pool runs the tasks that are still queued.
+TEST(WorkerThreadTests, DestructionDrainsQueuedTasks) {
+    constexpr uint32_t kTaskCount = 100;
+    std::atomic<uint32_t> counter = {0};
+    CountingTask task = {&counter};
+
+    {
+        AsyncWorkerThreadPool pool(1);
+        for (uint32_t i = 0; i < kTaskCount; ++i) {
+            pool.PostWorkerTask(IncrementCounter, &task);
+        }
+    }
+    EXPECT_EQ(kTaskCount, counter.load());
+}
@@ -0,0 +1,139 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/tests/DawnTest.h"
+
+#include "dawn/native/opengl/DeviceGL.h"
+#include "dawn/native/opengl/FramebufferCacheGL.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace {
+
+    using Stats = dawn::native::opengl::FramebufferCache::Stats;
+
+    constexpr uint32_t kSize = 4;
+
+    class OpenGLFramebufferCacheTests : public DawnTest {
+      protected:
+        void SetUp() override {
+            DawnTest::SetUp();
+            DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+
+            mDeviceGL = dawn::native::opengl::ToBackend(dawn::native::FromAPI(device.Get()));
+        }
+
+        Stats GetStats() const {
+            return mDeviceGL->GetFramebufferCache()->GetStats();
+        }
+
+        wgpu::Texture CreateRenderTexture() {
+            wgpu::TextureDescriptor desc;
+            desc.size = {kSize, kSize};
+            desc.format = wgpu::TextureFormat::RGBA8Unorm;
+            desc.usage = wgpu::TextureUsage::RenderAttachment | wgpu::TextureUsage::CopySrc;
+            return device.CreateTexture(&desc);
+        }
+
+        // Records and submits a render pass that clears |view| to |color|.
+        void ClearView(const wgpu::TextureView& view, const wgpu::Color& color) {
+            utils::ComboRenderPassDescriptor renderPass({view});
+            renderPass.cColorAttachments[0].clearValue = color;
+            wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+            encoder.BeginRenderPass(&renderPass).End();
+            wgpu::CommandBuffer commands = encoder.Finish();
+            queue.Submit(1, &commands);
+        }
+
+        dawn::native::opengl::Device* mDeviceGL;
+    };
+
+}  // anonymous namespace
+
+// Test that render passes with the same attachments reuse the same framebuffer.
+TEST_P(OpenGLFramebufferCacheTests, RepeatedRenderPassHitsCache) {
+    wgpu::Texture texture = CreateRenderTexture();
+    wgpu::TextureView view = texture.CreateView();
+
+    Stats before = GetStats();
+    ClearView(view, {1.0, 0.0, 0.0, 1.0});
+    Stats afterFirst = GetStats();
+    EXPECT_EQ(afterFirst.hits, before.hits);
+    EXPECT_EQ(afterFirst.misses, before.misses + 1);
+
+    // A new view of the same subresource uses the same framebuffer.
+    ClearView(texture.CreateView(), {0.0, 1.0, 0.0, 1.0});
+    for (uint32_t i = 0; i < 2; ++i) {
+        ClearView(view, {0.0, 1.0, 0.0, 1.0});
+    }
+    Stats afterRepeats = GetStats();
+    EXPECT_EQ(afterRepeats.hits, afterFirst.hits + 3);
+    EXPECT_EQ(afterRepeats.misses, afterFirst.misses);
+    EXPECT_EQ(afterRepeats.framebufferCount, afterFirst.framebufferCount);
+
+    EXPECT_PIXEL_RGBA8_EQ(RGBA8::kGreen, texture, 0, 0);
+}
+
+// Test that the framebuffers using a texture are deleted when the texture is destroyed.
+TEST_P(OpenGLFramebufferCacheTests, TextureDestructionEvictsFramebuffers) {
+    wgpu::Texture texture = CreateRenderTexture();
+
+    Stats before = GetStats();
+    ClearView(texture.CreateView(), {1.0, 0.0, 0.0, 1.0});
+    EXPECT_EQ(GetStats().framebufferCount, before.framebufferCount + 1);
+
+    texture.Destroy();
+    EXPECT_EQ(GetStats().framebufferCount, before.framebufferCount);
+
+    // Rendering to a new texture creates a new framebuffer.
+    texture = CreateRenderTexture();
+    ClearView(texture.CreateView(), {0.0, 1.0, 0.0, 1.0});
+    Stats after = GetStats();
+    EXPECT_EQ(after.framebufferCount, before.framebufferCount + 1);
+    EXPECT_EQ(after.misses, before.misses + 2);
+
+    EXPECT_PIXEL_RGBA8_EQ(RGBA8::kGreen, texture, 0, 0);
+}
+
+// Test that copies from a texture to a buffer reuse the framebuffer of the copied subresource.
+TEST_P(OpenGLFramebufferCacheTests, RepeatedCopyHitsCache) {
+    wgpu::Texture texture = CreateRenderTexture();
+    ClearView(texture.CreateView(), {0.0, 1.0, 0.0, 1.0});
+
+    wgpu::BufferDescriptor bufferDesc;
+    bufferDesc.size = kTextureBytesPerRowAlignment * kSize;
+    bufferDesc.usage = wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::CopySrc;
+    wgpu::Buffer buffer = device.CreateBuffer(&bufferDesc);
+
+    auto CopyToBuffer = [&]() {
+        wgpu::ImageCopyTexture src = utils::CreateImageCopyTexture(texture, 0, {0, 0, 0});
+        wgpu::ImageCopyBuffer dst =
+            utils::CreateImageCopyBuffer(buffer, 0, kTextureBytesPerRowAlignment);
+        wgpu::Extent3D copySize = {kSize, kSize};
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        encoder.CopyTextureToBuffer(&src, &dst, &copySize);
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+    };
+
+    CopyToBuffer();
+    Stats afterFirst = GetStats();
+    CopyToBuffer();
+    Stats afterSecond = GetStats();
+    EXPECT_EQ(afterSecond.hits, afterFirst.hits + 1);
+    EXPECT_EQ(afterSecond.misses, afterFirst.misses);
+
+    EXPECT_BUFFER_U32_EQ(0xFF00FF00, buffer, 0);
+}
+
+DAWN_INSTANTIATE_TEST(OpenGLFramebufferCacheTests, OpenGLBackend(), OpenGLESBackend());
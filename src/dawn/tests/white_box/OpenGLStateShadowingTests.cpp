@@ -0,0 +1,159 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/tests/DawnTest.h"
+
+#include "dawn/native/opengl/DeviceGL.h"
+#include "dawn/utils/ComboRenderPipelineDescriptor.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+#include <array>
+
+namespace {
+
+    using GLCallStats = dawn::native::opengl::GLCallStats;
+
+    constexpr uint32_t kRTSize = 4;
+
+    class OpenGLStateShadowingTests : public DawnTest {
+      protected:
+        void SetUp() override {
+            DawnTest::SetUp();
+            DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+
+            mDeviceGL = dawn::native::opengl::ToBackend(dawn::native::FromAPI(device.Get()));
+
+            mModule = utils::CreateShaderModule(device, R"(
+                struct Uniforms {
+                    color : vec4<f32>;
+                };
+                @group(0) @binding(0) var<uniform> uniforms : Uniforms;
+
+                @stage(vertex) fn vertex_main(@builtin(vertex_index) VertexIndex : u32)
+                                           -> @builtin(position) vec4<f32> {
+                    var pos = array<vec2<f32>, 3>(
+                        vec2<f32>(-1.0, -1.0),
+                        vec2<f32>( 3.0, -1.0),
+                        vec2<f32>(-1.0,  3.0));
+                    return vec4<f32>(pos[VertexIndex], 0.0, 1.0);
+                }
+
+                @stage(fragment) fn fragment_main() -> @location(0) vec4<f32> {
+                    return uniforms.color;
+                }
+            )");
+        }
+
+        GLCallStats GetGLCallStats() const {
+            return mDeviceGL->GetGLCallStats();
+        }
+
+        wgpu::RenderPipeline CreatePipeline(bool additiveBlending) {
+            utils::ComboRenderPipelineDescriptor desc;
+            desc.vertex.module = mModule;
+            desc.vertex.entryPoint = "vertex_main";
+            desc.cFragment.module = mModule;
+            desc.cFragment.entryPoint = "fragment_main";
+            desc.cTargets[0].format = wgpu::TextureFormat::RGBA8Unorm;
+            if (additiveBlending) {
+                desc.cBlends[0].color = {wgpu::BlendOperation::Add, wgpu::BlendFactor::One,
+                                         wgpu::BlendFactor::One};
+                desc.cBlends[0].alpha = desc.cBlends[0].color;
+                desc.cTargets[0].blend = &desc.cBlends[0];
+            }
+            return device.CreateRenderPipeline(&desc);
+        }
+
+        wgpu::BindGroup CreateColorBindGroup(const wgpu::RenderPipeline& pipeline,
+                                             std::array<float, 4> color) {
+            wgpu::Buffer buffer = utils::CreateBufferFromData(device, color.data(), sizeof(color),
+                                                              wgpu::BufferUsage::Uniform);
+            return utils::MakeBindGroup(device, pipeline.GetBindGroupLayout(0), {{0, buffer}});
+        }
+
+        dawn::native::opengl::Device* mDeviceGL;
+        wgpu::ShaderModule mModule;
+    };
+
+}  // anonymous namespace
+
+// Test that setting the same pipeline several times in a pass doesn't issue more GL calls.
+TEST_P(OpenGLStateShadowingTests, RedundantPipelineChangesAreElided) {
+    wgpu::RenderPipeline pipeline = CreatePipeline(false);
+    wgpu::BindGroup bindGroup = CreateColorBindGroup(pipeline, {0.0f, 1.0f, 0.0f, 1.0f});
+    utils::BasicRenderPass renderPass = utils::CreateBasicRenderPass(device, kRTSize, kRTSize);
+
+    // Records a pass drawing |drawCount| times, setting the pipeline and bind group each time.
+    auto SubmitPass = [&](uint32_t drawCount) {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass.renderPassInfo);
+        for (uint32_t i = 0; i < drawCount; ++i) {
+            pass.SetPipeline(pipeline);
+            pass.SetBindGroup(0, bindGroup);
+            pass.Draw(3);
+        }
+        pass.End();
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+    };
+
+    GLCallStats before = GetGLCallStats();
+    SubmitPass(1);
+    GLCallStats afterOneDraw = GetGLCallStats();
+    SubmitPass(4);
+    GLCallStats afterFourDraws = GetGLCallStats();
+
+    uint64_t issuedForOneDraw = afterOneDraw.issuedCallCount - before.issuedCallCount;
+    uint64_t issuedForFourDraws = afterFourDraws.issuedCallCount - afterOneDraw.issuedCallCount;
+    EXPECT_EQ(issuedForOneDraw, issuedForFourDraws);
+    EXPECT_GT(afterFourDraws.elidedCallCount, afterOneDraw.elidedCallCount);
+
+    EXPECT_PIXEL_RGBA8_EQ(RGBA8::kGreen, renderPass.color, 0, 0);
+}
+
+// Test that the state that differs between pipelines is still applied when switching between
+// them.
+TEST_P(OpenGLStateShadowingTests, StateChangesBetweenPipelinesAreApplied) {
+    wgpu::RenderPipeline opaquePipeline = CreatePipeline(false);
+    wgpu::RenderPipeline additivePipeline = CreatePipeline(true);
+    wgpu::BindGroup red = CreateColorBindGroup(opaquePipeline, {1.0f, 0.0f, 0.0f, 1.0f});
+    wgpu::BindGroup green = CreateColorBindGroup(additivePipeline, {0.0f, 1.0f, 0.0f, 0.0f});
+    wgpu::BindGroup blue = CreateColorBindGroup(opaquePipeline, {0.0f, 0.0f, 1.0f, 1.0f});
+    utils::BasicRenderPass renderPass = utils::CreateBasicRenderPass(device, kRTSize, kRTSize);
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass.renderPassInfo);
+    // Blending adds green to the red drawn before it.
+    pass.SetPipeline(opaquePipeline);
+    pass.SetBindGroup(0, red);
+    pass.Draw(3);
+    pass.SetPipeline(additivePipeline);
+    pass.SetBindGroup(0, green);
+    pass.Draw(3);
+    // Blending is disabled again for the opaque pipeline, so blue replaces the yellow.
+    pass.SetPipeline(opaquePipeline);
+    pass.SetBindGroup(0, blue);
+    pass.Draw(3);
+    // The additive pipeline still blends.
+    pass.SetPipeline(additivePipeline);
+    pass.SetBindGroup(0, green);
+    pass.Draw(3);
+    pass.End();
+    wgpu::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+
+    EXPECT_PIXEL_RGBA8_EQ(RGBA8(0, 255, 255, 255), renderPass.color, 0, 0);
+}
+
+DAWN_INSTANTIATE_TEST(OpenGLStateShadowingTests, OpenGLBackend(), OpenGLESBackend());
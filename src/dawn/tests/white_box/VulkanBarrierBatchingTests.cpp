@@ -0,0 +1,156 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/tests/DawnTest.h"
+
+#include "dawn/native/vulkan/DeviceVk.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+#include <vector>
+
+namespace {
+
+    using BarrierStats = dawn::native::vulkan::Device::BarrierStats;
+
+    // A single row of RGBA8 texels is exactly the 256 bytes of a row of a buffer copy.
+    constexpr uint32_t kWidth = 64;
+    constexpr uint64_t kBufferSize = kWidth * 4;
+    constexpr uint32_t kCopyCount = 8;
+
+    class VulkanBarrierBatchingTests : public DawnTest {
+      protected:
+        void SetUp() override {
+            DawnTest::SetUp();
+            DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+
+            mDeviceVk = dawn::native::vulkan::ToBackend(dawn::native::FromAPI(device.Get()));
+        }
+
+        BarrierStats GetBarrierStats() const {
+            return mDeviceVk->GetBarrierStats();
+        }
+
+        wgpu::Buffer CreateBuffer() {
+            wgpu::BufferDescriptor desc;
+            desc.size = kBufferSize;
+            desc.usage = wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::CopyDst;
+            wgpu::Buffer buffer = device.CreateBuffer(&desc);
+
+            std::vector<uint8_t> data(kBufferSize, 1);
+            queue.WriteBuffer(buffer, 0, data.data(), data.size());
+            return buffer;
+        }
+
+        wgpu::Texture CreateTexture() {
+            wgpu::TextureDescriptor desc;
+            desc.size = {kWidth, 1};
+            desc.format = wgpu::TextureFormat::RGBA8Unorm;
+            desc.usage = wgpu::TextureUsage::CopySrc | wgpu::TextureUsage::CopyDst;
+            return device.CreateTexture(&desc);
+        }
+
+        // Submits the pending uploads and initializations so that the following submit only
+        // contains the commands of the test.
+        void FlushPendingCommands() {
+            queue.Submit(0, nullptr);
+        }
+
+        void EncodeBufferToTextureCopy(const wgpu::CommandEncoder& encoder,
+                                       const wgpu::Buffer& buffer,
+                                       const wgpu::Texture& texture) {
+            wgpu::ImageCopyBuffer src = utils::CreateImageCopyBuffer(buffer, 0, kBufferSize);
+            wgpu::ImageCopyTexture dst = utils::CreateImageCopyTexture(texture, 0, {0, 0, 0});
+            wgpu::Extent3D copySize = {kWidth, 1};
+            encoder.CopyBufferToTexture(&src, &dst, &copySize);
+        }
+
+        dawn::native::vulkan::Device* mDeviceVk;
+    };
+
+}  // anonymous namespace
+
+// Test that the barriers of independent copies are recorded with a single pipeline barrier.
+TEST_P(VulkanBarrierBatchingTests, IndependentCopiesShareOneBarrier) {
+    std::vector<wgpu::Buffer> buffers;
+    std::vector<wgpu::Texture> textures;
+    for (uint32_t i = 0; i < kCopyCount; ++i) {
+        buffers.push_back(CreateBuffer());
+        textures.push_back(CreateTexture());
+    }
+    FlushPendingCommands();
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    for (uint32_t i = 0; i < kCopyCount; ++i) {
+        EncodeBufferToTextureCopy(encoder, buffers[i], textures[i]);
+    }
+    wgpu::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+
+    // Each copy transitions its buffer to CopySrc and its texture to CopyDst.
+    BarrierStats stats = GetBarrierStats();
+    EXPECT_EQ(stats.lastSubmitPipelineBarrierCount, 1u);
+    EXPECT_EQ(stats.lastSubmitMemoryBarrierCount, 2 * kCopyCount);
+}
+
+// Test that a copy reading the result of a previous copy starts a new batch of barriers.
+TEST_P(VulkanBarrierBatchingTests, DependentCopiesAreNotBatched) {
+    wgpu::Buffer srcBuffer = CreateBuffer();
+    wgpu::Buffer dstBuffer = CreateBuffer();
+    wgpu::Texture texture = CreateTexture();
+    FlushPendingCommands();
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    EncodeBufferToTextureCopy(encoder, srcBuffer, texture);
+    wgpu::ImageCopyTexture src = utils::CreateImageCopyTexture(texture, 0, {0, 0, 0});
+    wgpu::ImageCopyBuffer dst = utils::CreateImageCopyBuffer(dstBuffer, 0, kBufferSize);
+    wgpu::Extent3D copySize = {kWidth, 1};
+    encoder.CopyTextureToBuffer(&src, &dst, &copySize);
+    wgpu::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+
+    EXPECT_EQ(GetBarrierStats().lastSubmitPipelineBarrierCount, 2u);
+}
+
+// Test that the lazy clears of the textures read by a batch of copies share a single barrier.
+TEST_P(VulkanBarrierBatchingTests, LazyClearsShareOneBarrier) {
+    DAWN_TEST_UNSUPPORTED_IF(!HasToggleEnabled("lazy_clear_resource_on_first_use"));
+
+    std::vector<wgpu::Buffer> buffers;
+    std::vector<wgpu::Texture> textures;
+    for (uint32_t i = 0; i < kCopyCount; ++i) {
+        wgpu::BufferDescriptor desc;
+        desc.size = kBufferSize;
+        desc.usage = wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::CopyDst;
+        buffers.push_back(device.CreateBuffer(&desc));
+        textures.push_back(CreateTexture());
+    }
+    FlushPendingCommands();
+
+    // The copies read the uninitialized textures, which are cleared first.
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    for (uint32_t i = 0; i < kCopyCount; ++i) {
+        wgpu::ImageCopyTexture src = utils::CreateImageCopyTexture(textures[i], 0, {0, 0, 0});
+        wgpu::ImageCopyBuffer dst = utils::CreateImageCopyBuffer(buffers[i], 0, kBufferSize);
+        wgpu::Extent3D copySize = {kWidth, 1};
+        encoder.CopyTextureToBuffer(&src, &dst, &copySize);
+    }
+    wgpu::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+
+    // One barrier transitions the textures for the clears, and one for the copies.
+    EXPECT_EQ(GetBarrierStats().lastSubmitPipelineBarrierCount, 2u);
+    EXPECT_BUFFER_U32_EQ(0u, buffers[kCopyCount - 1], 0);
+}
+
+DAWN_INSTANTIATE_TEST(VulkanBarrierBatchingTests, VulkanBackend());
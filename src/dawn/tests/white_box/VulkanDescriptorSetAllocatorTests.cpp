@@ -0,0 +1,149 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/tests/DawnTest.h"
+
+#include "dawn/native/vulkan/DescriptorSetAllocator.h"
+#include "dawn/native/vulkan/DeviceVk.h"
+
+#include <vector>
+
+namespace {
+
+    using Stats = dawn::native::vulkan::DescriptorSetAllocator::Stats;
+
+    class VulkanDescriptorSetAllocatorTests : public DawnTest {
+      protected:
+        void SetUp() override {
+            DawnTest::SetUp();
+            DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+
+            mDeviceVk = dawn::native::vulkan::ToBackend(dawn::native::FromAPI(device.Get()));
+        }
+
+        Stats GetStats() const {
+            return mDeviceVk->GetDescriptorSetAllocator()->GetStats();
+        }
+
+        wgpu::BindGroupLayout MakeUniformLayout(uint32_t bindingCount,
+                                                wgpu::ShaderStage visibility) {
+            std::vector<wgpu::BindGroupLayoutEntry> entries(bindingCount);
+            for (uint32_t i = 0; i < bindingCount; ++i) {
+                entries[i].binding = i;
+                entries[i].visibility = visibility;
+                entries[i].buffer.type = wgpu::BufferBindingType::Uniform;
+            }
+
+            wgpu::BindGroupLayoutDescriptor desc;
+            desc.entryCount = entries.size();
+            desc.entries = entries.data();
+            return device.CreateBindGroupLayout(&desc);
+        }
+
+        wgpu::BindGroup MakeUniformBindGroup(const wgpu::BindGroupLayout& layout,
+                                             uint32_t bindingCount) {
+            std::vector<wgpu::BindGroupEntry> entries(bindingCount);
+            for (uint32_t i = 0; i < bindingCount; ++i) {
+                entries[i].binding = i;
+                entries[i].buffer = mUniformBuffer;
+                entries[i].size = 4;
+            }
+
+            wgpu::BindGroupDescriptor desc;
+            desc.layout = layout;
+            desc.entryCount = entries.size();
+            desc.entries = entries.data();
+            return device.CreateBindGroup(&desc);
+        }
+
+        // Make the GPU complete a serial after the current one so that the descriptor sets
+        // deallocated until now are reclaimed.
+        void ReclaimDeallocatedSets() {
+            wgpu::CommandBuffer commands = device.CreateCommandEncoder().Finish();
+            queue.Submit(1, &commands);
+            WaitForAllOperations();
+        }
+
+        void CreateUniformBuffer() {
+            wgpu::BufferDescriptor desc;
+            desc.size = 4;
+            desc.usage = wgpu::BufferUsage::Uniform;
+            mUniformBuffer = device.CreateBuffer(&desc);
+        }
+
+        dawn::native::vulkan::Device* mDeviceVk;
+        wgpu::Buffer mUniformBuffer;
+    };
+
+}  // anonymous namespace
+
+// Test that layouts with different but close descriptor counts allocate from the same pool, and
+// that layouts with very different counts don't.
+TEST_P(VulkanDescriptorSetAllocatorTests, SimilarLayoutsSharePools) {
+    CreateUniformBuffer();
+    Stats before = GetStats();
+
+    // 3 and 4 descriptors are both rounded up to 4.
+    wgpu::BindGroupLayout layout3 = MakeUniformLayout(3, wgpu::ShaderStage::Vertex);
+    wgpu::BindGroupLayout layout4 = MakeUniformLayout(4, wgpu::ShaderStage::Fragment);
+    wgpu::BindGroup bindGroup3 = MakeUniformBindGroup(layout3, 3);
+    wgpu::BindGroup bindGroup4 = MakeUniformBindGroup(layout4, 4);
+
+    Stats after = GetStats();
+    EXPECT_EQ(after.bucketCount, before.bucketCount + 1);
+    EXPECT_EQ(after.poolCount, before.poolCount + 1);
+    EXPECT_EQ(after.setsInUse, before.setsInUse + 2);
+
+    // A single descriptor is in another bucket.
+    wgpu::BindGroupLayout layout1 = MakeUniformLayout(1, wgpu::ShaderStage::Fragment);
+    wgpu::BindGroup bindGroup1 = MakeUniformBindGroup(layout1, 1);
+
+    after = GetStats();
+    EXPECT_EQ(after.bucketCount, before.bucketCount + 2);
+    EXPECT_EQ(after.poolCount, before.poolCount + 2);
+}
+
+// Test that pools are reset once all of their descriptor sets are no longer used, and then reused
+// instead of creating new pools.
+TEST_P(VulkanDescriptorSetAllocatorTests, PoolsAreResetAndReused) {
+    CreateUniformBuffer();
+    wgpu::BindGroupLayout layout = MakeUniformLayout(2, wgpu::ShaderStage::Fragment);
+
+    // Fill more than one pool.
+    Stats before = GetStats();
+    std::vector<wgpu::BindGroup> bindGroups;
+    do {
+        bindGroups.push_back(MakeUniformBindGroup(layout, 2));
+    } while (GetStats().poolCount < before.poolCount + 2);
+
+    Stats full = GetStats();
+    EXPECT_EQ(full.setsInUse, before.setsInUse + bindGroups.size());
+    EXPECT_GE(full.setCapacity, full.setsInUse);
+
+    // The descriptor sets are reclaimed only after the GPU is done with the current serial.
+    bindGroups.clear();
+    EXPECT_EQ(GetStats().setsInUse, full.setsInUse);
+    ReclaimDeallocatedSets();
+    EXPECT_EQ(GetStats().setsInUse, before.setsInUse);
+
+    // Allocating as many sets again reuses the pools.
+    size_t bindGroupCount = full.setsInUse - before.setsInUse;
+    for (size_t i = 0; i < bindGroupCount; ++i) {
+        bindGroups.push_back(MakeUniformBindGroup(layout, 2));
+    }
+    EXPECT_EQ(GetStats().poolCount, full.poolCount);
+    EXPECT_EQ(GetStats().setsInUse, full.setsInUse);
+}
+
+DAWN_INSTANTIATE_TEST(VulkanDescriptorSetAllocatorTests, VulkanBackend());
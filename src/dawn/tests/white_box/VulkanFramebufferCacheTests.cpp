@@ -0,0 +1,134 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/tests/DawnTest.h"
+
+#include "dawn/native/vulkan/DeviceVk.h"
+#include "dawn/native/vulkan/FramebufferCache.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace {
+
+    using Stats = dawn::native::vulkan::FramebufferCache::Stats;
+
+    constexpr uint32_t kSize = 4;
+
+    class VulkanFramebufferCacheTests : public DawnTest {
+      protected:
+        void SetUp() override {
+            DawnTest::SetUp();
+            DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+
+            mDeviceVk = dawn::native::vulkan::ToBackend(dawn::native::FromAPI(device.Get()));
+        }
+
+        Stats GetStats() const {
+            return mDeviceVk->GetFramebufferCache()->GetStats();
+        }
+
+        bool SupportsImagelessFramebuffers() const {
+            const dawn::native::vulkan::VulkanDeviceInfo& info = mDeviceVk->GetDeviceInfo();
+            return info.HasExt(dawn::native::vulkan::DeviceExt::ImagelessFramebuffer) &&
+                   info.imagelessFramebufferFeatures.imagelessFramebuffer == VK_TRUE;
+        }
+
+        wgpu::Texture CreateRenderTexture(uint32_t mipLevelCount = 1) {
+            wgpu::TextureDescriptor desc;
+            desc.size = {kSize, kSize};
+            desc.mipLevelCount = mipLevelCount;
+            desc.format = wgpu::TextureFormat::RGBA8Unorm;
+            desc.usage = wgpu::TextureUsage::RenderAttachment;
+            return device.CreateTexture(&desc);
+        }
+
+        // Records and submits a render pass that clears |view|.
+        void ClearView(const wgpu::TextureView& view) {
+            utils::ComboRenderPassDescriptor renderPass({view});
+            wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+            encoder.BeginRenderPass(&renderPass).End();
+            wgpu::CommandBuffer commands = encoder.Finish();
+            queue.Submit(1, &commands);
+        }
+
+        dawn::native::vulkan::Device* mDeviceVk;
+    };
+
+}  // anonymous namespace
+
+// Test that render passes with the same attachments reuse the same framebuffer.
+TEST_P(VulkanFramebufferCacheTests, RepeatedRenderPassHitsCache) {
+    wgpu::TextureView view = CreateRenderTexture().CreateView();
+
+    Stats before = GetStats();
+    ClearView(view);
+    Stats afterFirst = GetStats();
+    EXPECT_EQ(afterFirst.hits, before.hits);
+    EXPECT_EQ(afterFirst.misses, before.misses + 1);
+
+    for (uint32_t i = 0; i < 3; ++i) {
+        ClearView(view);
+    }
+    Stats afterRepeats = GetStats();
+    EXPECT_EQ(afterRepeats.hits, afterFirst.hits + 3);
+    EXPECT_EQ(afterRepeats.misses, afterFirst.misses);
+    EXPECT_EQ(afterRepeats.framebufferCount, afterFirst.framebufferCount);
+}
+
+// Test that the framebuffers using a view are removed from the cache when the view is destroyed.
+TEST_P(VulkanFramebufferCacheTests, ViewDestructionEvictsFramebuffers) {
+    // Framebuffers for views of a mip level other than the first one are never imageless, so they
+    // are always keyed by their views.
+    wgpu::Texture texture = CreateRenderTexture(2);
+    wgpu::TextureViewDescriptor viewDesc;
+    viewDesc.baseMipLevel = 1;
+    viewDesc.mipLevelCount = 1;
+    wgpu::TextureView view = texture.CreateView(&viewDesc);
+
+    Stats before = GetStats();
+    ClearView(view);
+    EXPECT_EQ(GetStats().framebufferCount, before.framebufferCount + 1);
+
+    view = nullptr;
+    EXPECT_EQ(GetStats().framebufferCount, before.framebufferCount);
+
+    // Rendering again with a new view creates a new framebuffer.
+    view = texture.CreateView(&viewDesc);
+    ClearView(view);
+    Stats after = GetStats();
+    EXPECT_EQ(after.framebufferCount, before.framebufferCount + 1);
+    EXPECT_EQ(after.misses, before.misses + 2);
+}
+
+// Test that imageless framebuffers are shared between render passes using different textures with
+// the same description.
+TEST_P(VulkanFramebufferCacheTests, ImagelessFramebufferIsShared) {
+    DAWN_TEST_UNSUPPORTED_IF(!SupportsImagelessFramebuffers());
+
+    wgpu::TextureView view1 = CreateRenderTexture().CreateView();
+    wgpu::TextureView view2 = CreateRenderTexture().CreateView();
+
+    Stats before = GetStats();
+    ClearView(view1);
+    ClearView(view2);
+    Stats after = GetStats();
+    EXPECT_EQ(after.misses, before.misses + 1);
+    EXPECT_EQ(after.hits, before.hits + 1);
+
+    // Imageless framebuffers don't depend on the views and stay in the cache.
+    view1 = nullptr;
+    view2 = nullptr;
+    EXPECT_EQ(GetStats().framebufferCount, after.framebufferCount);
+}
+
+DAWN_INSTANTIATE_TEST(VulkanFramebufferCacheTests, VulkanBackend());
@@ -0,0 +1,126 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/tests/DawnTest.h"
+
+#include "dawn/common/vulkan_platform.h"
+#include "dawn/native/VulkanBackend.h"
+#include "dawn/native/vulkan/DeviceVk.h"
+#include "dawn/native/vulkan/ResourceMemoryAllocatorVk.h"
+
+#include <vector>
+
+namespace {
+
+    using DefragmentationStats =
+        dawn::native::vulkan::ResourceMemoryAllocator::DefragmentationStats;
+
+    // Buffers sub-allocated in blocks of 1MiB, with 8 of them in each 8MiB memory block.
+    constexpr uint64_t kBufferSize = 1024 * 1024 - 1024;
+    constexpr uint32_t kBuffersPerHeap = 8;
+
+    class VulkanMemoryDefragmentationTests : public DawnTest {
+      protected:
+        void SetUp() override {
+            DawnTest::SetUp();
+            DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+
+            mDeviceVk = dawn::native::vulkan::ToBackend(dawn::native::FromAPI(device.Get()));
+        }
+
+        DefragmentationStats GetDefragmentationStats() const {
+            return mDeviceVk->GetResourceMemoryAllocator()->GetDefragmentationStats();
+        }
+
+        wgpu::Buffer CreateBuffer(uint32_t value) {
+            wgpu::BufferDescriptor desc;
+            desc.size = kBufferSize;
+            desc.usage = wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::CopyDst;
+            wgpu::Buffer buffer = device.CreateBuffer(&desc);
+
+            std::vector<uint32_t> data(kBufferSize / sizeof(uint32_t), value);
+            queue.WriteBuffer(buffer, 0, data.data(), kBufferSize);
+            return buffer;
+        }
+
+        // Waits until the GPU is idle and lets the device tick, which is when it defragments.
+        void TickWhenIdle() {
+            for (uint32_t i = 0; i < 3; ++i) {
+                WaitForAllOperations();
+                device.Tick();
+            }
+        }
+
+        dawn::native::vulkan::Device* mDeviceVk;
+    };
+
+}  // anonymous namespace
+
+// Test that the buffers of a memory block that is mostly free are moved to the other memory
+// blocks, without changing their contents.
+TEST_P(VulkanMemoryDefragmentationTests, SparseHeapIsEvacuated) {
+    std::vector<wgpu::Buffer> buffers;
+    for (uint32_t i = 0; i < 2 * kBuffersPerHeap; ++i) {
+        buffers.push_back(CreateBuffer(i));
+    }
+    TickWhenIdle();
+    DefragmentationStats statsBefore = GetDefragmentationStats();
+
+    // Keep a single buffer in the first memory block and half of the second one.
+    std::vector<uint32_t> keptBuffers = {0};
+    for (uint32_t i = kBuffersPerHeap; i < kBuffersPerHeap * 3 / 2; ++i) {
+        keptBuffers.push_back(i);
+    }
+    std::vector<wgpu::Buffer> remainingBuffers;
+    for (uint32_t i : keptBuffers) {
+        remainingBuffers.push_back(buffers[i]);
+    }
+    buffers.clear();
+    TickWhenIdle();
+
+    DefragmentationStats statsAfter = GetDefragmentationStats();
+    EXPECT_GE(statsAfter.movedBufferCount, statsBefore.movedBufferCount + 1);
+    EXPECT_GT(statsAfter.movedBytes, statsBefore.movedBytes);
+
+    for (size_t i = 0; i < keptBuffers.size(); ++i) {
+        std::vector<uint32_t> expected(kBufferSize / sizeof(uint32_t), keptBuffers[i]);
+        EXPECT_BUFFER_U32_RANGE_EQ(expected.data(), remainingBuffers[i], 0, expected.size());
+    }
+}
+
+// Test that the heap infos report the memory allocated by the device.
+TEST_P(VulkanMemoryDefragmentationTests, MemoryHeapInfos) {
+    std::vector<dawn::native::vulkan::MemoryHeapInfo> infosBefore =
+        dawn::native::vulkan::GetMemoryHeapInfos(device.Get());
+    ASSERT_FALSE(infosBefore.empty());
+
+    wgpu::Buffer buffer = CreateBuffer(0);
+
+    std::vector<dawn::native::vulkan::MemoryHeapInfo> infosAfter =
+        dawn::native::vulkan::GetMemoryHeapInfos(device.Get());
+    ASSERT_EQ(infosBefore.size(), infosAfter.size());
+
+    uint64_t usageBefore = 0;
+    uint64_t usageAfter = 0;
+    for (size_t i = 0; i < infosAfter.size(); ++i) {
+        EXPECT_GT(infosAfter[i].size, 0u);
+        EXPECT_GT(infosAfter[i].budget, 0u);
+        usageBefore += infosBefore[i].usage;
+        usageAfter += infosAfter[i].usage;
+    }
+    EXPECT_GE(usageAfter, usageBefore);
+}
+
+DAWN_INSTANTIATE_TEST(VulkanMemoryDefragmentationTests,
+                      VulkanBackend({"vulkan_defragment_memory_when_idle"}));
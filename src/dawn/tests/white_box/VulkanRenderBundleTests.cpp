@@ -0,0 +1,115 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/tests/DawnTest.h"
+
+#include "dawn/native/vulkan/DeviceVk.h"
+#include "dawn/utils/ComboRenderBundleEncoderDescriptor.h"
+#include "dawn/utils/ComboRenderPipelineDescriptor.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace {
+
+    constexpr uint32_t kRTSize = 4;
+
+    class VulkanRenderBundleTests : public DawnTest {
+      protected:
+        void SetUp() override {
+            DawnTest::SetUp();
+            DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+
+            mDeviceVk = dawn::native::vulkan::ToBackend(dawn::native::FromAPI(device.Get()));
+            mRenderPass = utils::CreateBasicRenderPass(device, kRTSize, kRTSize);
+
+            wgpu::ShaderModule module = utils::CreateShaderModule(device, R"(
+                @stage(vertex) fn vs_main(@builtin(vertex_index) VertexIndex : u32)
+                                          -> @builtin(position) vec4<f32> {
+                    var pos = array<vec2<f32>, 3>(
+                        vec2<f32>(-1.0, -1.0),
+                        vec2<f32>( 3.0, -1.0),
+                        vec2<f32>(-1.0,  3.0));
+                    return vec4<f32>(pos[VertexIndex], 0.0, 1.0);
+                }
+
+                @stage(fragment) fn fs_main() -> @location(0) vec4<f32> {
+                    return vec4<f32>(0.0, 1.0, 0.0, 1.0);
+                })");
+
+            utils::ComboRenderPipelineDescriptor descriptor;
+            descriptor.vertex.module = module;
+            descriptor.vertex.entryPoint = "vs_main";
+            descriptor.cFragment.module = module;
+            descriptor.cFragment.entryPoint = "fs_main";
+            descriptor.cTargets[0].format = mRenderPass.colorFormat;
+            mPipeline = device.CreateRenderPipeline(&descriptor);
+        }
+
+        wgpu::RenderBundle CreateDrawBundle() {
+            utils::ComboRenderBundleEncoderDescriptor desc = {};
+            desc.colorFormatsCount = 1;
+            desc.cColorFormats[0] = mRenderPass.colorFormat;
+
+            wgpu::RenderBundleEncoder encoder = device.CreateRenderBundleEncoder(&desc);
+            encoder.SetPipeline(mPipeline);
+            encoder.Draw(3);
+            return encoder.Finish();
+        }
+
+        uint64_t GetExecuteCommandsCount() const {
+            return mDeviceVk->GetExecuteCommandsCountForTesting();
+        }
+
+        dawn::native::vulkan::Device* mDeviceVk;
+        utils::BasicRenderPass mRenderPass;
+        wgpu::RenderPipeline mPipeline;
+    };
+
+}  // anonymous namespace
+
+// Test that a render pass executing an empty list of bundles records its commands inline instead
+// of calling vkCmdExecuteCommands without command buffers.
+TEST_P(VulkanRenderBundleTests, EmptyExecuteBundles) {
+    uint64_t executeCommandsCount = GetExecuteCommandsCount();
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&mRenderPass.renderPassInfo);
+    pass.ExecuteBundles(0, nullptr);
+    pass.End();
+    wgpu::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+
+    EXPECT_EQ(GetExecuteCommandsCount(), executeCommandsCount);
+    EXPECT_PIXEL_RGBA8_EQ(RGBA8::kZero, mRenderPass.color, 0, 0);
+}
+
+// Test that an empty list of bundles is skipped in a render pass executing other bundles as
+// secondary command buffers.
+TEST_P(VulkanRenderBundleTests, EmptyExecuteBundlesWithOtherBundles) {
+    wgpu::RenderBundle bundle = CreateDrawBundle();
+    uint64_t executeCommandsCount = GetExecuteCommandsCount();
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&mRenderPass.renderPassInfo);
+    pass.ExecuteBundles(0, nullptr);
+    pass.ExecuteBundles(1, &bundle);
+    pass.ExecuteBundles(0, nullptr);
+    pass.End();
+    wgpu::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+
+    EXPECT_EQ(GetExecuteCommandsCount(), executeCommandsCount + 1);
+    EXPECT_PIXEL_RGBA8_EQ(RGBA8::kGreen, mRenderPass.color, 0, 0);
+}
+
+DAWN_INSTANTIATE_TEST(VulkanRenderBundleTests, VulkanBackend());
@@ -0,0 +1,63 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/tests/DawnTest.h"
+
+#include "dawn/native/vulkan/DeviceVk.h"
+
+namespace {
+
+    class VulkanSerialTrackingTests : public DawnTest {
+      protected:
+        void SetUp() override {
+            DawnTest::SetUp();
+            DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+
+            mDeviceVk = dawn::native::vulkan::ToBackend(dawn::native::FromAPI(device.Get()));
+        }
+
+        void SubmitEmptyCommands() {
+            wgpu::CommandBuffer commands = device.CreateCommandEncoder().Finish();
+            queue.Submit(1, &commands);
+        }
+
+        dawn::native::vulkan::Device* mDeviceVk;
+    };
+
+}  // anonymous namespace
+
+// Test that waiting for a serial makes it and all the previous ones completed, whether serials are
+// tracked with a timeline semaphore or with fences.
+TEST_P(VulkanSerialTrackingTests, WaitForSerial) {
+    SubmitEmptyCommands();
+    dawn::native::ExecutionSerial firstSerial = mDeviceVk->GetLastSubmittedCommandSerial();
+    SubmitEmptyCommands();
+    SubmitEmptyCommands();
+    dawn::native::ExecutionSerial lastSerial = mDeviceVk->GetLastSubmittedCommandSerial();
+    EXPECT_LT(firstSerial, lastSerial);
+
+    ASSERT_FALSE(mDeviceVk->ConsumedError(mDeviceVk->WaitForSerial(firstSerial)));
+    EXPECT_GE(mDeviceVk->GetCompletedCommandSerial(), firstSerial);
+
+    ASSERT_FALSE(mDeviceVk->ConsumedError(mDeviceVk->WaitForSerial(lastSerial)));
+    EXPECT_EQ(mDeviceVk->GetCompletedCommandSerial(), lastSerial);
+
+    // Waiting for a completed serial returns immediately.
+    ASSERT_FALSE(mDeviceVk->ConsumedError(mDeviceVk->WaitForSerial(firstSerial)));
+    EXPECT_EQ(mDeviceVk->GetCompletedCommandSerial(), lastSerial);
+}
+
+DAWN_INSTANTIATE_TEST(VulkanSerialTrackingTests,
+                      VulkanBackend(),
+                      VulkanBackend({"vulkan_disable_timeline_semaphore"}));